@@ -3,21 +3,91 @@
 
 #include <parus/backend/Backend.hpp>
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 
 namespace parus::backend::jit {
 
-    /// @brief JIT 백엔드 스텁 구현.
+    /// @brief JIT 실행(run) 옵션.
+    struct JITRunOptions {
+        /// @brief 실행할 C 엔트리 심볼. OIR lowering이 만드는 `main` 브릿지가 기본이다.
+        std::string entry_symbol{"main"};
+
+        /// @brief 엔트리에 전달할 argv (argv[0] 포함).
+        std::vector<std::string> argv{};
+
+        /// @brief 심볼 해석에 추가할 정적 아카이브 경로(예: libcore_ext.a).
+        std::vector<std::string> archive_paths{};
+
+        /// @brief true면 함수 단위로 처음 호출될 때 코드 생성한다(CompileOnDemand).
+        bool lazy = true;
+
+        /// @brief 함수 호출 횟수가 이 값에 도달하면 -O2로 재컴파일한다. 0이면 tier-up을 끈다.
+        uint64_t tier_up_threshold = 1000;
+    };
+
+    /// @brief 함수 단위 JIT 컴파일 통계.
+    struct JITTierStats {
+        /// @brief 모듈에 정의된 함수 수.
+        uint32_t total_functions = 0;
+
+        /// @brief 실제로 코드 생성(tier-0)된 함수 수.
+        uint32_t compiled_functions = 0;
+
+        /// @brief -O2로 재컴파일(tier-up)된 함수 수.
+        uint32_t tiered_up_functions = 0;
+
+        /// @brief tier-up 재컴파일에 쓴 누적 시간(ns). run_ns에 포함된다.
+        uint64_t tier_up_ns = 0;
+
+        /// @brief tier-up된 함수의 심볼 이름(발생 순서).
+        std::vector<std::string> hot_functions{};
+    };
+
+    /// @brief JIT 실행 결과.
+    struct JITRunResult {
+        bool ok = false;
+        int exit_code = 1;
+
+        /// @brief OIR lowering + IR 파싱 + materialize까지 걸린 시간(ns).
+        uint64_t compile_ns = 0;
+
+        /// @brief 엔트리 실행 시간(ns).
+        uint64_t run_ns = 0;
+
+        JITTierStats tier{};
+
+        std::vector<CompileMessage> messages{};
+    };
+
+    /// @brief LLVM ORC LLJIT 기반 in-process 백엔드.
+    ///
+    /// OIR은 AOT와 동일한 LLVM-IR lowering을 거친 뒤 LLJIT에 올라간다.
+    /// prt 런타임 심볼은 현재 프로세스에 링크된 구현으로 바로 해석된다.
+    ///
+    /// 기본 실행은 2단계(tier)다. 함수는 첫 호출 시 -O0로 코드 생성되고,
+    /// 호출 카운터가 임계값에 닿으면 -O2 본문으로 교체된다.
     class JITBackend final : public parus::backend::Backend {
     public:
         /// @brief 백엔드 종류를 반환한다.
         BackendKind kind() const override;
 
-        /// @brief OIR을 JIT 경로로 컴파일한다(현재는 스텁).
+        /// @brief OIR을 JIT에 올리고 엔트리 심볼까지 materialize한다(실행은 하지 않는다).
         CompileResult compile(
             const parus::oir::Module& oir,
             const parus::ty::TypePool& types,
             const CompileOptions& opt
         ) override;
+
+        /// @brief OIR을 JIT 컴파일한 뒤 엔트리를 현재 프로세스에서 실행한다.
+        JITRunResult run(
+            const parus::oir::Module& oir,
+            const parus::ty::TypePool& types,
+            const CompileOptions& opt,
+            const JITRunOptions& run_opt
+        );
     };
 
 } // namespace parus::backend::jit
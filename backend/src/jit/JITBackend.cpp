@@ -1,26 +1,651 @@
 // backend/src/jit/JITBackend.cpp
 #include <parus/backend/jit/JITBackend.hpp>
+#include <parus/backend/aot/LLVMIRLowering.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef PARUS_LLVM_TOOLCHAIN_FOUND
+#define PARUS_LLVM_TOOLCHAIN_FOUND 0
+#endif
+
+#if PARUS_LLVM_TOOLCHAIN_FOUND
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/IRTransformLayer.h>
+#if LLVM_VERSION_MAJOR >= 19
+#include <llvm/ExecutionEngine/Orc/IRPartitionLayer.h>
+#endif
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+
+// prt(hosted) 런타임은 parus_backend_jit에 정적으로 링크되어 있다.
+// JIT 코드가 참조하는 actor ABI 심볼을 이 프로세스의 구현으로 직접 바인딩한다.
+extern "C" {
+void* __parus_actor_new(uint64_t type_tag, uint64_t draft_size, uint64_t draft_align);
+void* __parus_actor_clone(void* handle);
+void  __parus_actor_release(void* handle);
+void* __parus_actor_enter(void* handle, uint32_t mode);
+void* __parus_actor_draft_ptr(void* ctx);
+void  __parus_actor_commit(void* ctx);
+void  __parus_actor_recast(void* ctx);
+void  __parus_actor_leave(void* ctx);
+uint64_t __parus_prt_debug_live_actors(void);
+uint64_t __parus_prt_dump_stats(char* buf, uint64_t cap, uint32_t format);
+}
+#endif
 
 namespace parus::backend::jit {
 
+    namespace {
+
+#if PARUS_LLVM_TOOLCHAIN_FOUND
+        uint64_t elapsed_ns_(std::chrono::steady_clock::time_point since) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - since).count());
+        }
+
+        /// @brief O 레벨 숫자를 LLVM CodeGen 레벨로 변환한다.
+        llvm::CodeGenOptLevel to_codegen_opt_level_(uint8_t opt_level) {
+            switch (opt_level) {
+                case 0: return llvm::CodeGenOptLevel::None;
+                case 1: return llvm::CodeGenOptLevel::Less;
+                case 2: return llvm::CodeGenOptLevel::Default;
+                case 3: return llvm::CodeGenOptLevel::Aggressive;
+                default: return llvm::CodeGenOptLevel::Default;
+            }
+        }
+
+        /// @brief JIT은 host 타깃만 필요하므로 native target만 1회 초기화한다.
+        void init_native_target_once_() {
+            static bool inited = false;
+            if (inited) return;
+            llvm::InitializeNativeTarget();
+            llvm::InitializeNativeTargetAsmPrinter();
+            llvm::InitializeNativeTargetAsmParser();
+            inited = true;
+        }
+
+        std::string render_error_(llvm::Error err) {
+            return llvm::toString(std::move(err));
+        }
+
+        std::string render_diag_(const llvm::SMDiagnostic& diag) {
+            std::string s;
+            llvm::raw_string_ostream os(s);
+            diag.print("parus", os);
+            os.flush();
+            return s;
+        }
+
+        constexpr const char* kTierUpHookSymbol = "__parus_jit_tier_up";
+        constexpr const char* kTrampolineAttr = "parus-jit-trampoline";
+
+        /// @brief 모듈의 정의된(선언이 아닌) 함수 수를 센다. 트램펄린은 제외한다.
+        uint32_t count_defined_functions_(const llvm::Module& m) {
+            uint32_t n = 0;
+            for (const auto& f : m) {
+                if (f.isDeclaration() || f.hasFnAttribute(kTrampolineAttr)) continue;
+                ++n;
+            }
+            return n;
+        }
+
+        /// @brief 모듈 하나를 IR 레벨에서 최적화한다(new pass manager 기본 파이프라인).
+        void optimize_module_(llvm::Module& m, llvm::TargetMachine& tm, llvm::OptimizationLevel level) {
+            llvm::LoopAnalysisManager lam;
+            llvm::FunctionAnalysisManager fam;
+            llvm::CGSCCAnalysisManager cgam;
+            llvm::ModuleAnalysisManager mam;
+            llvm::PassBuilder pb(&tm);
+            pb.registerModuleAnalyses(mam);
+            pb.registerCGSCCAnalyses(cgam);
+            pb.registerFunctionAnalyses(fam);
+            pb.registerLoopAnalyses(lam);
+            pb.crossRegisterProxies(lam, fam, cgam, mam);
+            auto mpm = pb.buildPerModuleDefaultPipeline(level);
+            mpm.run(m, mam);
+        }
+
+        /// @brief 함수 단위 tier-up 관리자.
+        ///
+        /// tier-0 모듈에서 각 함수 `f`는 본문 `f.t0`, 호출 카운터 `f.cnt`,
+        /// 현재 구현을 가리키는 슬롯 `f.slot`, 그리고 `f`라는 이름의 트램펄린으로 분리된다.
+        /// 모든 호출은 트램펄린을 거치므로 카운터가 임계값에 닿으면 `f.t0`만 잘라내
+        /// -O2로 컴파일한 `f.t2`를 슬롯에 기록하는 것으로 교체가 끝난다.
+        class TierManager {
+        public:
+            TierManager(std::string lowered_ir, std::string entry_symbol, uint64_t threshold)
+                : lowered_ir_(std::move(lowered_ir)),
+                  entry_symbol_(std::move(entry_symbol)),
+                  threshold_(threshold) {}
+
+            /// @brief tier-0 모듈을 트램펄린 형태로 변환한다. 재컴파일용 원본 복제에도 그대로 재사용된다.
+            void prepare_module(llvm::Module& m) {
+                externalize_locals_(m);
+                std::vector<std::string> names = install_trampolines_(m);
+                if (names_.empty()) names_ = std::move(names);
+            }
+
+            /// @brief JIT 세션과 -O2 코드 생성용 TargetMachine을 연결한다.
+            void attach(llvm::orc::LLJIT& jit, std::unique_ptr<llvm::TargetMachine> hot_tm, llvm::OptimizationLevel hot_level) {
+                jit_ = &jit;
+                hot_tm_ = std::move(hot_tm);
+                hot_level_ = hot_level;
+            }
+
+            /// @brief JIT 코드의 트램펄린이 호출하는 진입점.
+            static void hook(void* self, uint64_t idx) {
+                static_cast<TierManager*>(self)->tier_up_(idx);
+            }
+
+            uint32_t tiered_up() const { return static_cast<uint32_t>(hot_functions_.size()); }
+            uint64_t tier_up_ns() const { return tier_up_ns_; }
+            const std::vector<std::string>& hot_functions() const { return hot_functions_; }
+            const std::vector<std::string>& failures() const { return failures_; }
+
+        private:
+            /// @brief 재컴파일 모듈이 선언만으로 참조할 수 있도록 로컬 심볼을 외부 링크로 올린다.
+            static void externalize_locals_(llvm::Module& m) {
+                uint64_t anon = 0;
+                auto promote = [&](llvm::GlobalValue& gv) {
+                    if (gv.isDeclaration()) return;
+                    if (!gv.hasName()) gv.setName("__parus_jit_anon." + std::to_string(anon++));
+                    if (gv.hasLocalLinkage()) {
+                        gv.setLinkage(llvm::GlobalValue::ExternalLinkage);
+                        gv.setVisibility(llvm::GlobalValue::DefaultVisibility);
+                    }
+                };
+                for (auto& f : m.functions()) promote(f);
+                for (auto& g : m.globals()) {
+                    if (g.getName().starts_with("llvm.")) continue;
+                    promote(g);
+                }
+                for (auto& a : m.aliases()) promote(a);
+            }
+
+            bool is_tierable_(const llvm::Function& f) const {
+                if (f.isDeclaration() || f.isIntrinsic() || f.isVarArg()) return false;
+                if (f.hasFnAttribute(kTrampolineAttr)) return false;
+                // 엔트리 브릿지는 한 번만 호출되므로 트램펄린을 둘 이유가 없다.
+                return f.getName() != entry_symbol_;
+            }
+
+            std::vector<std::string> install_trampolines_(llvm::Module& m) {
+                auto& ctx = m.getContext();
+                auto* i64 = llvm::Type::getInt64Ty(ctx);
+                auto* ptr = llvm::PointerType::getUnqual(ctx);
+                auto* hook_ty = llvm::FunctionType::get(llvm::Type::getVoidTy(ctx), {ptr, i64}, /*isVarArg=*/false);
+                const llvm::FunctionCallee hook_fn = m.getOrInsertFunction(kTierUpHookSymbol, hook_ty);
+                auto* self = llvm::ConstantExpr::getIntToPtr(
+                    llvm::ConstantInt::get(i64, reinterpret_cast<uintptr_t>(this)), ptr);
+                llvm::MDBuilder md(ctx);
+
+                std::vector<llvm::Function*> bodies{};
+                for (auto& f : m) {
+                    if (is_tierable_(f)) bodies.push_back(&f);
+                }
+
+                std::vector<std::string> names{};
+                names.reserve(bodies.size());
+                for (auto* body : bodies) {
+                    const std::string name = body->getName().str();
+                    const uint64_t idx = names.size();
+                    names.push_back(name);
+
+                    body->setName(name + ".t0");
+                    body->setLinkage(llvm::GlobalValue::ExternalLinkage);
+
+                    // musttail 전달에는 ABI에 영향을 주는 ret/param 속성만 일치하면 된다.
+                    const auto attrs = body->getAttributes();
+                    std::vector<llvm::AttributeSet> param_attrs{};
+                    for (unsigned i = 0; i < body->arg_size(); ++i) param_attrs.push_back(attrs.getParamAttrs(i));
+                    const auto call_attrs = llvm::AttributeList::get(ctx, llvm::AttributeSet{}, attrs.getRetAttrs(), param_attrs);
+
+                    auto* tramp = llvm::Function::Create(
+                        body->getFunctionType(), llvm::GlobalValue::ExternalLinkage, name, m);
+                    tramp->setCallingConv(body->getCallingConv());
+                    tramp->setAttributes(call_attrs);
+                    tramp->addFnAttr(kTrampolineAttr);
+                    body->replaceAllUsesWith(tramp);
+
+                    auto* counter = new llvm::GlobalVariable(
+                        m, i64, /*isConstant=*/false, llvm::GlobalValue::ExternalLinkage,
+                        llvm::ConstantInt::get(i64, 0), name + ".cnt");
+                    counter->setAlignment(llvm::Align(8));
+                    auto* slot = new llvm::GlobalVariable(
+                        m, ptr, /*isConstant=*/false, llvm::GlobalValue::ExternalLinkage, body, name + ".slot");
+                    slot->setAlignment(llvm::Align(8));
+
+                    auto* entry_bb = llvm::BasicBlock::Create(ctx, "entry", tramp);
+                    auto* hot_bb = llvm::BasicBlock::Create(ctx, "tier_up", tramp);
+                    auto* dispatch_bb = llvm::BasicBlock::Create(ctx, "dispatch", tramp);
+                    llvm::IRBuilder<> b(entry_bb);
+                    auto* prev = b.CreateAtomicRMW(
+                        llvm::AtomicRMWInst::Add, counter, llvm::ConstantInt::get(i64, 1),
+                        llvm::MaybeAlign(8), llvm::AtomicOrdering::Monotonic);
+                    auto* is_hot = b.CreateICmpEQ(prev, llvm::ConstantInt::get(i64, threshold_ - 1));
+                    b.CreateCondBr(is_hot, hot_bb, dispatch_bb, md.createBranchWeights(1, 1u << 20));
+
+                    b.SetInsertPoint(hot_bb);
+                    b.CreateCall(hook_fn, {self, llvm::ConstantInt::get(i64, idx)});
+                    b.CreateBr(dispatch_bb);
+
+                    b.SetInsertPoint(dispatch_bb);
+                    auto* target = b.CreateAlignedLoad(ptr, slot, llvm::Align(8));
+                    target->setAtomic(llvm::AtomicOrdering::Monotonic);
+                    std::vector<llvm::Value*> args{};
+                    for (auto& a : tramp->args()) args.push_back(&a);
+                    auto* call = b.CreateCall(body->getFunctionType(), target, args);
+                    call->setCallingConv(body->getCallingConv());
+                    call->setAttributes(call_attrs);
+                    call->setTailCallKind(llvm::CallInst::TCK_MustTail);
+                    if (body->getReturnType()->isVoidTy()) {
+                        b.CreateRetVoid();
+                    } else {
+                        b.CreateRet(call);
+                    }
+                }
+                return names;
+            }
+
+            void tier_up_(uint64_t idx) {
+                std::lock_guard<std::mutex> lock(mu_);
+                if (jit_ == nullptr || idx >= names_.size()) return;
+                const auto start = std::chrono::steady_clock::now();
+                // 실패해도 실행은 tier-0 본문으로 계속된다.
+                if (auto err = compile_hot_(names_[idx])) {
+                    failures_.push_back("tier-up of '" + names_[idx] + "' failed: " + render_error_(std::move(err)));
+                } else {
+                    hot_functions_.push_back(names_[idx]);
+                }
+                tier_up_ns_ += elapsed_ns_(start);
+            }
+
+            /// @brief 원본 IR을 재파싱해 tier-0와 같은 변환을 재현한다(첫 tier-up 때 1회).
+            llvm::Error ensure_pristine_() {
+                if (pristine_ != nullptr) return llvm::Error::success();
+                pristine_ctx_ = std::make_unique<llvm::LLVMContext>();
+                llvm::SMDiagnostic smdiag;
+                auto mem = llvm::MemoryBuffer::getMemBuffer(lowered_ir_, "parus.oir.ll", /*RequiresNullTerminator=*/false);
+                pristine_ = llvm::parseAssembly(*mem, smdiag, *pristine_ctx_);
+                if (pristine_ == nullptr) {
+                    return llvm::make_error<llvm::StringError>(render_diag_(smdiag), llvm::inconvertibleErrorCode());
+                }
+                pristine_->setDataLayout(jit_->getDataLayout());
+#if LLVM_VERSION_MAJOR >= 21
+                pristine_->setTargetTriple(jit_->getTargetTriple());
+#else
+                pristine_->setTargetTriple(jit_->getTargetTriple().str());
+#endif
+                prepare_module(*pristine_);
+                return llvm::Error::success();
+            }
+
+            /// @brief `name.t0`만 복제해 -O2로 컴파일하고 슬롯을 `name.t2`로 돌린다.
+            llvm::Error compile_hot_(const std::string& name) {
+                if (auto err = ensure_pristine_()) return err;
+                const llvm::Function* body = pristine_->getFunction(name + ".t0");
+                if (body == nullptr) {
+                    return llvm::make_error<llvm::StringError>("missing tier-0 body", llvm::inconvertibleErrorCode());
+                }
+
+                // 다른 함수/전역은 선언으로 남아 메인 JITDylib의 정의(트램펄린 포함)로 해석된다.
+                llvm::ValueToValueMapTy vmap;
+                auto hot = llvm::CloneModule(*pristine_, vmap, [body](const llvm::GlobalValue* gv) {
+                    return gv == body;
+                });
+                for (const char* special : {"llvm.global_ctors", "llvm.global_dtors"}) {
+                    if (auto* gv = hot->getNamedGlobal(special)) gv->eraseFromParent();
+                }
+                hot->getFunction(name + ".t0")->setName(name + ".t2");
+
+                optimize_module_(*hot, *hot_tm_, hot_level_);
+                llvm::orc::SimpleCompiler compiler(*hot_tm_);
+                auto obj = compiler(*hot);
+                if (!obj) return obj.takeError();
+                if (auto err = jit_->addObjectFile(jit_->getMainJITDylib(), std::move(*obj))) return err;
+
+                auto hot_addr = jit_->lookup(name + ".t2");
+                if (!hot_addr) return hot_addr.takeError();
+                auto slot_addr = jit_->lookup(name + ".slot");
+                if (!slot_addr) return slot_addr.takeError();
+                std::atomic_ref<void*>(*slot_addr->toPtr<void**>())
+                    .store(hot_addr->toPtr<void*>(), std::memory_order_release);
+                return llvm::Error::success();
+            }
+
+            std::string lowered_ir_;
+            std::string entry_symbol_;
+            uint64_t threshold_ = 0;
+            std::vector<std::string> names_{};
+
+            llvm::orc::LLJIT* jit_ = nullptr;
+            std::unique_ptr<llvm::TargetMachine> hot_tm_{};
+            llvm::OptimizationLevel hot_level_ = llvm::OptimizationLevel::O2;
+
+            std::unique_ptr<llvm::LLVMContext> pristine_ctx_{};
+            std::unique_ptr<llvm::Module> pristine_{};
+
+            std::mutex mu_{};
+            std::vector<std::string> hot_functions_{};
+            std::vector<std::string> failures_{};
+            uint64_t tier_up_ns_ = 0;
+        };
+
+        /// @brief 한 번의 JIT 실행에 필요한 상태. tier 관리자는 JIT 코드가 참조하므로 JIT보다 오래 산다.
+        struct Session {
+            std::unique_ptr<TierManager> tiers{};
+            std::unique_ptr<std::atomic<uint32_t>> compiled_functions{};
+            uint32_t total_functions = 0;
+            std::unique_ptr<llvm::orc::LLJIT> jit{};
+        };
+
+        /// @brief prt 심볼과 tier-up 훅을 absolute symbol로 JITDylib에 정의한다.
+        llvm::Error define_host_symbols_(llvm::orc::LLJIT& jit, llvm::orc::JITDylib& jd) {
+            const auto flags = llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable;
+            llvm::orc::SymbolMap syms{};
+            auto add = [&](const char* name, auto* fn) {
+                syms[jit.mangleAndIntern(name)] =
+                    llvm::orc::ExecutorSymbolDef(llvm::orc::ExecutorAddr::fromPtr(fn), flags);
+            };
+            add("__parus_actor_new", &__parus_actor_new);
+            add("__parus_actor_clone", &__parus_actor_clone);
+            add("__parus_actor_release", &__parus_actor_release);
+            add("__parus_actor_enter", &__parus_actor_enter);
+            add("__parus_actor_draft_ptr", &__parus_actor_draft_ptr);
+            add("__parus_actor_commit", &__parus_actor_commit);
+            add("__parus_actor_recast", &__parus_actor_recast);
+            add("__parus_actor_leave", &__parus_actor_leave);
+            add("__parus_prt_debug_live_actors", &__parus_prt_debug_live_actors);
+            add("__parus_prt_dump_stats", &__parus_prt_dump_stats);
+            add(kTierUpHookSymbol, &TierManager::hook);
+            return jd.define(llvm::orc::absoluteSymbols(std::move(syms)));
+        }
+
+        /// @brief OIR -> LLVM-IR -> LLJIT(LLLazyJIT) 세션 구성까지 수행한다.
+        bool build_session_(
+            const parus::oir::Module& oir,
+            const parus::ty::TypePool& types,
+            const CompileOptions& opt,
+            const JITRunOptions& run_opt,
+            Session& session,
+            std::vector<CompileMessage>& messages
+        ) {
+            const auto lowered = parus::backend::aot::lower_oir_to_llvm_ir_text(
+                oir,
+                types,
+                parus::backend::aot::LLVMIRLoweringOptions{.llvm_lane_major = LLVM_VERSION_MAJOR}
+            );
+            for (const auto& m : lowered.messages) {
+                if (m.is_error) messages.push_back(m);
+            }
+            if (!lowered.ok) {
+                messages.push_back(CompileMessage{true, "JIT lowering failed."});
+                return false;
+            }
+
+            init_native_target_once_();
+
+            auto context = std::make_unique<llvm::LLVMContext>();
+            llvm::SMDiagnostic smdiag;
+            auto mem = llvm::MemoryBuffer::getMemBuffer(lowered.llvm_ir, "parus.oir.ll", /*RequiresNullTerminator=*/false);
+            auto module = llvm::parseAssembly(*mem, smdiag, *context);
+            if (!module) {
+                messages.push_back(CompileMessage{
+                    true,
+                    "failed to parse lowered LLVM-IR: " + render_diag_(smdiag)
+                });
+                return false;
+            }
+            session.total_functions = count_defined_functions_(*module);
+
+            auto jtmb = llvm::orc::JITTargetMachineBuilder::detectHost();
+            if (!jtmb) {
+                messages.push_back(CompileMessage{true, "failed to detect JIT host target: " + render_error_(jtmb.takeError())});
+                return false;
+            }
+            jtmb->setCodeGenOptLevel(to_codegen_opt_level_(opt.opt_level));
+            if (!opt.cpu.empty()) jtmb->setCPU(opt.cpu);
+
+            // tier-up 대상은 -O2 이상(사용자가 -O3를 주면 -O3)으로 다시 컴파일한다.
+            std::unique_ptr<llvm::TargetMachine> hot_tm{};
+            llvm::OptimizationLevel hot_level = llvm::OptimizationLevel::O2;
+            if (run_opt.tier_up_threshold != 0) {
+                auto hot_jtmb = *jtmb;
+                const uint8_t hot_opt = (opt.opt_level > 2) ? opt.opt_level : 2;
+                hot_jtmb.setCodeGenOptLevel(to_codegen_opt_level_(hot_opt));
+                if (hot_opt > 2) hot_level = llvm::OptimizationLevel::O3;
+                auto tm = hot_jtmb.createTargetMachine();
+                if (!tm) {
+                    messages.push_back(CompileMessage{true, "failed to create tier-up target machine: " + render_error_(tm.takeError())});
+                    return false;
+                }
+                hot_tm = std::move(*tm);
+            }
+
+            llvm::orc::LLLazyJIT* lazy_jit = nullptr;
+            if (run_opt.lazy) {
+                auto jit = llvm::orc::LLLazyJITBuilder().setJITTargetMachineBuilder(std::move(*jtmb)).create();
+                if (!jit) {
+                    messages.push_back(CompileMessage{true, "failed to create LLLazyJIT: " + render_error_(jit.takeError())});
+                    return false;
+                }
+                // 요청된 함수만 하나씩 코드 생성한다.
+                // LLVM 19부터 파티션 함수는 IRPartitionLayer로 옮겨졌다.
+#if LLVM_VERSION_MAJOR >= 19
+                (*jit)->setPartitionFunction(llvm::orc::IRPartitionLayer::compileRequested);
+#else
+                (*jit)->setPartitionFunction(llvm::orc::CompileOnDemandLayer::compileRequested);
+#endif
+                lazy_jit = jit->get();
+                session.jit = std::move(*jit);
+            } else {
+                auto jit = llvm::orc::LLJITBuilder().setJITTargetMachineBuilder(std::move(*jtmb)).create();
+                if (!jit) {
+                    messages.push_back(CompileMessage{true, "failed to create LLJIT: " + render_error_(jit.takeError())});
+                    return false;
+                }
+                session.jit = std::move(*jit);
+            }
+            auto& jit = *session.jit;
+
+            // 코드 생성 직전의 모듈(lazy면 함수 단위 파티션)을 보고 실제로 컴파일된 함수 수를 센다.
+            session.compiled_functions = std::make_unique<std::atomic<uint32_t>>(0);
+            jit.getIRTransformLayer().setTransform(
+                [counter = session.compiled_functions.get()](
+                    llvm::orc::ThreadSafeModule tsm,
+                    llvm::orc::MaterializationResponsibility&
+                ) -> llvm::Expected<llvm::orc::ThreadSafeModule> {
+                    tsm.withModuleDo([&](llvm::Module& m) {
+                        counter->fetch_add(count_defined_functions_(m), std::memory_order_relaxed);
+                    });
+                    return std::move(tsm);
+                });
+
+            auto& jd = jit.getMainJITDylib();
+            if (auto err = define_host_symbols_(jit, jd)) {
+                messages.push_back(CompileMessage{true, "failed to bind prt runtime symbols: " + render_error_(std::move(err))});
+                return false;
+            }
+            for (const auto& path : run_opt.archive_paths) {
+                auto gen = llvm::orc::StaticLibraryDefinitionGenerator::Load(jit.getObjLinkingLayer(), path.c_str());
+                if (!gen) {
+                    messages.push_back(CompileMessage{true, "failed to load archive '" + path + "': " + render_error_(gen.takeError())});
+                    return false;
+                }
+                jd.addGenerator(std::move(*gen));
+            }
+            auto host = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+                jit.getDataLayout().getGlobalPrefix());
+            if (!host) {
+                messages.push_back(CompileMessage{true, "failed to expose host process symbols: " + render_error_(host.takeError())});
+                return false;
+            }
+            jd.addGenerator(std::move(*host));
+
+            module->setDataLayout(jit.getDataLayout());
+#if LLVM_VERSION_MAJOR >= 21
+            module->setTargetTriple(jit.getTargetTriple());
+#else
+            module->setTargetTriple(jit.getTargetTriple().str());
+#endif
+            if (run_opt.tier_up_threshold != 0) {
+                session.tiers = std::make_unique<TierManager>(
+                    lowered.llvm_ir, run_opt.entry_symbol, run_opt.tier_up_threshold);
+                session.tiers->prepare_module(*module);
+                session.tiers->attach(jit, std::move(hot_tm), hot_level);
+            }
+
+            llvm::orc::ThreadSafeModule tsm(std::move(module), std::move(context));
+            auto err = (lazy_jit != nullptr)
+                ? lazy_jit->addLazyIRModule(std::move(tsm))
+                : jit.addIRModule(std::move(tsm));
+            if (err) {
+                messages.push_back(CompileMessage{true, "failed to add module to JIT: " + render_error_(std::move(err))});
+                return false;
+            }
+            return true;
+        }
+#endif
+
+    } // namespace
+
     /// @brief JIT 백엔드 종류를 반환한다.
     BackendKind JITBackend::kind() const {
         return BackendKind::kJit;
     }
 
-    /// @brief JIT lowering/실행 파이프라인은 다음 단계에서 구현한다.
+    /// @brief OIR을 JIT에 올려 `main` 엔트리까지 코드 생성한다.
     CompileResult JITBackend::compile(
-        const parus::oir::Module&,
-        const parus::ty::TypePool&,
-        const CompileOptions&
+        const parus::oir::Module& oir,
+        const parus::ty::TypePool& types,
+        const CompileOptions& opt
     ) {
         CompileResult r{};
+#if !PARUS_LLVM_TOOLCHAIN_FOUND
+        (void)oir;
+        (void)types;
+        (void)opt;
         r.ok = false;
         r.messages.push_back(CompileMessage{
             true,
-            "JIT backend is scaffolded but not implemented yet."
+            "LLVM toolchain is not available in this build. JIT requires direct LLVM static linkage."
+        });
+        return r;
+#else
+        // compile()은 전체 모듈 코드 생성 확인용이므로 eager/단일 tier로 올린다.
+        JITRunOptions eager{};
+        eager.lazy = false;
+        eager.tier_up_threshold = 0;
+        Session session{};
+        if (!build_session_(oir, types, opt, eager, session, r.messages)) return r;
+        auto entry = session.jit->lookup(eager.entry_symbol);
+        if (!entry) {
+            r.messages.push_back(CompileMessage{true, "JIT entry lookup failed: " + render_error_(entry.takeError())});
+            return r;
+        }
+        r.ok = true;
+        r.messages.push_back(CompileMessage{false, "JIT compiled module entry 'main'."});
+        return r;
+#endif
+    }
+
+    /// @brief OIR을 JIT 컴파일하고 엔트리를 in-process로 실행한다.
+    JITRunResult JITBackend::run(
+        const parus::oir::Module& oir,
+        const parus::ty::TypePool& types,
+        const CompileOptions& opt,
+        const JITRunOptions& run_opt
+    ) {
+        JITRunResult r{};
+#if !PARUS_LLVM_TOOLCHAIN_FOUND
+        (void)oir;
+        (void)types;
+        (void)opt;
+        (void)run_opt;
+        r.messages.push_back(CompileMessage{
+            true,
+            "LLVM toolchain is not available in this build. JIT requires direct LLVM static linkage."
         });
         return r;
+#else
+        const auto compile_start = std::chrono::steady_clock::now();
+        Session session{};
+        if (!build_session_(oir, types, opt, run_opt, session, r.messages)) return r;
+        auto& jit = session.jit;
+
+        auto& jd = jit->getMainJITDylib();
+        if (auto err = jit->initialize(jd)) {
+            r.messages.push_back(CompileMessage{true, "JIT static initialization failed: " + render_error_(std::move(err))});
+            return r;
+        }
+        auto entry = jit->lookup(run_opt.entry_symbol);
+        if (!entry) {
+            r.messages.push_back(CompileMessage{
+                true,
+                "JIT entry '" + run_opt.entry_symbol + "' lookup failed: " + render_error_(entry.takeError())
+            });
+            return r;
+        }
+        r.compile_ns = elapsed_ns_(compile_start);
+
+        // lowering이 만드는 `main` 브릿지는 인자를 받지 않지만,
+        // C 호출 규약상 (argc, argv)를 넘겨도 안전하다(lli의 runAsMain과 동일).
+        std::vector<std::string> argv_storage = run_opt.argv;
+        if (argv_storage.empty()) argv_storage.push_back("parus-jit");
+        std::vector<char*> argv{};
+        argv.reserve(argv_storage.size() + 1);
+        for (auto& a : argv_storage) argv.push_back(a.data());
+        argv.push_back(nullptr);
+
+        using EntryFn = int (*)(int, char**);
+        auto* fn = entry->toPtr<EntryFn>();
+        const auto run_start = std::chrono::steady_clock::now();
+        r.exit_code = fn(static_cast<int>(argv_storage.size()), argv.data());
+        r.run_ns = elapsed_ns_(run_start);
+        std::fflush(nullptr);
+
+        r.tier.total_functions = session.total_functions;
+        r.tier.compiled_functions = session.compiled_functions->load(std::memory_order_relaxed);
+        if (session.tiers != nullptr) {
+            r.tier.tiered_up_functions = session.tiers->tiered_up();
+            r.tier.tier_up_ns = session.tiers->tier_up_ns();
+            r.tier.hot_functions = session.tiers->hot_functions();
+            for (const auto& f : session.tiers->failures()) {
+                r.messages.push_back(CompileMessage{false, f});
+            }
+        }
+
+        if (auto err = jit->deinitialize(jd)) {
+            r.messages.push_back(CompileMessage{true, "JIT static deinitialization failed: " + render_error_(std::move(err))});
+            return r;
+        }
+        r.ok = true;
+        return r;
+#endif
     }
 
 } // namespace parus::backend::jit
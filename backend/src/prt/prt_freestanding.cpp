@@ -5,6 +5,8 @@
 #include <cstring>
 #include <new>
 
+#include "prt_stats.hpp"
+
 namespace {
 
 std::atomic<uint64_t> g_live_actors{0};
@@ -17,6 +19,16 @@ struct SpinLock {
         }
     }
 
+    /// Same as lock(), but reports how many failed attempts preceded the
+    /// acquisition (0 when uncontended).
+    uint64_t lock_counting_spins() {
+        uint64_t spins = 0;
+        while (flag.test_and_set(std::memory_order_acquire)) {
+            ++spins;
+        }
+        return spins;
+    }
+
     void unlock() {
         flag.clear(std::memory_order_release);
     }
@@ -31,6 +43,9 @@ struct ActorObject {
     size_t alloc_align = alignof(void*);
     void* draft_ptr = nullptr;
     SpinLock lock{};
+#if PARUS_PRT_STATS
+    prt_stats::TagStats* stats = nullptr;
+#endif
 };
 
 struct ActorContext {
@@ -42,12 +57,18 @@ constexpr size_t align_up_(size_t value, size_t align) {
     return (align <= 1) ? value : ((value + align - 1) / align) * align;
 }
 
+/// Freestanding has no clock, so waits are measured in spin iterations.
+constexpr uint64_t kStatsWaitBucketBase = 64;
+
 ActorObject* actor_from_handle_(void* handle) {
     return static_cast<ActorObject*>(handle);
 }
 
 void destroy_actor_(ActorObject* actor) {
     if (actor == nullptr) return;
+#if PARUS_PRT_STATS
+    prt_stats::bump(actor->stats->actors_destroyed);
+#endif
     const size_t alloc_align = actor->alloc_align;
     actor->~ActorObject();
     ::operator delete(static_cast<void*>(actor), std::align_val_t(alloc_align));
@@ -81,6 +102,10 @@ void* __parus_actor_new(uint64_t type_tag, uint64_t draft_size, uint64_t draft_a
     if (draft_size != 0) {
         std::memset(actor->draft_ptr, 0, static_cast<size_t>(draft_size));
     }
+#if PARUS_PRT_STATS
+    actor->stats = prt_stats::slot_for_tag(type_tag);
+    prt_stats::bump(actor->stats->actors_created);
+#endif
     g_live_actors.fetch_add(1, std::memory_order_acq_rel);
     return actor;
 }
@@ -110,7 +135,13 @@ void* __parus_actor_enter(void* handle, uint32_t mode) {
     auto* actor = actor_from_handle_(handle);
     if (actor == nullptr) return nullptr;
     actor->active_contexts.fetch_add(1, std::memory_order_acq_rel);
+#if PARUS_PRT_STATS
+    prt_stats::bump(mode == 1u ? actor->stats->enter_shared : actor->stats->enter_exclusive);
+    const uint64_t spins = actor->lock.lock_counting_spins();
+    if (spins != 0) prt_stats::record_wait(actor->stats, spins, kStatsWaitBucketBase);
+#else
     actor->lock.lock();
+#endif
     auto* ctx = new ActorContext{};
     ctx->actor = actor;
     ctx->draft_ptr = actor->draft_ptr;
@@ -134,6 +165,9 @@ void __parus_actor_leave(void* ctx) {
     auto* actor_ctx = static_cast<ActorContext*>(ctx);
     if (actor_ctx == nullptr) return;
     auto* actor = actor_ctx->actor;
+#if PARUS_PRT_STATS
+    prt_stats::bump(actor->stats->leave);
+#endif
     actor->lock.unlock();
     delete actor_ctx;
     const uint64_t prev = actor->active_contexts.fetch_sub(1, std::memory_order_acq_rel);
@@ -146,4 +180,12 @@ uint64_t __parus_prt_debug_live_actors(void) {
     return g_live_actors.load(std::memory_order_acquire);
 }
 
+/// Writes runtime stats into `buf` (format 0=text, 1=JSON), NUL-terminated
+/// when `cap != 0`. Returns the full length, so a short buffer can be resized.
+uint64_t __parus_prt_dump_stats(char* buf, uint64_t cap, uint32_t format) {
+    return prt_stats::dump(buf, cap, format,
+                           g_live_actors.load(std::memory_order_acquire),
+                           "spins", kStatsWaitBucketBase);
+}
+
 }
@@ -6,6 +6,12 @@
 #include <cstring>
 #include <new>
 
+#include "prt_stats.hpp"
+
+#if PARUS_PRT_STATS
+#include <chrono>
+#endif
+
 #if defined(_WIN32)
 #include <malloc.h>
 #include <windows.h>
@@ -32,6 +38,12 @@ void actor_lock_shared_lock_(ActorLock* lock) {
     AcquireSRWLockShared(&lock->lock);
 }
 
+#if PARUS_PRT_STATS
+bool actor_lock_try_shared_lock_(ActorLock* lock) {
+    return TryAcquireSRWLockShared(&lock->lock) != 0;
+}
+#endif
+
 void actor_lock_shared_unlock_(ActorLock* lock) {
     ReleaseSRWLockShared(&lock->lock);
 }
@@ -40,6 +52,12 @@ void actor_lock_exclusive_lock_(ActorLock* lock) {
     AcquireSRWLockExclusive(&lock->lock);
 }
 
+#if PARUS_PRT_STATS
+bool actor_lock_try_exclusive_lock_(ActorLock* lock) {
+    return TryAcquireSRWLockExclusive(&lock->lock) != 0;
+}
+#endif
+
 void actor_lock_exclusive_unlock_(ActorLock* lock) {
     ReleaseSRWLockExclusive(&lock->lock);
 }
@@ -66,6 +84,12 @@ void actor_lock_shared_lock_(ActorLock* lock) {
     (void)pthread_rwlock_rdlock(&lock->lock);
 }
 
+#if PARUS_PRT_STATS
+bool actor_lock_try_shared_lock_(ActorLock* lock) {
+    return pthread_rwlock_tryrdlock(&lock->lock) == 0;
+}
+#endif
+
 void actor_lock_shared_unlock_(ActorLock* lock) {
     (void)pthread_rwlock_unlock(&lock->lock);
 }
@@ -74,6 +98,12 @@ void actor_lock_exclusive_lock_(ActorLock* lock) {
     (void)pthread_rwlock_wrlock(&lock->lock);
 }
 
+#if PARUS_PRT_STATS
+bool actor_lock_try_exclusive_lock_(ActorLock* lock) {
+    return pthread_rwlock_trywrlock(&lock->lock) == 0;
+}
+#endif
+
 void actor_lock_exclusive_unlock_(ActorLock* lock) {
     (void)pthread_rwlock_unlock(&lock->lock);
 }
@@ -88,6 +118,9 @@ struct ActorObject {
     size_t alloc_align = alignof(void*);
     void* draft_ptr = nullptr;
     ActorLock lock{};
+#if PARUS_PRT_STATS
+    prt_stats::TagStats* stats = nullptr;
+#endif
 };
 
 struct ActorContext {
@@ -125,8 +158,42 @@ ActorObject* actor_from_handle_(void* handle) {
     return static_cast<ActorObject*>(handle);
 }
 
+/// Hosted waits are measured in nanoseconds; first bucket is < 1us.
+constexpr uint64_t kStatsWaitBucketBase = 1024;
+
+#if PARUS_PRT_STATS
+uint64_t stats_now_ns_() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+#endif
+
+/// Acquires the actor lock. The try-lock fast path keeps the clock out of
+/// uncontended enters when stats are enabled.
+void actor_acquire_(ActorObject* actor, bool shared) {
+#if PARUS_PRT_STATS
+    if (shared) {
+        prt_stats::bump(actor->stats->enter_shared);
+        if (actor_lock_try_shared_lock_(&actor->lock)) return;
+    } else {
+        prt_stats::bump(actor->stats->enter_exclusive);
+        if (actor_lock_try_exclusive_lock_(&actor->lock)) return;
+    }
+    const uint64_t start = stats_now_ns_();
+    if (shared) actor_lock_shared_lock_(&actor->lock);
+    else actor_lock_exclusive_lock_(&actor->lock);
+    prt_stats::record_wait(actor->stats, stats_now_ns_() - start, kStatsWaitBucketBase);
+#else
+    if (shared) actor_lock_shared_lock_(&actor->lock);
+    else actor_lock_exclusive_lock_(&actor->lock);
+#endif
+}
+
 void destroy_actor_(ActorObject* actor) {
     if (actor == nullptr) return;
+#if PARUS_PRT_STATS
+    prt_stats::bump(actor->stats->actors_destroyed);
+#endif
     actor_lock_destroy_(&actor->lock);
     actor->~ActorObject();
     aligned_free_bytes_(actor);
@@ -166,6 +233,10 @@ void* __parus_actor_new(uint64_t type_tag, uint64_t draft_size, uint64_t draft_a
     if (draft_size != 0) {
         std::memset(actor->draft_ptr, 0, static_cast<size_t>(draft_size));
     }
+#if PARUS_PRT_STATS
+    actor->stats = prt_stats::slot_for_tag(type_tag);
+    prt_stats::bump(actor->stats->actors_created);
+#endif
     g_live_actors.fetch_add(1, std::memory_order_acq_rel);
     return actor;
 }
@@ -205,10 +276,10 @@ void* __parus_actor_enter(void* handle, uint32_t mode) {
     ctx->draft_ptr = actor->draft_ptr;
     ctx->mode = mode;
     if (mode == 1u) {
-        actor_lock_shared_lock_(&actor->lock);
+        actor_acquire_(actor, /*shared=*/true);
         ctx->holds_read_lock = true;
     } else {
-        actor_lock_exclusive_lock_(&actor->lock);
+        actor_acquire_(actor, /*shared=*/false);
         ctx->holds_write_lock = true;
     }
     return ctx;
@@ -232,6 +303,9 @@ void __parus_actor_leave(void* ctx) {
     if (actor_ctx == nullptr) return;
     auto* actor = actor_ctx->actor;
     if (actor != nullptr) {
+#if PARUS_PRT_STATS
+        prt_stats::bump(actor->stats->leave);
+#endif
         if (actor_ctx->holds_read_lock) actor_lock_shared_unlock_(&actor->lock);
         if (actor_ctx->holds_write_lock) actor_lock_exclusive_unlock_(&actor->lock);
     }
@@ -249,4 +323,12 @@ uint64_t __parus_prt_debug_live_actors(void) {
     return g_live_actors.load(std::memory_order_acquire);
 }
 
+/// Writes runtime stats into `buf` (format 0=text, 1=JSON), NUL-terminated
+/// when `cap != 0`. Returns the full length, so a short buffer can be resized.
+uint64_t __parus_prt_dump_stats(char* buf, uint64_t cap, uint32_t format) {
+    return prt_stats::dump(buf, cap, format,
+                           g_live_actors.load(std::memory_order_acquire),
+                           "ns", kStatsWaitBucketBase);
+}
+
 }
@@ -0,0 +1,248 @@
+#pragma once
+
+// Opt-in prt instrumentation (PARUS_PRT_STATS=1).
+// Private to the prt variants; everything has internal linkage so the runtime
+// archives do not export C++ symbols into user programs. When stats are
+// disabled only the dump formatter is compiled, which keeps
+// `__parus_prt_dump_stats` available in every build.
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef PARUS_PRT_STATS
+#define PARUS_PRT_STATS 0
+#endif
+
+namespace {
+namespace prt_stats {
+
+constexpr uint32_t kFormatText = 0;
+constexpr uint32_t kFormatJson = 1;
+
+constexpr size_t kTagSlotCount = 256;
+constexpr size_t kWaitBucketCount = 16;
+
+/// Per-type_tag counters. Wait counters only track contended acquisitions;
+/// uncontended enters are counted by enter_* alone.
+struct TagStats {
+    std::atomic<uint32_t> state{0}; // 0=empty, 1=claiming, 2=ready
+    uint64_t type_tag = 0;
+    std::atomic<uint64_t> actors_created{0};
+    std::atomic<uint64_t> actors_destroyed{0};
+    std::atomic<uint64_t> enter_shared{0};
+    std::atomic<uint64_t> enter_exclusive{0};
+    std::atomic<uint64_t> leave{0};
+    std::atomic<uint64_t> contended{0};
+    std::atomic<uint64_t> wait_total{0};
+    std::atomic<uint64_t> wait_max{0};
+    std::atomic<uint64_t> wait_hist[kWaitBucketCount]{};
+};
+
+#if PARUS_PRT_STATS
+
+TagStats g_tag_slots[kTagSlotCount]{};
+TagStats g_tag_overflow{};
+
+constexpr uint64_t mix_tag_(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    return x;
+}
+
+/// Finds or claims the slot for `type_tag`. Called once per actor creation,
+/// the result is cached on the actor object so enter/leave never probe.
+inline TagStats* slot_for_tag(uint64_t type_tag) {
+    const size_t start = static_cast<size_t>(mix_tag_(type_tag) % kTagSlotCount);
+    for (size_t i = 0; i < kTagSlotCount; ++i) {
+        TagStats& slot = g_tag_slots[(start + i) % kTagSlotCount];
+        uint32_t st = slot.state.load(std::memory_order_acquire);
+        if (st == 0) {
+            uint32_t expected = 0;
+            if (slot.state.compare_exchange_strong(expected, 1, std::memory_order_acq_rel)) {
+                slot.type_tag = type_tag;
+                slot.state.store(2, std::memory_order_release);
+                return &slot;
+            }
+            st = expected;
+        }
+        while (st == 1) st = slot.state.load(std::memory_order_acquire);
+        if (slot.type_tag == type_tag) return &slot;
+    }
+    return &g_tag_overflow;
+}
+
+inline void bump(std::atomic<uint64_t>& counter) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void record_wait(TagStats* s, uint64_t wait, uint64_t bucket_base) {
+    if (s == nullptr) return;
+    bump(s->contended);
+    s->wait_total.fetch_add(wait, std::memory_order_relaxed);
+    uint64_t prev = s->wait_max.load(std::memory_order_relaxed);
+    while (wait > prev &&
+           !s->wait_max.compare_exchange_weak(prev, wait, std::memory_order_relaxed)) {
+    }
+    size_t bucket = static_cast<size_t>(std::bit_width(wait / bucket_base));
+    if (bucket >= kWaitBucketCount) bucket = kWaitBucketCount - 1;
+    bump(s->wait_hist[bucket]);
+}
+
+#endif
+
+/// snprintf-like sink: always counts, writes only while capacity remains.
+/// Kept libc-free so the freestanding runtime can use it.
+struct Writer {
+    char* buf = nullptr;
+    uint64_t cap = 0;
+    uint64_t len = 0;
+
+    void put(char c) {
+        if (buf != nullptr && len + 1 < cap) buf[len] = c;
+        ++len;
+    }
+
+    void put(const char* s) {
+        while (*s != '\0') put(*s++);
+    }
+
+    void put_u64(uint64_t v) {
+        char tmp[20];
+        int n = 0;
+        do {
+            tmp[n++] = static_cast<char>('0' + (v % 10));
+            v /= 10;
+        } while (v != 0);
+        while (n > 0) put(tmp[--n]);
+    }
+
+    uint64_t finish() {
+        if (buf != nullptr && cap != 0) {
+            buf[len < cap ? len : cap - 1] = '\0';
+        }
+        return len;
+    }
+};
+
+#if PARUS_PRT_STATS
+
+inline void write_tag_text_(Writer& w, const TagStats& s, bool overflow) {
+    if (overflow) {
+        w.put("type_tag overflow:");
+    } else {
+        w.put("type_tag ");
+        w.put_u64(s.type_tag);
+        w.put(':');
+    }
+    w.put(" created="); w.put_u64(s.actors_created.load(std::memory_order_relaxed));
+    w.put(" destroyed="); w.put_u64(s.actors_destroyed.load(std::memory_order_relaxed));
+    w.put(" enter_shared="); w.put_u64(s.enter_shared.load(std::memory_order_relaxed));
+    w.put(" enter_exclusive="); w.put_u64(s.enter_exclusive.load(std::memory_order_relaxed));
+    w.put(" leave="); w.put_u64(s.leave.load(std::memory_order_relaxed));
+    w.put(" contended="); w.put_u64(s.contended.load(std::memory_order_relaxed));
+    w.put(" wait_total="); w.put_u64(s.wait_total.load(std::memory_order_relaxed));
+    w.put(" wait_max="); w.put_u64(s.wait_max.load(std::memory_order_relaxed));
+    w.put("\n  wait_hist:");
+    for (size_t i = 0; i < kWaitBucketCount; ++i) {
+        w.put(' ');
+        w.put_u64(s.wait_hist[i].load(std::memory_order_relaxed));
+    }
+    w.put('\n');
+}
+
+inline void write_tag_json_(Writer& w, const TagStats& s, bool overflow) {
+    w.put("{\"type_tag\":");
+    if (overflow) w.put("null"); else w.put_u64(s.type_tag);
+    w.put(",\"created\":"); w.put_u64(s.actors_created.load(std::memory_order_relaxed));
+    w.put(",\"destroyed\":"); w.put_u64(s.actors_destroyed.load(std::memory_order_relaxed));
+    w.put(",\"enter_shared\":"); w.put_u64(s.enter_shared.load(std::memory_order_relaxed));
+    w.put(",\"enter_exclusive\":"); w.put_u64(s.enter_exclusive.load(std::memory_order_relaxed));
+    w.put(",\"leave\":"); w.put_u64(s.leave.load(std::memory_order_relaxed));
+    w.put(",\"contended\":"); w.put_u64(s.contended.load(std::memory_order_relaxed));
+    w.put(",\"wait_total\":"); w.put_u64(s.wait_total.load(std::memory_order_relaxed));
+    w.put(",\"wait_max\":"); w.put_u64(s.wait_max.load(std::memory_order_relaxed));
+    w.put(",\"wait_hist\":[");
+    for (size_t i = 0; i < kWaitBucketCount; ++i) {
+        if (i != 0) w.put(',');
+        w.put_u64(s.wait_hist[i].load(std::memory_order_relaxed));
+    }
+    w.put("]}");
+}
+
+#endif
+
+/// Renders the current counters. `bucket_base` is the upper bound of the first
+/// wait bucket; bucket i covers waits below `bucket_base << i`, the last bucket
+/// is open-ended.
+inline uint64_t dump(char* buf,
+                     uint64_t cap,
+                     uint32_t format,
+                     uint64_t live_actors,
+                     const char* wait_unit,
+                     uint64_t bucket_base) {
+    Writer w{buf, cap, 0};
+    const bool json = (format == kFormatJson);
+#if PARUS_PRT_STATS
+    if (json) {
+        w.put("{\"enabled\":true,\"wait_unit\":\"");
+        w.put(wait_unit);
+        w.put("\",\"live_actors\":");
+        w.put_u64(live_actors);
+        w.put(",\"wait_bucket_bounds\":[");
+        for (size_t i = 0; i + 1 < kWaitBucketCount; ++i) {
+            if (i != 0) w.put(',');
+            w.put_u64(bucket_base << i);
+        }
+        w.put("],\"types\":[");
+        bool first = true;
+        for (const TagStats& s : g_tag_slots) {
+            if (s.state.load(std::memory_order_acquire) != 2) continue;
+            if (!first) w.put(',');
+            first = false;
+            write_tag_json_(w, s, /*overflow=*/false);
+        }
+        if (g_tag_overflow.actors_created.load(std::memory_order_relaxed) != 0) {
+            if (!first) w.put(',');
+            write_tag_json_(w, g_tag_overflow, /*overflow=*/true);
+        }
+        w.put("]}");
+    } else {
+        w.put("prt stats (wait unit: ");
+        w.put(wait_unit);
+        w.put(")\nlive_actors ");
+        w.put_u64(live_actors);
+        w.put("\nwait_bucket_bounds");
+        for (size_t i = 0; i + 1 < kWaitBucketCount; ++i) {
+            w.put(' ');
+            w.put_u64(bucket_base << i);
+        }
+        w.put('\n');
+        for (const TagStats& s : g_tag_slots) {
+            if (s.state.load(std::memory_order_acquire) != 2) continue;
+            write_tag_text_(w, s, /*overflow=*/false);
+        }
+        if (g_tag_overflow.actors_created.load(std::memory_order_relaxed) != 0) {
+            write_tag_text_(w, g_tag_overflow, /*overflow=*/true);
+        }
+    }
+#else
+    (void)wait_unit;
+    (void)bucket_base;
+    if (json) {
+        w.put("{\"enabled\":false,\"live_actors\":");
+        w.put_u64(live_actors);
+        w.put('}');
+    } else {
+        w.put("prt stats disabled (build with PARUS_PRT_ENABLE_STATS=ON)\nlive_actors ");
+        w.put_u64(live_actors);
+        w.put('\n');
+    }
+#endif
+    return w.finish();
+}
+
+} // namespace prt_stats
+} // namespace
@@ -17,6 +17,7 @@ namespace parusc::cli {
         kUsage,
         kVersion,
         kCompile,
+        kRun,
         kLsp,
     };
 
@@ -66,6 +67,10 @@ namespace parusc::cli {
         Mode mode = Mode::kUsage;
 
         std::vector<std::string> inputs{};
+        std::vector<std::string> run_args{};
+        bool jit_stats = false;
+        bool jit_eager = false;
+        uint64_t jit_tier_up_threshold = 1000;
         std::string output_path{};
         std::string target_triple{};
         std::string sysroot_path{};
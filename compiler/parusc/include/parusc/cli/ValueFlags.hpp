@@ -0,0 +1,27 @@
+// compiler/parusc/include/parusc/cli/ValueFlags.hpp
+#pragma once
+
+#include <array>
+#include <string_view>
+
+namespace parusc::cli {
+
+    /// @brief 값을 다음 인자로 받는 parusc 플래그(`-o out`처럼 띄어 쓰는 형태).
+    /// `parus run`은 이 표로 플래그 값을 소스 파일과 구분한다. parse_options에 값 플래그를 추가하면
+    /// 여기에도 넣는다(parusc_cli_option_tests가 표의 각 플래그가 값을 요구하는지 확인한다).
+    inline constexpr std::array<std::string_view, 22> kValueFlags = {
+        "-o", "--lang", "--context", "--target", "--diag-format",
+        "-I", "-isystem", "-D", "-U", "-include", "-imacros",
+        "--sysroot", "--apple-sdk-root", "-Xparus",
+        "--bundle-name", "--bundle-root", "--module-head", "--emit-export-index",
+        "--module-import", "--bundle-source", "--bundle-dep", "--load-export-index",
+    };
+
+    constexpr bool flag_takes_value(std::string_view a) {
+        for (const auto f : kValueFlags) {
+            if (a == f) return true;
+        }
+        return false;
+    }
+
+} // namespace parusc::cli
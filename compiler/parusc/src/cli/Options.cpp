@@ -2,9 +2,11 @@
 #include <parusc/cli/Options.hpp>
 
 #include <algorithm>
+#include <charconv>
 #include <limits>
 #include <optional>
 #include <string_view>
+#include <system_error>
 #include <vector>
 
 namespace parusc::cli {
@@ -182,6 +184,35 @@ namespace parusc::cli {
             return true;
         }
 
+        bool validate_run_conflicts_(Options& out) {
+            if (out.mode != Mode::kRun) return true;
+
+            if (out.syntax_only) {
+                out.ok = false;
+                out.error = "run mode cannot be combined with -fsyntax-only";
+                return false;
+            }
+            if (out.output_path_explicit) {
+                out.ok = false;
+                out.error = "run mode cannot be combined with -o";
+                return false;
+            }
+            if (out.emit_object || out.internal.emit_object || out.internal.emit_llvm_ir
+                || out.internal.emit_goir_mlir || out.internal.emit_goir_llvm_ir
+                || out.internal.emit_goir_object) {
+                out.ok = false;
+                out.error = "run mode cannot be combined with emit options";
+                return false;
+            }
+            if (out.target_triple_explicit || out.linker_mode_explicit || out.link_fallback_explicit
+                || out.apple_sdk_root_explicit || out.freestanding) {
+                out.ok = false;
+                out.error = "run mode executes on the host and cannot be combined with target/linker options";
+                return false;
+            }
+            return true;
+        }
+
         bool validate_runtime_profile_conflicts_(Options& out) {
             if (!out.freestanding || !out.no_std) return true;
             out.ok = false;
@@ -226,6 +257,47 @@ namespace parusc::cli {
             return false;
         }
 
+        /// @brief run 모드 전용 JIT 옵션(`-fjit-*`)을 읽는다.
+        bool parse_jit_opt_(Options& out, std::string_view arg) {
+            constexpr std::string_view kTierPrefix = "-fjit-tier-up=";
+            const bool is_jit_opt =
+                arg == "-fjit-stats" || arg == "-fjit-eager" || arg.starts_with(kTierPrefix);
+            if (!is_jit_opt) return false;
+            if (out.mode != Mode::kRun) {
+                out.ok = false;
+                out.error = std::string(arg) + " is only available in run mode";
+                return true;
+            }
+
+            if (arg == "-fjit-stats") {
+                out.jit_stats = true;
+                return true;
+            }
+            if (arg == "-fjit-eager") {
+                out.jit_eager = true;
+                return true;
+            }
+
+            const auto value_text = arg.substr(kTierPrefix.size());
+            if (value_text.empty()) {
+                out.ok = false;
+                out.error = std::string(kTierPrefix) + " requires a number";
+                return true;
+            }
+            // 부호/공백/뒤따르는 문자를 허용하지 않도록 값 전체를 부호 없는 정수로 읽는다.
+            uint64_t v = 0;
+            const char* const first = value_text.data();
+            const char* const last = first + value_text.size();
+            const auto [ptr, ec] = std::from_chars(first, last, v, 10);
+            if (ec != std::errc{} || ptr != last) {
+                out.ok = false;
+                out.error = std::string(kTierPrefix) + " requires a valid number";
+                return true;
+            }
+            out.jit_tier_up_threshold = v;
+            return true;
+        }
+
         bool parse_bundle_value_opt_(
             const std::vector<std::string_view>& args,
             size_t& i,
@@ -395,6 +467,7 @@ namespace parusc::cli {
         os
             << "parusc [options] <input.pr>\n"
             << "parusc lsp --stdio\n"
+            << "parusc run [options] <input.pr> [-- <program-args>...]\n"
             << "  parusc main.pr -o main\n"
             << "  parusc --version\n"
             << "\n"
@@ -448,6 +521,12 @@ namespace parusc::cli {
             << "  -Xparus -emit-goir-mlir\n"
             << "  -Xparus -emit-goir-llvm-ir\n"
             << "\n"
+            << "Run mode (JIT, host only):\n"
+            << "  parusc run main.pr -- arg1 arg2\n"
+            << "  -fjit-stats           Print JIT compile/run/tier statistics to stderr\n"
+            << "  -fjit-eager           Compile every function up front instead of on first call\n"
+            << "  -fjit-tier-up=<N>     Recompile a function at -O2 after N calls (0 disables, default 1000)\n"
+            << "\n"
             << "LSP mode:\n"
             << "  parusc lsp --stdio\n";
     }
@@ -494,10 +573,27 @@ namespace parusc::cli {
         }
 
         out.mode = Mode::kCompile;
+        size_t first_arg = 0;
+        if (!args.empty() && args.front() == "run") {
+            out.mode = Mode::kRun;
+            first_arg = 1;
+        }
 
-        for (size_t i = 0; i < args.size(); ++i) {
+        for (size_t i = first_arg; i < args.size(); ++i) {
             const auto a = args[i];
 
+            if (out.mode == Mode::kRun && a == "--") {
+                for (size_t j = i + 1; j < args.size(); ++j) {
+                    out.run_args.emplace_back(args[j]);
+                }
+                break;
+            }
+
+            if (parse_jit_opt_(out, a)) {
+                if (!out.ok) return out;
+                continue;
+            }
+
             if (a == "-h" || a == "--help") {
                 out.mode = Mode::kUsage;
                 return out;
@@ -787,13 +883,14 @@ namespace parusc::cli {
             out.inputs.push_back(std::string(a));
         }
 
-        if (out.mode == Mode::kCompile && out.inputs.empty()) {
+        const bool needs_input = (out.mode == Mode::kCompile || out.mode == Mode::kRun);
+        if (needs_input && out.inputs.empty()) {
             out.ok = false;
             out.error = "no input file";
             return out;
         }
 
-        if (out.mode == Mode::kCompile && out.inputs.size() > 1) {
+        if (needs_input && out.inputs.size() > 1) {
             out.ok = false;
             out.error = "multiple input files are not supported yet";
             return out;
@@ -805,11 +902,14 @@ namespace parusc::cli {
         if (!validate_runtime_profile_conflicts_(out)) {
             return out;
         }
+        if (!validate_run_conflicts_(out)) {
+            return out;
+        }
         if (!validate_bundle_opts_(out)) {
             return out;
         }
 
-        if (out.output_path.empty() && !out.syntax_only) {
+        if (out.output_path.empty() && !out.syntax_only && out.mode != Mode::kRun) {
             if (out.internal.emit_object) out.output_path = "a.o";
             else if (out.internal.emit_goir_mlir) out.output_path = "a.mlir";
             else if (out.internal.emit_goir_llvm_ir) out.output_path = "a.ll";
@@ -150,7 +150,8 @@ namespace parusc::driver {
 
     int run(const cli::Options& opt, const char* argv0) {
         switch (opt.mode) {
-            case cli::Mode::kCompile: {
+            case cli::Mode::kCompile:
+            case cli::Mode::kRun: {
                 p0::Invocation inv{};
                 std::string err;
                 if (!prepare_invocation_(opt, argv0, inv, err)) {
@@ -24,6 +24,7 @@
 #include <parus/oir/Passes.hpp>
 #include <parus/oir/Verify.hpp>
 #include <parus/macro/Expander.hpp>
+#include <parus/macro/Prelude.hpp>
 #include <parus/parse/Parser.hpp>
 #include <parus/passes/Passes.hpp>
 #include <parus/os/File.hpp>
@@ -45,6 +46,10 @@
 #include <parus/backend/mlir/GOIRMLIRLowering.hpp>
 #endif
 
+#if PARUSC_HAS_JIT_BACKEND
+#include <parus/backend/jit/JITBackend.hpp>
+#endif
+
 #include <filesystem>
 #include <cctype>
 #include <functional>
@@ -5494,6 +5499,25 @@ namespace parusc::p0 {
 
         std::string_view clone_sv_into_ast_(parus::ast::AstArena& dst, std::string_view s);
 
+        /// @brief bundle 하나의 module head / module별 local type 이름. type repr 한정에 쓴다.
+        struct ImportedBundleTypeScope {
+            std::unordered_set<std::string> module_heads{};
+            std::unordered_map<std::string, std::unordered_set<std::string>> local_types_by_module{};
+        };
+
+        /// @brief sidecar template 하나를 AST로 복제하는 상태.
+        ///
+        /// free function template의 본문은 첫 인스턴스화 때 복제하므로(ImportedFnTemplate::load_body)
+        /// 이 상태는 load_imported_templates_into_ast_보다 오래 산다.
+        struct ImportedTemplateCloneState {
+            std::unordered_map<uint32_t, parus::ast::ExprId> expr_map{};
+            std::unordered_map<uint32_t, parus::ast::StmtId> stmt_map{};
+            std::function<parus::ast::ExprId(uint32_t)> clone_expr{};
+            std::function<parus::ast::StmtId(uint32_t)> clone_stmt{};
+            uint32_t deferred_body_of = parus::ast::k_invalid_stmt; // 본문(a) 복제를 미루는 sidecar stmt
+            std::string err{};
+        };
+
         bool load_imported_templates_into_ast_(
             const std::vector<LoadedExternalIndex>& loaded,
             std::string_view current_norm,
@@ -5519,7 +5543,7 @@ namespace parusc::p0 {
             out_file_bundle_overrides.clear();
             out_file_module_head_overrides.clear();
             out_err.clear();
-            std::unordered_map<std::string, parus::ty::TypeId> imported_type_cache{};
+            auto imported_type_cache = std::make_shared<std::unordered_map<std::string, parus::ty::TypeId>>();
 
             const auto make_anchor_span = [&](const TemplateSidecarFunction& templ) -> parus::Span {
                 std::string fake{};
@@ -5536,7 +5560,8 @@ namespace parusc::p0 {
                 return parus::Span{fid, lo, lo + 1};
             };
 
-            const auto add_type_node_for = [&](parus::ty::TypeId tid, const parus::Span& sp) -> parus::ast::TypeNodeId {
+            const auto add_type_node_for = [ast_p = &ast](parus::ty::TypeId tid, const parus::Span& sp) -> parus::ast::TypeNodeId {
+                auto& ast = *ast_p;
                 if (tid == parus::ty::kInvalidType) return parus::ast::k_invalid_type_node;
                 parus::ast::TypeNode tn{};
                 tn.kind = parus::ast::TypeNodeKind::kError;
@@ -5547,16 +5572,16 @@ namespace parusc::p0 {
 
             std::unordered_map<std::string, std::string> seen_sidecar_keys{};
             for (const auto& index : loaded) {
-                auto relative_module_head = [&](std::string_view module_head) -> std::string {
-                    const std::string prefix = index.bundle + "::";
+                auto relative_module_head = [prefix = index.bundle + "::"](std::string_view module_head) -> std::string {
                     if (module_head.starts_with(prefix)) {
                         return std::string(module_head.substr(prefix.size()));
                     }
                     return std::string(module_head);
                 };
 
-                std::unordered_set<std::string> bundle_module_heads{};
-                std::unordered_map<std::string, std::unordered_set<std::string>> bundle_local_types_by_module{};
+                auto type_scope = std::make_shared<ImportedBundleTypeScope>();
+                auto& bundle_module_heads = type_scope->module_heads;
+                auto& bundle_local_types_by_module = type_scope->local_types_by_module;
                 bundle_module_heads.reserve(index.entries.size());
                 bundle_local_types_by_module.reserve(index.entries.size());
                 for (const auto& e : index.entries) {
@@ -5590,7 +5615,6 @@ namespace parusc::p0 {
                         bundle_local_types_by_module[module_head].insert(root_stmt.name);
                     }
                 }
-                const std::unordered_set<std::string> empty_local_names{};
 
                 for (const auto& templ : index.sidecars) {
                     if (!templ.decl_file.empty() && templ.decl_file == current_norm) continue;
@@ -5612,15 +5636,24 @@ namespace parusc::p0 {
 
                     const parus::Span anchor = make_anchor_span(templ);
 
-                    std::unordered_map<uint32_t, parus::ast::ExprId> expr_map{};
-                    std::unordered_map<uint32_t, parus::ast::StmtId> stmt_map{};
-
-                    std::function<parus::ast::ExprId(uint32_t)> clone_expr{};
-                    std::function<parus::ast::StmtId(uint32_t)> clone_stmt{};
-                    auto parse_imported_type_repr_into_ = [&](std::string_view repr,
-                                                             std::string_view semantic,
-                                                             std::string_view inst_payload)
+                    // 아래 람다는 지연 본문 로드 때 다시 불리므로 이 함수의 지역 변수를 참조로 잡지 않는다.
+                    auto clone_state = std::make_shared<ImportedTemplateCloneState>();
+                    ImportedTemplateCloneState* const st = clone_state.get();
+                    auto parse_imported_type_repr_into_ = [types_p = &types,
+                                                           index_p = &index,
+                                                           templ_p = &templ,
+                                                           imported_type_cache,
+                                                           type_scope,
+                                                           relative_module_head](std::string_view repr,
+                                                                                 std::string_view semantic,
+                                                                                 std::string_view inst_payload)
                         -> parus::ty::TypeId {
+                        static const std::unordered_set<std::string> empty_local_names{};
+                        auto& types = *types_p;
+                        const auto& index = *index_p;
+                        const auto& templ = *templ_p;
+                        const auto& bundle_module_heads = type_scope->module_heads;
+                        const auto& bundle_local_types_by_module = type_scope->local_types_by_module;
                         std::string cache_key = index.bundle;
                         cache_key.push_back('|');
                         cache_key.append(templ.module_head);
@@ -5630,8 +5663,8 @@ namespace parusc::p0 {
                         cache_key.append(semantic);
                         cache_key.push_back('|');
                         cache_key.append(inst_payload);
-                        if (auto it = imported_type_cache.find(cache_key);
-                            it != imported_type_cache.end()) {
+                        if (auto it = imported_type_cache->find(cache_key);
+                            it != imported_type_cache->end()) {
                             return it->second;
                         }
                         const std::string current_module_head = relative_module_head(templ.module_head);
@@ -5648,11 +5681,21 @@ namespace parusc::p0 {
                         );
                         const auto parsed =
                             parse_type_repr_into_(qualified.first, qualified.second, inst_payload, types);
-                        imported_type_cache.emplace(std::move(cache_key), parsed);
+                        imported_type_cache->emplace(std::move(cache_key), parsed);
                         return parsed;
                     };
 
-                    clone_expr = [&](uint32_t src_idx) -> parus::ast::ExprId {
+                    st->clone_expr = [st,
+                                      anchor,
+                                      ast_p = &ast,
+                                      templ_p = &templ,
+                                      parse_imported_type_repr_into_,
+                                      add_type_node_for](uint32_t src_idx) -> parus::ast::ExprId {
+                        auto& ast = *ast_p;
+                        const auto& templ = *templ_p;
+                        auto& expr_map = st->expr_map;
+                        auto& clone_expr = st->clone_expr;
+                        auto& clone_stmt = st->clone_stmt;
                         if (src_idx == parus::ast::k_invalid_expr || src_idx >= templ.exprs.size()) {
                             return parus::ast::k_invalid_expr;
                         }
@@ -5777,7 +5820,20 @@ namespace parusc::p0 {
                         return eid;
                     };
 
-                    clone_stmt = [&](uint32_t src_idx) -> parus::ast::StmtId {
+                    st->clone_stmt = [st,
+                                      anchor,
+                                      ast_p = &ast,
+                                      types_p = &types,
+                                      templ_p = &templ,
+                                      parse_imported_type_repr_into_,
+                                      add_type_node_for](uint32_t src_idx) -> parus::ast::StmtId {
+                        auto& ast = *ast_p;
+                        auto& types = *types_p;
+                        const auto& templ = *templ_p;
+                        auto& stmt_map = st->stmt_map;
+                        auto& clone_expr = st->clone_expr;
+                        auto& clone_stmt = st->clone_stmt;
+                        auto& out_err = st->err;
                         if (src_idx == parus::ast::k_invalid_stmt || src_idx >= templ.stmts.size()) {
                             return parus::ast::k_invalid_stmt;
                         }
@@ -5863,7 +5919,7 @@ namespace parusc::p0 {
                         stmt_map[src_idx] = sid;
                         parus::ast::Stmt dst = ast.stmt(sid);
 
-                        dst.a = clone_stmt(src.a);
+                        dst.a = (src_idx == st->deferred_body_of) ? parus::ast::k_invalid_stmt : clone_stmt(src.a);
                         dst.b = clone_stmt(src.b);
 
                         if (src.kind == static_cast<uint8_t>(parus::ast::StmtKind::kBlock) ||
@@ -6086,8 +6142,17 @@ namespace parusc::p0 {
                         ast.add_fn_constraint_decl(out_cc);
                     }
 
-                    const auto root_sid = clone_stmt(templ.root_stmt);
-                    if (!out_err.empty()) return false;
+                    // free function 본문은 첫 인스턴스화 때 복제한다(시그니처만 먼저 등록).
+                    const auto& root_src = templ.stmts[templ.root_stmt];
+                    const bool lazy_body =
+                        root_src.kind == static_cast<uint8_t>(parus::ast::StmtKind::kFnDecl) &&
+                        root_src.a != parus::ast::k_invalid_stmt;
+                    if (lazy_body) st->deferred_body_of = templ.root_stmt;
+                    const auto root_sid = st->clone_stmt(templ.root_stmt);
+                    if (!st->err.empty()) {
+                        out_err = st->err;
+                        return false;
+                    }
                     if (root_sid == parus::ast::k_invalid_stmt ||
                         static_cast<size_t>(root_sid) >= ast.stmts().size()) {
                         out_err = "typed template sidecar failed to reconstruct root decl: " + templ.lookup_name;
@@ -6195,6 +6260,16 @@ namespace parusc::p0 {
                         out_t.is_public_export = templ.is_public_export;
                         out_t.declared_type = root_stmt.type;
                         out_t.constraints = copy_constraints();
+                        if (lazy_body) {
+                            out_t.load_body = [clone_state, body_src = root_src.a](std::string& err) -> parus::ast::StmtId {
+                                const parus::ast::StmtId body = clone_state->clone_stmt(body_src);
+                                if (!clone_state->err.empty()) {
+                                    err = clone_state->err;
+                                    return parus::ast::k_invalid_stmt;
+                                }
+                                return body;
+                            };
+                        }
                         out_fn_templates.push_back(std::move(out_t));
                     } else if (root_stmt.kind == parus::ast::StmtKind::kProtoDecl) {
                         parus::tyck::ImportedProtoTemplate out_t{};
@@ -6515,111 +6590,6 @@ namespace parusc::p0 {
             return dst.add_owned_string(std::string(s));
         }
 
-        parus::Token clone_token_into_ast_(parus::ast::AstArena& dst, const parus::Token& src) {
-            parus::Token out = src;
-            out.lexeme = clone_sv_into_ast_(dst, src.lexeme);
-            return out;
-        }
-
-        void copy_macro_token_range_into_ast_(
-            const parus::ast::AstArena& src,
-            parus::ast::AstArena& dst,
-            uint32_t in_begin,
-            uint32_t in_count,
-            uint32_t& out_begin,
-            uint32_t& out_count
-        ) {
-            out_begin = static_cast<uint32_t>(dst.macro_tokens().size());
-            out_count = 0;
-
-            const auto& toks = src.macro_tokens();
-            const uint64_t begin = in_begin;
-            const uint64_t end = begin + in_count;
-            if (begin > toks.size() || end > toks.size()) return;
-            for (uint32_t i = 0; i < in_count; ++i) {
-                const auto& t = toks[in_begin + i];
-                (void)dst.add_macro_token(clone_token_into_ast_(dst, t));
-                ++out_count;
-            }
-        }
-
-        void append_top_level_macro_decls_(
-            const parus::ast::AstArena& src,
-            parus::ast::AstArena& dst
-        ) {
-            const auto& src_decls = src.macro_decls();
-            const auto& src_groups = src.macro_groups();
-            const auto& src_arms = src.macro_arms();
-            const auto& src_caps = src.macro_captures();
-
-            for (const auto& d : src_decls) {
-                if (d.scope_depth != 0) continue; // top-level only
-                if (!d.is_export) continue;       // external prelude only exports public macros
-
-                parus::ast::MacroDecl nd{};
-                nd.name = clone_sv_into_ast_(dst, d.name);
-                nd.scope_depth = 0;
-                nd.is_export = true;
-                nd.span = d.span;
-                nd.group_begin = static_cast<uint32_t>(dst.macro_groups().size());
-                nd.group_count = 0;
-
-                const uint64_t g_begin = d.group_begin;
-                const uint64_t g_end = g_begin + d.group_count;
-                if (g_begin > src_groups.size() || g_end > src_groups.size()) continue;
-
-                for (uint32_t gi = 0; gi < d.group_count; ++gi) {
-                    const auto& g = src_groups[d.group_begin + gi];
-                    parus::ast::MacroGroup ng{};
-                    ng.match_kind = g.match_kind;
-                    ng.span = g.span;
-                    ng.arm_begin = static_cast<uint32_t>(dst.macro_arms().size());
-                    ng.arm_count = 0;
-
-                    const uint64_t a_begin = g.arm_begin;
-                    const uint64_t a_end = a_begin + g.arm_count;
-                    if (a_begin > src_arms.size() || a_end > src_arms.size()) continue;
-
-                    for (uint32_t ai = 0; ai < g.arm_count; ++ai) {
-                        const auto& a = src_arms[g.arm_begin + ai];
-                        parus::ast::MacroArm na{};
-                        na.out_kind = a.out_kind;
-                        na.span = a.span;
-                        na.capture_begin = static_cast<uint32_t>(dst.macro_captures().size());
-                        na.capture_count = 0;
-
-                        const uint64_t c_begin = a.capture_begin;
-                        const uint64_t c_end = c_begin + a.capture_count;
-                        if (c_begin <= src_caps.size() && c_end <= src_caps.size()) {
-                            for (uint32_t ci = 0; ci < a.capture_count; ++ci) {
-                                auto cap = src_caps[a.capture_begin + ci];
-                                cap.name = clone_sv_into_ast_(dst, cap.name);
-                                (void)dst.add_macro_capture(cap);
-                                ++na.capture_count;
-                            }
-                        }
-
-                        copy_macro_token_range_into_ast_(
-                            src, dst, a.pattern_token_begin, a.pattern_token_count,
-                            na.pattern_token_begin, na.pattern_token_count
-                        );
-                        copy_macro_token_range_into_ast_(
-                            src, dst, a.template_token_begin, a.template_token_count,
-                            na.template_token_begin, na.template_token_count
-                        );
-
-                        (void)dst.add_macro_arm(na);
-                        ++ng.arm_count;
-                    }
-
-                    (void)dst.add_macro_group(ng);
-                    ++nd.group_count;
-                }
-
-                (void)dst.add_macro_decl(nd);
-            }
-        }
-
         bool load_core_macro_prelude_into_ast_(
             const cli::Options& opt,
             parus::ast::AstArena& dst_ast,
@@ -6640,26 +6610,12 @@ namespace parusc::p0 {
                 return false;
             }
 
+            // 진단 span용 file id는 매 컴파일 등록하고, lex/parse 결과는 내용 hash가 같으면 재사용한다.
             const uint32_t fid = sm.add(prelude_path, text);
-            auto tokens = lex_with_sm_(sm, fid, &bag);
-            if (bag.has_error()) {
-                out_err = "failed to lex core macro prelude: " + prelude_path;
-                return false;
-            }
+            const auto prelude = parus::macro::shared_macro_prelude(prelude_path, std::move(text), fid, bag, out_err);
+            if (prelude == nullptr) return false;
 
-            parus::ast::AstArena src_ast{};
-            parus::ty::TypePool src_types{};
-            parus::diag::Bag local_bag{};
-            parus::ParserFeatureFlags flags{};
-            parus::Parser p(tokens, src_ast, src_types, &local_bag, 128, flags);
-            (void)p.parse_program();
-            if (local_bag.has_error()) {
-                for (const auto& d : local_bag.diags()) bag.add(d);
-                out_err = "failed to parse core macro prelude: " + prelude_path;
-                return false;
-            }
-
-            append_top_level_macro_decls_(src_ast, dst_ast);
+            parus::macro::append_macro_prelude(prelude, dst_ast, fid);
             return true;
         }
 
@@ -8114,6 +8070,58 @@ namespace parusc::p0 {
             parusc::dump::dump_oir_module(oir_res.mod, types);
         }
 
+        if (opt.mode == cli::Mode::kRun) {
+#if PARUSC_HAS_JIT_BACKEND
+            seed_parus_toolchain_env_from_driver_(inv);
+
+            parus::backend::CompileOptions jit_opt{};
+            jit_opt.opt_level = opt.opt_level;
+
+            parus::backend::jit::JITRunOptions run_opt{};
+            run_opt.lazy = !opt.jit_eager;
+            run_opt.tier_up_threshold = opt.jit_tier_up_threshold;
+            run_opt.argv.push_back(inv.input_path);
+            run_opt.argv.insert(run_opt.argv.end(), opt.run_args.begin(), opt.run_args.end());
+            if (auto_core_injection) {
+                const std::string core_ext_archive = resolve_core_ext_archive_path_(opt);
+                if (core_ext_archive.empty()) {
+                    std::cerr << "error: missing core runtime archive 'libcore_ext.a' in sysroot target lib dir; "
+                                 "run ./install.sh to build/install core artifacts\n";
+                    return 1;
+                }
+                run_opt.archive_paths.push_back(core_ext_archive);
+            }
+            // actor 런타임(prt)은 JIT 백엔드가 in-process 구현으로 직접 바인딩하므로
+            // libprt_hosted.a를 따로 싣지 않는다.
+
+            parus::backend::jit::JITBackend jit;
+            const auto rr = jit.run(oir_res.mod, types, jit_opt, run_opt);
+            bool has_jit_error = false;
+            for (const auto& m : rr.messages) {
+                if (!m.is_error) {
+                    std::cerr << "warning: " << m.text << "\n";
+                    continue;
+                }
+                has_jit_error = true;
+                std::cerr << "error: " << m.text << "\n";
+            }
+            if (!rr.ok || has_jit_error) return 1;
+            if (opt.jit_stats) {
+                std::cerr << "jit-stats: compile_ns=" << rr.compile_ns << " run_ns=" << rr.run_ns
+                          << " functions=" << rr.tier.compiled_functions << "/" << rr.tier.total_functions
+                          << " tiered_up=" << rr.tier.tiered_up_functions
+                          << " tier_up_ns=" << rr.tier.tier_up_ns << "\n";
+                for (const auto& name : rr.tier.hot_functions) {
+                    std::cerr << "jit-stats: hot " << name << "\n";
+                }
+            }
+            return rr.exit_code;
+#else
+            std::cerr << "error: parusc was built without JIT backend support.\n";
+            return 1;
+#endif
+        }
+
 #if PARUSC_HAS_AOT_BACKEND
         seed_parus_toolchain_env_from_driver_(inv);
 
@@ -5,10 +5,13 @@
 #include <parus/lex/Token.hpp>
 #include <parus/ty/Type.hpp>
 
+#include <array>
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 
@@ -756,6 +759,9 @@ namespace parus::ast {
             return owned_strings_.back();
         }
 
+        /// @brief 이 arena의 string_view/토큰이 가리키는 외부 저장소(공유 매크로 prelude 등)를 붙잡아 둔다.
+        void retain(std::shared_ptr<const void> owner) { retained_.push_back(std::move(owner)); }
+
         uint32_t add_path_seg(std::string_view s) {
             const std::string_view owned = add_owned_string(std::string(s));
             path_segs_.push_back(owned);
@@ -859,7 +865,55 @@ namespace parus::ast {
         const std::vector<MacroDecl>& macro_decls() const { return macro_decls_; }
         std::vector<MacroDecl>& macro_decls_mut() { return macro_decls_; }
 
+        // --------------------
+        // append-only 되돌리기
+        // --------------------
+        // arena는 노드를 덧붙이기만 하므로 저장소 길이 묶음이 곧 시점(generation)이다.
+        // 증분 재파싱은 기존 스냅샷 위에 바로 덧붙이고, 병합이 거절되면 truncate로 되돌린다.
+        // kStoreCount는 아래 stores_() 목록 길이와 같아야 한다(for_each_store_의 static_assert가 검사).
+        static constexpr size_t kStoreCount = 27;
+        struct Mark {
+            std::array<size_t, kStoreCount> sizes{};
+        };
+
+        Mark mark() const {
+            Mark m{};
+            size_t i = 0;
+            for_each_store_(*this, [&](const auto& store) { m.sizes[i++] = store.size(); });
+            return m;
+        }
+
+        /// @brief mark 이후에 덧붙은 항목을 모두 버린다. mark 이전 항목과 그 string_view는 그대로다.
+        void truncate(const Mark& m) {
+            size_t i = 0;
+            for_each_store_(*this, [&](auto& store) {
+                const size_t keep = m.sizes[i++];
+                if (keep < store.size()) store.erase(store.begin() + static_cast<std::ptrdiff_t>(keep), store.end());
+            });
+        }
+
     private:
+        /// @brief mark/truncate가 다루는 저장소 목록. kStoreCount는 이 tuple 크기와 static_assert로 묶인다.
+        template <typename Self>
+        static auto stores_(Self& self) {
+            return std::tie(
+                self.exprs_, self.stmts_, self.type_nodes_, self.type_node_children_,
+                self.type_args_, self.args_, self.fn_attrs_, self.params_,
+                self.switch_cases_, self.switch_enum_binds_, self.try_catch_clauses_,
+                self.field_members_, self.enum_variant_decls_, self.field_init_entries_,
+                self.path_refs_, self.generic_param_decls_, self.fn_constraint_decls_,
+                self.acts_assoc_type_witness_decls_, self.fstring_parts_, self.owned_strings_,
+                self.path_segs_, self.stmt_children_, self.macro_tokens_, self.macro_captures_,
+                self.macro_arms_, self.macro_groups_, self.macro_decls_);
+        }
+
+        template <typename Self, typename Fn>
+        static void for_each_store_(Self& self, Fn&& fn) {
+            static_assert(std::tuple_size_v<decltype(stores_(self))> == kStoreCount,
+                          "AstArena::kStoreCount must match stores_()");
+            std::apply([&](auto&... store) { (fn(store), ...); }, stores_(self));
+        }
+
         std::vector<Expr> exprs_;
         std::vector<Stmt> stmts_;
         std::vector<TypeNode> type_nodes_;
@@ -882,6 +936,7 @@ namespace parus::ast {
         std::vector<ActsAssocTypeWitnessDecl> acts_assoc_type_witness_decls_;
         std::vector<FStringPart> fstring_parts_;
         std::deque<std::string> owned_strings_;
+        std::vector<std::shared_ptr<const void>> retained_;
         std::vector<std::string_view> path_segs_;
 
         std::vector<StmtId> stmt_children_;
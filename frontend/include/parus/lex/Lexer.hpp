@@ -2,6 +2,7 @@
 #pragma once
 #include <parus/lex/Token.hpp>
 #include <parus/diag/Diagnostic.hpp>
+#include <parus/lex/Scan.hpp>
 
 #include <string_view>
 #include <vector>
@@ -18,12 +19,23 @@ namespace parus {
 
         std::vector<Token> lex_all();
 
+        /// @brief 증분 relex용으로 offset부터 다시 읽도록 위치를 옮긴다.
+        ///
+        /// offset은 이전 토큰 스트림의 토큰 끝(또는 0)이어야 한다. lexer는 토큰 사이에 상태가 없으므로
+        /// 그 지점부터 읽은 결과는 lex_all()과 같다. UTF-8 검사는 [offset, validate_hi) 구간만 하며,
+        /// 실패하면 진단 없이 false를 돌려준다(호출자가 lex_all()로 되돌아간다).
+        bool seek(uint32_t offset, uint32_t validate_hi);
+
+        /// @brief 현재 위치에서 토큰 하나를 읽는다. 입력 끝이면 kEof 토큰을 돌려준다.
+        Token next_token();
+
     private:
         char peek(size_t k = 0) const;
         bool eof() const;
         char bump();
 
         void skip_ws_and_comments();
+        void scan_quoted_body(bool escapes); // 닫는 '"'까지(포함) 전진
 
         Token lex_number();
         Token lex_ident_or_kw();
@@ -45,6 +57,7 @@ namespace parus {
         size_t pos_ = 0;
 
         diag::Bag* diags_ = nullptr;
+        const scan::ScanKernels* scan_ = nullptr; // 공백/주석/식별자/문자열 본문 스캔 루틴
     };
 
 } // namespace parus
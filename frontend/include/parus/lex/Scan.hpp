@@ -0,0 +1,43 @@
+// frontend/include/parus/lex/Scan.hpp
+#pragma once
+
+#include <cstddef>
+
+
+namespace parus::scan {
+
+    /// @brief lexer 바이트 스캔 루틴이 쓰는 명령어 집합.
+    enum class ScanIsa : unsigned char {
+        kScalar = 0,
+        kSse2,
+        kAvx2,
+    };
+
+    /// @brief ISA별 스캔 루틴 묶음. 모든 루틴은 [p, p+n)에서 멈출 바이트의 index를, 없으면 n을 돌려준다.
+    struct ScanKernels {
+        ScanIsa isa = ScanIsa::kScalar;
+
+        size_t (*skip_ascii)(const char* p, size_t n) = nullptr;  // 첫 >= 0x80 바이트
+        size_t (*skip_space)(const char* p, size_t n) = nullptr;  // 첫 비공백(C locale isspace 기준)
+        size_t (*skip_ident)(const char* p, size_t n) = nullptr;  // 첫 식별자 아닌 바이트([A-Za-z0-9_], >= 0x80 제외)
+        size_t (*find_byte)(const char* p, size_t n, char a) = nullptr;
+        size_t (*find_byte2)(const char* p, size_t n, char a, char b) = nullptr;
+    };
+
+    /// @brief 현재 CPU에서 쓸 루틴. 처음 호출될 때 CPU 기능을 보고 한 번 고른다.
+    ///
+    /// `PARUS_LEX_SIMD=scalar|sse2|avx2`로 더 낮은 단계를 강제할 수 있다(CPU가 지원하는 범위 안에서).
+    const ScanKernels& kernels();
+
+    /// @brief 지정한 ISA의 루틴. 이 빌드/CPU가 지원하지 않으면 nullptr.
+    const ScanKernels* kernels_for(ScanIsa isa);
+
+    const char* isa_name(ScanIsa isa);
+
+    inline size_t skip_ascii(const char* p, size_t n) { return kernels().skip_ascii(p, n); }
+    inline size_t skip_space(const char* p, size_t n) { return kernels().skip_space(p, n); }
+    inline size_t skip_ident(const char* p, size_t n) { return kernels().skip_ident(p, n); }
+    inline size_t find_byte(const char* p, size_t n, char a) { return kernels().find_byte(p, n, a); }
+    inline size_t find_byte2(const char* p, size_t n, char a, char b) { return kernels().find_byte2(p, n, a, b); }
+
+} // namespace parus::scan
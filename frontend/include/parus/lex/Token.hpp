@@ -1,6 +1,10 @@
 // frontend/include/parus/lex/Token.hpp
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <string_view>
+#include <vector>
 #include <parus/text/Span.hpp>
 #include <parus/syntax/TokenKind.hpp>
 
@@ -13,4 +17,126 @@ namespace parus {
         std::string_view lexeme{};
     };
 
-} // namespace parus
\ No newline at end of file
+    /// @brief 오래 보관하는 토큰 스트림용 12바이트 토큰(시작 오프셋 + 길이 + 종류).
+    ///
+    /// file_id와 lexeme은 담지 않는다. lexer 토큰은 항상 lexeme == source[lo, lo+len)이므로
+    /// TokenStream이 자신이 가리키는 source에서 다시 만든다.
+    struct CompactToken {
+        uint32_t lo = 0;
+        uint32_t len = 0;
+        syntax::TokenKind kind = syntax::TokenKind::kError;
+    };
+    static_assert(sizeof(CompactToken) <= 12, "CompactToken must stay within 12 bytes");
+
+    /// @brief 한 source 버퍼를 lex한 결과를 CompactToken으로 보관한다.
+    ///
+    /// source 버퍼는 소유하지 않으므로 스트림보다 오래 살아야 한다. operator[]/반복자는
+    /// Token을 값으로 돌려준다(span/lexeme은 그때 계산). parser처럼 Token 배열을 참조로 잡는
+    /// 쪽에는 to_tokens()로 풀어서 넘긴다.
+    class TokenStream {
+    public:
+        class const_iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = Token;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Token;
+
+            const_iterator() = default;
+            const_iterator(const TokenStream* s, size_t i) : s_(s), i_(i) {}
+
+            Token operator*() const { return (*s_)[i_]; }
+            Token operator[](difference_type n) const { return (*s_)[i_ + static_cast<size_t>(n)]; }
+
+            const_iterator& operator++() { ++i_; return *this; }
+            const_iterator operator++(int) { auto t = *this; ++i_; return t; }
+            const_iterator& operator--() { --i_; return *this; }
+            const_iterator operator--(int) { auto t = *this; --i_; return t; }
+            const_iterator& operator+=(difference_type n) { i_ = static_cast<size_t>(static_cast<difference_type>(i_) + n); return *this; }
+            const_iterator& operator-=(difference_type n) { return *this += -n; }
+            friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+            friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+            friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+            friend difference_type operator-(const const_iterator& a, const const_iterator& b) {
+                return static_cast<difference_type>(a.i_) - static_cast<difference_type>(b.i_);
+            }
+
+            friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.i_ == b.i_; }
+            friend bool operator!=(const const_iterator& a, const const_iterator& b) { return a.i_ != b.i_; }
+            friend bool operator<(const const_iterator& a, const const_iterator& b) { return a.i_ < b.i_; }
+            friend bool operator>(const const_iterator& a, const const_iterator& b) { return a.i_ > b.i_; }
+            friend bool operator<=(const const_iterator& a, const const_iterator& b) { return a.i_ <= b.i_; }
+            friend bool operator>=(const const_iterator& a, const const_iterator& b) { return a.i_ >= b.i_; }
+
+            size_t index() const { return i_; }
+
+        private:
+            const TokenStream* s_ = nullptr;
+            size_t i_ = 0;
+        };
+
+        TokenStream() = default;
+
+        /// @brief lexer 출력(source에서 잘라낸 lexeme)을 압축한다. tokens의 file_id는 무시한다.
+        TokenStream(std::string_view source, uint32_t file_id, const std::vector<Token>& tokens)
+            : source_(source), file_id_(file_id) {
+            toks_.reserve(tokens.size());
+            for (const auto& t : tokens) {
+                toks_.push_back(CompactToken{t.span.lo, static_cast<uint32_t>(t.lexeme.size()), t.kind});
+            }
+        }
+
+        size_t size() const { return toks_.size(); }
+        bool empty() const { return toks_.empty(); }
+
+        Token operator[](size_t i) const {
+            const auto& c = toks_[i];
+            Token t{};
+            t.kind = c.kind;
+            t.span = Span{file_id_, c.lo, c.lo + c.len};
+            t.lexeme = source_.substr(c.lo, c.len);
+            return t;
+        }
+        Token back() const { return (*this)[toks_.size() - 1]; }
+
+        syntax::TokenKind kind(size_t i) const { return toks_[i].kind; }
+        Span span(size_t i) const { return Span{file_id_, toks_[i].lo, toks_[i].lo + toks_[i].len}; }
+        std::string_view lexeme(size_t i) const { return source_.substr(toks_[i].lo, toks_[i].len); }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, toks_.size()); }
+
+        /// @brief 시작 오프셋이 lo 이상인 첫 토큰 index(없으면 size()).
+        size_t lower_bound(uint32_t lo) const {
+            size_t a = 0;
+            size_t b = toks_.size();
+            while (a < b) {
+                const size_t mid = a + (b - a) / 2;
+                if (toks_[mid].lo < lo) a = mid + 1;
+                else b = mid;
+            }
+            return a;
+        }
+
+        std::vector<Token> to_tokens() const {
+            std::vector<Token> out{};
+            out.reserve(toks_.size());
+            for (size_t i = 0; i < toks_.size(); ++i) out.push_back((*this)[i]);
+            return out;
+        }
+
+        const std::vector<CompactToken>& compact() const { return toks_; }
+        std::string_view source() const { return source_; }
+        uint32_t file_id() const { return file_id_; }
+
+        /// @brief 토큰 배열이 차지하는 바이트(capacity 기준, source 버퍼 제외).
+        size_t memory_bytes() const { return toks_.capacity() * sizeof(CompactToken); }
+
+    private:
+        std::string_view source_{};
+        uint32_t file_id_ = 0;
+        std::vector<CompactToken> toks_{};
+    };
+
+} // namespace parus
@@ -5,7 +5,9 @@
 #include <parus/ty/TypePool.hpp>
 
 #include <cstdint>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace parus::macro {
@@ -27,13 +29,11 @@ namespace parus::macro {
         bool output_tokens = false;
     };
 
-    struct MacroExpansionContext {
-        ast::AstArena& ast;
-        ty::TypePool& types;
-        diag::Bag& diags;
-        ExpansionBudget budget{};
-        uint32_t steps = 0;
-        std::vector<Span> stack{};
+    struct ExpansionStats {
+        uint32_t expansion_count = 0;
+        uint32_t memo_hit_count = 0;
+        uint32_t reused_parse_count = 0; // memo 적중 중 치환/재파싱 없이 파싱 결과를 복제한 횟수
+        uint32_t token_arm_try_count = 0;
     };
 
     struct MacroTokenRange {
@@ -47,6 +47,52 @@ namespace parus::macro {
         std::vector<MacroTokenRange> ranges{};
     };
 
+    /// @brief (macro decl, 호출 문맥, 인자 토큰열)로 선택된 arm과 capture 결과.
+    ///
+    /// capture range는 인자 시작 기준 상대 offset이다. 같은 인자 토큰열의 다른 호출은
+    /// arm 매칭 없이 첫 호출의 파싱 결과(중첩 macro까지 전개한 subtree)를 복제한다.
+    /// 복제본은 span을 자기 인자 토큰으로 옮기고, subtree 안의 hygiene binder 이름을 새로 받는다.
+    /// 파싱 결과가 없거나(복제기가 다루지 않는 노드) scope/전개 깊이가 다르면 치환/재파싱으로 돌아간다.
+    struct MacroArmMemo {
+        size_t decl_index = 0;
+        uint8_t call_ctx = 0;
+        uint32_t arg_begin = 0;
+        uint32_t arg_count = 0;
+        uint32_t arm_index = 0;
+        bool token_group = false;
+        std::vector<MacroCaptureBinding> captures{};
+
+        ast::ExprId parsed_expr = ast::k_invalid_expr;
+        ast::StmtId parsed_stmt = ast::k_invalid_stmt;
+        Span call_span{};
+        uint32_t scope_depth = 0;
+        uint32_t depth = 0;
+        uint32_t step_cost = 0; // 중첩 전개가 쓴 step. 복제해도 같은 만큼 청구한다.
+        std::vector<std::string_view> gensyms{}; // subtree 안에서 선언된 hygiene binder 이름
+    };
+
+    /// @brief token group의 첫 토큰 dispatch 표. group마다 한 번 만든다.
+    ///
+    /// 패턴 첫 원소가 literal/구분자 group인 arm은 그 토큰이 인자 첫 토큰과 같을 때만 매칭될 수 있다.
+    /// 첫 토큰 key마다 후보 arm 목록(선언 순서, 첫 원소가 capture/repeat인 arm 포함)을 미리 만들어 둔다.
+    struct TokenArmDispatch {
+        std::vector<uint32_t> any_first{};
+        std::unordered_map<std::string, std::vector<uint32_t>> by_first{};
+    };
+
+    struct MacroExpansionContext {
+        ast::AstArena& ast;
+        ty::TypePool& types;
+        diag::Bag& diags;
+        ExpansionBudget budget{};
+        uint32_t steps = 0;
+        std::vector<Span> stack{};
+        bool arm_dispatch = true;
+        std::unordered_map<uint64_t, std::vector<MacroArmMemo>> arm_memo{};
+        std::unordered_map<size_t, TokenArmDispatch> token_dispatch{};
+        ExpansionStats stats{};
+    };
+
     enum class TokenArmMatchStatus : uint8_t {
         kNoMatch = 0,
         kMatch,
@@ -64,6 +110,19 @@ namespace parus::macro {
         std::vector<MacroCaptureBinding>& out_captures
     );
 
+    TokenArmDispatch build_token_arm_dispatch(
+        const ast::AstArena& ast,
+        uint32_t arm_begin,
+        uint32_t arm_count
+    );
+
+    const std::vector<uint32_t>& token_arm_candidates(
+        const TokenArmDispatch& dispatch,
+        const ast::AstArena& ast,
+        uint32_t arg_begin,
+        uint32_t arg_count
+    );
+
     bool substitute_token_template(
         ast::AstArena& ast,
         const ast::MacroArm& arm,
@@ -84,12 +143,31 @@ namespace parus::macro {
         uint64_t hygiene_seed = 0
     );
 
+    /// @brief hygiene seed에 현재 arena 크기를 섞는다. 같은 위치의 반복 전개도 다른 이름을 받는다.
+    uint64_t mix_hygiene_seed(const ast::AstArena& ast, uint64_t seed);
+
+    /// @brief binder 하나의 hygiene 이름(`__pm_g<id>`)을 arena 소유 문자열로 만든다.
+    /// serial은 같은 seed 안에서 매번 증가시킨다.
+    std::string_view make_hygiene_gensym(
+        ast::AstArena& ast,
+        std::string_view name,
+        size_t binder_index,
+        uint64_t seed,
+        uint64_t& serial
+    );
+
+    bool is_hygiene_gensym(std::string_view name);
+
+    /// @brief 호출자가 만든 context로 전개한다(budget clamp는 호출자 몫). 통계는 ctx.stats에 남는다.
+    bool expand_program(MacroExpansionContext& ctx, ast::StmtId root);
+
     bool expand_program(
         ast::AstArena& ast,
         ty::TypePool& types,
         ast::StmtId root,
         diag::Bag& diags,
-        ExpansionBudget budget = {}
+        ExpansionBudget budget = {},
+        ExpansionStats* out_stats = nullptr
     );
 
 } // namespace parus::macro
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <parus/ast/Nodes.hpp>
+#include <parus/diag/Diagnostic.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace parus::macro {
+
+    /// @brief lex/parse를 마친 매크로 prelude(예: sysroot core/ext/cstr.pr).
+    ///
+    /// 한 번 만들면 바뀌지 않으므로 여러 컴파일 단위가 공유한다. 토큰/이름 문자열은
+    /// text와 ast가 소유하고, append_macro_prelude()로 붙인 AstArena가 이 객체를 붙잡는다.
+    struct MacroPrelude {
+        std::string path{};
+        uint64_t content_hash = 0;
+        std::string text{};
+        ast::AstArena ast{};
+    };
+
+    uint64_t macro_prelude_hash(std::string_view text);
+
+    /// @brief prelude 소스를 lex/parse 한다. 실패하면 diags에 진단을 옮기고 nullptr를 돌려준다.
+    std::shared_ptr<const MacroPrelude> parse_macro_prelude(
+        std::string path,
+        std::string text,
+        uint32_t file_id,
+        diag::Bag& diags,
+        std::string& out_err
+    );
+
+    /// @brief 프로세스 단위 prelude 캐시. 같은 path의 내용 hash가 같으면 이전 파싱 결과를 재사용하고,
+    ///        hash가 바뀌면 다시 파싱해 교체한다. 실패 결과는 캐시하지 않는다.
+    std::shared_ptr<const MacroPrelude> shared_macro_prelude(
+        const std::string& path,
+        std::string text,
+        uint32_t file_id,
+        diag::Bag& diags,
+        std::string& out_err,
+        bool* out_cache_hit = nullptr
+    );
+
+    /// @brief prelude의 export top-level 매크로 선언을 dst 뒤에 붙인다.
+    ///
+    /// 문자열은 복제하지 않고 prelude 소유 문자열을 가리키며, dst가 prelude 수명을 연장한다.
+    /// span의 file id는 이번 컴파일의 prelude file_id로 바꾼다.
+    void append_macro_prelude(
+        const std::shared_ptr<const MacroPrelude>& prelude,
+        ast::AstArena& dst,
+        uint32_t file_id
+    );
+
+} // namespace parus::macro
@@ -30,11 +30,18 @@ namespace parus::parse {
         ast::AstArena ast{};
         ty::TypePool types{};
         ast::StmtId root = ast::k_invalid_stmt;
-        std::vector<Token> tokens{};
+        TokenStream tokens{};
         std::vector<TopItemMeta> top_items{};
         uint64_t revision = 0;
     };
 
+    /// @brief 마지막 재파싱에서 토큰 스트림을 만든 방식.
+    struct RelexStats {
+        bool incremental = false;   // 이전 토큰을 재사용했는지(false면 lex_all 전체 실행)
+        uint32_t relexed_tokens = 0;
+        uint32_t reused_tokens = 0;
+    };
+
     enum class ReparseMode : uint8_t {
         kNone = 0,
         kFullRebuild,
@@ -55,6 +62,17 @@ namespace parus::parse {
 
         bool ready() const { return ready_; }
         ReparseMode last_mode() const { return last_mode_; }
+        const RelexStats& last_relex() const { return last_relex_; }
+        /// @brief 살아있는 top item 노드가 참조하는 source 버전 수(최신 source 포함).
+        size_t retained_sources() const { return source_owners_.size(); }
+        /// @brief 보관 중인 source 버전들의 총 바이트 수.
+        size_t retained_source_bytes() const {
+            size_t total = 0;
+            for (const auto& p : source_owners_) {
+                if (p) total += p->size();
+            }
+            return total;
+        }
 
         void set_feature_flags(ParserFeatureFlags flags) { feature_flags_ = flags; }
         const ParserFeatureFlags& feature_flags() const { return feature_flags_; }
@@ -68,15 +86,21 @@ namespace parus::parse {
                                     uint32_t file_id,
                                     std::span<const EditWindow> edits,
                                     diag::Bag& bag);
+        std::vector<Token> lex_(std::string_view source, uint32_t file_id, diag::Bag& bag, bool allow_incremental);
 
         ParseSnapshot snapshot_{};
         bool ready_ = false;
         ReparseMode last_mode_ = ReparseMode::kNone;
+        RelexStats last_relex_{};
         uint64_t revision_seq_ = 0;
         ParserFeatureFlags feature_flags_{};
 
-        // AST/TypePool 내부 string_view 수명 보장을 위한 source 보관.
+        // AST/TypePool 내부 string_view 수명 보장을 위한 source 보관. item_owners_의 중복 제거 + 최신 source.
         std::vector<std::shared_ptr<std::string>> source_owners_{};
+        // snapshot_.top_items와 같은 순서로, 각 item을 파싱한 source.
+        std::vector<std::shared_ptr<std::string>> item_owners_{};
+        // snapshot_.top_items와 같은 순서로, 각 item의 arena/type pool 시작 mark. 병합은 여기서 잘라 낸다.
+        std::vector<TopItemMark> item_marks_{};
     };
 
 } // namespace parus::parse
@@ -16,6 +16,13 @@ namespace parus {
     struct ParserFeatureFlags {
     };
 
+    /// @brief top-level item 하나가 덧붙기 시작한 arena/type pool 길이.
+    /// 증분 병합은 첫 영향 item의 mark로 잘라 내고 그 자리에 다시 파싱한다.
+    struct TopItemMark {
+        ast::AstArena::Mark ast{};
+        ty::TypePool::Mark types{};
+    };
+
     class Parser {
     public:
         Parser(const std::vector<Token>& tokens,
@@ -44,7 +51,8 @@ namespace parus {
         ast::StmtId parse_stmt();
 
         // EOF까지 stmt/decl을 반복 파싱하여 프로그램(Block) 노드 생성
-        ast::StmtId parse_program();
+        // item_marks가 있으면 top-level item마다 시작 mark를 root 자식 순서대로 채운다.
+        ast::StmtId parse_program(std::vector<TopItemMark>* item_marks = nullptr);
 
         // true when file contains valid header marker: $![Impl::Core];
         bool is_core_impl_file_mode() const { return core_impl_file_mode_; }
@@ -0,0 +1,179 @@
+// frontend/include/parus/syntax/Keyword.hpp
+#pragma once
+#include <parus/syntax/TokenKind.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+
+namespace parus::syntax {
+
+    struct KeywordEntry {
+        std::string_view text;
+        TokenKind kind;
+    };
+
+    // lexer가 키워드로 읽는 source 철자 전체. 한 kind에 철자가 둘일 수 있다(struct/field).
+    // pure/comptime은 `@` + attr 이름(kIdent)으로 바뀌어 여기 없다.
+    inline constexpr std::array<KeywordEntry, 62> k_keyword_table = {{
+        {"true",     TokenKind::kKwTrue},
+        {"false",    TokenKind::kKwFalse},
+        {"null",     TokenKind::kKwNull},
+
+        {"and",      TokenKind::kKwAnd},
+        {"or",       TokenKind::kKwOr},
+        {"not",      TokenKind::kKwNot},
+        {"xor",      TokenKind::kKwXor},
+
+        {"mut",      TokenKind::kKwMut},
+        {"static",   TokenKind::kKwStatic},
+        {"const",    TokenKind::kKwConst},
+
+        {"let",      TokenKind::kKwLet},
+        {"set",      TokenKind::kKwSet},
+        {"fix",      TokenKind::kKwFix},
+        {"if",       TokenKind::kKwIf},
+        {"elif",     TokenKind::kKwElif},
+        {"else",     TokenKind::kKwElse},
+        {"for",      TokenKind::kKwFor},
+        {"while",    TokenKind::kKwWhile},
+        {"do",       TokenKind::kKwDo},
+        {"loop",     TokenKind::kKwLoop},
+        {"in",       TokenKind::kKwIn},
+        {"return",   TokenKind::kKwReturn},
+        {"break",    TokenKind::kKwBreak},
+        {"continue", TokenKind::kKwContinue},
+        {"manual",   TokenKind::kKwManual},
+        {"throw",    TokenKind::kKwThrow},
+        {"try",      TokenKind::kKwTry},
+        {"catch",    TokenKind::kKwCatch},
+        {"copy",     TokenKind::kKwCopy},
+        {"clone",    TokenKind::kKwClone},
+
+        {"switch",   TokenKind::kKwSwitch},
+        {"case",     TokenKind::kKwCase},
+        {"default",  TokenKind::kKwDefault},
+
+        {"use",      TokenKind::kKwUse},
+        {"import",   TokenKind::kKwImport},
+        {"module",   TokenKind::kKwModule},
+        {"as",       TokenKind::kKwAs},
+        {"nest",     TokenKind::kKwNest},
+        {"with",     TokenKind::kKwWith},
+        {"require",  TokenKind::kKwRequire},
+        {"provide",  TokenKind::kKwProvide},
+
+        {"commit",   TokenKind::kKwCommit},
+        {"recast",   TokenKind::kKwRecast},
+        {"pub",      TokenKind::kKwPub},
+        {"sub",      TokenKind::kKwSub},
+
+        {"def",      TokenKind::kKwFn},
+        {"macro",    TokenKind::kKwMacro},
+        {"struct",   TokenKind::kKwField},
+        {"field",    TokenKind::kKwField},
+        {"enum",     TokenKind::kKwEnum},
+        {"proto",    TokenKind::kKwProto},
+        {"class",    TokenKind::kKwClass},
+        {"actor",    TokenKind::kKwActor},
+        {"inst",     TokenKind::kKwInst},
+        {"init",     TokenKind::kKwInit},
+        {"deinit",   TokenKind::kKwDeinit},
+        {"draft",    TokenKind::kKwDraft},
+        {"acts",     TokenKind::kKwActs},
+        {"export",   TokenKind::kKwExport},
+        {"extern",   TokenKind::kKwExtern},
+        {"layout",   TokenKind::kKwLayout},
+        {"align",    TokenKind::kKwAlign},
+    }};
+
+    // ------------------------------------------------------------
+    // perfect hash
+    // ------------------------------------------------------------
+    // 키는 (길이, 첫 글자, 가운데 글자, 끝 글자)다. 길이+첫/끝 글자만으로는 init/inst가 겹친다.
+    // 곱셈 상수는 컴파일 타임에 충돌 없는 값을 찾는다. 표에 철자를 더해 충돌이 생기면
+    // 탐색 범위 안에서 다른 상수를 고르고, 못 찾으면 static_assert로 빌드가 멈춘다.
+    namespace keyword_detail {
+
+        inline constexpr uint32_t kSlotBits = 9;
+        inline constexpr uint32_t kSlotCount = 1u << kSlotBits;
+
+        constexpr size_t max_keyword_len() {
+            size_t n = 0;
+            for (const auto& e : k_keyword_table) n = (e.text.size() > n) ? e.text.size() : n;
+            return n;
+        }
+
+        constexpr uint32_t key_of(std::string_view s) {
+            const auto b = [&](size_t i) { return static_cast<uint32_t>(static_cast<unsigned char>(s[i])); };
+            return static_cast<uint32_t>(s.size()) | (b(0) << 8) | (b(s.size() / 2) << 16) | (b(s.size() - 1) << 24);
+        }
+
+        constexpr uint32_t slot_of(uint32_t key, uint32_t mul) {
+            return (key * mul) >> (32 - kSlotBits);
+        }
+
+        constexpr uint32_t find_multiplier() {
+            for (uint32_t i = 0; i < 4096; ++i) {
+                const uint32_t mul = 0x9E3779B1u + 2u * i;
+                std::array<bool, kSlotCount> used{};
+                bool ok = true;
+                for (const auto& e : k_keyword_table) {
+                    const uint32_t slot = slot_of(key_of(e.text), mul);
+                    if (used[slot]) { ok = false; break; }
+                    used[slot] = true;
+                }
+                if (ok) return mul;
+            }
+            return 0;
+        }
+
+        inline constexpr uint32_t kMultiplier = find_multiplier();
+        static_assert(kMultiplier != 0, "keyword perfect hash: no collision-free multiplier found");
+
+        inline constexpr size_t kMaxKeywordLen = max_keyword_len();
+
+        // slot -> k_keyword_table index + 1 (0 = 빈 칸)
+        inline constexpr std::array<uint8_t, kSlotCount> kSlots = [] {
+            std::array<uint8_t, kSlotCount> slots{};
+            for (size_t i = 0; i < k_keyword_table.size(); ++i) {
+                slots[slot_of(key_of(k_keyword_table[i].text), kMultiplier)] = static_cast<uint8_t>(i + 1);
+            }
+            return slots;
+        }();
+
+        // kind -> 키워드 여부
+        inline constexpr size_t kKindCount = static_cast<size_t>(TokenKind::kUnknownPunct) + 1;
+        inline constexpr std::array<bool, kKindCount> kIsKeywordKind = [] {
+            std::array<bool, kKindCount> out{};
+            for (const auto& e : k_keyword_table) out[static_cast<size_t>(e.kind)] = true;
+            return out;
+        }();
+
+    } // namespace keyword_detail
+
+    /// @brief 식별자 철자가 키워드면 해당 kind, 아니면 kIdent. 해시 한 번 + 문자열 비교 한 번.
+    constexpr TokenKind keyword_kind(std::string_view s) {
+        using namespace keyword_detail;
+        if (s.size() < 2 || s.size() > kMaxKeywordLen) return TokenKind::kIdent;
+        const uint8_t e = kSlots[slot_of(key_of(s), kMultiplier)];
+        if (e == 0) return TokenKind::kIdent;
+        const auto& entry = k_keyword_table[e - 1];
+        if (entry.text != s) return TokenKind::kIdent;
+        return entry.kind;
+    }
+
+    /// @brief kind가 키워드 토큰인지(semantic token 분류 등).
+    constexpr bool is_keyword_kind(TokenKind k) {
+        const auto i = static_cast<size_t>(k);
+        return i < keyword_detail::kKindCount && keyword_detail::kIsKeywordKind[i];
+    }
+
+    static_assert(keyword_kind("def") == TokenKind::kKwFn);
+    static_assert(keyword_kind("init") == TokenKind::kKwInit && keyword_kind("inst") == TokenKind::kKwInst);
+    static_assert(keyword_kind("pure") == TokenKind::kIdent);
+    static_assert(keyword_kind("defx") == TokenKind::kIdent);
+
+} // namespace parus::syntax
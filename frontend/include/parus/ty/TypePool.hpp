@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <ostream>
+#include <algorithm>
 #include <cctype>
 #include <limits>
 
@@ -310,11 +311,15 @@ namespace parus::ty {
             t.fn_is_c_variadic = fn_is_c_variadic;
             t.fn_callconv = fn_callconv;
 
+            // labels는 fn_param_labels_ 원소를 가리킬 수 있다(fn_param_label_at 결과 재사용).
+            // 재할당 전에 먼저 복사한다.
+            std::vector<std::string> label_copies(param_count);
+            if (labels) {
+                for (uint32_t k = 0; k < param_count; ++k) label_copies[k] = std::string(labels[k]);
+            }
             for (uint32_t k = 0; k < param_count; ++k) {
                 fn_params_.push_back(params ? params[k] : error());
-                const size_t next_label = fn_param_labels_.size();
-                fn_param_labels_.resize(next_label + 1);
-                fn_param_labels_[next_label] = labels ? std::string(labels[k]) : std::string{};
+                fn_param_labels_.push_back(std::move(label_copies[k]));
                 fn_param_has_default_.push_back(has_default ? has_default[k] : 0u);
             }
 
@@ -601,6 +606,33 @@ namespace parus::ty {
             }
         }
 
+        /// @brief 저장소 길이 묶음. 증분 재파싱이 거절된 partial parse의 타입을 되돌릴 때 쓴다.
+        struct Mark {
+            size_t types = 0;
+            size_t fn_params = 0;
+            size_t fn_param_labels = 0;
+            size_t fn_param_has_default = 0;
+            size_t user_path_segs = 0;
+            size_t named_type_args = 0;
+        };
+
+        Mark mark() const {
+            return Mark{
+                types_.size(), fn_params_.size(), fn_param_labels_.size(),
+                fn_param_has_default_.size(), user_path_segs_.size(), named_type_args_.size(),
+            };
+        }
+
+        /// @brief mark 이후에 intern된 타입을 버린다. builtin은 생성자에서 만들어지므로 항상 남는다.
+        void truncate(const Mark& m) {
+            types_.resize(std::min(types_.size(), m.types));
+            fn_params_.resize(std::min(fn_params_.size(), m.fn_params));
+            fn_param_labels_.resize(std::min(fn_param_labels_.size(), m.fn_param_labels));
+            fn_param_has_default_.resize(std::min(fn_param_has_default_.size(), m.fn_param_has_default));
+            user_path_segs_.resize(std::min(user_path_segs_.size(), m.user_path_segs));
+            named_type_args_.resize(std::min(named_type_args_.size(), m.named_type_args));
+        }
+
     private:
         TypeId push_(const Type& t) {
             TypeId id = (TypeId)types_.size();
@@ -0,0 +1,121 @@
+// frontend/include/parus/tyck/QualifiedNameTable.hpp
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace parus::tyck {
+
+    /// @brief 경로 이름("a::b::C") -> V 표. 마지막 segment -> 항목 역색인을 함께 유지한다.
+    ///
+    /// 정확한 이름 조회는 std::unordered_map과 같다. 비한정 이름/접미 경로 조회는
+    /// with_leaf()로 같은 마지막 segment를 가진 항목만 보면 되므로 표 전체를 돌지 않는다.
+    /// 역색인은 node 포인터를 들고 있으므로 rehash에도 유효하고, erase/clear 때 함께 정리된다.
+    template <typename V>
+    class QualifiedNameTable {
+    public:
+        using Map = std::unordered_map<std::string, V>;
+        using value_type = typename Map::value_type;
+        using iterator = typename Map::iterator;
+        using const_iterator = typename Map::const_iterator;
+
+        QualifiedNameTable() = default;
+        QualifiedNameTable(const QualifiedNameTable& other) : map_(other.map_) { rebuild_leaf_index_(); }
+        QualifiedNameTable(QualifiedNameTable&&) noexcept = default;
+        QualifiedNameTable& operator=(const QualifiedNameTable& other) {
+            if (this != &other) {
+                map_ = other.map_;
+                rebuild_leaf_index_();
+            }
+            return *this;
+        }
+        QualifiedNameTable& operator=(QualifiedNameTable&&) noexcept = default;
+
+        static std::string_view leaf_of(std::string_view name) {
+            const size_t sep = name.rfind("::");
+            return (sep == std::string_view::npos) ? name : name.substr(sep + 2);
+        }
+
+        V& operator[](const std::string& key) { return insert_key_(key)->second; }
+        V& operator[](std::string&& key) { return insert_key_(std::move(key))->second; }
+
+        iterator find(const std::string& key) { return map_.find(key); }
+        const_iterator find(const std::string& key) const { return map_.find(key); }
+        size_t count(const std::string& key) const { return map_.count(key); }
+
+        iterator begin() { return map_.begin(); }
+        iterator end() { return map_.end(); }
+        const_iterator begin() const { return map_.begin(); }
+        const_iterator end() const { return map_.end(); }
+        size_t size() const { return map_.size(); }
+        bool empty() const { return map_.empty(); }
+
+        iterator erase(const_iterator it) {
+            unlink_leaf_(&*it);
+            return map_.erase(it);
+        }
+        size_t erase(const std::string& key) {
+            auto it = map_.find(key);
+            if (it == map_.end()) return 0;
+            erase(it);
+            return 1;
+        }
+        void clear() {
+            map_.clear();
+            by_leaf_.clear();
+        }
+
+        /// @brief 마지막 segment가 leaf인 항목들(삽입 순서). 이름에 "::"가 없으면 이름 전체가 leaf다.
+        const std::vector<const value_type*>& with_leaf(std::string_view leaf) const {
+            static const std::vector<const value_type*> kEmpty{};
+            auto it = by_leaf_.find(leaf);
+            return (it == by_leaf_.end()) ? kEmpty : it->second;
+        }
+
+    private:
+        struct LeafHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+        };
+
+        template <typename K>
+        iterator insert_key_(K&& key) {
+            auto [it, inserted] = map_.try_emplace(std::forward<K>(key));
+            if (inserted) {
+                const std::string_view leaf = leaf_of(it->first);
+                auto lit = by_leaf_.find(leaf);
+                if (lit == by_leaf_.end()) lit = by_leaf_.emplace(std::string(leaf), std::vector<const value_type*>{}).first;
+                lit->second.push_back(&*it);
+            }
+            return it;
+        }
+
+        void rebuild_leaf_index_() {
+            by_leaf_.clear();
+            for (const auto& entry : map_) {
+                const std::string_view leaf = leaf_of(entry.first);
+                auto lit = by_leaf_.find(leaf);
+                if (lit == by_leaf_.end()) lit = by_leaf_.emplace(std::string(leaf), std::vector<const value_type*>{}).first;
+                lit->second.push_back(&entry);
+            }
+        }
+
+        void unlink_leaf_(const value_type* entry) {
+            auto lit = by_leaf_.find(leaf_of(entry->first));
+            if (lit == by_leaf_.end()) return;
+            std::erase(lit->second, entry);
+            if (lit->second.empty()) by_leaf_.erase(lit);
+        }
+
+        Map map_{};
+        std::unordered_map<std::string, std::vector<const value_type*>, LeafHash, std::equal_to<>> by_leaf_{};
+    };
+
+} // namespace parus::tyck
@@ -9,8 +9,10 @@
 #include <parus/num/BigInt.hpp>
 #include <parus/syntax/TokenKind.hpp>
 #include <parus/passes/GenericPrep.hpp>
+#include <parus/tyck/QualifiedNameTable.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -53,6 +55,9 @@ namespace parus::tyck {
         bool is_public_export = false;
         ty::TypeId declared_type = ty::kInvalidType;
         std::vector<ImportedFnConstraintMeta> constraints{};
+        /// 본문을 지연 로드하는 template이면 template_sid의 본문(a)은 비어 있고, 첫 인스턴스화 때
+        /// 이 함수로 본문 block을 AST에 복제한다. 실패하면 k_invalid_stmt와 사유(err)를 돌려준다.
+        std::function<ast::StmtId(std::string& err)> load_body{};
     };
 
     struct ImportedProtoTemplate {
@@ -181,10 +186,49 @@ namespace parus::tyck {
         uint64_t imported_template_index_miss_count = 0;
         uint64_t proto_target_cache_hit_count = 0;
         uint64_t proto_target_cache_miss_count = 0;
+        uint64_t imported_fn_template_available_count = 0;
+        uint64_t imported_fn_template_materialized_count = 0;
+        uint64_t instance_cloned_expr_count = 0;  // 인스턴스화가 arena에 더한 expr 노드
+        uint64_t instance_cloned_stmt_count = 0;  // 인스턴스화가 arena에 더한 stmt 노드
+        uint64_t instance_shared_expr_count = 0;  // 복제하지 않고 템플릿 노드를 공유한 expr subtree
+    };
+
+    /// @brief const 평가 경로 통계. bytecode VM/AST walker 분담과 (fn, args) memo 적중을 본다.
+    struct ConstEvalStats {
+        uint64_t bytecode_fn_count = 0;      // bytecode로 컴파일된 const def 수
+        uint64_t bytecode_call_count = 0;    // VM에서 끝난 호출
+        uint64_t walker_call_count = 0;      // AST walker에서 끝난 호출(컴파일 불가/VM 되돌림 포함)
+        uint64_t vm_fallback_count = 0;      // VM이 포기하고 walker로 다시 돈 호출
+        uint64_t memo_hit_count = 0;         // (fn, args) memo 적중
     };
 
     using MonoStmtCache = std::unordered_map<MonoCacheKey, ast::StmtId, MonoCacheKeyHasher>;
 
+    struct ExternalGenericConstraintMeta {
+        enum class Kind : uint8_t {
+            kProto = 0,
+            kTypeEq,
+        };
+        Kind kind = Kind::kProto;
+        std::string lhs{};
+        std::string rhs{};
+    };
+
+    /// @brief 외부 generic 선언 payload의 gparam/gconstraint/impl_proto 항목.
+    struct ExternalGenericDeclMeta {
+        std::vector<std::string> params{};
+        std::vector<ExternalGenericConstraintMeta> constraints{};
+        std::vector<std::pair<std::string, std::string>> impl_protos{};
+    };
+
+    /// @brief 외부 심볼 `external_payload`를 한 번 풀어 둔 결과. 호출 해석은 payload 문자열 대신 이것을 본다.
+    struct ExternalPayloadRecord {
+        bool compiler_impl_binding = false;  // parus_impl_binding payload의 mode가 compiler
+        bool has_generic_decl = false;       // payload에 parus_generic_decl 표식이 있음
+        ExternalGenericDeclMeta generic{};
+        std::vector<std::optional<ty::TypeId>> constraint_rhs_types{}; // generic.constraints[i].rhs repr 해석(처음 쓸 때)
+    };
+
     // tyck의 에러는 우선 compile-safe한 독립 포맷으로 저장
     // (diag::Bag 연동은 프로젝트 내 Diagnostic API가 확정되면 쉽게 브릿지 가능)
     struct TyError {
@@ -277,6 +321,7 @@ namespace parus::tyck {
         std::unordered_map<uint32_t, ConstInitData> const_symbol_values; // SymbolId -> const initializer value
         std::unordered_map<ast::ExprId, ConstInitData> expr_external_const_values; // expr id -> imported external const literal payload
         MonoStats mono_stats{};
+        ConstEvalStats const_eval_stats{};
         std::vector<TyError> errors;
     };
 
@@ -303,6 +348,13 @@ namespace parus::tyck {
         void set_core_impl_marker_file_ids(std::unordered_set<uint32_t> file_ids) {
             explicit_core_impl_marker_file_ids_ = std::move(file_ids);
         }
+        /// @brief 본문 검사를 건너뛸 def 선언 stmt 집합(시그니처는 그대로 수집/검사한다).
+        ///        증분 분석에서 이전 결과를 재사용하는 top-level 아이템에 쓴다.
+        void set_body_skip_stmts(std::unordered_set<ast::StmtId> sids) {
+            explicit_body_skip_sids_ = std::move(sids);
+        }
+        /// @brief false면 const def를 bytecode VM/(fn, args) memo 없이 AST walker로만 평가한다(비교/검증용).
+        void set_const_eval_bytecode(bool enabled) { const_eval_bytecode_enabled_ = enabled; }
         void set_file_bundle_overrides(std::unordered_map<uint32_t, std::string> file_bundles) {
             explicit_file_bundle_overrides_ = std::move(file_bundles);
         }
@@ -781,9 +833,9 @@ namespace parus::tyck {
         // NOTE: std::string을 key로 쓰는 이유:
         // - string_view는 AST storage lifetime에 의존하는데,
         //   향후 AST arena의 내부 저장 방식이 바뀌면 위험해질 수 있음.
-        std::unordered_map<std::string, std::vector<ast::StmtId>> fn_decl_by_name_;
+        QualifiedNameTable<std::vector<ast::StmtId>> fn_decl_by_name_;
         std::unordered_map<ast::StmtId, std::string> fn_qualified_name_by_stmt_;
-        std::unordered_map<std::string, ast::StmtId> proto_decl_by_name_;
+        QualifiedNameTable<ast::StmtId> proto_decl_by_name_;
         std::unordered_map<ty::TypeId, ast::StmtId> proto_decl_by_type_;
         std::unordered_map<ast::StmtId, std::string> proto_qualified_name_by_stmt_;
         std::unordered_map<ty::TypeId, std::vector<ast::StmtId>> explicit_impl_proto_sids_by_type_;
@@ -791,18 +843,18 @@ namespace parus::tyck {
         std::unordered_map<ast::StmtId, std::string> field_qualified_name_by_stmt_;
         std::unordered_map<ast::StmtId, std::string> enum_qualified_name_by_stmt_;
         std::unordered_map<ast::StmtId, std::string> acts_qualified_name_by_stmt_;
-        std::unordered_map<std::string, ast::StmtId> class_decl_by_name_;
+        QualifiedNameTable<ast::StmtId> class_decl_by_name_;
         std::unordered_map<ty::TypeId, ast::StmtId> class_decl_by_type_;
         std::unordered_map<ty::TypeId, std::unordered_map<std::string, std::vector<ast::StmtId>>> class_effective_method_map_;
         std::unordered_set<ast::StmtId> class_member_fn_sid_set_;
         std::unordered_map<ast::StmtId, ast::StmtId> class_member_owner_by_stmt_;
         std::unordered_map<std::string, ast::StmtId> private_class_member_qname_owner_;
-        std::unordered_map<std::string, ast::StmtId> actor_decl_by_name_;
+        QualifiedNameTable<ast::StmtId> actor_decl_by_name_;
         std::unordered_map<ty::TypeId, ast::StmtId> actor_decl_by_type_;
         std::unordered_map<ty::TypeId, std::unordered_map<std::string, std::vector<ast::StmtId>>> actor_method_map_;
         std::unordered_set<ast::StmtId> actor_member_fn_sid_set_;
         std::unordered_set<ast::StmtId> proto_member_fn_sid_set_;
-        std::unordered_map<std::string, ast::StmtId> enum_decl_by_name_;
+        QualifiedNameTable<ast::StmtId> enum_decl_by_name_;
         std::unordered_map<ty::TypeId, ast::StmtId> enum_decl_by_type_;
         std::vector<std::string> namespace_stack_;
         std::unordered_map<std::string, std::string> import_alias_to_path_;
@@ -865,6 +917,7 @@ namespace parus::tyck {
         std::unordered_map<std::string, ast::StmtId> acts_named_decl_by_owner_and_name_;
         std::unordered_map<ty::TypeId, std::vector<ast::StmtId>> acts_default_decls_by_owner_;
         std::unordered_set<uint32_t> explicit_core_impl_marker_file_ids_;
+        std::unordered_set<ast::StmtId> explicit_body_skip_sids_;
         std::unordered_set<uint32_t> core_impl_marker_file_ids_;
         std::unordered_map<uint32_t, std::string> explicit_file_bundle_overrides_;
         std::unordered_map<uint32_t, std::string> explicit_file_module_head_overrides_;
@@ -1172,8 +1225,84 @@ namespace parus::tyck {
             uint32_t step_count = 0;
             uint32_t call_depth_budget = 128;
             std::vector<ast::StmtId> call_stack{};
+            size_t call_depth_peak = 0; // 평가 중 call_stack이 가장 깊었던 높이(memo 비용 기록용)
+        };
+        /// @brief (fn, args) memo 항목. 적중해도 원래 평가가 쓴 step/호출 깊이를 같은 예산에 청구한다.
+        struct ConstCallMemo {
+            ConstValue value{};
+            uint32_t step_cost = 0;
+            uint32_t depth_cost = 0; // 호출 자신을 포함해 call_stack을 더 쌓은 높이
         };
 
+        /// @brief const def 본문을 한 번 내린 레지스터 bytecode.
+        ///
+        /// 본문 타입 검사가 끝난 뒤(식 타입/overload 캐시가 채워진 뒤) 처음 호출될 때 컴파일한다.
+        /// VM은 성공 경로만 맡는다. 자료에 따라 갈리는 실패(0 나눗셈, 타입 불일치, step 초과 등)는
+        /// kRetry로 돌아가 AST walker가 처음부터 다시 돌며 기존과 같은 진단을 낸다.
+        /// walker만 아는 구성(struct 초기화, shadowing, 불변 대입 등)이 보이면 컴파일하지 않는다.
+        enum class ConstOp : uint8_t {
+            kLoadK = 0,   // r[dst] = consts[imm]
+            kMove,        // r[dst] = r[a] (지역 식별자)
+            kGlobal,      // r[dst] = 전역 const(global_names[imm])
+            kUnary,       // r[dst] = tok r[a]
+            kBinary,      // r[dst] = r[a] tok r[b]
+            kAssign,      // r[a] = r[dst] (지역 대입, 값은 r[dst]에 남는다)
+            kCall,        // r[dst] = callees[imm](r[a] .. r[a + b])
+            kStep,        // 조건식 노드 step
+            kSetType,     // r[dst].type = type (조건식 결과)
+            kDefine,      // 지역 선언 초기값 타입 확인
+            kJump,        // pc = imm
+            kJumpIfNot,   // r[a]가 bool이 아니면 kRetry, false면 pc = imm
+            kReturn,      // return r[a]
+            kReturnUnit,  // return;
+            kFallOff,     // return 없이 본문 끝
+        };
+        struct ConstInstr {
+            ConstOp op = ConstOp::kFallOff;
+            bool step = false;
+            syntax::TokenKind tok = syntax::TokenKind::kError;
+            uint32_t dst = 0;
+            uint32_t a = 0;
+            uint32_t b = 0;
+            uint32_t imm = 0;
+            uint32_t site = 0;  // 중첩 호출/전역 평가 실패 때 낼 문장 진단(0 = 없음)
+            ty::TypeId type = ty::kInvalidType;
+            Span span{};        // kGlobal/kCall: 중첩 평가에 넘길 식 span
+        };
+        struct ConstFailSite {
+            Span span{};
+            std::string_view reason{};
+        };
+        struct ConstFnProgram {
+            bool usable = false;
+            uint32_t param_count = 0;
+            uint32_t reg_count = 0;
+            std::vector<ConstInstr> code{};
+            std::vector<ConstValue> consts{};
+            std::vector<std::string> global_names{};
+            std::vector<ast::StmtId> callees{};
+            std::vector<ConstFailSite> sites{};
+        };
+        enum class ConstVmResult : uint8_t {
+            kOk = 0,
+            kRetry,   // 진단 없이 포기: walker로 다시 평가
+            kFailed,  // 중첩 평가가 이미 진단을 냄
+        };
+        const ConstFnProgram* const_fn_program_(ast::StmtId fn_sid);
+        bool compile_const_fn_program_(ast::StmtId fn_sid, ConstFnProgram& out);
+        ConstVmResult run_const_fn_program_(
+            const ConstFnProgram& prog,
+            std::vector<ConstValue>& regs,
+            ConstValue& out,
+            ConstEvalContext& ctx
+        );
+        static bool const_call_memo_key_(ast::StmtId fn_sid, const std::vector<ConstValue>& args, std::string& out);
+        static bool const_vm_is_numeric_(ConstValue::Kind k);
+        static bool const_vm_as_i64_(const ConstValue& v, int64_t& out);
+        static bool const_vm_as_f64_(const ConstValue& v, double& out);
+        static bool const_vm_unary_(syntax::TokenKind op, const ConstValue& in, ConstValue& out);
+        static bool const_vm_binary_(syntax::TokenKind op, const ConstValue& l, const ConstValue& r, ConstValue& out);
+
         bool eval_const_expr_value_(ast::ExprId expr_id, ConstValue& out, Span diag_span);
         bool eval_const_symbol_value_(uint32_t symbol_id, ConstValue& out, Span diag_span);
         bool eval_const_expr_(ast::ExprId expr_id, ConstInitData& out, Span diag_span);
@@ -1223,6 +1352,7 @@ namespace parus::tyck {
             std::unordered_map<ast::ExprId, ast::ExprId>& expr_map,
             std::unordered_map<ast::StmtId, ast::StmtId>& stmt_map
         );
+        bool materialize_imported_fn_template_body_(ast::StmtId template_sid, Span use_span);
         std::optional<ast::StmtId> ensure_generic_function_instance_(
             ast::StmtId template_sid,
             const std::vector<ty::TypeId>& concrete_args,
@@ -1348,12 +1478,36 @@ namespace parus::tyck {
         mutable std::unordered_map<std::string, std::optional<uint32_t>> public_proto_target_symbol_cache_;
         mutable std::unordered_map<std::string, std::optional<ast::StmtId>> imported_proto_sid_by_identity_cache_;
         mutable MonoStats mono_stats_{};
+        /// @brief sym_.symbols() 전체 순회를 대신하는 색인. check_program마다 비우고,
+        /// 심볼 테이블이 자라면 sync_symbol_scan_index_()가 늘어난 뒤쪽만 이어서 색인한다.
+        struct SymbolScanIndex {
+            uint32_t indexed = 0;
+            std::string local_bundle{};                                     // 첫 비외부 심볼의 decl_bundle_name
+            std::unordered_map<uint32_t, std::string> module_head_by_file{}; // 비외부 심볼 기준 파일별 첫 module head
+            std::vector<uint32_t> external_fns{};
+            std::vector<uint32_t> external_types{};                         // kType/kField
+            std::unordered_map<std::string, std::vector<uint32_t>> fns_by_visible_name{};     // "@@extovl$" 앞 이름
+            std::unordered_map<std::string, std::vector<uint32_t>> external_fns_by_member{};  // acts member 이름
+        };
+        mutable SymbolScanIndex symbol_scan_index_{};
+        const SymbolScanIndex& sync_symbol_scan_index_() const;
+        // sid -> 풀어 둔 external payload. 참조가 유지되도록 node 기반 map을 쓴다.
+        mutable std::unordered_map<uint32_t, ExternalPayloadRecord> external_payload_records_;
+        const ExternalPayloadRecord& external_payload_record_(uint32_t sid) const;
+        ty::TypeId external_constraint_rhs_type_(uint32_t sid, size_t constraint_index);
+        static ExternalGenericDeclMeta decode_external_generic_decl_meta_(std::string_view payload);
         std::unordered_set<ast::ExprId> proto_require_type_diag_emitted_;
         std::unordered_set<ast::ExprId> proto_require_complex_diag_emitted_;
         std::unordered_map<uint32_t, ast::StmtId> const_symbol_decl_sid_;
         std::unordered_map<uint32_t, uint8_t> const_symbol_eval_state_;
         std::unordered_map<uint32_t, ConstValue> const_symbol_runtime_values_;
         std::unordered_set<uint32_t> const_cycle_diag_emitted_;
+        std::unordered_set<ast::StmtId> const_fn_body_checked_;
+        std::unordered_map<ast::StmtId, ConstFnProgram> const_fn_programs_;
+        // (fn, scalar args) -> 결과. 본문의 전역 이름 해석이 호출 위치와 무관하다고 본다.
+        std::unordered_map<std::string, ConstCallMemo> const_call_memo_;
+        ConstEvalStats const_eval_stats_{};
+        bool const_eval_bytecode_enabled_ = true;
         bool external_c_record_fields_collected_ = false;
         std::unordered_map<ty::TypeId, std::unordered_map<std::string, ty::TypeId>> external_c_union_fields_by_type_;
         std::unordered_map<std::string, std::unordered_map<std::string, ty::TypeId>> external_c_union_fields_by_name_;
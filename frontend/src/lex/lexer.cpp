@@ -1,5 +1,6 @@
 // frontend/src/lex/lexer.cpp
 #include <parus/lex/Lexer.hpp>
+#include <parus/syntax/Keyword.hpp>
 #include <parus/syntax/Punct.hpp>
 #include <parus/syntax/TokenKind.hpp>
 
@@ -11,6 +12,7 @@
 namespace parus {
 
     static bool utf8_validate_strict(std::string_view s, uint32_t& bad_off) {
+        const auto& scan = scan::kernels();
         auto is_cont = [&](unsigned char b) -> bool {
             return (b & 0xC0) == 0x80;
         };
@@ -19,9 +21,9 @@ namespace parus {
         while (i < s.size()) {
             unsigned char b0 = static_cast<unsigned char>(s[i]);
 
-            // ASCII
+            // ASCII run
             if (b0 < 0x80) {
-                i += 1;
+                i += scan.skip_ascii(s.data() + i, s.size() - i);
                 continue;
             }
 
@@ -91,14 +93,28 @@ namespace parus {
         return std::isalpha(u) || c == '_';
     }
 
-    static bool is_ident_cont(char c) {
-        unsigned char u = static_cast<unsigned char>(c);
-        if (u >= 0x80) return true; // UTF-8 bytes: accept as identifier (v0 policy)
-        return std::isalnum(u) || c == '_';
+    // 공백/식별자 run은 대부분 몇 바이트라서, 앞부분은 바로 검사하고 run이 길 때만 스캔 루틴을 부른다.
+    static constexpr size_t kInlineRunBytes = 8;
+
+    static bool is_space_byte(unsigned char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    static bool is_ident_byte(unsigned char c) {
+        return c >= 0x80 || c == '_' || std::isalnum(c);
+    }
+
+    template <typename Pred>
+    static size_t scan_run(const char* p, size_t n, Pred pred, size_t (*kernel)(const char*, size_t)) {
+        size_t i = 0;
+        for (; i < n && i < kInlineRunBytes; ++i) {
+            if (!pred(static_cast<unsigned char>(p[i]))) return i;
+        }
+        return i + kernel(p + i, n - i);
     }
 
     Lexer::Lexer(std::string_view source, uint32_t file_id, diag::Bag* diags) 
-        : source_(source), file_id_(file_id), diags_(diags) {}
+        : source_(source), file_id_(file_id), diags_(diags), scan_(&scan::kernels()) {}
 
     bool Lexer::validate_utf8_all(uint32_t& bad_off) const {
         return utf8_validate_strict(source_, bad_off);
@@ -148,23 +164,27 @@ namespace parus {
     }
 
     void Lexer::skip_ws_and_comments() {
+        const char* const base = source_.data();
+        const size_t n = source_.size();
         while (1) {
             // white space
-            while (!eof() && std::isspace(static_cast<unsigned char>(peek()))) bump();
+            pos_ += scan_run(base + pos_, n - pos_, is_space_byte, scan_->skip_space);
 
             // line comment //
             if (peek() == '/' && peek(1) == '/') {
-                bump(); bump();
-                while (!eof() && peek() != '\n') bump();
+                pos_ += 2;
+                pos_ += scan_->find_byte(base + pos_, n - pos_, '\n');
                 continue;
             }
 
             // block comment /* ... */
             if (peek() == '/' && peek(1) == '*') {
-                bump(); bump();
+                pos_ += 2;
                 while (!eof()) {
-                    if (peek() == '*' && peek(1) == '/') { bump(); bump(); break; }
-                    bump();
+                    pos_ += scan_->find_byte(base + pos_, n - pos_, '*');
+                    if (eof()) break;
+                    if (peek(1) == '/') { pos_ += 2; break; }
+                    ++pos_;
                 }
 
                 continue;
@@ -174,6 +194,23 @@ namespace parus {
         }
     }
 
+    void Lexer::scan_quoted_body(bool escapes) {
+        const char* const base = source_.data();
+        const size_t n = source_.size();
+        while (!eof()) {
+            pos_ += escapes ? scan_->find_byte2(base + pos_, n - pos_, '"', '\\')
+                            : scan_->find_byte(base + pos_, n - pos_, '"');
+            if (eof()) break;
+            if (source_[pos_] == '\\') {
+                ++pos_;
+                if (!eof()) ++pos_; // escape next
+                continue;
+            }
+            ++pos_; // closing "
+            break;
+        }
+    }
+
     Token Lexer::lex_number() {
         size_t start = pos_;
         bool saw_dot = false;
@@ -238,15 +275,7 @@ namespace parus {
     Token Lexer::lex_string() {
         size_t start = pos_;
         bump(); // opening "
-
-        while (!eof()) {
-            char c = bump();
-            if (c == '\\') {
-            if (!eof()) bump(); // escape next
-            continue;
-            }
-            if (c == '"') break;
-        }
+        scan_quoted_body(/*escapes=*/true);
 
         size_t end = pos_;
         Token t;
@@ -267,13 +296,13 @@ namespace parus {
         bump(); // "
 
         while (!eof()) {
-            if (peek() == '"' && peek(1) == '"' && peek(2) == '"') {
-                bump();
-                bump();
-                bump();
+            pos_ += scan_->find_byte(source_.data() + pos_, source_.size() - pos_, '"');
+            if (eof()) break;
+            if (peek(1) == '"' && peek(2) == '"') {
+                pos_ += 3;
                 break;
             }
-            bump();
+            ++pos_;
         }
 
         const size_t end = pos_;
@@ -288,15 +317,7 @@ namespace parus {
         const size_t start = pos_;
         bump(); // '$'
         bump(); // opening '"'
-
-        while (!eof()) {
-            const char c = bump();
-            if (c == '\\') {
-                if (!eof()) bump(); // escape next
-                continue;
-            }
-            if (c == '"') break;
-        }
+        scan_quoted_body(/*escapes=*/true);
 
         const size_t end = pos_;
         Token t;
@@ -311,15 +332,7 @@ namespace parus {
         bump(); // 'c'
         if (raw_mode) bump(); // 'r'
         bump(); // opening '"'
-
-        while (!eof()) {
-            const char c = bump();
-            if (!raw_mode && c == '\\') {
-                if (!eof()) bump(); // escape next
-                continue;
-            }
-            if (c == '"') break;
-        }
+        scan_quoted_body(/*escapes=*/!raw_mode);
 
         const size_t end = pos_;
         Token t;
@@ -386,14 +399,13 @@ namespace parus {
     Token Lexer::lex_ident_or_kw() {
         size_t start = pos_;
         bump(); // first char
-        while (!eof() && is_ident_cont(peek())) {
-            // Allow compact macro payload form like `$fooR"""..."""` / `$fooF"""..."""`.
-            // Stop identifier scan before the prefixed triple-string token.
-            if ((peek() == 'R' || peek() == 'F') &&
-                peek(1) == '"' && peek(2) == '"' && peek(3) == '"') {
-                break;
-            }
-            bump();
+        pos_ += scan_run(source_.data() + pos_, source_.size() - pos_, is_ident_byte, scan_->skip_ident);
+        // Allow compact macro payload form like `$fooR"""..."""` / `$fooF"""..."""`.
+        // Stop identifier scan before the prefixed triple-string token. '"' is not an
+        // identifier byte, so only the last byte of the run can start one.
+        if (pos_ - 1 > start && (source_[pos_ - 1] == 'R' || source_[pos_ - 1] == 'F') &&
+            peek() == '"' && peek(1) == '"' && peek(2) == '"') {
+            --pos_;
         }
         size_t end = pos_;
 
@@ -407,84 +419,8 @@ namespace parus {
             return t;
         }
 
-        // keywords for expressions
-        if (t.lexeme == "true")  { t.kind = syntax::TokenKind::kKwTrue;  return t; }
-        if (t.lexeme == "false") { t.kind = syntax::TokenKind::kKwFalse; return t; }
-        if (t.lexeme == "null")  { t.kind = syntax::TokenKind::kKwNull;  return t; }
-
-        if (t.lexeme == "and") { t.kind = syntax::TokenKind::kKwAnd; return t; }
-        if (t.lexeme == "or")  { t.kind = syntax::TokenKind::kKwOr;  return t; }
-        if (t.lexeme == "not") { t.kind = syntax::TokenKind::kKwNot; return t; }
-        if (t.lexeme == "xor") { t.kind = syntax::TokenKind::kKwXor; return t; }
-
-        if (t.lexeme == "mut") { t.kind = syntax::TokenKind::kKwMut; return t; }
-        if (t.lexeme == "static") { t.kind = syntax::TokenKind::kKwStatic; return t; }
-        if (t.lexeme == "const") { t.kind = syntax::TokenKind::kKwConst; return t; }
-
-        // stmt keywords
-        if (t.lexeme == "let")      { t.kind = syntax::TokenKind::kKwLet;      return t; }
-        if (t.lexeme == "set")      { t.kind = syntax::TokenKind::kKwSet;      return t; }
-        if (t.lexeme == "fix")      { t.kind = syntax::TokenKind::kKwFix;      return t; }
-        if (t.lexeme == "if")       { t.kind = syntax::TokenKind::kKwIf;       return t; }
-        if (t.lexeme == "elif")     { t.kind = syntax::TokenKind::kKwElif;     return t; }
-        if (t.lexeme == "else")     { t.kind = syntax::TokenKind::kKwElse;     return t; }
-        if (t.lexeme == "for")      { t.kind = syntax::TokenKind::kKwFor;      return t; }
-        if (t.lexeme == "while")    { t.kind = syntax::TokenKind::kKwWhile;    return t; }
-        if (t.lexeme == "do")       { t.kind = syntax::TokenKind::kKwDo;       return t; }
-        if (t.lexeme == "loop")     { t.kind = syntax::TokenKind::kKwLoop;     return t; }
-        if (t.lexeme == "in")       { t.kind = syntax::TokenKind::kKwIn;       return t; }
-        if (t.lexeme == "return")   { t.kind = syntax::TokenKind::kKwReturn;   return t; }
-        if (t.lexeme == "break")    { t.kind = syntax::TokenKind::kKwBreak;    return t; }
-        if (t.lexeme == "continue") { t.kind = syntax::TokenKind::kKwContinue; return t; }
-        if (t.lexeme == "manual")   { t.kind = syntax::TokenKind::kKwManual;   return t; }
-        if (t.lexeme == "throw")    { t.kind = syntax::TokenKind::kKwThrow;    return t; }
-        if (t.lexeme == "try")      { t.kind = syntax::TokenKind::kKwTry;      return t; }
-        if (t.lexeme == "catch")    { t.kind = syntax::TokenKind::kKwCatch;    return t; }
-        if (t.lexeme == "copy")     { t.kind = syntax::TokenKind::kKwCopy;     return t; }
-        if (t.lexeme == "clone")    { t.kind = syntax::TokenKind::kKwClone;    return t; }
-
-        if (t.lexeme == "switch")   { t.kind = syntax::TokenKind::kKwSwitch;    return t; }
-        if (t.lexeme == "case")     { t.kind = syntax::TokenKind::kKwCase;      return t; }
-        if (t.lexeme == "default")  { t.kind = syntax::TokenKind::kKwDefault;   return t; }
-
-        if (t.lexeme == "use")      { t.kind = syntax::TokenKind::kKwUse;       return t; }
-        if (t.lexeme == "import")   { t.kind = syntax::TokenKind::kKwImport;    return t; }
-        if (t.lexeme == "module")   { t.kind = syntax::TokenKind::kKwModule;    return t; }        
-        if (t.lexeme == "as")       { t.kind = syntax::TokenKind::kKwAs;        return t; }
-        if (t.lexeme == "nest")     { t.kind = syntax::TokenKind::kKwNest;      return t; }
-        if (t.lexeme == "with")     { t.kind = syntax::TokenKind::kKwWith;      return t; }
-        if (t.lexeme == "require")  { t.kind = syntax::TokenKind::kKwRequire;   return t; }
-        if (t.lexeme == "provide")  { t.kind = syntax::TokenKind::kKwProvide;   return t; }
-
-        if (t.lexeme == "commit")   { t.kind = syntax::TokenKind::kKwCommit;   return t; }
-        if (t.lexeme == "recast")   { t.kind = syntax::TokenKind::kKwRecast;   return t; }
-        if (t.lexeme == "pub")      { t.kind = syntax::TokenKind::kKwPub;      return t; }
-        if (t.lexeme == "sub")      { t.kind = syntax::TokenKind::kKwSub;      return t; }
-
-        if (t.lexeme == "def")       { t.kind = syntax::TokenKind::kKwFn;       return t; }
-        if (t.lexeme == "macro")     { t.kind = syntax::TokenKind::kKwMacro;    return t; }
-        if (t.lexeme == "struct" || t.lexeme == "field") {
-            t.kind = syntax::TokenKind::kKwField;
-            return t;
-        }
-        if (t.lexeme == "enum")     { t.kind = syntax::TokenKind::kKwEnum;     return t; }
-        if (t.lexeme == "proto")    { t.kind = syntax::TokenKind::kKwProto;    return t; }
-        if (t.lexeme == "class")   { t.kind = syntax::TokenKind::kKwClass;   return t; }
-        if (t.lexeme == "actor")   { t.kind = syntax::TokenKind::kKwActor;   return t; }
-        if (t.lexeme == "inst")    { t.kind = syntax::TokenKind::kKwInst;    return t; }
-        if (t.lexeme == "init")     { t.kind = syntax::TokenKind::kKwInit;     return t; }
-        if (t.lexeme == "deinit")   { t.kind = syntax::TokenKind::kKwDeinit;   return t; }
-        if (t.lexeme == "draft")    { t.kind = syntax::TokenKind::kKwDraft;    return t; }
-        if (t.lexeme == "acts")     { t.kind = syntax::TokenKind::kKwActs;     return t; }
-        if (t.lexeme == "export")   { t.kind = syntax::TokenKind::kKwExport;   return t; }
-        if (t.lexeme == "extern")   { t.kind = syntax::TokenKind::kKwExtern;   return t; }
-        if (t.lexeme == "layout")   { t.kind = syntax::TokenKind::kKwLayout;   return t; }
-        if (t.lexeme == "align")    { t.kind = syntax::TokenKind::kKwAlign;    return t; }
-        // - 설계 변경: pure/comptime 등 @ + attr에서 attr은 이제 kIdent로 취급
-        // if (t.lexeme == "pure")     { t.kind = syntax::TokenKind::kKwPure;     return t; }
-        // if (t.lexeme == "comptime") { t.kind = syntax::TokenKind::kKwComptime; return t; }
-
-        t.kind = syntax::TokenKind::kIdent;
+        // keywords: perfect hash over syntax::k_keyword_table
+        t.kind = syntax::keyword_kind(t.lexeme);
         return t;
     }
 
@@ -528,6 +464,51 @@ namespace parus {
         out.push_back(t);
     }
 
+    bool Lexer::seek(uint32_t offset, uint32_t validate_hi) {
+        if (offset > source_.size()) return false;
+        pos_ = offset;
+
+        // 편집 경계가 UTF-8 시퀀스 중간이면 다음 문자 경계까지 검사 구간을 늘린다.
+        size_t hi = std::clamp<size_t>(validate_hi, offset, source_.size());
+        while (hi < source_.size() && (static_cast<unsigned char>(source_[hi]) & 0xC0) == 0x80) ++hi;
+        uint32_t bad_off = 0;
+        return utf8_validate_strict(source_.substr(offset, hi - offset), bad_off);
+    }
+
+    Token Lexer::next_token() {
+        skip_ws_and_comments();
+        if (eof()) {
+            Token t;
+            t.kind = syntax::TokenKind::kEof;
+            t.span = Span{file_id_, static_cast<uint32_t>(source_.size()), static_cast<uint32_t>(source_.size())};
+            return t;
+        }
+
+        char c = peek();
+        unsigned char u = static_cast<unsigned char>(c);
+
+        if (std::isdigit(u)) return lex_number();
+
+        if ((c == 'R' || c == 'F') &&
+            peek(1) == '"' && peek(2) == '"' && peek(3) == '"') {
+            return lex_prefixed_triple_string(c);
+        }
+
+        if (c == 'c' && peek(1) == 'r' && peek(2) == '"') return lex_c_prefixed_string(/*raw_mode=*/true);
+        if (c == 'c' && peek(1) == '"') return lex_c_prefixed_string(/*raw_mode=*/false);
+
+        if (c == '$' && peek(1) == '"') return lex_dollar_string();
+
+        if (c == '"') return lex_string();
+
+        if (peek() == '\'') return lex_char();
+
+        // ident / keyword (ASCII or UTF-8 bytes)
+        if (is_ident_start(c)) return lex_ident_or_kw();
+
+        return lex_punct_or_unknown();
+    }
+
     std::vector<Token> Lexer::lex_all() {
         std::vector<Token> out;
         out.reserve(source_.size() / 4);
@@ -540,55 +521,10 @@ namespace parus {
             return out;
         }
         
-        while (!eof()) {
-            skip_ws_and_comments();
-            if (eof()) break;
-
-            char c = peek();
-            unsigned char u = static_cast<unsigned char>(c);
-
-            if (std::isdigit(u)) {
-                out.push_back(lex_number());
-                continue;
-            }
-
-            if ((c == 'R' || c == 'F') &&
-                peek(1) == '"' && peek(2) == '"' && peek(3) == '"') {
-                out.push_back(lex_prefixed_triple_string(c));
-                continue;
-            }
-
-            if (c == 'c' && peek(1) == 'r' && peek(2) == '"') {
-                out.push_back(lex_c_prefixed_string(/*raw_mode=*/true));
-                continue;
-            }
-            if (c == 'c' && peek(1) == '"') {
-                out.push_back(lex_c_prefixed_string(/*raw_mode=*/false));
-                continue;
-            }
-
-            if (c == '$' && peek(1) == '"') {
-                out.push_back(lex_dollar_string());
-                continue;
-            }
-
-            if (c == '"') {
-                out.push_back(lex_string());
-                continue;
-            }
-
-            if (peek() == '\'') {
-                out.push_back(lex_char());
-                continue;
-            }
-            
-            // ident / keyword (ASCII or UTF-8 bytes)
-            if (is_ident_start(c)) {
-                out.push_back(lex_ident_or_kw());
-                continue;
-            }
-
-            out.push_back(lex_punct_or_unknown());
+        while (true) {
+            Token t = next_token();
+            if (t.kind == syntax::TokenKind::kEof) break;
+            out.push_back(t);
         }
 
         emit_eof(out);
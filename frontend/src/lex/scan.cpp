@@ -0,0 +1,217 @@
+// frontend/src/lex/scan.cpp
+#include "scan_internal.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PARUS_SCAN_X86 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+#else
+#define PARUS_SCAN_X86 0
+#endif
+
+
+namespace parus::scan {
+
+    namespace {
+
+        // --------------------
+        // scalar
+        // --------------------
+
+        constexpr bool is_space_byte_(unsigned char c) {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        constexpr bool is_ident_byte_(unsigned char c) {
+            return c >= 0x80 || c == '_' || (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z');
+        }
+
+        size_t scalar_skip_ascii_(const char* p, size_t n) {
+            size_t i = 0;
+            while (i < n && static_cast<unsigned char>(p[i]) < 0x80) ++i;
+            return i;
+        }
+
+        size_t scalar_skip_space_(const char* p, size_t n) {
+            size_t i = 0;
+            while (i < n && is_space_byte_(static_cast<unsigned char>(p[i]))) ++i;
+            return i;
+        }
+
+        size_t scalar_skip_ident_(const char* p, size_t n) {
+            size_t i = 0;
+            while (i < n && is_ident_byte_(static_cast<unsigned char>(p[i]))) ++i;
+            return i;
+        }
+
+        size_t scalar_find_byte_(const char* p, size_t n, char a) {
+            const void* hit = std::memchr(p, a, n);
+            return hit ? static_cast<size_t>(static_cast<const char*>(hit) - p) : n;
+        }
+
+        size_t scalar_find_byte2_(const char* p, size_t n, char a, char b) {
+            size_t i = 0;
+            while (i < n && p[i] != a && p[i] != b) ++i;
+            return i;
+        }
+
+        constexpr ScanKernels kScalarKernels{
+            ScanIsa::kScalar,
+            scalar_skip_ascii_,
+            scalar_skip_space_,
+            scalar_skip_ident_,
+            scalar_find_byte_,
+            scalar_find_byte2_,
+        };
+
+#if PARUS_SCAN_X86
+        // --------------------
+        // SSE2 (x86-64 기본 집합)
+        // --------------------
+
+        // 16바이트 블록마다 "멈출 바이트" 마스크를 만들고 첫 비트를 찾는다. 남은 꼬리는 scalar로 처리한다.
+        template <typename StopMask, typename Tail>
+        inline size_t sse2_scan_(const char* p, size_t n, StopMask stop_mask, Tail tail) {
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+                const uint32_t m = static_cast<uint32_t>(_mm_movemask_epi8(stop_mask(v)));
+                if (m != 0) return i + static_cast<size_t>(std::countr_zero(m));
+            }
+            return i + tail(p + i, n - i);
+        }
+
+        // unsigned (v - lo) <= span
+        inline __m128i sse2_in_range_(__m128i v, char lo, char span) {
+            const __m128i t = _mm_sub_epi8(v, _mm_set1_epi8(lo));
+            return _mm_cmpeq_epi8(_mm_subs_epu8(t, _mm_set1_epi8(span)), _mm_setzero_si128());
+        }
+
+        inline __m128i sse2_not_(__m128i v) {
+            return _mm_xor_si128(v, _mm_set1_epi8(static_cast<char>(0xFF)));
+        }
+
+        size_t sse2_skip_ascii_(const char* p, size_t n) {
+            return sse2_scan_(p, n, [](__m128i v) { return v; }, scalar_skip_ascii_);
+        }
+
+        size_t sse2_skip_space_(const char* p, size_t n) {
+            return sse2_scan_(p, n, [](__m128i v) {
+                const __m128i sp = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+                return sse2_not_(_mm_or_si128(sp, sse2_in_range_(v, '\t', '\r' - '\t')));
+            }, scalar_skip_space_);
+        }
+
+        size_t sse2_skip_ident_(const char* p, size_t n) {
+            return sse2_scan_(p, n, [](__m128i v) {
+                const __m128i high = _mm_cmplt_epi8(v, _mm_setzero_si128());
+                const __m128i under = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+                const __m128i digit = sse2_in_range_(v, '0', 9);
+                const __m128i alpha = sse2_in_range_(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 25);
+                return sse2_not_(_mm_or_si128(_mm_or_si128(high, under), _mm_or_si128(digit, alpha)));
+            }, scalar_skip_ident_);
+        }
+
+        size_t sse2_find_byte_(const char* p, size_t n, char a) {
+            const __m128i va = _mm_set1_epi8(a);
+            return sse2_scan_(p, n, [&](__m128i v) { return _mm_cmpeq_epi8(v, va); },
+                              [&](const char* q, size_t k) { return scalar_find_byte_(q, k, a); });
+        }
+
+        size_t sse2_find_byte2_(const char* p, size_t n, char a, char b) {
+            const __m128i va = _mm_set1_epi8(a);
+            const __m128i vb = _mm_set1_epi8(b);
+            return sse2_scan_(p, n, [&](__m128i v) { return _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)); },
+                              [&](const char* q, size_t k) { return scalar_find_byte2_(q, k, a, b); });
+        }
+
+        constexpr ScanKernels kSse2Kernels{
+            ScanIsa::kSse2,
+            sse2_skip_ascii_,
+            sse2_skip_space_,
+            sse2_skip_ident_,
+            sse2_find_byte_,
+            sse2_find_byte2_,
+        };
+
+        bool cpu_has_avx2_() {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4]{};
+            __cpuid(info, 0);
+            if (info[0] < 7) return false;
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx) return false;
+            if ((_xgetbv(0) & 0x6) != 0x6) return false; // OS가 YMM 상태를 저장하는지
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif // PARUS_SCAN_X86
+
+        const ScanKernels& select_kernels_() {
+            ScanIsa limit = ScanIsa::kAvx2;
+            if (const char* env = std::getenv("PARUS_LEX_SIMD"); env != nullptr && env[0] != '\0') {
+                if (std::strcmp(env, "scalar") == 0 || std::strcmp(env, "0") == 0) limit = ScanIsa::kScalar;
+                else if (std::strcmp(env, "sse2") == 0) limit = ScanIsa::kSse2;
+            }
+            // 넓은 ISA부터 시도한다.
+            static constexpr std::array<ScanIsa, 2> kOrder{ScanIsa::kAvx2, ScanIsa::kSse2};
+            for (const auto isa : kOrder) {
+                if (isa > limit) continue;
+                if (const auto* k = kernels_for(isa)) return *k;
+            }
+            return kScalarKernels;
+        }
+
+    } // namespace
+
+    const ScanKernels* kernels_for(ScanIsa isa) {
+        switch (isa) {
+            case ScanIsa::kScalar:
+                return &kScalarKernels;
+            case ScanIsa::kSse2:
+#if PARUS_SCAN_X86
+                return &kSse2Kernels;
+#else
+                return nullptr;
+#endif
+            case ScanIsa::kAvx2:
+#if PARUS_SCAN_X86
+                if (!cpu_has_avx2_()) return nullptr;
+                return detail::avx2_kernels();
+#else
+                return nullptr;
+#endif
+        }
+        return nullptr;
+    }
+
+    const ScanKernels& kernels() {
+        static const ScanKernels& selected = select_kernels_();
+        return selected;
+    }
+
+    const char* isa_name(ScanIsa isa) {
+        switch (isa) {
+            case ScanIsa::kScalar: return "scalar";
+            case ScanIsa::kSse2: return "sse2";
+            case ScanIsa::kAvx2: return "avx2";
+        }
+        return "unknown";
+    }
+
+} // namespace parus::scan
@@ -0,0 +1,122 @@
+// frontend/src/lex/scan_avx2.cpp
+//
+// Built with AVX2 enabled on x86 (see frontend/CMakeLists.txt). Only reached
+// through kernels_for() after a runtime CPU check.
+#include "scan_internal.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#include <cstdint>
+#include <cstring>
+#endif
+
+
+namespace parus::scan::detail {
+
+#if defined(__AVX2__)
+    namespace {
+
+        // scalar 꼬리 루틴도 이 파일 안에 따로 둔다(scan_internal.hpp 주석 참고).
+        bool is_space_byte_(unsigned char c) {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        bool is_ident_byte_(unsigned char c) {
+            return c >= 0x80 || c == '_' || (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z');
+        }
+
+        // std::countr_zero는 inline 템플릿이라 scan.cpp의 같은 인스턴스와 하나로 합쳐질 수 있다.
+        // 이 파일 안에서만 보이는 helper로 첫 비트를 찾는다.
+        uint32_t first_set_bit_(uint32_t m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long idx = 0;
+            _BitScanForward(&idx, m);
+            return static_cast<uint32_t>(idx);
+#else
+            return static_cast<uint32_t>(__builtin_ctz(m));
+#endif
+        }
+
+        // 32바이트 블록마다 "멈출 바이트" 마스크를 만들고 첫 비트를 찾는다. 남은 꼬리는 scalar로 처리한다.
+        template <typename StopMask, typename TailStop>
+        inline size_t avx2_scan_(const char* p, size_t n, StopMask stop_mask, TailStop tail_stop) {
+            size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+                const uint32_t m = static_cast<uint32_t>(_mm256_movemask_epi8(stop_mask(v)));
+                if (m != 0) return i + static_cast<size_t>(first_set_bit_(m));
+            }
+            for (; i < n; ++i) {
+                if (tail_stop(static_cast<unsigned char>(p[i]))) return i;
+            }
+            return n;
+        }
+
+        // unsigned (v - lo) <= span
+        inline __m256i avx2_in_range_(__m256i v, char lo, char span) {
+            const __m256i t = _mm256_sub_epi8(v, _mm256_set1_epi8(lo));
+            return _mm256_cmpeq_epi8(_mm256_subs_epu8(t, _mm256_set1_epi8(span)), _mm256_setzero_si256());
+        }
+
+        inline __m256i avx2_not_(__m256i v) {
+            return _mm256_xor_si256(v, _mm256_set1_epi8(static_cast<char>(0xFF)));
+        }
+
+        size_t avx2_skip_ascii_(const char* p, size_t n) {
+            return avx2_scan_(p, n, [](__m256i v) { return v; }, [](unsigned char c) { return c >= 0x80; });
+        }
+
+        size_t avx2_skip_space_(const char* p, size_t n) {
+            return avx2_scan_(p, n, [](__m256i v) {
+                const __m256i sp = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+                return avx2_not_(_mm256_or_si256(sp, avx2_in_range_(v, '\t', '\r' - '\t')));
+            }, [](unsigned char c) { return !is_space_byte_(c); });
+        }
+
+        size_t avx2_skip_ident_(const char* p, size_t n) {
+            return avx2_scan_(p, n, [](__m256i v) {
+                const __m256i high = _mm256_cmpgt_epi8(_mm256_setzero_si256(), v);
+                const __m256i under = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+                const __m256i digit = avx2_in_range_(v, '0', 9);
+                const __m256i alpha = avx2_in_range_(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 25);
+                return avx2_not_(_mm256_or_si256(_mm256_or_si256(high, under), _mm256_or_si256(digit, alpha)));
+            }, [](unsigned char c) { return !is_ident_byte_(c); });
+        }
+
+        size_t avx2_find_byte_(const char* p, size_t n, char a) {
+            const __m256i va = _mm256_set1_epi8(a);
+            return avx2_scan_(p, n, [&](__m256i v) { return _mm256_cmpeq_epi8(v, va); },
+                              [&](unsigned char c) { return c == static_cast<unsigned char>(a); });
+        }
+
+        size_t avx2_find_byte2_(const char* p, size_t n, char a, char b) {
+            const __m256i va = _mm256_set1_epi8(a);
+            const __m256i vb = _mm256_set1_epi8(b);
+            return avx2_scan_(p, n,
+                              [&](__m256i v) { return _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb)); },
+                              [&](unsigned char c) {
+                                  return c == static_cast<unsigned char>(a) || c == static_cast<unsigned char>(b);
+                              });
+        }
+
+        constexpr ScanKernels kAvx2Kernels{
+            ScanIsa::kAvx2,
+            avx2_skip_ascii_,
+            avx2_skip_space_,
+            avx2_skip_ident_,
+            avx2_find_byte_,
+            avx2_find_byte2_,
+        };
+
+    } // namespace
+
+    const ScanKernels* avx2_kernels() { return &kAvx2Kernels; }
+#else
+    const ScanKernels* avx2_kernels() { return nullptr; }
+#endif
+
+} // namespace parus::scan::detail
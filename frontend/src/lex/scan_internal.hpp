@@ -0,0 +1,16 @@
+#pragma once
+
+// Shared declarations for the lexer scan kernels split by instruction set.
+// scan_avx2.cpp is built with AVX2 enabled, so nothing inline is shared here:
+// an inline definition emitted from that unit could be picked by the linker
+// for callers running on CPUs without AVX2. The same holds for inline library
+// templates such as std::countr_zero, so that unit uses file-local helpers.
+#include <parus/lex/Scan.hpp>
+
+
+namespace parus::scan::detail {
+
+    /// @brief AVX2 루틴(scan_avx2.cpp). x86이 아니거나 AVX2 없이 빌드되면 nullptr.
+    const ScanKernels* avx2_kernels();
+
+} // namespace parus::scan::detail
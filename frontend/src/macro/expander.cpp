@@ -9,6 +9,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -34,6 +35,13 @@ namespace parus::macro {
             ast::MacroOutKind out_kind = ast::MacroOutKind::kExpr;
             std::vector<Token> tokens{};
             std::string_view macro_name{};
+
+            // 이 호출이 쓰는 arm memo 항목. 파싱 결과를 기록하거나 복제할 때 찾는다.
+            uint64_t memo_key = 0;
+            size_t memo_slot = static_cast<size_t>(-1);
+            bool reuse_parsed = false; // tokens 없이 memo의 파싱 결과를 복제한다
+            uint32_t arg_begin = 0;
+            Span call_span{};
         };
 
         static void add_diag_(diag::Bag& diags, diag::Code code, Span span, std::string_view a0 = {}) {
@@ -410,6 +418,357 @@ namespace parus::macro {
             return true;
         }
 
+        static uint64_t arg_token_fingerprint_(const ast::AstArena& ast, uint32_t begin, uint32_t count) {
+            const auto& toks = ast.macro_tokens();
+            uint64_t h = 1469598103934665603ull;
+            const auto mix = [&](uint64_t v) {
+                h ^= v;
+                h *= 1099511628211ull;
+            };
+            mix(count);
+            for (uint32_t i = begin; i < begin + count && i < toks.size(); ++i) {
+                mix(static_cast<uint64_t>(toks[i].kind));
+                for (const char c : toks[i].lexeme) mix(static_cast<unsigned char>(c));
+                mix(0xffu);
+            }
+            return h;
+        }
+
+        static bool same_arg_tokens_(const ast::AstArena& ast, uint32_t a, uint32_t b, uint32_t count) {
+            const auto& toks = ast.macro_tokens();
+            if (a + count > toks.size() || b + count > toks.size()) return false;
+            for (uint32_t i = 0; i < count; ++i) {
+                if (toks[a + i].kind != toks[b + i].kind) return false;
+                if (toks[a + i].lexeme != toks[b + i].lexeme) return false;
+            }
+            return true;
+        }
+
+        static std::vector<MacroCaptureBinding> rebase_captures_(
+            const std::vector<MacroCaptureBinding>& captures,
+            uint32_t from,
+            uint32_t to
+        ) {
+            std::vector<MacroCaptureBinding> out = captures;
+            for (auto& cap : out) {
+                for (auto& r : cap.ranges) r.begin = r.begin - from + to;
+            }
+            return out;
+        }
+
+        /// @brief memo에 남긴 파싱 결과를 검사하고 다른 호출 위치로 복제한다.
+        ///
+        /// 같은 인자 토큰열의 전개는 span과 hygiene 이름만 다르다. span 끝점이 첫 호출의 인자 토큰/호출 span이면
+        /// 새 호출의 같은 토큰으로 옮기고, 나머지(템플릿 토큰)는 그대로 둔다.
+        /// 복제기가 모르는 노드(loop, switch, 구조체 초기화, f-string 등)가 있으면 재사용하지 않는다.
+        struct ExpansionCloner {
+            ast::AstArena& ast;
+            std::unordered_map<uint64_t, Span> lo_map{};
+            std::unordered_map<uint64_t, Span> hi_map{};
+            std::unordered_map<std::string_view, std::string_view> renames{};
+            std::vector<std::string_view>* gensyms_out = nullptr;
+
+            static uint64_t pos_key_(uint32_t file_id, uint32_t off) {
+                return (static_cast<uint64_t>(file_id) << 32) | off;
+            }
+
+            void map_tokens(uint32_t from_begin, uint32_t to_begin, uint32_t count, Span from_call, Span to_call) {
+                const auto& toks = ast.macro_tokens();
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (from_begin + i >= toks.size() || to_begin + i >= toks.size()) break;
+                    const Span f = toks[from_begin + i].span;
+                    const Span t = toks[to_begin + i].span;
+                    lo_map.emplace(pos_key_(f.file_id, f.lo), t);
+                    hi_map.emplace(pos_key_(f.file_id, f.hi), t);
+                }
+                lo_map.emplace(pos_key_(from_call.file_id, from_call.lo), to_call);
+                hi_map.emplace(pos_key_(from_call.file_id, from_call.hi), to_call);
+            }
+
+            Span map_span(Span sp) const {
+                Span out = sp;
+                bool file_set = false;
+                const auto find_end = [&](uint32_t off, bool want_lo, Span& hit) {
+                    const auto& first = want_lo ? lo_map : hi_map;
+                    const auto& second = want_lo ? hi_map : lo_map;
+                    if (auto it = first.find(pos_key_(sp.file_id, off)); it != first.end()) {
+                        hit = it->second;
+                        return true;
+                    }
+                    if (auto it = second.find(pos_key_(sp.file_id, off)); it != second.end()) {
+                        hit = it->second;
+                        return true;
+                    }
+                    return false;
+                };
+                Span hit{};
+                if (find_end(sp.lo, /*want_lo=*/true, hit)) {
+                    out.lo = (lo_map.count(pos_key_(sp.file_id, sp.lo)) != 0) ? hit.lo : hit.hi;
+                    out.file_id = hit.file_id;
+                    file_set = true;
+                }
+                if (find_end(sp.hi, /*want_lo=*/false, hit)) {
+                    out.hi = (hi_map.count(pos_key_(sp.file_id, sp.hi)) != 0) ? hit.hi : hit.lo;
+                    if (!file_set) out.file_id = hit.file_id;
+                }
+                return out;
+            }
+
+            std::string_view rename_(std::string_view name) const {
+                if (auto it = renames.find(name); it != renames.end()) return it->second;
+                return name;
+            }
+
+            static bool expr_fields_supported_(const ast::Expr& e) {
+                return e.string_part_count == 0 &&
+                       e.call_type_arg_count == 0 &&
+                       e.field_init_count == 0 &&
+                       e.field_init_type_node == ast::k_invalid_type_node &&
+                       e.loop_iter == ast::k_invalid_expr &&
+                       e.loop_body == ast::k_invalid_stmt;
+            }
+
+            bool check_type(ast::TypeNodeId id) const {
+                if (id == ast::k_invalid_type_node) return true;
+                if (id >= ast.type_nodes().size()) return false;
+                const auto& n = ast.type_node(id);
+                switch (n.kind) {
+                    case ast::TypeNodeKind::kError:
+                        return true;
+                    case ast::TypeNodeKind::kNamedPath:
+                        for (uint32_t i = 0; i < n.generic_arg_count; ++i) {
+                            const auto ci = n.generic_arg_begin + i;
+                            if (ci >= ast.type_node_children().size()) return false;
+                            if (!check_type(ast.type_node_children()[ci])) return false;
+                        }
+                        return true;
+                    case ast::TypeNodeKind::kOptional:
+                    case ast::TypeNodeKind::kArray:
+                    case ast::TypeNodeKind::kBorrow:
+                    case ast::TypeNodeKind::kEscape:
+                    case ast::TypeNodeKind::kPtr:
+                        return check_type(n.elem);
+                    case ast::TypeNodeKind::kFn:
+                        if (!check_type(n.fn_ret)) return false;
+                        for (uint32_t i = 0; i < n.fn_param_count; ++i) {
+                            const auto ci = n.fn_param_begin + i;
+                            if (ci >= ast.type_node_children().size()) return false;
+                            if (!check_type(ast.type_node_children()[ci])) return false;
+                        }
+                        return true;
+                    case ast::TypeNodeKind::kMacroCall:
+                        return false;
+                }
+                return false;
+            }
+
+            bool check_expr(ast::ExprId id) const {
+                if (id == ast::k_invalid_expr) return true;
+                if (id >= ast.exprs().size()) return false;
+                const auto& e = ast.expr(id);
+                if (!expr_fields_supported_(e)) return false;
+                switch (e.kind) {
+                    case ast::ExprKind::kIntLit:
+                    case ast::ExprKind::kFloatLit:
+                    case ast::ExprKind::kStringLit:
+                    case ast::ExprKind::kCharLit:
+                    case ast::ExprKind::kBoolLit:
+                    case ast::ExprKind::kNullLit:
+                    case ast::ExprKind::kIdent:
+                    case ast::ExprKind::kHole:
+                        return true;
+                    case ast::ExprKind::kUnary:
+                    case ast::ExprKind::kPostfixUnary:
+                        return check_expr(e.a);
+                    case ast::ExprKind::kBinary:
+                    case ast::ExprKind::kAssign:
+                    case ast::ExprKind::kIndex:
+                        return check_expr(e.a) && check_expr(e.b);
+                    case ast::ExprKind::kTernary:
+                    case ast::ExprKind::kIfExpr:
+                        return check_expr(e.a) && check_expr(e.b) && check_expr(e.c);
+                    case ast::ExprKind::kCast:
+                        return check_expr(e.a) && check_type(e.cast_type_node);
+                    case ast::ExprKind::kBlockExpr:
+                        return check_stmt(e.block_stmt) && check_expr(e.block_tail);
+                    case ast::ExprKind::kCall: {
+                        if (!check_expr(e.a)) return false;
+                        const uint64_t end = uint64_t(e.arg_begin) + e.arg_count;
+                        if (end > ast.args().size()) return false;
+                        for (uint32_t i = 0; i < e.arg_count; ++i) {
+                            if (!check_expr(ast.args()[e.arg_begin + i].expr)) return false;
+                        }
+                        return true;
+                    }
+                    default:
+                        return false;
+                }
+            }
+
+            bool check_stmt(ast::StmtId id) const {
+                if (id == ast::k_invalid_stmt) return true;
+                if (id >= ast.stmts().size()) return false;
+                const auto& s = ast.stmt(id);
+                switch (s.kind) {
+                    case ast::StmtKind::kEmpty:
+                    case ast::StmtKind::kBreak:
+                    case ast::StmtKind::kContinue:
+                    case ast::StmtKind::kExprStmt:
+                    case ast::StmtKind::kReturn:
+                    case ast::StmtKind::kIf:
+                    case ast::StmtKind::kWhile:
+                    case ast::StmtKind::kDoScope:
+                    case ast::StmtKind::kDoWhile:
+                        break;
+                    case ast::StmtKind::kVar:
+                        if (s.attr_count != 0 || s.var_has_acts_binding) return false;
+                        if (is_hygiene_gensym(s.name) && gensyms_out != nullptr) gensyms_out->push_back(s.name);
+                        break;
+                    case ast::StmtKind::kBlock: {
+                        const uint64_t end = uint64_t(s.stmt_begin) + s.stmt_count;
+                        if (end > ast.stmt_children().size()) return false;
+                        for (uint32_t i = 0; i < s.stmt_count; ++i) {
+                            if (!check_stmt(ast.stmt_children()[s.stmt_begin + i])) return false;
+                        }
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+                return check_expr(s.expr) && check_expr(s.init) && check_type(s.type_node) &&
+                       check_stmt(s.a) && check_stmt(s.b);
+            }
+
+            ast::TypeNodeId clone_type(ast::TypeNodeId id) {
+                if (id == ast::k_invalid_type_node) return id;
+                ast::TypeNode n = ast.type_node(id);
+                n.span = map_span(n.span);
+                n.elem = clone_type(n.elem);
+                n.fn_ret = clone_type(n.fn_ret);
+                const auto clone_children = [&](uint32_t& begin, uint32_t count) {
+                    if (count == 0) return;
+                    std::vector<ast::TypeNodeId> kids{};
+                    kids.reserve(count);
+                    for (uint32_t i = 0; i < count; ++i) {
+                        kids.push_back(clone_type(ast.type_node_children()[begin + i]));
+                    }
+                    begin = static_cast<uint32_t>(ast.type_node_children().size());
+                    for (const auto k : kids) ast.add_type_node_child(k);
+                };
+                clone_children(n.generic_arg_begin, n.generic_arg_count);
+                clone_children(n.fn_param_begin, n.fn_param_count);
+                return ast.add_type_node(n);
+            }
+
+            ast::ExprId clone_expr(ast::ExprId id) {
+                if (id == ast::k_invalid_expr) return id;
+                ast::Expr e = ast.expr(id);
+                e.span = map_span(e.span);
+                if (e.kind == ast::ExprKind::kIdent) e.text = rename_(e.text);
+                e.a = clone_expr(e.a);
+                e.b = clone_expr(e.b);
+                e.c = clone_expr(e.c);
+                e.cast_type_node = clone_type(e.cast_type_node);
+                e.block_stmt = clone_stmt(e.block_stmt);
+                e.block_tail = clone_expr(e.block_tail);
+                if (e.arg_count > 0) {
+                    std::vector<ast::Arg> args{};
+                    args.reserve(e.arg_count);
+                    for (uint32_t i = 0; i < e.arg_count; ++i) {
+                        ast::Arg a = ast.args()[e.arg_begin + i];
+                        a.span = map_span(a.span);
+                        a.expr = clone_expr(a.expr);
+                        args.push_back(a);
+                    }
+                    e.arg_begin = static_cast<uint32_t>(ast.args().size());
+                    for (const auto& a : args) ast.add_arg(a);
+                }
+                return ast.add_expr(e);
+            }
+
+            ast::StmtId clone_stmt(ast::StmtId id) {
+                if (id == ast::k_invalid_stmt) return id;
+                ast::Stmt s = ast.stmt(id);
+                s.span = map_span(s.span);
+                if (s.kind == ast::StmtKind::kVar) s.name = rename_(s.name);
+                s.expr = clone_expr(s.expr);
+                s.init = clone_expr(s.init);
+                s.type_node = clone_type(s.type_node);
+                s.a = clone_stmt(s.a);
+                s.b = clone_stmt(s.b);
+                if (s.kind == ast::StmtKind::kBlock && s.stmt_count > 0) {
+                    std::vector<ast::StmtId> kids{};
+                    kids.reserve(s.stmt_count);
+                    for (uint32_t i = 0; i < s.stmt_count; ++i) {
+                        kids.push_back(clone_stmt(ast.stmt_children()[s.stmt_begin + i]));
+                    }
+                    s.stmt_begin = static_cast<uint32_t>(ast.stmt_children().size());
+                    for (const auto k : kids) ast.add_stmt_child(k);
+                }
+                return ast.add_stmt(s);
+            }
+        };
+
+        /// @brief 첫 호출의 파싱 결과를 memo 항목에 남긴다. 복제기가 다룰 수 없으면 남기지 않는다.
+        static void record_parsed_expansion_(
+            MacroExpansionContext& ctx,
+            const ExpandResult& ex,
+            ast::ExprId parsed_expr,
+            ast::StmtId parsed_stmt,
+            uint32_t scope_depth,
+            uint32_t depth,
+            uint32_t step_cost
+        ) {
+            auto it = ctx.arm_memo.find(ex.memo_key);
+            if (it == ctx.arm_memo.end() || ex.memo_slot >= it->second.size()) return;
+            auto& m = it->second[ex.memo_slot];
+            if (m.parsed_expr != ast::k_invalid_expr || m.parsed_stmt != ast::k_invalid_stmt) return;
+
+            std::vector<std::string_view> gensyms{};
+            ExpansionCloner checker{ctx.ast};
+            checker.gensyms_out = &gensyms;
+            const bool ok = (parsed_expr != ast::k_invalid_expr)
+                ? checker.check_expr(parsed_expr)
+                : checker.check_stmt(parsed_stmt);
+            if (!ok) return;
+
+            m.parsed_expr = parsed_expr;
+            m.parsed_stmt = parsed_stmt;
+            m.call_span = ex.call_span;
+            m.scope_depth = scope_depth;
+            m.depth = depth;
+            m.step_cost = step_cost;
+            m.gensyms = std::move(gensyms);
+        }
+
+        /// @brief memo의 파싱 결과를 이번 호출 위치로 복제한다. 돌려받는 쪽은 expr 또는 stmt 하나다.
+        static std::pair<ast::ExprId, ast::StmtId> clone_parsed_expansion_(
+            MacroExpansionContext& ctx,
+            const ExpandResult& ex
+        ) {
+            auto it = ctx.arm_memo.find(ex.memo_key);
+            if (it == ctx.arm_memo.end() || ex.memo_slot >= it->second.size()) {
+                return {ast::k_invalid_expr, ast::k_invalid_stmt};
+            }
+            const auto& m = it->second[ex.memo_slot];
+
+            ExpansionCloner cloner{ctx.ast};
+            cloner.map_tokens(m.arg_begin, ex.arg_begin, m.arg_count, m.call_span, ex.call_span);
+            uint64_t seed = (static_cast<uint64_t>(ex.call_span.file_id) << 48) ^
+                            (static_cast<uint64_t>(ex.call_span.lo) << 16) ^
+                            static_cast<uint64_t>(ex.call_span.hi);
+            seed = mix_hygiene_seed(ctx.ast, seed);
+            uint64_t serial = 0;
+            for (size_t i = 0; i < m.gensyms.size(); ++i) {
+                if (cloner.renames.find(m.gensyms[i]) != cloner.renames.end()) continue;
+                cloner.renames.emplace(m.gensyms[i], make_hygiene_gensym(ctx.ast, m.gensyms[i], i, seed, serial));
+            }
+
+            // memo 항목 참조는 복제 중 arena가 자라도 바뀌지 않는다(arm_memo는 여기서 건드리지 않는다).
+            if (m.parsed_expr != ast::k_invalid_expr) return {cloner.clone_expr(m.parsed_expr), ast::k_invalid_stmt};
+            return {ast::k_invalid_expr, cloner.clone_stmt(m.parsed_stmt)};
+        }
+
         static bool expand_macro_call_to_tokens_(
             MacroExpansionContext& ctx,
             std::string_view macro_name,
@@ -419,6 +778,7 @@ namespace parus::macro {
             uint32_t arg_count,
             Span call_span,
             uint32_t scope_depth,
+            uint32_t depth,
             CallContext call_ctx,
             ExpandResult& out
         ) {
@@ -448,17 +808,94 @@ namespace parus::macro {
                 return false;
             }
             const auto& arms = ctx.ast.macro_arms();
+
+            const auto emit = [&](const ast::MacroArm& arm, bool token_group, const std::vector<MacroCaptureBinding>& captures) {
+                std::vector<Token> sub{};
+                const bool sub_ok = token_group
+                    ? substitute_token_template(ctx.ast, arm, captures, call_span, ctx.diags, sub)
+                    : substitute_template_(ctx.ast, arm, captures, call_span, sub);
+                if (!sub_ok) {
+                    if (!token_group) {
+                        add_diag_(ctx.diags, diag::Code::kMacroReparseFail, call_span, macro_name);
+                    }
+                    return false;
+                }
+                if (sub.size() > ctx.budget.max_output_tokens) {
+                    add_diag_(ctx.diags, diag::Code::kMacroRecursionBudget, call_span, macro_name);
+                    return false;
+                }
+
+                ++ctx.stats.expansion_count;
+                out.ok = true;
+                out.out_kind = arm.out_kind;
+                out.tokens = std::move(sub);
+                out.macro_name = macro_name;
+                return true;
+            };
+
+            // 같은 macro/문맥/인자 토큰열은 같은 arm에 같은 모양으로 매칭되고 같은 모양으로 파싱된다.
+            // 첫 호출의 파싱 결과가 있으면 복제하고, 없으면 매칭만 건너뛰고 치환/재파싱한다.
+            const uint64_t memo_key =
+                arg_token_fingerprint_(ctx.ast, arg_begin, arg_count)
+                ^ (static_cast<uint64_t>(*decl_index) << 8)
+                ^ static_cast<uint64_t>(call_ctx);
+            out.memo_key = memo_key;
+            out.arg_begin = arg_begin;
+            out.call_span = call_span;
+            if (const auto it = ctx.arm_memo.find(memo_key); it != ctx.arm_memo.end()) {
+                for (size_t mi = 0; mi < it->second.size(); ++mi) {
+                    const auto& m = it->second[mi];
+                    if (m.decl_index != *decl_index || m.call_ctx != static_cast<uint8_t>(call_ctx)) continue;
+                    if (m.arg_count != arg_count || !same_arg_tokens_(ctx.ast, m.arg_begin, arg_begin, arg_count)) continue;
+                    if (m.arm_index >= arms.size()) break;
+                    const auto& arm = arms[m.arm_index];
+                    ++ctx.stats.memo_hit_count;
+                    out.memo_slot = mi;
+
+                    const bool has_parsed =
+                        m.parsed_expr != ast::k_invalid_expr || m.parsed_stmt != ast::k_invalid_stmt;
+                    if (has_parsed && m.scope_depth == scope_depth && m.depth == depth &&
+                        uint64_t(ctx.steps) + m.step_cost <= ctx.budget.max_steps) {
+                        ctx.steps += m.step_cost;
+                        ++ctx.stats.expansion_count;
+                        ++ctx.stats.reused_parse_count;
+                        out.ok = true;
+                        out.out_kind = arm.out_kind;
+                        out.macro_name = macro_name;
+                        out.reuse_parsed = true;
+                        return true;
+                    }
+                    return emit(arm, m.token_group, rebase_captures_(m.captures, m.arg_begin, arg_begin));
+                }
+            }
+
             for (const auto gi : group_order) {
                 if (gi >= ctx.ast.macro_groups().size()) continue;
                 const auto& group = ctx.ast.macro_groups()[gi];
                 const bool token_group = (group.match_kind == ast::MacroMatchKind::kToken);
-                for (uint32_t i = 0; i < group.arm_count; ++i) {
-                    const auto ai = group.arm_begin + i;
+
+                // token group은 인자 첫 토큰으로 후보 arm을 먼저 고른다(dispatch 표는 group마다 한 번 생성).
+                std::vector<uint32_t> linear{};
+                const std::vector<uint32_t>* order = &linear;
+                if (token_group && ctx.arm_dispatch) {
+                    auto dit = ctx.token_dispatch.find(gi);
+                    if (dit == ctx.token_dispatch.end()) {
+                        dit = ctx.token_dispatch.emplace(
+                            gi, build_token_arm_dispatch(ctx.ast, group.arm_begin, group.arm_count)).first;
+                    }
+                    order = &token_arm_candidates(dit->second, ctx.ast, arg_begin, arg_count);
+                } else {
+                    linear.reserve(group.arm_count);
+                    for (uint32_t i = 0; i < group.arm_count; ++i) linear.push_back(group.arm_begin + i);
+                }
+
+                for (const auto ai : *order) {
                     if (ai >= arms.size()) break;
                     const auto& arm = arms[ai];
 
                     std::vector<MacroCaptureBinding> captures{};
                     if (token_group) {
+                        ++ctx.stats.token_arm_try_count;
                         auto st = match_token_arm(
                             ctx.ast,
                             ctx.types,
@@ -477,26 +914,18 @@ namespace parus::macro {
                         captures = match.captures;
                     }
 
-                    std::vector<Token> sub{};
-                    const bool sub_ok = token_group
-                        ? substitute_token_template(ctx.ast, arm, captures, call_span, ctx.diags, sub)
-                        : substitute_template_(ctx.ast, arm, captures, call_span, sub);
-                    if (!sub_ok) {
-                        if (!token_group) {
-                            add_diag_(ctx.diags, diag::Code::kMacroReparseFail, call_span, macro_name);
-                        }
-                        return false;
-                    }
-                    if (sub.size() > ctx.budget.max_output_tokens) {
-                        add_diag_(ctx.diags, diag::Code::kMacroRecursionBudget, call_span, macro_name);
-                        return false;
-                    }
-
-                    out.ok = true;
-                    out.out_kind = arm.out_kind;
-                    out.tokens = std::move(sub);
-                    out.macro_name = macro_name;
-                    return true;
+                    MacroArmMemo memo{};
+                    memo.decl_index = *decl_index;
+                    memo.call_ctx = static_cast<uint8_t>(call_ctx);
+                    memo.arg_begin = arg_begin;
+                    memo.arg_count = arg_count;
+                    memo.arm_index = ai;
+                    memo.token_group = token_group;
+                    memo.captures = captures;
+                    auto& slots = ctx.arm_memo[memo_key];
+                    slots.push_back(std::move(memo));
+                    out.memo_slot = slots.size() - 1;
+                    return emit(arm, token_group, captures);
                 }
             }
 
@@ -611,6 +1040,7 @@ namespace parus::macro {
                                 n.macro_arg_count,
                                 n.span,
                                 scope_depth,
+                                depth,
                                 CallContext::kType,
                                 ex)) {
                             return false;
@@ -751,6 +1181,7 @@ namespace parus::macro {
                         em.macro_token_count,
                         em.span,
                         scope_depth,
+                        depth,
                         CallContext::kExpr,
                         ex)) {
                     return false;
@@ -761,13 +1192,27 @@ namespace parus::macro {
                     return false;
                 }
 
+                if (ex.reuse_parsed) {
+                    const auto cloned = clone_parsed_expansion_(ctx, ex).first;
+                    if (cloned == ast::k_invalid_expr) {
+                        add_diag_(ctx.diags, diag::Code::kMacroReparseFail, em.span, macro_name);
+                        return false;
+                    }
+                    eid = cloned;
+                    return true;
+                }
+
                 auto parsed = reparse_expr_(ctx, std::move(ex.tokens), em.span);
                 if (!parsed.has_value()) {
                     add_diag_(ctx.diags, diag::Code::kMacroReparseFail, em.span, macro_name);
                     return false;
                 }
                 eid = *parsed;
-                return expand_expr(eid, scope_depth, depth + 1);
+                const uint32_t steps_before = ctx.steps;
+                if (!expand_expr(eid, scope_depth, depth + 1)) return false;
+                record_parsed_expansion_(
+                    ctx, ex, eid, ast::k_invalid_stmt, scope_depth, depth, ctx.steps - steps_before);
+                return true;
             }
 
             bool expand_stmt(ast::StmtId& sid, uint32_t scope_depth, uint32_t depth) {
@@ -795,6 +1240,7 @@ namespace parus::macro {
                             mc.macro_token_count,
                             mc.span,
                             scope_depth,
+                            depth,
                             cc,
                             out);
                     };
@@ -810,25 +1256,51 @@ namespace parus::macro {
                     if (!matched) return false;
 
                     if (ex.out_kind == ast::MacroOutKind::kExpr) {
-                        auto parsed = reparse_expr_(ctx, std::move(ex.tokens), mc.span);
-                        if (!parsed.has_value()) {
-                            add_diag_(ctx.diags, diag::Code::kMacroReparseFail, mc.span, macro_name);
-                            return false;
+                        if (ex.reuse_parsed) {
+                            const auto expr_id = clone_parsed_expansion_(ctx, ex).first;
+                            if (expr_id == ast::k_invalid_expr) {
+                                add_diag_(ctx.diags, diag::Code::kMacroReparseFail, mc.span, macro_name);
+                                return false;
+                            }
+                            if (sid >= ctx.ast.stmts().size()) return false;
+                            ctx.ast.stmt_mut(sid).expr = expr_id;
+                        } else {
+                            auto parsed = reparse_expr_(ctx, std::move(ex.tokens), mc.span);
+                            if (!parsed.has_value()) {
+                                add_diag_(ctx.diags, diag::Code::kMacroReparseFail, mc.span, macro_name);
+                                return false;
+                            }
+                            if (sid >= ctx.ast.stmts().size()) return false;
+                            ctx.ast.stmt_mut(sid).expr = *parsed;
+                            auto expr_id = *parsed;
+                            const uint32_t steps_before = ctx.steps;
+                            if (!expand_expr(expr_id, scope_depth, depth + 1)) return false;
+                            if (sid >= ctx.ast.stmts().size()) return false;
+                            ctx.ast.stmt_mut(sid).expr = expr_id;
+                            record_parsed_expansion_(
+                                ctx, ex, expr_id, ast::k_invalid_stmt, scope_depth, depth, ctx.steps - steps_before);
                         }
-                        if (sid >= ctx.ast.stmts().size()) return false;
-                        ctx.ast.stmt_mut(sid).expr = *parsed;
-                        auto expr_id = *parsed;
-                        if (!expand_expr(expr_id, scope_depth, depth + 1)) return false;
-                        if (sid >= ctx.ast.stmts().size()) return false;
-                        ctx.ast.stmt_mut(sid).expr = expr_id;
                     } else {
+                        if (ex.reuse_parsed) {
+                            const auto cloned = clone_parsed_expansion_(ctx, ex).second;
+                            if (cloned == ast::k_invalid_stmt) {
+                                add_diag_(ctx.diags, diag::Code::kMacroReparseFail, mc.span, macro_name);
+                                return false;
+                            }
+                            sid = cloned;
+                            return true;
+                        }
                         auto parsed = reparse_single_stmt_(ctx, std::move(ex.tokens), mc.span);
                         if (!parsed.has_value()) {
                             add_diag_(ctx.diags, diag::Code::kMacroReparseFail, mc.span, macro_name);
                             return false;
                         }
                         sid = *parsed;
-                        return expand_stmt(sid, scope_depth, depth + 1);
+                        const uint32_t steps_before = ctx.steps;
+                        if (!expand_stmt(sid, scope_depth, depth + 1)) return false;
+                        record_parsed_expansion_(
+                            ctx, ex, ast::k_invalid_expr, sid, scope_depth, depth, ctx.steps - steps_before);
+                        return true;
                     }
                 }
 
@@ -964,23 +1436,30 @@ namespace parus::macro {
         return out;
     }
 
+    bool expand_program(MacroExpansionContext& ctx, ast::StmtId root) {
+        ExpandWalk walk{ctx};
+        auto rid = root;
+        if (!walk.expand_stmt(rid, 0, 0)) return false;
+        for (ast::TypeNodeId i = 0; i < ctx.ast.type_nodes().size(); ++i) {
+            auto nid = i;
+            if (!walk.expand_type_node(nid, 0, 0)) return false;
+        }
+        return true;
+    }
+
     bool expand_program(
         ast::AstArena& ast,
         ty::TypePool& types,
         ast::StmtId root,
         diag::Bag& diags,
-        ExpansionBudget budget
+        ExpansionBudget budget,
+        ExpansionStats* out_stats
     ) {
         (void)clamp_budget(budget);
         MacroExpansionContext ctx{ast, types, diags, budget};
-        ExpandWalk walk{ctx};
-        auto rid = root;
-        if (!walk.expand_stmt(rid, 0, 0)) return false;
-        for (ast::TypeNodeId i = 0; i < ast.type_nodes().size(); ++i) {
-            auto nid = i;
-            if (!walk.expand_type_node(nid, 0, 0)) return false;
-        }
-        return true;
+        const bool ok = expand_program(ctx, root);
+        if (out_stats != nullptr) *out_stats = ctx.stats;
+        return ok;
     }
 
 } // namespace parus::macro
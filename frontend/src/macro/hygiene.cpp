@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -12,6 +13,8 @@ namespace parus::macro {
     namespace {
         using K = syntax::TokenKind;
 
+        constexpr std::string_view k_hygiene_gensym_prefix_ = "__pm_g";
+
         static bool is_generated_ident_(
             const std::vector<Token>& tokens,
             const std::vector<uint8_t>& generated_mask,
@@ -63,13 +66,7 @@ namespace parus::macro {
             if (name == "self") return;
             if (renames.find(name) != renames.end()) return;
 
-            const uint64_t serial = ++seq;
-            uint64_t id = seed;
-            id ^= mix64_(serial);
-            id ^= mix64_(static_cast<uint64_t>(binder_index));
-            id ^= mix64_(hash_name_(name));
-            const auto gensym = ast.add_owned_string("__pm_g" + std::to_string(id));
-            renames.emplace(name, gensym);
+            renames.emplace(name, make_hygiene_gensym(ast, name, binder_index, seed, seq));
         }
 
         static void collect_let_set_binders_(
@@ -268,6 +265,30 @@ namespace parus::macro {
         }
     } // namespace
 
+    uint64_t mix_hygiene_seed(const ast::AstArena& ast, uint64_t seed) {
+        seed ^= mix64_(static_cast<uint64_t>(ast.exprs().size()));
+        seed ^= mix64_(static_cast<uint64_t>(ast.stmts().size()));
+        return seed;
+    }
+
+    std::string_view make_hygiene_gensym(
+        ast::AstArena& ast,
+        std::string_view name,
+        size_t binder_index,
+        uint64_t seed,
+        uint64_t& serial
+    ) {
+        uint64_t id = seed;
+        id ^= mix64_(++serial);
+        id ^= mix64_(static_cast<uint64_t>(binder_index));
+        id ^= mix64_(hash_name_(name));
+        return ast.add_owned_string(std::string(k_hygiene_gensym_prefix_) + std::to_string(id));
+    }
+
+    bool is_hygiene_gensym(std::string_view name) {
+        return name.starts_with(k_hygiene_gensym_prefix_);
+    }
+
     void apply_binder_hygiene(
         ast::AstArena& ast,
         std::vector<Token>& tokens,
@@ -281,8 +302,7 @@ namespace parus::macro {
         if (seed == 0) {
             seed = derive_default_seed_(tokens);
         }
-        seed ^= mix64_(static_cast<uint64_t>(ast.exprs().size()));
-        seed ^= mix64_(static_cast<uint64_t>(ast.stmts().size()));
+        seed = mix_hygiene_seed(ast, seed);
 
         uint64_t seq = 0;
         std::vector<uint8_t> no_rename_mask(tokens.size(), 0);
@@ -1104,8 +1104,80 @@ namespace parus::macro {
             std::vector<uint8_t> generated_mask_{};
         };
 
+        /// literal 비교(token_literal_eq_)와 같은 기준의 첫 토큰 key.
+        static std::string dispatch_key_(const Token& t) {
+            std::string key(1, static_cast<char>(t.kind));
+            switch (t.kind) {
+                case K::kIdent:
+                case K::kHole:
+                case K::kIntLit:
+                case K::kFloatLit:
+                case K::kStringLit:
+                case K::kCharLit:
+                    key.append(t.lexeme);
+                    break;
+                default:
+                    break;
+            }
+            return key;
+        }
+
     } // namespace
 
+    TokenArmDispatch build_token_arm_dispatch(
+        const ast::AstArena& ast,
+        uint32_t arm_begin,
+        uint32_t arm_count
+    ) {
+        TokenArmDispatch out{};
+        const auto& arms = ast.macro_arms();
+        std::vector<std::optional<std::string>> first_keys{};
+        first_keys.reserve(arm_count);
+        for (uint32_t i = 0; i < arm_count && arm_begin + i < arms.size(); ++i) {
+            const auto& arm = arms[arm_begin + i];
+            // 패턴 오류는 매칭 시점에 보고해야 하므로 여기서는 진단을 버리고 항상 후보로 둔다.
+            diag::Bag scratch{};
+            std::vector<TokenPatternNode> pattern{};
+            TokenPatternParser parser(ast.macro_tokens(), arm.pattern_token_begin, arm.pattern_token_count, Span{}, scratch);
+            std::optional<std::string> key{};
+            if (parser.parse(pattern) && !pattern.empty()) {
+                const auto& first = pattern.front();
+                if (first.kind == TokenPatternNodeKind::kLiteral) {
+                    key = dispatch_key_(first.literal);
+                } else if (first.kind == TokenPatternNodeKind::kGroup) {
+                    Token open{};
+                    open.kind = first.group_open;
+                    key = dispatch_key_(open);
+                }
+            }
+            if (key.has_value()) out.by_first.try_emplace(*key);
+            first_keys.push_back(std::move(key));
+        }
+
+        for (uint32_t i = 0; i < first_keys.size(); ++i) {
+            const uint32_t ai = arm_begin + i;
+            if (!first_keys[i].has_value()) {
+                out.any_first.push_back(ai);
+                for (auto& [key, cands] : out.by_first) cands.push_back(ai);
+                continue;
+            }
+            out.by_first[*first_keys[i]].push_back(ai);
+        }
+        return out;
+    }
+
+    const std::vector<uint32_t>& token_arm_candidates(
+        const TokenArmDispatch& dispatch,
+        const ast::AstArena& ast,
+        uint32_t arg_begin,
+        uint32_t arg_count
+    ) {
+        const auto& toks = ast.macro_tokens();
+        if (arg_count == 0 || arg_begin >= toks.size()) return dispatch.any_first;
+        const auto it = dispatch.by_first.find(dispatch_key_(toks[arg_begin]));
+        return (it == dispatch.by_first.end()) ? dispatch.any_first : it->second;
+    }
+
     TokenArmMatchStatus match_token_arm(
         ast::AstArena& ast,
         ty::TypePool& types,
@@ -0,0 +1,203 @@
+#include <parus/macro/Prelude.hpp>
+
+#include <parus/lex/Lexer.hpp>
+#include <parus/parse/Parser.hpp>
+#include <parus/ty/TypePool.hpp>
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace parus::macro {
+
+    namespace {
+
+        Span rebase_span_(Span s, uint32_t file_id) {
+            s.file_id = file_id;
+            return s;
+        }
+
+        void append_token_range_(
+            const ast::AstArena& src,
+            ast::AstArena& dst,
+            uint32_t file_id,
+            uint32_t in_begin,
+            uint32_t in_count,
+            uint32_t& out_begin,
+            uint32_t& out_count
+        ) {
+            out_begin = static_cast<uint32_t>(dst.macro_tokens().size());
+            out_count = 0;
+
+            const auto& toks = src.macro_tokens();
+            const uint64_t begin = in_begin;
+            const uint64_t end = begin + in_count;
+            if (begin > toks.size() || end > toks.size()) return;
+            for (uint32_t i = 0; i < in_count; ++i) {
+                Token t = toks[in_begin + i];
+                t.span = rebase_span_(t.span, file_id);
+                (void)dst.add_macro_token(t);
+                ++out_count;
+            }
+        }
+
+    } // namespace
+
+    uint64_t macro_prelude_hash(std::string_view text) {
+        uint64_t h = 1469598103934665603ull;
+        for (const char c : text) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    std::shared_ptr<const MacroPrelude> parse_macro_prelude(
+        std::string path,
+        std::string text,
+        uint32_t file_id,
+        diag::Bag& diags,
+        std::string& out_err
+    ) {
+        out_err.clear();
+        auto out = std::make_shared<MacroPrelude>();
+        out->path = std::move(path);
+        out->content_hash = macro_prelude_hash(text);
+        out->text = std::move(text);
+
+        // 토큰 lexeme은 out->text를 가리키므로 text를 옮긴 뒤에 lex 한다.
+        diag::Bag lex_bag{};
+        Lexer lexer(out->text, file_id, &lex_bag);
+        const auto tokens = lexer.lex_all();
+        if (lex_bag.has_error()) {
+            for (const auto& d : lex_bag.diags()) diags.add(d);
+            out_err = "failed to lex core macro prelude: " + out->path;
+            return nullptr;
+        }
+
+        ty::TypePool types{};
+        diag::Bag parse_bag{};
+        ParserFeatureFlags flags{};
+        Parser p(tokens, out->ast, types, &parse_bag, 128, flags);
+        (void)p.parse_program();
+        if (parse_bag.has_error()) {
+            for (const auto& d : parse_bag.diags()) diags.add(d);
+            out_err = "failed to parse core macro prelude: " + out->path;
+            return nullptr;
+        }
+        return out;
+    }
+
+    std::shared_ptr<const MacroPrelude> shared_macro_prelude(
+        const std::string& path,
+        std::string text,
+        uint32_t file_id,
+        diag::Bag& diags,
+        std::string& out_err,
+        bool* out_cache_hit
+    ) {
+        static std::mutex mu{};
+        static std::unordered_map<std::string, std::shared_ptr<const MacroPrelude>> cache{};
+
+        out_err.clear();
+        if (out_cache_hit != nullptr) *out_cache_hit = false;
+        const uint64_t hash = macro_prelude_hash(text);
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            const auto it = cache.find(path);
+            if (it != cache.end() && it->second->content_hash == hash && it->second->text == text) {
+                if (out_cache_hit != nullptr) *out_cache_hit = true;
+                return it->second;
+            }
+        }
+
+        auto parsed = parse_macro_prelude(path, std::move(text), file_id, diags, out_err);
+        if (parsed == nullptr) return nullptr;
+
+        std::lock_guard<std::mutex> lock(mu);
+        cache[path] = parsed;
+        return parsed;
+    }
+
+    void append_macro_prelude(
+        const std::shared_ptr<const MacroPrelude>& prelude,
+        ast::AstArena& dst,
+        uint32_t file_id
+    ) {
+        if (prelude == nullptr) return;
+        const auto& src = prelude->ast;
+        const auto& src_groups = src.macro_groups();
+        const auto& src_arms = src.macro_arms();
+        const auto& src_caps = src.macro_captures();
+
+        dst.retain(prelude);
+        for (const auto& d : src.macro_decls()) {
+            if (d.scope_depth != 0) continue; // top-level only
+            if (!d.is_export) continue;       // external prelude only exports public macros
+
+            ast::MacroDecl nd{};
+            nd.name = d.name;
+            nd.scope_depth = 0;
+            nd.is_export = true;
+            nd.span = rebase_span_(d.span, file_id);
+            nd.group_begin = static_cast<uint32_t>(dst.macro_groups().size());
+            nd.group_count = 0;
+
+            const uint64_t g_begin = d.group_begin;
+            const uint64_t g_end = g_begin + d.group_count;
+            if (g_begin > src_groups.size() || g_end > src_groups.size()) continue;
+
+            for (uint32_t gi = 0; gi < d.group_count; ++gi) {
+                const auto& g = src_groups[d.group_begin + gi];
+                ast::MacroGroup ng{};
+                ng.match_kind = g.match_kind;
+                ng.span = rebase_span_(g.span, file_id);
+                ng.arm_begin = static_cast<uint32_t>(dst.macro_arms().size());
+                ng.arm_count = 0;
+
+                const uint64_t a_begin = g.arm_begin;
+                const uint64_t a_end = a_begin + g.arm_count;
+                if (a_begin > src_arms.size() || a_end > src_arms.size()) continue;
+
+                for (uint32_t ai = 0; ai < g.arm_count; ++ai) {
+                    const auto& a = src_arms[g.arm_begin + ai];
+                    ast::MacroArm na{};
+                    na.out_kind = a.out_kind;
+                    na.span = rebase_span_(a.span, file_id);
+                    na.capture_begin = static_cast<uint32_t>(dst.macro_captures().size());
+                    na.capture_count = 0;
+
+                    const uint64_t c_begin = a.capture_begin;
+                    const uint64_t c_end = c_begin + a.capture_count;
+                    if (c_begin <= src_caps.size() && c_end <= src_caps.size()) {
+                        for (uint32_t ci = 0; ci < a.capture_count; ++ci) {
+                            auto cap = src_caps[a.capture_begin + ci];
+                            cap.span = rebase_span_(cap.span, file_id);
+                            (void)dst.add_macro_capture(cap);
+                            ++na.capture_count;
+                        }
+                    }
+
+                    append_token_range_(
+                        src, dst, file_id, a.pattern_token_begin, a.pattern_token_count,
+                        na.pattern_token_begin, na.pattern_token_count
+                    );
+                    append_token_range_(
+                        src, dst, file_id, a.template_token_begin, a.template_token_count,
+                        na.template_token_begin, na.template_token_count
+                    );
+
+                    (void)dst.add_macro_arm(na);
+                    ++ng.arm_count;
+                }
+
+                (void)dst.add_macro_group(ng);
+                ++nd.group_count;
+            }
+
+            (void)dst.add_macro_decl(nd);
+        }
+    }
+
+} // namespace parus::macro
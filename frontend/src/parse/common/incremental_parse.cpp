@@ -196,6 +196,11 @@ namespace parus::parse {
             return i;
         }
 
+        // 살아있는 앞쪽 item이 가리키는 이전 source는 계속 붙잡아 둔다. 보관량이 최신 source의
+        // 이 배수 + floor를 넘으면 전체 재파싱으로 최신 하나로 줄인다.
+        static constexpr size_t kRetainedSourceFactor = 8;
+        static constexpr size_t kRetainedSourceFloorBytes = 1u << 20;
+
         void append_unique_owner_(std::vector<std::shared_ptr<std::string>>& out,
                                   const std::shared_ptr<std::string>& owner) {
             if (!owner) return;
@@ -205,6 +210,98 @@ namespace parus::parse {
             out.push_back(owner);
         }
 
+        // lexer가 토큰 끝 너머로 들여다보는 최대 거리(R""" 판별의 peek(3))보다 넉넉하게 잡는다.
+        static constexpr uint32_t kRelexLookahead = 4;
+
+        /// @brief 이전 토큰 스트림을 재사용해 new_source를 토큰화한다.
+        ///
+        /// 편집 구간은 이전/새 source의 공통 prefix/suffix로 구한다. 편집 지점을 들여다봤을 수 있는
+        /// 토큰부터 다시 읽고, 편집 구간 뒤에서 이전 토큰과 (이동량만큼 밀린) 위치/종류가 같은 토큰이
+        /// 나오면 나머지는 이전 토큰을 밀어서 붙인다. lexer는 토큰 사이에 상태가 없으므로 결과는
+        /// lex_all()과 같다. 이전 source는 old_tokens가 가리키는 버퍼다. 재사용할 수 없으면 false.
+        bool relex_incremental_(const TokenStream& old_tokens,
+                                std::string_view new_source,
+                                uint32_t file_id,
+                                std::vector<Token>& out,
+                                RelexStats& stats) {
+            // 이전 스트림이 EOF뿐이면(빈 입력 또는 UTF-8 오류) 재사용할 것이 없다.
+            const auto& old = old_tokens.compact();
+            const std::string_view old_source = old_tokens.source();
+            if (old.size() < 2 || old.back().kind != syntax::TokenKind::kEof) return false;
+            if (old.back().lo + old.back().len != old_source.size()) return false;
+            if (new_source.size() > std::numeric_limits<uint32_t>::max() / 2) return false;
+
+            const size_t common = std::min(old_source.size(), new_source.size());
+            const size_t prefix = static_cast<size_t>(
+                std::mismatch(old_source.begin(), old_source.begin() + common, new_source.begin()).first
+                - old_source.begin());
+            size_t suffix = 0;
+            while (suffix < common - prefix &&
+                   old_source[old_source.size() - 1 - suffix] == new_source[new_source.size() - 1 - suffix]) {
+                ++suffix;
+            }
+            const int64_t delta = static_cast<int64_t>(new_source.size()) - static_cast<int64_t>(old_source.size());
+            const uint32_t new_changed_hi = static_cast<uint32_t>(new_source.size() - suffix);
+
+            // 토큰 끝 + lookahead가 편집 시작에 닿지 않는 토큰까지만 그대로 둔다.
+            size_t restart = 0;
+            while (restart + 1 < old.size() &&
+                   static_cast<size_t>(old[restart].lo + old[restart].len) + kRelexLookahead < prefix) {
+                ++restart;
+            }
+            const uint32_t restart_pos = (restart == 0) ? 0u : old[restart - 1].lo + old[restart - 1].len;
+
+            Lexer lx(new_source, file_id);
+            if (!lx.seek(restart_pos, new_changed_hi + kRelexLookahead)) return false;
+
+            out.clear();
+            out.reserve(old.size() + 16);
+            auto rebuilt = [&](const CompactToken& c, uint32_t lo) {
+                Token t{};
+                t.kind = c.kind;
+                t.span = Span{file_id, lo, lo + c.len};
+                t.lexeme = new_source.substr(lo, c.len);
+                return t;
+            };
+            for (size_t i = 0; i < restart; ++i) {
+                out.push_back(rebuilt(old[i], old[i].lo));
+            }
+
+            size_t old_i = restart;
+            while (true) {
+                const Token t = lx.next_token();
+                ++stats.relexed_tokens;
+                if (t.kind == syntax::TokenKind::kEof) {
+                    out.push_back(t);
+                    break;
+                }
+
+                if (t.span.lo >= new_changed_hi) {
+                    const int64_t old_lo = static_cast<int64_t>(t.span.lo) - delta;
+                    while (old_i < old.size() && static_cast<int64_t>(old[old_i].lo) < old_lo) {
+                        ++old_i;
+                    }
+                    if (old_i < old.size()) {
+                        const auto& o = old[old_i];
+                        if (o.kind == t.kind && static_cast<int64_t>(o.lo) == old_lo &&
+                            static_cast<int64_t>(o.lo + o.len) + delta == t.span.hi) {
+                            --stats.relexed_tokens;
+                            for (size_t j = old_i; j < old.size(); ++j) {
+                                out.push_back(rebuilt(old[j], static_cast<uint32_t>(old[j].lo + delta)));
+                            }
+                            stats.reused_tokens =
+                                static_cast<uint32_t>(restart + (old.size() - old_i));
+                            break;
+                        }
+                    }
+                }
+                out.push_back(t);
+            }
+            if (stats.reused_tokens == 0) stats.reused_tokens = static_cast<uint32_t>(restart);
+            stats.incremental = true;
+            return true;
+        }
+
         bool validate_merged_children_(const ast::AstArena& ast, const std::vector<ast::StmtId>& children) {
             uint32_t prev_lo = 0;
             bool first = true;
@@ -251,23 +348,26 @@ namespace parus::parse {
                                                  ReparseMode mode) {
         auto source_owner = std::make_shared<std::string>(source);
 
-        Lexer lx(*source_owner, file_id, &bag);
-        auto toks = lx.lex_all();
+        // 전체 재파싱이어도 이전 스냅샷이 있으면 토큰은 이전 스트림을 재사용한다.
+        auto toks = lex_(*source_owner, file_id, bag, /*allow_incremental=*/true);
 
         ast::AstArena arena{};
         ty::TypePool types{};
         Parser parser(toks, arena, types, &bag, /*max_errors=*/256, feature_flags_);
-        const auto root = parser.parse_program();
+        std::vector<TopItemMark> item_marks{};
+        const auto root = parser.parse_program(&item_marks);
 
         ParseSnapshot next{};
         next.ast = std::move(arena);
         next.types = std::move(types);
         next.root = root;
-        next.tokens = std::move(toks);
+        next.tokens = TokenStream(*source_owner, file_id, toks);
         next.top_items = collect_top_items_(next.ast, next.root);
         next.revision = ++revision_seq_;
 
         snapshot_ = std::move(next);
+        item_marks_ = std::move(item_marks);
+        item_owners_.assign(snapshot_.top_items.size(), source_owner);
         source_owners_.clear();
         source_owners_.push_back(std::move(source_owner));
 
@@ -276,6 +376,24 @@ namespace parus::parse {
         return true;
     }
 
+    std::vector<Token> IncrementalParserSession::lex_(std::string_view source,
+                                                      uint32_t file_id,
+                                                      diag::Bag& bag,
+                                                      bool allow_incremental) {
+        last_relex_ = RelexStats{};
+        std::vector<Token> toks{};
+        if (allow_incremental && ready_ &&
+            relex_incremental_(snapshot_.tokens, source, file_id, toks, last_relex_)) {
+            return toks;
+        }
+
+        last_relex_ = RelexStats{};
+        Lexer lx(source, file_id, &bag);
+        toks = lx.lex_all();
+        last_relex_.relexed_tokens = static_cast<uint32_t>(toks.size());
+        return toks;
+    }
+
     bool IncrementalParserSession::try_incremental_merge_(std::string_view source,
                                                           uint32_t file_id,
                                                           std::span<const EditWindow> edits,
@@ -293,9 +411,14 @@ namespace parus::parse {
             incremental_merge_trace_("reject", "invalid-root");
             return false;
         }
-        if (source_owners_.size() > 16) {
-            incremental_merge_trace_("reject", "too-many-source-owners");
-            return false; // old source retention compact trigger
+        if (retained_source_bytes() + source.size()
+            > kRetainedSourceFactor * source.size() + kRetainedSourceFloorBytes) {
+            incremental_merge_trace_("reject", "retained-source-budget");
+            return false; // garbage가 붙잡은 이전 source 해제
+        }
+        if (item_owners_.size() != snapshot_.top_items.size()) {
+            incremental_merge_trace_("reject", "item-owner-shape-mismatch");
+            return false;
         }
 
         const auto earliest_lo = earliest_edit_lo_(edits);
@@ -321,8 +444,7 @@ namespace parus::parse {
         auto source_owner = std::make_shared<std::string>(source);
 
         diag::Bag local_bag;
-        Lexer lx(*source_owner, file_id, &local_bag);
-        auto new_tokens = lx.lex_all();
+        auto new_tokens = lex_(*source_owner, file_id, local_bag, /*allow_incremental=*/true);
         if (local_bag.has_fatal()) {
             incremental_merge_trace_("reject", "lex-fatal");
             return false;
@@ -349,50 +471,56 @@ namespace parus::parse {
             return false;
         }
 
-        ast::AstArena arena = snapshot_.ast;
-        ty::TypePool types = snapshot_.types;
-
-        Parser partial_parser(partial_tokens, arena, types, &local_bag, /*max_errors=*/256, feature_flags_);
-        const auto partial_root = partial_parser.parse_program();
-        if (partial_root == ast::k_invalid_stmt) {
-            incremental_merge_trace_("reject", "partial-root-invalid");
+        if (item_marks_.size() != old_items.size()) {
+            incremental_merge_trace_("reject", "item-mark-shape-mismatch");
             return false;
         }
-
-        const auto& old_root = arena.stmt(snapshot_.root);
-        if (old_root.kind != ast::StmtKind::kBlock) {
+        if (snapshot_.ast.stmt(snapshot_.root).kind != ast::StmtKind::kBlock) {
             incremental_merge_trace_("reject", "old-root-not-block");
             return false;
         }
 
+        // 이전 스냅샷을 복사하지 않고 그 arena/type pool을 그대로 이어 쓴다. top item은 파싱 순서대로
+        // 덧붙었으므로 첫 영향 item의 시작 mark 뒤에는 그 item부터의 노드와 이전 root뿐이다. 거기서
+        // 잘라 내고 partial parse를 덧붙이면 앞쪽 item은 기존 노드 id를 공유하고 garbage는 남지 않는다.
+        // 잘라 낸 뒤의 거절은 호출자가 곧바로 full rebuild로 스냅샷 전체를 교체한다.
+        auto& arena = snapshot_.ast;
+        auto& types = snapshot_.types;
+        arena.truncate(item_marks_[first].ast);
+        types.truncate(item_marks_[first].types);
+        auto reject = [&](const char* reason) {
+            incremental_merge_trace_("reject", reason);
+            return false;
+        };
+
+        std::vector<TopItemMark> partial_marks{};
+        Parser partial_parser(partial_tokens, arena, types, &local_bag, /*max_errors=*/256, feature_flags_);
+        const auto partial_root = partial_parser.parse_program(&partial_marks);
+        if (partial_root == ast::k_invalid_stmt) {
+            return reject("partial-root-invalid");
+        }
+
         const auto& partial_root_stmt = arena.stmt(partial_root);
         if (partial_root_stmt.kind != ast::StmtKind::kBlock) {
-            incremental_merge_trace_("reject", "partial-root-not-block");
-            return false;
+            return reject("partial-root-not-block");
         }
 
         const auto& children = arena.stmt_children();
-        if (old_root.stmt_begin > children.size() || old_root.stmt_begin + old_root.stmt_count > children.size()) {
-            incremental_merge_trace_("reject", "old-root-child-range-invalid");
-            return false;
-        }
         if (partial_root_stmt.stmt_begin > children.size()
             || partial_root_stmt.stmt_begin + partial_root_stmt.stmt_count > children.size()) {
-            incremental_merge_trace_("reject", "partial-root-child-range-invalid");
-            return false;
+            return reject("partial-root-child-range-invalid");
         }
 
         std::vector<ast::StmtId> merged_children{};
         merged_children.reserve(static_cast<size_t>(first) + partial_root_stmt.stmt_count);
         for (size_t i = 0; i < first; ++i) {
-            merged_children.push_back(children[old_root.stmt_begin + static_cast<uint32_t>(i)]);
+            merged_children.push_back(old_items[i].sid);
         }
         for (uint32_t i = 0; i < partial_root_stmt.stmt_count; ++i) {
             merged_children.push_back(children[partial_root_stmt.stmt_begin + i]);
         }
         if (!validate_merged_children_(arena, merged_children)) {
-            incremental_merge_trace_("reject", "merged-children-invalid");
-            return false;
+            return reject("merged-children-invalid");
         }
 
         uint32_t merged_begin = static_cast<uint32_t>(arena.stmt_children().size());
@@ -413,26 +541,27 @@ namespace parus::parse {
         }
 
         const auto new_root = arena.add_stmt(merged_root);
-
-        ParseSnapshot next{};
-        next.ast = std::move(arena);
-        next.types = std::move(types);
-        next.root = new_root;
-        next.tokens = std::move(new_tokens);
-        next.top_items = collect_top_items_(next.ast, next.root);
-        next.revision = ++revision_seq_;
-        if (next.root == ast::k_invalid_stmt || next.top_items.size() != merged_children.size()) {
-            incremental_merge_trace_("reject", "next-snapshot-shape-invalid");
-            return false;
+        auto next_items = collect_top_items_(arena, new_root);
+        if (new_root == ast::k_invalid_stmt || next_items.size() != merged_children.size()) {
+            return reject("next-snapshot-shape-invalid");
         }
 
-        snapshot_ = std::move(next);
+        snapshot_.root = new_root;
+        snapshot_.tokens = TokenStream(*source_owner, file_id, new_tokens);
+        snapshot_.top_items = std::move(next_items);
+        snapshot_.revision = ++revision_seq_;
 
-        std::vector<std::shared_ptr<std::string>> next_owners{};
-        next_owners.reserve(source_owners_.size() + 1);
-        for (const auto& old_owner : source_owners_) append_unique_owner_(next_owners, old_owner);
-        append_unique_owner_(next_owners, source_owner);
-        source_owners_ = std::move(next_owners);
+        // 앞쪽 item은 자신을 파싱한 source를 계속 참조하고, 나머지는 새 source를 참조한다.
+        item_owners_.resize(first);
+        item_owners_.resize(snapshot_.top_items.size(), source_owner);
+        item_marks_.resize(first);
+        item_marks_.insert(item_marks_.end(), partial_marks.begin(), partial_marks.end());
+
+        // arena에는 살아있는 item 노드만 남으므로 그 item들의 source만 붙잡으면 된다.
+        source_owners_.clear();
+        for (const auto& owner : item_owners_) append_unique_owner_(source_owners_, owner);
+        std::erase(source_owners_, source_owner);
+        source_owners_.push_back(source_owner); // 최신 source는 항상 마지막(relex/구조 판정 기준)
 
         append_diag_bag_(bag, local_bag);
         ready_ = true;
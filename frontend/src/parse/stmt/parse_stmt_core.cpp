@@ -37,7 +37,7 @@ namespace parus {
         return parse_stmt_any();
     }
 
-    ast::StmtId Parser::parse_program() {
+    ast::StmtId Parser::parse_program(std::vector<TopItemMark>* item_marks) {
         // NOTE: 전역 stmt_children_에 즉시 push하지 말고,
         //       top-level stmt들을 로컬에 모았다가 마지막에 한 번에 커밋
         std::vector<ast::StmtId> top;
@@ -54,6 +54,9 @@ namespace parus {
         core_impl_file_mode_ = false;
         seen_core_impl_marker_ = false;
 
+        // 실패한 파싱이 남긴 노드는 다음 item 구간에 포함된다.
+        TopItemMark item_mark{};
+        if (item_marks != nullptr) item_mark = TopItemMark{ast_.mark(), types_.mark()};
         while (!cursor_.at(syntax::TokenKind::kEof)) {
             if (aborted_) break;
 
@@ -63,6 +66,10 @@ namespace parus {
                 top.push_back(s);
                 last = ast_.stmt(s).span;
                 ++top_level_stmt_count_;
+                if (item_marks != nullptr) {
+                    item_marks->push_back(item_mark);
+                    item_mark = TopItemMark{ast_.mark(), types_.mark()};
+                }
             }
 
             if (aborted_) break;
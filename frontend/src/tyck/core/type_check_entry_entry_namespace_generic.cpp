@@ -28,6 +28,75 @@ namespace parus::tyck {
             return seed;
         }
 
+        /// @brief raw 안에 subst 키가 식별자 경계로 나오는지. 아니면 치환이 text를 바꿀 수 없다.
+        bool text_mentions_generic_param_(
+            std::string_view raw,
+            const std::unordered_map<std::string, ty::TypeId>& subst
+        ) {
+            const auto is_ident_char = [](char ch) {
+                return std::isalnum(static_cast<unsigned char>(ch)) != 0 || ch == '_';
+            };
+            for (const auto& [key, _] : subst) {
+                if (key.empty()) continue;
+                for (size_t pos = raw.find(key); pos != std::string_view::npos; pos = raw.find(key, pos + 1)) {
+                    const size_t end = pos + key.size();
+                    const bool left_ok = (pos == 0) || !is_ident_char(raw[pos - 1]);
+                    const bool right_ok = (end == raw.size()) || !is_ident_char(raw[end]);
+                    if (left_ok && right_ok) return true;
+                }
+            }
+            return false;
+        }
+
+        /// @brief 인스턴스마다 같은 tyck 결과를 내는 expr인지.
+        ///
+        /// 자기 타입이 정해진 리터럴(접미사 있는 정수, 실수, bool, char)과 그 위의 builtin 단항/이항 연산만 본다.
+        /// 이름, 타입 노드, 접미사 없는 정수(기대 타입으로 정해짐)를 품으면 치환에 따라 결과가 갈릴 수 있다.
+        bool expr_is_substitution_invariant_(const ast::AstArena& ast, ast::ExprId eid) {
+            if (eid == ast::k_invalid_expr || (size_t)eid >= ast.exprs().size()) return false;
+            const ast::Expr& e = ast.expr(eid);
+            switch (e.kind) {
+                case ast::ExprKind::kIntLit:
+                    return parse_int_literal_(e.text).has_suffix;
+                case ast::ExprKind::kFloatLit:
+                case ast::ExprKind::kBoolLit:
+                case ast::ExprKind::kCharLit:
+                    return true;
+                case ast::ExprKind::kUnary:
+                    switch (e.op) {
+                        case K::kPlus:
+                        case K::kMinus:
+                        case K::kBang:
+                        case K::kKwNot:
+                            return expr_is_substitution_invariant_(ast, e.a);
+                        default:
+                            return false;
+                    }
+                case ast::ExprKind::kBinary:
+                    switch (e.op) {
+                        case K::kPlus:
+                        case K::kMinus:
+                        case K::kStar:
+                        case K::kSlash:
+                        case K::kPercent:
+                        case K::kEqEq:
+                        case K::kBangEq:
+                        case K::kLt:
+                        case K::kLtEq:
+                        case K::kGt:
+                        case K::kGtEq:
+                        case K::kKwAnd:
+                        case K::kKwOr:
+                            return expr_is_substitution_invariant_(ast, e.a) &&
+                                   expr_is_substitution_invariant_(ast, e.b);
+                        default:
+                            return false;
+                    }
+                default:
+                    return false;
+            }
+        }
+
         std::string visible_external_fn_name_(std::string_view name) {
             constexpr std::string_view marker = "@@extovl$";
             const size_t pos = name.find(marker);
@@ -35,22 +104,6 @@ namespace parus::tyck {
             return std::string(name.substr(0, pos));
         }
 
-        struct ExternalGenericConstraintMeta {
-            enum class Kind : uint8_t {
-                kProto = 0,
-                kTypeEq,
-            };
-            Kind kind = Kind::kProto;
-            std::string lhs{};
-            std::string rhs{};
-        };
-
-        struct ExternalGenericDeclMeta {
-            std::vector<std::string> params{};
-            std::vector<ExternalGenericConstraintMeta> constraints{};
-            std::vector<std::pair<std::string, std::string>> impl_protos{};
-        };
-
         std::string payload_unescape_value_(std::string_view raw) {
             auto hex_value = [](char ch) -> int {
                 if (ch >= '0' && ch <= '9') return ch - '0';
@@ -76,47 +129,6 @@ namespace parus::tyck {
             return out;
         }
 
-        ExternalGenericDeclMeta parse_external_generic_decl_meta_(std::string_view payload) {
-            ExternalGenericDeclMeta out{};
-            size_t pos = 0;
-            while (pos < payload.size()) {
-                size_t next = payload.find('|', pos);
-                if (next == std::string_view::npos) next = payload.size();
-                const std::string_view part = payload.substr(pos, next - pos);
-                if (part.starts_with("gparam=")) {
-                    out.params.push_back(payload_unescape_value_(part.substr(std::string_view("gparam=").size())));
-                } else if (part.starts_with("gconstraint=")) {
-                    const std::string_view body = part.substr(std::string_view("gconstraint=").size());
-                    const size_t comma1 = body.find(',');
-                    const size_t comma2 =
-                        (comma1 == std::string_view::npos) ? std::string_view::npos : body.find(',', comma1 + 1);
-                    if (comma1 != std::string_view::npos && comma2 != std::string_view::npos) {
-                        ExternalGenericConstraintMeta cc{};
-                        const std::string_view kind = body.substr(0, comma1);
-                        cc.kind = (kind == "type_eq")
-                            ? ExternalGenericConstraintMeta::Kind::kTypeEq
-                            : ExternalGenericConstraintMeta::Kind::kProto;
-                        cc.lhs = payload_unescape_value_(body.substr(comma1 + 1, comma2 - comma1 - 1));
-                        cc.rhs = payload_unescape_value_(body.substr(comma2 + 1));
-                        out.constraints.push_back(std::move(cc));
-                    }
-                } else if (part.starts_with("impl_proto=")) {
-                    const std::string body = payload_unescape_value_(
-                        part.substr(std::string_view("impl_proto=").size())
-                    );
-                    const size_t split = body.find('@');
-                    if (split == std::string::npos) {
-                        out.impl_protos.emplace_back(body, std::string{});
-                    } else {
-                        out.impl_protos.emplace_back(body.substr(0, split), body.substr(split + 1));
-                    }
-                }
-                if (next == payload.size()) break;
-                pos = next + 1;
-            }
-            return out;
-        }
-
         std::string build_acts_template_identity_(
             const parus::ast::AstArena& ast,
             const parus::ty::TypePool& types,
@@ -261,6 +273,8 @@ namespace parus::tyck {
         imported_hidden_enum_instance_sid_set_.clear();
         seen_mono_requests_.clear();
         public_proto_target_symbol_cache_.clear();
+        external_payload_records_.clear();
+        symbol_scan_index_ = SymbolScanIndex{};
         imported_proto_sid_by_identity_cache_.clear();
         mono_stats_ = MonoStats{};
         generic_fn_instance_cache_.clear();
@@ -300,6 +314,10 @@ namespace parus::tyck {
         const_symbol_eval_state_.clear();
         const_symbol_runtime_values_.clear();
         const_cycle_diag_emitted_.clear();
+        const_fn_body_checked_.clear();
+        const_fn_programs_.clear();
+        const_call_memo_.clear();
+        const_eval_stats_ = ConstEvalStats{};
         namespace_stack_.clear();
         import_alias_to_path_.clear();
         known_namespace_paths_.clear();
@@ -813,6 +831,7 @@ namespace parus::tyck {
         result_.generic_instantiated_field_sids = generic_instantiated_field_sids_;
         result_.generic_instantiated_enum_sids = generic_instantiated_enum_sids_;
         result_.mono_stats = mono_stats_;
+        result_.const_eval_stats = const_eval_stats_;
         result_.generic_acts_template_sids.assign(
             generic_acts_template_sid_set_.begin(),
             generic_acts_template_sid_set_.end()
@@ -1522,10 +1541,18 @@ namespace parus::tyck {
             return it->second;
         }
 
+        // 치환과 무관한 subtree는 템플릿 노드를 그대로 가리킨다(인스턴스마다 tyck 결과가 같다).
+        if (expr_is_substitution_invariant_(ast_, src)) {
+            ++mono_stats_.instance_shared_expr_count;
+            expr_map[src] = src;
+            return src;
+        }
+
         const ast::Expr old_e = ast_.expr(src);
         ast::Expr e = old_e;
         auto rewrite_generic_text = [&](std::string_view raw) -> std::string_view {
-            if (raw.empty()) return raw;
+            // 지역 이름/리터럴 text를 타입으로 intern하지 않도록 gparam 이름이 보일 때만 해석한다.
+            if (raw.empty() || !text_mentions_generic_param_(raw, subst)) return raw;
             auto rewrite_type_text = [&](std::string_view candidate) -> std::optional<std::string> {
                 const ty::TypeId candidate_t = types_.intern_ident(candidate);
                 if (candidate_t == ty::kInvalidType) return std::nullopt;
@@ -1636,16 +1663,22 @@ namespace parus::tyck {
             const uint64_t begin = old_e.call_type_arg_begin;
             const uint64_t end = begin + old_e.call_type_arg_count;
             if (begin <= targs.size() && end <= targs.size()) {
-                std::vector<ty::TypeId> src_type_args;
-                src_type_args.reserve(old_e.call_type_arg_count);
-                for (uint32_t i = 0; i < old_e.call_type_arg_count; ++i) {
-                    src_type_args.push_back(targs[old_e.call_type_arg_begin + i]);
-                }
-                e.call_type_arg_begin = static_cast<uint32_t>(ast_.type_args().size());
-                e.call_type_arg_count = old_e.call_type_arg_count;
+                std::vector<ty::TypeId> sub_type_args;
+                sub_type_args.reserve(old_e.call_type_arg_count);
+                bool changed = false;
                 for (uint32_t i = 0; i < old_e.call_type_arg_count; ++i) {
-                    const ty::TypeId t = substitute_generic_type_(src_type_args[i], subst);
-                    ast_.add_type_arg(t);
+                    const ty::TypeId src_t = targs[old_e.call_type_arg_begin + i];
+                    const ty::TypeId t = substitute_generic_type_(src_t, subst);
+                    changed = changed || (t != src_t);
+                    sub_type_args.push_back(t);
+                }
+                // type arg 범위는 tyck 중 쓰지 않으므로 치환 결과가 같으면 템플릿 범위를 그대로 쓴다.
+                if (changed) {
+                    e.call_type_arg_begin = static_cast<uint32_t>(ast_.type_args().size());
+                    e.call_type_arg_count = old_e.call_type_arg_count;
+                    for (const ty::TypeId t : sub_type_args) {
+                        ast_.add_type_arg(t);
+                    }
                 }
             } else {
                 e.call_type_arg_begin = 0;
@@ -1656,10 +1689,13 @@ namespace parus::tyck {
         if (old_e.field_init_type_node != ast::k_invalid_type_node &&
             (size_t)old_e.field_init_type_node < ast_.type_nodes().size()) {
             ast::TypeNode tn = ast_.type_node(old_e.field_init_type_node);
-            if (tn.resolved_type != ty::kInvalidType) {
-                tn.resolved_type = substitute_generic_type_(tn.resolved_type, subst);
+            const ty::TypeId sub_t = (tn.resolved_type != ty::kInvalidType)
+                ? substitute_generic_type_(tn.resolved_type, subst)
+                : tn.resolved_type;
+            if (sub_t != tn.resolved_type) {
+                tn.resolved_type = sub_t;
+                e.field_init_type_node = ast_.add_type_node(tn);
             }
-            e.field_init_type_node = ast_.add_type_node(tn);
         }
 
         if (e.cast_type != ty::kInvalidType) {
@@ -1670,6 +1706,7 @@ namespace parus::tyck {
         }
 
         const ast::ExprId dst = ast_.add_expr(e);
+        ++mono_stats_.instance_cloned_expr_count;
         expr_map[src] = dst;
         return dst;
     }
@@ -1799,10 +1836,13 @@ namespace parus::tyck {
                     if (c.enum_type_node != ast::k_invalid_type_node &&
                         static_cast<size_t>(c.enum_type_node) < ast_.type_nodes().size()) {
                         ast::TypeNode tn = ast_.type_node(c.enum_type_node);
-                        if (tn.resolved_type != ty::kInvalidType) {
-                            tn.resolved_type = substitute_generic_type_(tn.resolved_type, subst);
+                        const ty::TypeId sub_t = (tn.resolved_type != ty::kInvalidType)
+                            ? substitute_generic_type_(tn.resolved_type, subst)
+                            : tn.resolved_type;
+                        if (sub_t != tn.resolved_type) {
+                            tn.resolved_type = sub_t;
+                            c.enum_type_node = ast_.add_type_node(tn);
                         }
-                        c.enum_type_node = ast_.add_type_node(tn);
                     }
                     c.body = clone_stmt_with_type_subst_(c.body, subst, expr_map, stmt_map);
                     if (c.enum_bind_count > 0) {
@@ -1985,6 +2025,7 @@ namespace parus::tyck {
         }
 
         const ast::StmtId dst = ast_.add_stmt(s);
+        ++mono_stats_.instance_cloned_stmt_count;
         stmt_map[src] = dst;
         return dst;
     }
@@ -1997,7 +2038,7 @@ namespace parus::tyck {
         if (template_sid == ast::k_invalid_stmt || (size_t)template_sid >= ast_.stmts().size()) {
             return std::nullopt;
         }
-        const ast::Stmt templ = ast_.stmt(template_sid);
+        ast::Stmt templ = ast_.stmt(template_sid);
         const bool imported_template =
             imported_fn_template_sid_set_.find(template_sid) != imported_fn_template_sid_set_.end();
         if (templ.kind != ast::StmtKind::kFnDecl) {
@@ -2035,6 +2076,10 @@ namespace parus::tyck {
             cached.has_value()) {
             return *cached;
         }
+        if (imported_template) {
+            if (!materialize_imported_fn_template_body_(template_sid, call_span)) return std::nullopt;
+            templ.a = ast_.stmt(template_sid).a;
+        }
 
         std::unordered_map<std::string, ty::TypeId> subst;
         subst.reserve(generic_names.size());
@@ -2232,6 +2277,39 @@ namespace parus::tyck {
         return inst_sid;
     }
 
+    bool TypeChecker::materialize_imported_fn_template_body_(ast::StmtId template_sid, Span use_span) {
+        if (ast_.stmt(template_sid).a != ast::k_invalid_stmt) return true;
+        auto it = imported_fn_template_index_by_sid_.find(template_sid);
+        if (it == imported_fn_template_index_by_sid_.end() ||
+            it->second >= explicit_imported_fn_templates_.size()) {
+            return true;
+        }
+        auto& templ_meta = explicit_imported_fn_templates_[it->second];
+        if (!templ_meta.load_body) return true;
+
+        // 로더는 한 번만 부른다. 실패하면 같은 사유를 돌려주는 로더로 바꿔 이후 요청도 같은 진단을 받는다.
+        std::string load_err{};
+        const ast::StmtId body = templ_meta.load_body(load_err);
+        if (body == ast::k_invalid_stmt) {
+            if (load_err.empty()) {
+                load_err = "failed to load template body: " +
+                           (!templ_meta.lookup_name.empty() ? templ_meta.lookup_name : templ_meta.public_path);
+            }
+            templ_meta.load_body = [load_err](std::string& err) {
+                err = load_err;
+                return ast::k_invalid_stmt;
+            };
+            diag_(diag::Code::kTemplateSidecarSchema, use_span, load_err);
+            err_(use_span, load_err);
+            return false;
+        }
+        templ_meta.load_body = nullptr;
+        ast_.stmt_mut(template_sid).a = body;
+        ++mono_stats_.imported_fn_template_materialized_count;
+        ensure_tyck_cache_capacity_for_current_ast_();
+        return true;
+    }
+
     std::optional<MonoInstance> TypeChecker::ensure_monomorphized_free_function_(
         const MonoRequest& request,
         Span use_span
@@ -2350,12 +2428,8 @@ namespace parus::tyck {
             if (leaf.empty()) return std::nullopt;
             std::optional<ast::StmtId> unique{};
             bool ambiguous = false;
-            for (const auto& [name, sid] : proto_decl_by_name_) {
-                const size_t name_sep = name.rfind("::");
-                const std::string_view candidate_leaf =
-                    (name_sep == std::string::npos) ? std::string_view(name)
-                                                    : std::string_view(name).substr(name_sep + 2);
-                if (candidate_leaf != leaf) continue;
+            for (const auto* entry : proto_decl_by_name_.with_leaf(leaf)) {
+                const ast::StmtId sid = entry->second;
                 if (unique.has_value() && *unique != sid) {
                     ambiguous = true;
                     break;
@@ -2940,7 +3014,7 @@ namespace parus::tyck {
                 ? std::string_view(ss.external_field_payload)
                 : std::string_view(ss.external_payload);
         if (ss.is_external && external_field_payload.starts_with("parus_field_decl")) {
-            const auto meta = parse_external_generic_decl_meta_(external_field_payload);
+            const auto meta = decode_external_generic_decl_meta_(external_field_payload);
             if (!meta.params.empty() || !meta.constraints.empty()) {
                 if (args.size() != meta.params.size()) {
                     diag_(diag::Code::kGenericTypePathArityMismatch, use_span,
@@ -3103,7 +3177,7 @@ namespace parus::tyck {
                     pos = next + 1;
                 }
 
-                const auto payload_meta = parse_external_generic_decl_meta_(external_field_payload);
+                const auto payload_meta = decode_external_generic_decl_meta_(external_field_payload);
                 if (!payload_meta.impl_protos.empty()) {
                     auto parse_impl_proto_type = [&](std::string_view repr,
                                                      std::string_view semantic) -> ty::TypeId {
@@ -5235,7 +5309,7 @@ namespace parus::tyck {
         stub.type = ss.declared_type;
         stub.is_export = ss.is_export;
 
-        const auto meta = parse_external_generic_decl_meta_(ss.external_payload);
+        const auto meta = decode_external_generic_decl_meta_(ss.external_payload);
         for (const auto& name : meta.params) {
             ast::GenericParamDecl gp{};
             gp.name = ast_.add_owned_string(name);
@@ -5400,6 +5474,8 @@ namespace parus::tyck {
 
             imported_fn_template_sid_set_.insert(templ.template_sid);
             imported_fn_template_index_by_sid_[templ.template_sid] = idx;
+            ++mono_stats_.imported_fn_template_available_count;
+            if (fn_stmt.a != ast::k_invalid_stmt) ++mono_stats_.imported_fn_template_materialized_count;
             if (!templ.lookup_name.empty()) {
                 imported_fn_template_sid_by_lookup_name_[templ.lookup_name] = templ.template_sid;
                 register_name(templ.lookup_name, templ.template_sid);
@@ -140,11 +140,8 @@
         };
         auto module_head_for_file = [&](uint32_t file_id) -> std::string {
             if (file_id == 0) return {};
-            for (const auto& sym : sym_.symbols()) {
-                if (sym.is_external) continue;
-                if (sym.decl_file_id != file_id) continue;
-                if (!sym.decl_module_head.empty()) return sym.decl_module_head;
-            }
+            const auto& heads = sync_symbol_scan_index_().module_head_by_file;
+            if (auto it = heads.find(file_id); it != heads.end()) return it->second;
             return {};
         };
 
@@ -391,9 +388,11 @@
                     } else if (ins.ok && s.link_abi == ast::LinkAbi::kC) {
                         auto& sym = sym_.symbol_mut(ins.symbol_id);
                         sym.external_payload = make_c_abi_decl_payload(s);
+                        external_payload_records_.erase(ins.symbol_id);
                     } else if (ins.ok && !impl_payload.empty()) {
                         auto& sym = sym_.symbol_mut(ins.symbol_id);
                         sym.external_payload = impl_payload;
+                        external_payload_records_.erase(ins.symbol_id);
                     }
                 }
 
@@ -1732,7 +1731,7 @@
             const std::string repr = (split == std::string::npos) ? repr_and_sem : repr_and_sem.substr(0, split);
             const std::string sem = (split == std::string::npos) ? std::string{} : repr_and_sem.substr(split + 1);
             const ty::TypeId parsed =
-                parus::cimport::parse_external_type_repr(repr, sem, std::string(payload), types_);
+                parus::cimport::parse_external_type_repr(repr, sem, payload, types_);
             if (parsed == ty::kInvalidType) return false;
             out_assoc_name = name;
             out_bound_type = parsed;
@@ -1768,51 +1767,6 @@
         external_acts_template_method_map_.clear();
         external_acts_default_assoc_type_map_.clear();
         external_acts_template_assoc_type_map_.clear();
-        auto parse_external_generic_decl_meta_ = [](std::string_view payload) {
-            struct ExternalGenericDeclMeta {
-                std::vector<std::string> params{};
-            };
-            auto payload_unescape_value_ = [](std::string_view raw) -> std::string {
-                auto hex_value = [](char ch) -> int {
-                    if (ch >= '0' && ch <= '9') return ch - '0';
-                    if (ch >= 'a' && ch <= 'f') return 10 + (ch - 'a');
-                    if (ch >= 'A' && ch <= 'F') return 10 + (ch - 'A');
-                    return -1;
-                };
-
-                std::string out{};
-                out.reserve(raw.size());
-                for (size_t i = 0; i < raw.size(); ++i) {
-                    if (raw[i] == '%' && i + 2 < raw.size()) {
-                        const int hi = hex_value(raw[i + 1]);
-                        const int lo = hex_value(raw[i + 2]);
-                        if (hi >= 0 && lo >= 0) {
-                            out.push_back(static_cast<char>((hi << 4) | lo));
-                            i += 2;
-                            continue;
-                        }
-                    }
-                    out.push_back(raw[i]);
-                }
-                return out;
-            };
-
-            ExternalGenericDeclMeta meta{};
-            size_t pos = 0;
-            while (pos < payload.size()) {
-                size_t next = payload.find('|', pos);
-                if (next == std::string_view::npos) next = payload.size();
-                const std::string_view part = payload.substr(pos, next - pos);
-                if (part.starts_with("gparam=")) {
-                    meta.params.push_back(
-                        payload_unescape_value_(part.substr(std::string_view("gparam=").size()))
-                    );
-                }
-                if (next == payload.size()) break;
-                pos = next + 1;
-            }
-            return meta;
-        };
         auto type_contains_meta_generic_ =
             [&](auto&& self, ty::TypeId t, const std::unordered_set<std::string>& generic_names) -> bool {
                 if (t == ty::kInvalidType || t >= types_.count()) return false;
@@ -1847,10 +1801,10 @@
                         return false;
                 }
             };
-        for (uint32_t sid = 0; sid < sym_.symbols().size(); ++sid) {
+        const auto& external_fns = sync_symbol_scan_index_().external_fns;
+        for (size_t i = 0; i < external_fns.size(); ++i) {
+            const uint32_t sid = external_fns[i];
             const auto& sym = sym_.symbol(sid);
-            if (!sym.is_external) continue;
-            if (sym.kind != sema::SymbolKind::kFn) continue;
             if (sym.declared_type == ty::kInvalidType) continue;
 
             ty::TypeId owner_t = ty::kInvalidType;
@@ -1902,7 +1856,7 @@
 
             std::string owner_base{};
             std::vector<ty::TypeId> owner_args{};
-            const auto meta = parse_external_generic_decl_meta_(sym.external_payload);
+            const auto& meta = external_payload_record_(sid).generic;
             std::unordered_set<std::string> meta_generic_names(meta.params.begin(), meta.params.end());
             const bool owner_contains_named_meta_generic =
                 !meta_generic_names.empty() &&
@@ -1949,9 +1903,10 @@
             return out;
         };
 
-        for (uint32_t sid = 0; sid < sym_.symbols().size(); ++sid) {
+        const auto& external_types = sync_symbol_scan_index_().external_types;
+        for (size_t i = 0; i < external_types.size(); ++i) {
+            const uint32_t sid = external_types[i];
             const auto& sym = sym_.symbol(sid);
-            if (!sym.is_external) continue;
             const bool struct_like_external_type =
                 (sym.kind == sema::SymbolKind::kField) ||
                 (sym.kind == sema::SymbolKind::kType &&
@@ -2006,7 +1961,7 @@
                         const std::string sem =
                             (split == std::string::npos) ? std::string{} : repr_and_sem.substr(split + 1);
                         const ty::TypeId bound =
-                            parus::cimport::parse_external_type_repr(repr, sem, std::string(sym.external_payload), types_);
+                            parus::cimport::parse_external_type_repr(repr, sem, sym.external_payload, types_);
                         if (!assoc_name.empty() && bound != ty::kInvalidType) {
                             ExternalActsAssocTypeDecl decl{};
                             decl.owner_type = owner_t;
@@ -2055,9 +2010,10 @@
             return out;
         };
 
-        for (uint32_t sid = 0; sid < sym_.symbols().size(); ++sid) {
+        const auto& external_types = sync_symbol_scan_index_().external_types;
+        for (size_t i = 0; i < external_types.size(); ++i) {
+            const uint32_t sid = external_types[i];
             const auto& sym = sym_.symbol(sid);
-            if (!sym.is_external) continue;
             if (!sym.is_export) continue;
             if (sym.kind != sema::SymbolKind::kType) continue;
             if (!sym.external_payload.starts_with("parus_decl_kind=proto")) continue;
@@ -2133,15 +2089,8 @@
             try_key(std::string("constraints::") + std::string(leaf));
             try_key(std::string("core::constraints::") + std::string(leaf));
             if (!sid.has_value()) {
-                for (const auto& [name, existing_sid] : proto_decl_by_name_) {
-                    const size_t pos = name.rfind("::");
-                    const std::string_view tail =
-                        (pos == std::string::npos) ? std::string_view(name)
-                                                   : std::string_view(name).substr(pos + 2);
-                    if (tail == leaf) {
-                        sid = existing_sid;
-                        break;
-                    }
+                if (const auto& same_leaf = proto_decl_by_name_.with_leaf(leaf); !same_leaf.empty()) {
+                    sid = same_leaf.front()->second;
                 }
             }
 
@@ -2170,10 +2119,10 @@
                    payload.starts_with("parus_c_abi_decl|");
         };
 
-        for (uint32_t sid = 0; sid < sym_.symbols().size(); ++sid) {
+        const auto& external_fns = sync_symbol_scan_index_().external_fns;
+        for (size_t i = 0; i < external_fns.size(); ++i) {
+            const uint32_t sid = external_fns[i];
             const auto& sym = sym_.symbol(sid);
-            if (!sym.is_external) continue;
-            if (sym.kind != sema::SymbolKind::kFn) continue;
             if (sym.declared_type == ty::kInvalidType) continue;
             if (is_c_abi_external_payload(sym.external_payload)) continue;
             external_fn_overload_map_[visible_name(sym.name)].push_back(sid);
@@ -2319,9 +2268,10 @@
     }
 
     void TypeChecker::collect_external_enum_metadata_() {
-        for (uint32_t sid = 0; sid < sym_.symbols().size(); ++sid) {
+        const auto& external_types = sync_symbol_scan_index_().external_types;
+        for (size_t i = 0; i < external_types.size(); ++i) {
+            const uint32_t sid = external_types[i];
             const auto& sym = sym_.symbol(sid);
-            if (!sym.is_external) continue;
             if (sym.kind != sema::SymbolKind::kType) continue;
             if (sym.external_payload.empty()) continue;
             if (sym.declared_type == ty::kInvalidType) continue;
@@ -2564,12 +2514,8 @@
         if (!leaf.empty()) {
             std::optional<ast::StmtId> unique{};
             bool ambiguous = false;
-            for (const auto& [name, sid] : proto_decl_by_name_) {
-                const size_t name_sep = name.rfind("::");
-                const std::string_view candidate_leaf =
-                    (name_sep == std::string::npos) ? std::string_view(name)
-                                                    : std::string_view(name).substr(name_sep + 2);
-                if (candidate_leaf != leaf) continue;
+            for (const auto* entry : proto_decl_by_name_.with_leaf(leaf)) {
+                const ast::StmtId sid = entry->second;
                 if (unique.has_value() && *unique != sid) {
                     ambiguous = true;
                     break;
@@ -3304,14 +3250,55 @@
         }
     }
 
-    std::string TypeChecker::current_bundle_name_() const {
-        if (!explicit_current_bundle_name_.empty()) return explicit_current_bundle_name_;
+    const TypeChecker::SymbolScanIndex& TypeChecker::sync_symbol_scan_index_() const {
+        auto& idx = symbol_scan_index_;
         const auto& syms = sym_.symbols();
-        for (const auto& s : syms) {
-            if (s.is_external) continue;
-            if (!s.decl_bundle_name.empty()) return s.decl_bundle_name;
+        if (syms.size() < idx.indexed) idx = SymbolScanIndex{};
+        for (uint32_t sid = idx.indexed; sid < syms.size(); ++sid) {
+            const auto& sym = syms[sid];
+            if (!sym.is_external) {
+                if (idx.local_bundle.empty()) idx.local_bundle = sym.decl_bundle_name;
+                if (sym.decl_file_id != 0 && !sym.decl_module_head.empty()) {
+                    idx.module_head_by_file.emplace(sym.decl_file_id, sym.decl_module_head);
+                }
+            }
+            if (sym.kind == sema::SymbolKind::kFn) {
+                const std::string_view name = sym.name;
+                const size_t ovl = name.find("@@extovl$");
+                idx.fns_by_visible_name[std::string(name.substr(0, ovl))].push_back(sid);
+            }
+            if (!sym.is_external) continue;
+
+            if (sym.kind == sema::SymbolKind::kFn) {
+                idx.external_fns.push_back(sid);
+                // builtin acts payload는 owner 해석에 실패하면 이름 끝 segment로 되돌아가므로 양쪽에 모두 넣는다.
+                // 실제 판정은 lookup_external_acts_methods_for_call_이 후보마다 다시 한다.
+                std::string_view payload_member{};
+                if (std::string_view payload = sym.external_payload; payload.starts_with("parus_builtin_acts|")) {
+                    for (size_t pos = 0; pos < payload.size();) {
+                        size_t next = payload.find('|', pos);
+                        if (next == std::string_view::npos) next = payload.size();
+                        const std::string_view part = payload.substr(pos, next - pos);
+                        if (part.starts_with("member=") && part.size() > 7) payload_member = part.substr(7);
+                        pos = next + 1;
+                    }
+                }
+                if (!payload_member.empty()) idx.external_fns_by_member[std::string(payload_member)].push_back(sid);
+                if (const size_t split = sym.name.rfind("::"); split != std::string::npos) {
+                    const std::string_view tail = std::string_view(sym.name).substr(split + 2);
+                    if (tail != payload_member) idx.external_fns_by_member[std::string(tail)].push_back(sid);
+                }
+            } else if (sym.kind == sema::SymbolKind::kType || sym.kind == sema::SymbolKind::kField) {
+                idx.external_types.push_back(sid);
+            }
         }
-        return {};
+        idx.indexed = static_cast<uint32_t>(syms.size());
+        return idx;
+    }
+
+    std::string TypeChecker::current_bundle_name_() const {
+        if (!explicit_current_bundle_name_.empty()) return explicit_current_bundle_name_;
+        return sync_symbol_scan_index_().local_bundle;
     }
 
     std::string TypeChecker::bundle_name_for_file_(uint32_t file_id) const {
@@ -3829,51 +3816,6 @@
         const bool have_concrete_owner_base =
             decompose_named_user_type_(concrete_owner_type, concrete_owner_base, concrete_owner_args) &&
             !concrete_owner_base.empty();
-        auto parse_external_generic_decl_meta_ = [](std::string_view payload) {
-            struct ExternalGenericDeclMeta {
-                std::vector<std::string> params{};
-            };
-            auto payload_unescape_value_ = [](std::string_view raw) -> std::string {
-                auto hex_value = [](char ch) -> int {
-                    if (ch >= '0' && ch <= '9') return ch - '0';
-                    if (ch >= 'a' && ch <= 'f') return 10 + (ch - 'a');
-                    if (ch >= 'A' && ch <= 'F') return 10 + (ch - 'A');
-                    return -1;
-                };
-
-                std::string out{};
-                out.reserve(raw.size());
-                for (size_t i = 0; i < raw.size(); ++i) {
-                    if (raw[i] == '%' && i + 2 < raw.size()) {
-                        const int hi = hex_value(raw[i + 1]);
-                        const int lo = hex_value(raw[i + 2]);
-                        if (hi >= 0 && lo >= 0) {
-                            out.push_back(static_cast<char>((hi << 4) | lo));
-                            i += 2;
-                            continue;
-                        }
-                    }
-                    out.push_back(raw[i]);
-                }
-                return out;
-            };
-
-            ExternalGenericDeclMeta meta{};
-            size_t pos = 0;
-            while (pos < payload.size()) {
-                size_t next = payload.find('|', pos);
-                if (next == std::string_view::npos) next = payload.size();
-                const std::string_view part = payload.substr(pos, next - pos);
-                if (part.starts_with("gparam=")) {
-                    meta.params.push_back(
-                        payload_unescape_value_(part.substr(std::string_view("gparam=").size()))
-                    );
-                }
-                if (next == payload.size()) break;
-                pos = next + 1;
-            }
-            return meta;
-        };
         auto type_contains_meta_generic_ =
             [&](auto&& self, ty::TypeId t, const std::unordered_set<std::string>& generic_names) -> bool {
                 if (t == ty::kInvalidType || t >= types_.count()) return false;
@@ -3910,9 +3852,12 @@
             };
 
         std::unordered_set<uint32_t> seen{};
-        for (uint32_t sid = 0; sid < sym_.symbols().size(); ++sid) {
+        const auto& by_member = sync_symbol_scan_index_().external_fns_by_member;
+        const auto member_it = by_member.find(std::string(member_name));
+        if (member_it == by_member.end()) return out;
+        const std::vector<uint32_t> candidates = member_it->second;
+        for (const uint32_t sid : candidates) {
             const auto& sym = sym_.symbol(sid);
-            if (!sym.is_external || sym.kind != sema::SymbolKind::kFn) continue;
             if (sym.declared_type == ty::kInvalidType || sym.declared_type >= types_.count()) continue;
             const auto& fn_t = types_.get(sym.declared_type);
             if (fn_t.kind != ty::Kind::kFn || fn_t.param_count == 0) continue;
@@ -3952,7 +3897,7 @@
             md.receiver_is_self = true;
             md.external_payload = sym.external_payload;
 
-            const auto meta = parse_external_generic_decl_meta_(sym.external_payload);
+            const auto& meta = external_payload_record_(sid).generic;
             std::unordered_set<std::string> meta_generic_names(meta.params.begin(), meta.params.end());
             std::string template_owner_base{};
             std::vector<ty::TypeId> template_owner_args{};
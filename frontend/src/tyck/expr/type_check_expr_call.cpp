@@ -58,62 +58,6 @@ namespace parus::tyck {
             return out;
         }
 
-        struct ExternalGenericConstraintMeta {
-            enum class Kind : uint8_t {
-                kProto = 0,
-                kTypeEq,
-            };
-            Kind kind = Kind::kProto;
-            std::string lhs{};
-            std::string rhs{};
-        };
-
-        struct ExternalGenericDeclMeta {
-            std::vector<std::string> params{};
-            std::vector<ExternalGenericConstraintMeta> constraints{};
-            std::vector<std::pair<std::string, std::string>> impl_protos{};
-        };
-
-        ExternalGenericDeclMeta parse_external_generic_decl_meta_(std::string_view payload) {
-            ExternalGenericDeclMeta out{};
-            size_t pos = 0;
-            while (pos < payload.size()) {
-                size_t next = payload.find('|', pos);
-                if (next == std::string_view::npos) next = payload.size();
-                const std::string_view part = payload.substr(pos, next - pos);
-                if (part.starts_with("gparam=")) {
-                    out.params.push_back(payload_unescape_value_(part.substr(std::string_view("gparam=").size())));
-                } else if (part.starts_with("gconstraint=")) {
-                    const std::string_view body = part.substr(std::string_view("gconstraint=").size());
-                    const size_t comma1 = body.find(',');
-                    const size_t comma2 = (comma1 == std::string_view::npos) ? std::string_view::npos : body.find(',', comma1 + 1);
-                    if (comma1 != std::string_view::npos && comma2 != std::string_view::npos) {
-                        ExternalGenericConstraintMeta cc{};
-                        const std::string_view kind = body.substr(0, comma1);
-                        cc.kind = (kind == "type_eq")
-                            ? ExternalGenericConstraintMeta::Kind::kTypeEq
-                            : ExternalGenericConstraintMeta::Kind::kProto;
-                        cc.lhs = payload_unescape_value_(body.substr(comma1 + 1, comma2 - comma1 - 1));
-                        cc.rhs = payload_unescape_value_(body.substr(comma2 + 1));
-                        out.constraints.push_back(std::move(cc));
-                    }
-                } else if (part.starts_with("impl_proto=")) {
-                    const std::string body = payload_unescape_value_(
-                        part.substr(std::string_view("impl_proto=").size())
-                    );
-                    const size_t split = body.find('@');
-                    if (split == std::string::npos) {
-                        out.impl_protos.emplace_back(body, std::string{});
-                    } else {
-                        out.impl_protos.emplace_back(body.substr(0, split), body.substr(split + 1));
-                    }
-                }
-                if (next == payload.size()) break;
-                pos = next + 1;
-            }
-            return out;
-        }
-
         struct CImportCallMeta {
             bool is_c_import = false;
             bool is_c_decl = false;
@@ -195,6 +139,72 @@ namespace parus::tyck {
         }
     } // namespace
 
+    ExternalGenericDeclMeta TypeChecker::decode_external_generic_decl_meta_(std::string_view payload) {
+        ExternalGenericDeclMeta out{};
+        size_t pos = 0;
+        while (pos < payload.size()) {
+            size_t next = payload.find('|', pos);
+            if (next == std::string_view::npos) next = payload.size();
+            const std::string_view part = payload.substr(pos, next - pos);
+            if (part.starts_with("gparam=")) {
+                out.params.push_back(payload_unescape_value_(part.substr(std::string_view("gparam=").size())));
+            } else if (part.starts_with("gconstraint=")) {
+                const std::string_view body = part.substr(std::string_view("gconstraint=").size());
+                const size_t comma1 = body.find(',');
+                const size_t comma2 = (comma1 == std::string_view::npos) ? std::string_view::npos : body.find(',', comma1 + 1);
+                if (comma1 != std::string_view::npos && comma2 != std::string_view::npos) {
+                    ExternalGenericConstraintMeta cc{};
+                    const std::string_view kind = body.substr(0, comma1);
+                    cc.kind = (kind == "type_eq")
+                        ? ExternalGenericConstraintMeta::Kind::kTypeEq
+                        : ExternalGenericConstraintMeta::Kind::kProto;
+                    cc.lhs = payload_unescape_value_(body.substr(comma1 + 1, comma2 - comma1 - 1));
+                    cc.rhs = payload_unescape_value_(body.substr(comma2 + 1));
+                    out.constraints.push_back(std::move(cc));
+                }
+            } else if (part.starts_with("impl_proto=")) {
+                const std::string body = payload_unescape_value_(
+                    part.substr(std::string_view("impl_proto=").size())
+                );
+                const size_t split = body.find('@');
+                if (split == std::string::npos) {
+                    out.impl_protos.emplace_back(body, std::string{});
+                } else {
+                    out.impl_protos.emplace_back(body.substr(0, split), body.substr(split + 1));
+                }
+            }
+            if (next == payload.size()) break;
+            pos = next + 1;
+        }
+        return out;
+    }
+
+    const ExternalPayloadRecord& TypeChecker::external_payload_record_(uint32_t sid) const {
+        if (auto it = external_payload_records_.find(sid); it != external_payload_records_.end()) {
+            return it->second;
+        }
+        ExternalPayloadRecord rec{};
+        if (sid < sym_.symbols().size()) {
+            const std::string_view payload = sym_.symbol(sid).external_payload;
+            rec.compiler_impl_binding = (parse_impl_binding_mode_(payload) == "compiler");
+            rec.has_generic_decl = payload.find("parus_generic_decl") != std::string_view::npos;
+            rec.generic = decode_external_generic_decl_meta_(payload);
+            rec.constraint_rhs_types.resize(rec.generic.constraints.size());
+        }
+        return external_payload_records_.emplace(sid, std::move(rec)).first->second;
+    }
+
+    ty::TypeId TypeChecker::external_constraint_rhs_type_(uint32_t sid, size_t constraint_index) {
+        (void)external_payload_record_(sid);
+        auto& rec = external_payload_records_.at(sid);
+        if (constraint_index >= rec.generic.constraints.size()) return ty::kInvalidType;
+        auto& slot = rec.constraint_rhs_types[constraint_index];
+        if (!slot.has_value()) {
+            slot = parus::cimport::parse_external_type_repr(rec.generic.constraints[constraint_index].rhs, {}, {}, types_);
+        }
+        return *slot;
+    }
+
     ty::TypeId TypeChecker::check_expr_call_(ast::Expr e) {
         // e.a = callee, args slice in e.arg_begin/e.arg_count
         const ast::ExprId call_expr_id = current_expr_id_;
@@ -514,11 +524,12 @@ namespace parus::tyck {
             return out;
         };
 
-        auto is_external_free_fn_candidate_ = [&](const sema::Symbol& ss) -> bool {
+        auto is_external_free_fn_candidate_ = [&](uint32_t sid) -> bool {
+            const auto& ss = sym_.symbol(sid);
             if (ss.kind != sema::SymbolKind::kFn) return false;
-            if (parse_impl_binding_mode_(ss.external_payload) == "compiler") return false;
-            const bool has_external_generic_meta =
-                ss.external_payload.find("parus_generic_decl") != std::string::npos;
+            const auto& payload = external_payload_record_(sid);
+            if (payload.compiler_impl_binding) return false;
+            const bool has_external_generic_meta = payload.has_generic_decl;
             const bool is_hidden_external_overload =
                 ss.name.find("@@extovl$") != std::string::npos;
             const std::string current_bundle = current_bundle_name_();
@@ -537,12 +548,12 @@ namespace parus::tyck {
             if (auto rewritten = rewrite_imported_path_(lookup)) {
                 lookup = *rewritten;
             }
-            const std::string visible_lookup = visible_external_fn_name_(lookup);
-            for (uint32_t sid = 0; sid < sym_.symbols().size(); ++sid) {
-                const auto& ss = sym_.symbol(sid);
-                if (!is_external_free_fn_candidate_(ss)) continue;
-                if (visible_external_fn_name_(ss.name) != visible_lookup) continue;
-                out.push_back(sid);
+            // 심볼 테이블 전체 대신 같은 visible 이름을 가진 함수 심볼만 본다.
+            const auto& by_name = sync_symbol_scan_index_().fns_by_visible_name;
+            const auto it = by_name.find(visible_external_fn_name_(lookup));
+            if (it == by_name.end()) return out;
+            for (const uint32_t sid : it->second) {
+                if (is_external_free_fn_candidate_(sid)) out.push_back(sid);
             }
             return out;
         };
@@ -1186,12 +1197,12 @@ namespace parus::tyck {
         // 1) method call fast-path: `value.ident(...)`
         // ------------------------------------------------------------
         {
-        const ast::Expr& callee_expr = ast_.expr(e.a);
+        const ast::Expr callee_expr = ast_.expr(e.a);
         if (callee_expr.kind == ast::ExprKind::kBinary &&
             callee_expr.op == K::kArrow &&
                 callee_expr.a != ast::k_invalid_expr &&
                 callee_expr.b != ast::k_invalid_expr) {
-                const ast::Expr& rhs = ast_.expr(callee_expr.b);
+                const ast::Expr rhs = ast_.expr(callee_expr.b);
                 if (rhs.kind == ast::ExprKind::kIdent) {
                     const ty::TypeId owner_t = resolve_member_owner_type(callee_expr.a, rhs.span);
                     if (is_error_(owner_t)) {
@@ -1218,7 +1229,7 @@ namespace parus::tyck {
                 callee_expr.op == K::kDot &&
                 callee_expr.a != ast::k_invalid_expr &&
                 callee_expr.b != ast::k_invalid_expr) {
-                const ast::Expr& rhs = ast_.expr(callee_expr.b);
+                const ast::Expr rhs = ast_.expr(callee_expr.b);
                 if (rhs.kind == ast::ExprKind::kIdent) {
                     ast::ExprId recv_eid = callee_expr.a;
                     std::optional<std::string_view> proto_qualifier{};
@@ -1532,7 +1543,7 @@ namespace parus::tyck {
         // 2) non-method path: regular callee typing + ident overload lookup
         // ------------------------------------------------------------
         if (!is_dot_method_call) {
-            const ast::Expr& callee_expr = ast_.expr(e.a);
+            const ast::Expr callee_expr = ast_.expr(e.a);
 
             if (callee_expr.kind == ast::ExprKind::kIdent) {
                 const std::string callee_text(callee_expr.text);
@@ -1606,7 +1617,8 @@ namespace parus::tyck {
                         {
                             ast::StmtId found = ast::k_invalid_stmt;
                             const std::string suffix = "::" + key;
-                            for (const auto& kv : enum_decl_by_name_) {
+                            for (const auto* entry : enum_decl_by_name_.with_leaf(enum_decl_by_name_.leaf_of(key))) {
+                                const auto& kv = *entry;
                                 const std::string& q = kv.first;
                                 if (q == key) {
                                     if (!allow_hidden_imported_enum && is_hidden_imported_enum_sid(kv.second)) {
@@ -2786,7 +2798,7 @@ namespace parus::tyck {
             if (external_candidate_sids.empty() &&
                 preferred_sid != sema::SymbolTable::kNoScope &&
                 preferred_sid < sym_.symbols().size() &&
-                is_external_free_fn_candidate_(sym_.symbol(preferred_sid))) {
+                is_external_free_fn_candidate_(preferred_sid)) {
                 external_candidate_sids.push_back(preferred_sid);
             }
             if (external_candidate_sids.empty()) return {};
@@ -2890,7 +2902,7 @@ namespace parus::tyck {
                 const auto& fn_tt = types_.get(fn_t);
                 if (fn_tt.kind != ty::Kind::kFn) continue;
 
-                const auto meta = parse_external_generic_decl_meta_(fn_sym.external_payload);
+                const auto& meta = external_payload_record_(sid).generic;
                 std::unordered_map<std::string, ty::TypeId> bindings{};
                 std::vector<ty::TypeId> expected_params{};
                 expected_params.reserve(fn_tt.param_count);
@@ -2947,7 +2959,8 @@ namespace parus::tyck {
                 }
 
                 bool constraint_ok = true;
-                for (const auto& cc : meta.constraints) {
+                for (size_t ci = 0; ci < meta.constraints.size(); ++ci) {
+                    const auto& cc = meta.constraints[ci];
                     auto lhs_it = bindings.find(cc.lhs);
                     if (lhs_it == bindings.end()) {
                         ext_has_infer_fail = true;
@@ -2967,7 +2980,7 @@ namespace parus::tyck {
                             const auto& proto_decl = ast_.stmt(*proto_sid);
                             rhs_t = proto_decl.type;
                         } else {
-                            rhs_t = parus::cimport::parse_external_type_repr(cc.rhs, {}, {}, types_);
+                            rhs_t = external_constraint_rhs_type_(sid, ci);
                             if (rhs_t == ty::kInvalidType) {
                                 ext_has_proto_not_found = true;
                                 ext_proto_not_found = cc.rhs;
@@ -3015,7 +3028,7 @@ namespace parus::tyck {
                             break;
                         }
                     } else {
-                        ty::TypeId rhs_t = parus::cimport::parse_external_type_repr(cc.rhs, {}, {}, types_);
+                        ty::TypeId rhs_t = external_constraint_rhs_type_(sid, ci);
                         if (rhs_t == ty::kInvalidType) {
                             ext_has_infer_fail = true;
                             constraint_ok = false;
@@ -3635,7 +3648,11 @@ namespace parus::tyck {
                 const auto& fn_sym = sym_.symbol(cand.fn_symbol);
                 const ty::TypeId fn_t = fn_sym.declared_type;
                 if (fn_t == ty::kInvalidType || types_.get(fn_t).kind != ty::Kind::kFn) continue;
-                const auto meta = parse_external_generic_decl_meta_(cand.external_payload);
+                // 빈 payload는 builtin acts 후보다(generic 메타 없음). 그 밖에는 심볼 payload와 같다.
+                static const ExternalGenericDeclMeta kNoGenericMeta{};
+                const auto& meta = cand.external_payload.empty()
+                    ? kNoGenericMeta
+                    : external_payload_record_(cand.fn_symbol).generic;
                 const uint32_t total_cnt = types_.get(fn_t).param_count;
                 if (total_cnt == 0) continue;
 
@@ -3717,7 +3734,8 @@ namespace parus::tyck {
                     }
 
                     bool constraint_ok = true;
-                    for (const auto& cc : meta.constraints) {
+                    for (size_t ci = 0; ci < meta.constraints.size(); ++ci) {
+                        const auto& cc = meta.constraints[ci];
                         auto lhs_it = bindings.find(cc.lhs);
                         if (lhs_it == bindings.end()) {
                             ext_has_infer_fail = true;
@@ -3737,7 +3755,7 @@ namespace parus::tyck {
                                 const auto& proto_decl = ast_.stmt(*proto_sid);
                                 rhs_t = proto_decl.type;
                             } else {
-                                rhs_t = parus::cimport::parse_external_type_repr(cc.rhs, {}, {}, types_);
+                                rhs_t = external_constraint_rhs_type_(cand.fn_symbol, ci);
                                 if (rhs_t == ty::kInvalidType) {
                                     ext_has_proto_not_found = true;
                                     ext_proto_not_found = cc.rhs;
@@ -3786,7 +3804,7 @@ namespace parus::tyck {
                             continue;
                         }
 
-                        ty::TypeId rhs_t = parus::cimport::parse_external_type_repr(cc.rhs, {}, {}, types_);
+                        ty::TypeId rhs_t = external_constraint_rhs_type_(cand.fn_symbol, ci);
                         if (rhs_t == ty::kInvalidType) {
                             ext_has_infer_fail = true;
                             constraint_ok = false;
@@ -4085,7 +4103,7 @@ namespace parus::tyck {
 
             const auto& direct_sym = sym_.symbol(direct_ident_symbol);
             const ImplBindingKind impl_binding =
-                (parse_impl_binding_mode_(direct_sym.external_payload) == "compiler")
+                external_payload_record_(direct_ident_symbol).compiler_impl_binding
                     ? parse_impl_binding_payload_(direct_sym.external_payload)
                     : ImplBindingKind::kNone;
 
@@ -544,10 +544,12 @@
     }
 
     ty::TypeId TypeChecker::check_expr_loop_(
-        const ast::Expr& e,
+        const ast::Expr& loop_expr,
         Slot /*slot*/,
         BreakTargetKind break_target_kind
     ) {
+        // iter source의 generic acts 인스턴스화가 AST expr 배열을 늘릴 수 있으므로 노드를 복사해 둔다.
+        const ast::Expr e = loop_expr;
         // loop result type comes ONLY from breaks, plus optional null if:
         // - break; exists, or
         // - iter-loop can naturally end
@@ -935,50 +937,7 @@
                         const auto& ss = sym_.symbol(md.fn_symbol);
                         ty::TypeId fn_t = ss.declared_type;
                         if (md.owner_is_generic_template) {
-                            struct ExternalGenericDeclMeta {
-                                std::vector<std::string> params{};
-                            };
-                            auto payload_unescape_value_ = [](std::string_view raw) -> std::string {
-                                auto hex_value = [](char ch) -> int {
-                                    if (ch >= '0' && ch <= '9') return ch - '0';
-                                    if (ch >= 'a' && ch <= 'f') return 10 + (ch - 'a');
-                                    if (ch >= 'A' && ch <= 'F') return 10 + (ch - 'A');
-                                    return -1;
-                                };
-                                std::string out{};
-                                out.reserve(raw.size());
-                                for (size_t i = 0; i < raw.size(); ++i) {
-                                    if (raw[i] == '%' && i + 2 < raw.size()) {
-                                        const int hi = hex_value(raw[i + 1]);
-                                        const int lo = hex_value(raw[i + 2]);
-                                        if (hi >= 0 && lo >= 0) {
-                                            out.push_back(static_cast<char>((hi << 4) | lo));
-                                            i += 2;
-                                            continue;
-                                        }
-                                    }
-                                    out.push_back(raw[i]);
-                                }
-                                return out;
-                            };
-                            auto parse_external_generic_decl_meta_ = [&](std::string_view payload) {
-                                ExternalGenericDeclMeta meta{};
-                                size_t pos = 0;
-                                while (pos < payload.size()) {
-                                    size_t next = payload.find('|', pos);
-                                    if (next == std::string_view::npos) next = payload.size();
-                                    const std::string_view part = payload.substr(pos, next - pos);
-                                    if (part.starts_with("gparam=")) {
-                                        meta.params.push_back(
-                                            payload_unescape_value_(part.substr(std::string_view("gparam=").size()))
-                                        );
-                                    }
-                                    if (next == payload.size()) break;
-                                    pos = next + 1;
-                                }
-                                return meta;
-                            };
-                            const auto meta = parse_external_generic_decl_meta_(ss.external_payload);
+                            const auto& meta = external_payload_record_(md.fn_symbol).generic;
                             if (owner_args.size() != md.owner_generic_arity ||
                                 meta.params.size() < md.owner_generic_arity) {
                                 continue;
@@ -1002,50 +961,7 @@
                 const auto& ss = sym_.symbol(md.fn_symbol);
                 ty::TypeId fn_t = ss.declared_type;
                 if (md.owner_is_generic_template) {
-                    struct ExternalGenericDeclMeta {
-                        std::vector<std::string> params{};
-                    };
-                    auto payload_unescape_value_ = [](std::string_view raw) -> std::string {
-                        auto hex_value = [](char ch) -> int {
-                            if (ch >= '0' && ch <= '9') return ch - '0';
-                            if (ch >= 'a' && ch <= 'f') return 10 + (ch - 'a');
-                            if (ch >= 'A' && ch <= 'F') return 10 + (ch - 'A');
-                            return -1;
-                        };
-                        std::string out{};
-                        out.reserve(raw.size());
-                        for (size_t i = 0; i < raw.size(); ++i) {
-                            if (raw[i] == '%' && i + 2 < raw.size()) {
-                                const int hi = hex_value(raw[i + 1]);
-                                const int lo = hex_value(raw[i + 2]);
-                                if (hi >= 0 && lo >= 0) {
-                                    out.push_back(static_cast<char>((hi << 4) | lo));
-                                    i += 2;
-                                    continue;
-                                }
-                            }
-                            out.push_back(raw[i]);
-                        }
-                        return out;
-                    };
-                    auto parse_external_generic_decl_meta_ = [&](std::string_view payload) {
-                        ExternalGenericDeclMeta meta{};
-                        size_t pos = 0;
-                        while (pos < payload.size()) {
-                            size_t next = payload.find('|', pos);
-                            if (next == std::string_view::npos) next = payload.size();
-                            const std::string_view part = payload.substr(pos, next - pos);
-                            if (part.starts_with("gparam=")) {
-                                meta.params.push_back(
-                                    payload_unescape_value_(part.substr(std::string_view("gparam=").size()))
-                                );
-                            }
-                            if (next == payload.size()) break;
-                            pos = next + 1;
-                        }
-                        return meta;
-                    };
-                    const auto meta = parse_external_generic_decl_meta_(ss.external_payload);
+                    const auto& meta = external_payload_record_(md.fn_symbol).generic;
                     if (owner_args.size() != md.owner_generic_arity ||
                         meta.params.size() < md.owner_generic_arity) {
                         continue;
@@ -1,3 +1,4 @@
 #include "type_check_stmt_control.cpp"
 #include "type_check_stmt_decl_const.cpp"
+#include "type_check_stmt_const_vm.cpp"
 #include "type_check_stmt_type_decls.cpp"
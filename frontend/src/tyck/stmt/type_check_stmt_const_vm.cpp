@@ -0,0 +1,686 @@
+    // --------------------
+    // const def bytecode: compile once, run on a register VM
+    // --------------------
+
+    bool TypeChecker::const_vm_is_numeric_(ConstValue::Kind k) {
+        return k == ConstValue::Kind::kInt || k == ConstValue::Kind::kFloat || k == ConstValue::Kind::kChar;
+    }
+
+    bool TypeChecker::const_vm_as_i64_(const ConstValue& v, int64_t& out) {
+        if (v.kind == ConstValue::Kind::kInt) {
+            out = v.i64;
+            return true;
+        }
+        if (v.kind == ConstValue::Kind::kChar) {
+            out = static_cast<int64_t>(v.ch);
+            return true;
+        }
+        return false;
+    }
+
+    bool TypeChecker::const_vm_as_f64_(const ConstValue& v, double& out) {
+        if (v.kind == ConstValue::Kind::kFloat) {
+            out = v.f64;
+            return true;
+        }
+        int64_t iv = 0;
+        if (!const_vm_as_i64_(v, iv)) return false;
+        out = static_cast<double>(iv);
+        return true;
+    }
+
+    /// @brief walker의 단항 규칙과 같다. walker가 진단할 입력이면 false.
+    bool TypeChecker::const_vm_unary_(K op, const ConstValue& in, ConstValue& out) {
+        switch (op) {
+            case K::kPlus:
+                if (!const_vm_is_numeric_(in.kind)) return false;
+                out = in;
+                return true;
+            case K::kMinus:
+                if (in.kind == ConstValue::Kind::kInt) {
+                    out.kind = ConstValue::Kind::kInt;
+                    out.i64 = -in.i64;
+                    return true;
+                }
+                if (in.kind == ConstValue::Kind::kFloat) {
+                    out.kind = ConstValue::Kind::kFloat;
+                    out.f64 = -in.f64;
+                    return true;
+                }
+                if (in.kind == ConstValue::Kind::kChar) {
+                    out.kind = ConstValue::Kind::kInt;
+                    out.i64 = -static_cast<int64_t>(in.ch);
+                    return true;
+                }
+                return false;
+            case K::kKwNot:
+                if (in.kind != ConstValue::Kind::kBool) return false;
+                out.kind = ConstValue::Kind::kBool;
+                out.b = !in.b;
+                return true;
+            case K::kBang:
+                if (in.kind != ConstValue::Kind::kInt) return false;
+                out.kind = ConstValue::Kind::kInt;
+                out.i64 = ~in.i64;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /// @brief walker의 이항 규칙과 같다(양쪽 모두 평가한 뒤 계산). walker가 진단할 입력이면 false.
+    bool TypeChecker::const_vm_binary_(K op, const ConstValue& l, const ConstValue& r, ConstValue& out) {
+        const bool any_float = (l.kind == ConstValue::Kind::kFloat || r.kind == ConstValue::Kind::kFloat);
+        switch (op) {
+            case K::kPlus:
+            case K::kMinus:
+            case K::kStar:
+            case K::kSlash: {
+                if (!const_vm_is_numeric_(l.kind) || !const_vm_is_numeric_(r.kind)) return false;
+                if (any_float) {
+                    double lf = 0.0;
+                    double rf = 0.0;
+                    if (!const_vm_as_f64_(l, lf) || !const_vm_as_f64_(r, rf)) return false;
+                    if (op == K::kSlash && rf == 0.0) return false;
+                    out.kind = ConstValue::Kind::kFloat;
+                    if (op == K::kPlus) out.f64 = lf + rf;
+                    else if (op == K::kMinus) out.f64 = lf - rf;
+                    else if (op == K::kStar) out.f64 = lf * rf;
+                    else out.f64 = lf / rf;
+                    return true;
+                }
+                int64_t li = 0;
+                int64_t ri = 0;
+                if (!const_vm_as_i64_(l, li) || !const_vm_as_i64_(r, ri)) return false;
+                if (op == K::kSlash && ri == 0) return false;
+                out.kind = ConstValue::Kind::kInt;
+                if (op == K::kPlus) out.i64 = li + ri;
+                else if (op == K::kMinus) out.i64 = li - ri;
+                else if (op == K::kStar) out.i64 = li * ri;
+                else out.i64 = li / ri;
+                return true;
+            }
+            case K::kPercent: {
+                int64_t li = 0;
+                int64_t ri = 0;
+                if (!const_vm_as_i64_(l, li) || !const_vm_as_i64_(r, ri) || ri == 0) return false;
+                out.kind = ConstValue::Kind::kInt;
+                out.i64 = li % ri;
+                return true;
+            }
+            case K::kEqEq:
+            case K::kBangEq: {
+                bool eq = false;
+                if (l.kind == ConstValue::Kind::kBool && r.kind == ConstValue::Kind::kBool) {
+                    eq = (l.b == r.b);
+                } else if (const_vm_is_numeric_(l.kind) && const_vm_is_numeric_(r.kind)) {
+                    if (any_float) {
+                        double lf = 0.0;
+                        double rf = 0.0;
+                        if (!const_vm_as_f64_(l, lf) || !const_vm_as_f64_(r, rf)) return false;
+                        eq = (lf == rf);
+                    } else {
+                        int64_t li = 0;
+                        int64_t ri = 0;
+                        if (!const_vm_as_i64_(l, li) || !const_vm_as_i64_(r, ri)) return false;
+                        eq = (li == ri);
+                    }
+                } else {
+                    return false;
+                }
+                out.kind = ConstValue::Kind::kBool;
+                out.b = (op == K::kEqEq) ? eq : !eq;
+                return true;
+            }
+            case K::kLt:
+            case K::kLtEq:
+            case K::kGt:
+            case K::kGtEq: {
+                if (!const_vm_is_numeric_(l.kind) || !const_vm_is_numeric_(r.kind)) return false;
+                const auto cmp = [op](auto a, auto b) {
+                    if (op == K::kLt) return a < b;
+                    if (op == K::kLtEq) return a <= b;
+                    if (op == K::kGt) return a > b;
+                    return a >= b;
+                };
+                out.kind = ConstValue::Kind::kBool;
+                if (any_float) {
+                    double lf = 0.0;
+                    double rf = 0.0;
+                    if (!const_vm_as_f64_(l, lf) || !const_vm_as_f64_(r, rf)) return false;
+                    out.b = cmp(lf, rf);
+                    return true;
+                }
+                int64_t li = 0;
+                int64_t ri = 0;
+                if (!const_vm_as_i64_(l, li) || !const_vm_as_i64_(r, ri)) return false;
+                out.b = cmp(li, ri);
+                return true;
+            }
+            case K::kKwAnd:
+            case K::kKwOr:
+                if (l.kind != ConstValue::Kind::kBool || r.kind != ConstValue::Kind::kBool) return false;
+                out.kind = ConstValue::Kind::kBool;
+                out.b = (op == K::kKwAnd) ? (l.b && r.b) : (l.b || r.b);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool TypeChecker::const_call_memo_key_(
+        ast::StmtId fn_sid,
+        const std::vector<ConstValue>& args,
+        std::string& out
+    ) {
+        out.clear();
+        out.reserve(sizeof(fn_sid) + args.size() * 16u);
+        const auto put = [&](const void* p, size_t n) { out.append(static_cast<const char*>(p), n); };
+        put(&fn_sid, sizeof(fn_sid));
+        for (const auto& a : args) {
+            if (a.kind == ConstValue::Kind::kStruct || a.kind == ConstValue::Kind::kInvalid) return false;
+            const uint8_t kind = static_cast<uint8_t>(a.kind);
+            put(&kind, sizeof(kind));
+            put(&a.type, sizeof(a.type));
+            switch (a.kind) {
+                case ConstValue::Kind::kInt: put(&a.i64, sizeof(a.i64)); break;
+                case ConstValue::Kind::kFloat: put(&a.f64, sizeof(a.f64)); break;
+                case ConstValue::Kind::kBool: put(&a.b, sizeof(a.b)); break;
+                case ConstValue::Kind::kChar: put(&a.ch, sizeof(a.ch)); break;
+                default: return false;
+            }
+        }
+        return true;
+    }
+
+    const TypeChecker::ConstFnProgram* TypeChecker::const_fn_program_(ast::StmtId fn_sid) {
+        if (!const_eval_bytecode_enabled_) return nullptr;
+        if (auto it = const_fn_programs_.find(fn_sid); it != const_fn_programs_.end()) {
+            return it->second.usable ? &it->second : nullptr;
+        }
+        // 본문 검사 전에는 식 타입 캐시가 비어 있을 수 있으니 컴파일을 미룬다(walker로 평가).
+        if (!const_fn_body_checked_.contains(fn_sid)) return nullptr;
+
+        ConstFnProgram& prog = const_fn_programs_[fn_sid];
+        if (!compile_const_fn_program_(fn_sid, prog)) {
+            prog = ConstFnProgram{};
+            return nullptr;
+        }
+        prog.usable = true;
+        ++const_eval_stats_.bytecode_fn_count;
+        return &prog;
+    }
+
+    bool TypeChecker::compile_const_fn_program_(ast::StmtId fn_sid, ConstFnProgram& out) {
+        const auto& fn = ast_.stmt(fn_sid);
+        const auto& params = ast_.params();
+        if ((uint64_t)fn.param_begin + fn.param_count > params.size()) return false;
+
+        struct Local {
+            std::string_view name{};
+            uint32_t reg = 0;
+            bool is_mut = false;
+        };
+        struct Loop {
+            uint32_t top = 0;
+            std::vector<uint32_t> breaks{};
+        };
+        std::vector<Local> locals{};
+        std::vector<Loop> loops{};
+        uint32_t reg_top = 0;
+        uint32_t site = 0;
+
+        const auto alloc = [&]() -> uint32_t {
+            const uint32_t r = reg_top++;
+            if (reg_top > out.reg_count) out.reg_count = reg_top;
+            return r;
+        };
+        const auto find_local = [&](std::string_view name) -> const Local* {
+            for (auto it = locals.rbegin(); it != locals.rend(); ++it) {
+                if (it->name == name) return &*it;
+            }
+            return nullptr;
+        };
+        const auto emit = [&](ConstInstr in) -> uint32_t {
+            in.site = site;
+            out.code.push_back(in);
+            return static_cast<uint32_t>(out.code.size() - 1);
+        };
+        const auto here = [&]() { return static_cast<uint32_t>(out.code.size()); };
+        const auto expr_type_of = [&](ast::ExprId eid) -> ty::TypeId {
+            return (static_cast<size_t>(eid) < expr_type_cache_.size()) ? expr_type_cache_[eid] : ty::kInvalidType;
+        };
+        const auto load_const = [&](uint32_t dst, ConstValue v) {
+            out.consts.push_back(std::move(v));
+            ConstInstr in{};
+            in.op = ConstOp::kLoadK;
+            in.step = true;
+            in.dst = dst;
+            in.imm = static_cast<uint32_t>(out.consts.size() - 1);
+            emit(in);
+        };
+
+        for (uint32_t i = 0; i < fn.param_count; ++i) {
+            const auto& p = params[fn.param_begin + i];
+            locals.push_back(Local{p.name, alloc(), p.is_mut});
+        }
+        out.param_count = fn.param_count;
+
+        // 결과는 항상 dst에 남긴다. walker와 같은 노드에서 step을 센다(조건식은 kStep, 나머지는 연산 명령).
+        auto expr = [&](auto&& self, ast::ExprId eid, uint32_t dst) -> bool {
+            if (eid == ast::k_invalid_expr || (size_t)eid >= ast_.exprs().size()) return false;
+            const auto& e = ast_.expr(eid);
+            const ty::TypeId inferred_ty = expr_type_of(eid);
+            switch (e.kind) {
+                case ast::ExprKind::kIntLit: {
+                    ConstValue v{};
+                    std::string canonical;
+                    if (!parse_int_literal_i64_(e.text, v.i64, canonical)) return false;
+                    v.kind = ConstValue::Kind::kInt;
+                    v.type = inferred_ty;
+                    load_const(dst, std::move(v));
+                    return true;
+                }
+                case ast::ExprKind::kFloatLit: {
+                    ConstValue v{};
+                    std::string canonical;
+                    if (!parse_float_literal_f64_(e.text, v.f64, canonical)) return false;
+                    v.kind = ConstValue::Kind::kFloat;
+                    v.type = inferred_ty;
+                    load_const(dst, std::move(v));
+                    return true;
+                }
+                case ast::ExprKind::kBoolLit: {
+                    ConstValue v{};
+                    v.kind = ConstValue::Kind::kBool;
+                    v.b = (e.text == "true");
+                    v.type = inferred_ty;
+                    load_const(dst, std::move(v));
+                    return true;
+                }
+                case ast::ExprKind::kCharLit: {
+                    ConstValue v{};
+                    if (!parse_char_literal_scalar_(e.text, v.ch)) return false;
+                    v.kind = ConstValue::Kind::kChar;
+                    v.type = inferred_ty;
+                    load_const(dst, std::move(v));
+                    return true;
+                }
+                case ast::ExprKind::kIdent: {
+                    ConstInstr in{};
+                    in.step = true;
+                    in.dst = dst;
+                    in.span = e.span;
+                    if (const Local* l = find_local(e.text)) {
+                        in.op = ConstOp::kMove;
+                        in.a = l->reg;
+                    } else {
+                        in.op = ConstOp::kGlobal;
+                        out.global_names.emplace_back(e.text);
+                        in.imm = static_cast<uint32_t>(out.global_names.size() - 1);
+                    }
+                    emit(in);
+                    return true;
+                }
+                case ast::ExprKind::kUnary: {
+                    if (!self(self, e.a, dst)) return false;
+                    ConstInstr in{};
+                    in.op = ConstOp::kUnary;
+                    in.step = true;
+                    in.tok = e.op;
+                    in.dst = dst;
+                    in.a = dst;
+                    in.type = inferred_ty;
+                    emit(in);
+                    return true;
+                }
+                case ast::ExprKind::kBinary: {
+                    const uint32_t saved_top = reg_top;
+                    const uint32_t rhs = alloc();
+                    if (!self(self, e.a, dst) || !self(self, e.b, rhs)) return false;
+                    reg_top = saved_top;
+                    ConstInstr in{};
+                    in.op = ConstOp::kBinary;
+                    in.step = true;
+                    in.tok = e.op;
+                    in.dst = dst;
+                    in.a = dst;
+                    in.b = rhs;
+                    in.type = inferred_ty;
+                    emit(in);
+                    return true;
+                }
+                case ast::ExprKind::kAssign: {
+                    if (e.op != K::kAssign) return false;
+                    if (e.a == ast::k_invalid_expr || (size_t)e.a >= ast_.exprs().size()) return false;
+                    const auto& lhs = ast_.expr(e.a);
+                    if (lhs.kind != ast::ExprKind::kIdent) return false;
+                    const Local* l = find_local(lhs.text);
+                    if (l == nullptr || !l->is_mut) return false;
+                    const uint32_t target = l->reg;
+                    if (!self(self, e.b, dst)) return false;
+                    ConstInstr in{};
+                    in.op = ConstOp::kAssign;
+                    in.step = true;
+                    in.dst = dst;
+                    in.a = target;
+                    in.type = inferred_ty;
+                    emit(in);
+                    return true;
+                }
+                case ast::ExprKind::kTernary:
+                case ast::ExprKind::kIfExpr: {
+                    ConstInstr step{};
+                    step.op = ConstOp::kStep;
+                    step.step = true;
+                    emit(step);
+                    if (!self(self, e.a, dst)) return false;
+                    ConstInstr jf{};
+                    jf.op = ConstOp::kJumpIfNot;
+                    jf.a = dst;
+                    const uint32_t jf_at = emit(jf);
+                    if (!self(self, e.b, dst)) return false;
+                    ConstInstr j{};
+                    j.op = ConstOp::kJump;
+                    const uint32_t j_at = emit(j);
+                    out.code[jf_at].imm = here();
+                    if (!self(self, e.c, dst)) return false;
+                    out.code[j_at].imm = here();
+                    ConstInstr st{};
+                    st.op = ConstOp::kSetType;
+                    st.dst = dst;
+                    st.type = inferred_ty;
+                    emit(st);
+                    return true;
+                }
+                case ast::ExprKind::kCall: {
+                    ast::StmtId callee_sid = ast::k_invalid_stmt;
+                    if ((size_t)eid < expr_overload_target_cache_.size()) {
+                        callee_sid = expr_overload_target_cache_[eid];
+                    }
+                    if (callee_sid == ast::k_invalid_stmt) {
+                        if (e.a == ast::k_invalid_expr || (size_t)e.a >= ast_.exprs().size()) return false;
+                        const auto& ce = ast_.expr(e.a);
+                        if (ce.kind != ast::ExprKind::kIdent) return false;
+                        auto fit = fn_decl_by_name_.find(std::string(ce.text));
+                        if (fit != fn_decl_by_name_.end() && fit->second.size() == 1) {
+                            callee_sid = fit->second.front();
+                        }
+                    }
+                    if (callee_sid == ast::k_invalid_stmt ||
+                        (size_t)callee_sid >= ast_.stmts().size() ||
+                        ast_.stmt(callee_sid).kind != ast::StmtKind::kFnDecl) {
+                        return false;
+                    }
+
+                    const auto& args = ast_.args();
+                    if ((uint64_t)e.arg_begin + e.arg_count > args.size()) return false;
+                    const uint32_t saved_top = reg_top;
+                    const uint32_t base = reg_top;
+                    for (uint32_t i = 0; i < e.arg_count; ++i) (void)alloc();
+                    for (uint32_t i = 0; i < e.arg_count; ++i) {
+                        const auto& a = args[e.arg_begin + i];
+                        if (a.has_label || a.kind == ast::ArgKind::kLabeled || a.is_hole) return false;
+                        if (!self(self, a.expr, base + i)) return false;
+                    }
+                    reg_top = saved_top;
+                    out.callees.push_back(callee_sid);
+                    ConstInstr in{};
+                    in.op = ConstOp::kCall;
+                    in.step = true;
+                    in.span = e.span;
+                    in.dst = dst;
+                    in.a = base;
+                    in.b = e.arg_count;
+                    in.imm = static_cast<uint32_t>(out.callees.size() - 1);
+                    in.type = inferred_ty;
+                    emit(in);
+                    return true;
+                }
+                default:
+                    // struct 초기화/loop 식 등은 walker가 맡는다.
+                    return false;
+            }
+        };
+
+        const auto add_site = [&](Span sp, std::string_view reason) -> uint32_t {
+            out.sites.push_back(ConstFailSite{sp, reason});
+            return static_cast<uint32_t>(out.sites.size());
+        };
+
+        auto stmt = [&](auto&& self, ast::StmtId sid) -> bool {
+            if (sid == ast::k_invalid_stmt || (size_t)sid >= ast_.stmts().size()) return false;
+            const auto& s = ast_.stmt(sid);
+            const uint32_t saved_top = reg_top;
+            switch (s.kind) {
+                case ast::StmtKind::kEmpty:
+                    return true;
+                case ast::StmtKind::kBlock: {
+                    const auto& kids = ast_.stmt_children();
+                    if ((uint64_t)s.stmt_begin + s.stmt_count > kids.size()) return false;
+                    const size_t saved_locals = locals.size();
+                    for (uint32_t i = 0; i < s.stmt_count; ++i) {
+                        if (!self(self, kids[s.stmt_begin + i])) return false;
+                    }
+                    locals.resize(saved_locals);
+                    reg_top = saved_top;
+                    return true;
+                }
+                case ast::StmtKind::kExprStmt: {
+                    if (s.expr == ast::k_invalid_expr) return true;
+                    site = add_site(s.span, "expression statement const evaluation failed");
+                    const bool ok = expr(expr, s.expr, alloc());
+                    reg_top = saved_top;
+                    return ok;
+                }
+                case ast::StmtKind::kVar: {
+                    if (s.is_static || s.is_extern || s.is_export || s.name.empty()) return false;
+                    if (s.init == ast::k_invalid_expr) return false;
+                    if (find_local(s.name) != nullptr) return false;
+                    site = add_site(s.span, "local initializer is not const-evaluable");
+                    const uint32_t reg = alloc();
+                    if (!expr(expr, s.init, reg)) return false;
+                    reg_top = reg + 1;
+                    ConstInstr in{};
+                    in.op = ConstOp::kDefine;
+                    in.dst = reg;
+                    in.type = s.type;
+                    emit(in);
+                    locals.push_back(Local{s.name, reg, (!s.is_const) && (s.is_set || s.is_mut)});
+                    return true;
+                }
+                case ast::StmtKind::kIf: {
+                    // block이 아닌 선언이 분기에 바로 오면 실행 여부에 따라 이름이 보이므로 walker에 맡긴다.
+                    for (const ast::StmtId br : {s.a, s.b}) {
+                        if (br != ast::k_invalid_stmt && (size_t)br < ast_.stmts().size() &&
+                            ast_.stmt(br).kind == ast::StmtKind::kVar) {
+                            return false;
+                        }
+                    }
+                    site = add_site(s.span, "if condition must be bool in const evaluator");
+                    const uint32_t cond = alloc();
+                    if (!expr(expr, s.expr, cond)) return false;
+                    reg_top = saved_top;
+                    ConstInstr jf{};
+                    jf.op = ConstOp::kJumpIfNot;
+                    jf.a = cond;
+                    const uint32_t jf_at = emit(jf);
+                    if (s.a != ast::k_invalid_stmt && !self(self, s.a)) return false;
+                    if (s.b == ast::k_invalid_stmt) {
+                        out.code[jf_at].imm = here();
+                        return true;
+                    }
+                    ConstInstr j{};
+                    j.op = ConstOp::kJump;
+                    const uint32_t j_at = emit(j);
+                    out.code[jf_at].imm = here();
+                    if (!self(self, s.b)) return false;
+                    out.code[j_at].imm = here();
+                    return true;
+                }
+                case ast::StmtKind::kWhile: {
+                    if (s.a != ast::k_invalid_stmt && (size_t)s.a < ast_.stmts().size() &&
+                        ast_.stmt(s.a).kind == ast::StmtKind::kVar) {
+                        return false;
+                    }
+                    loops.push_back(Loop{here(), {}});
+                    site = add_site(s.span, "while condition must be bool in const evaluator");
+                    const uint32_t cond = alloc();
+                    if (!expr(expr, s.expr, cond)) return false;
+                    reg_top = saved_top;
+                    ConstInstr jf{};
+                    jf.op = ConstOp::kJumpIfNot;
+                    jf.a = cond;
+                    const uint32_t jf_at = emit(jf);
+                    if (!self(self, s.a)) return false;
+                    ConstInstr back{};
+                    back.op = ConstOp::kJump;
+                    back.imm = loops.back().top;
+                    emit(back);
+                    out.code[jf_at].imm = here();
+                    for (const uint32_t at : loops.back().breaks) out.code[at].imm = here();
+                    loops.pop_back();
+                    return true;
+                }
+                case ast::StmtKind::kBreak: {
+                    if (s.expr != ast::k_invalid_expr || loops.empty()) return false;
+                    ConstInstr j{};
+                    j.op = ConstOp::kJump;
+                    loops.back().breaks.push_back(emit(j));
+                    return true;
+                }
+                case ast::StmtKind::kContinue: {
+                    if (loops.empty()) return false;
+                    ConstInstr j{};
+                    j.op = ConstOp::kJump;
+                    j.imm = loops.back().top;
+                    emit(j);
+                    return true;
+                }
+                case ast::StmtKind::kReturn: {
+                    site = 0;
+                    ConstInstr in{};
+                    if (s.expr == ast::k_invalid_expr) {
+                        in.op = ConstOp::kReturnUnit;
+                        emit(in);
+                        return true;
+                    }
+                    const uint32_t val = alloc();
+                    if (!expr(expr, s.expr, val)) return false;
+                    reg_top = saved_top;
+                    in.op = ConstOp::kReturn;
+                    in.a = val;
+                    emit(in);
+                    return true;
+                }
+                default:
+                    return false;
+            }
+        };
+
+        if (!stmt(stmt, fn.a)) return false;
+        ConstInstr end{};
+        end.op = ConstOp::kFallOff;
+        emit(end);
+        return true;
+    }
+
+    TypeChecker::ConstVmResult TypeChecker::run_const_fn_program_(
+        const ConstFnProgram& prog,
+        std::vector<ConstValue>& regs,
+        ConstValue& out,
+        ConstEvalContext& ctx
+    ) {
+        // 중첩 평가가 진단을 낸 뒤에는 walker가 감싸던 문장 진단을 여기서 낸다.
+        const auto fail_site = [&](const ConstInstr& in) -> ConstVmResult {
+            if (in.site != 0) {
+                const ConstFailSite& s = prog.sites[in.site - 1];
+                diag_(diag::Code::kConstFnBodyUnsupportedStmt, s.span, s.reason);
+                err_(s.span, std::string("unsupported const def statement: ") + std::string(s.reason));
+            }
+            return ConstVmResult::kFailed;
+        };
+
+        const ConstInstr* code = prog.code.data();
+        std::vector<ConstValue> call_args{};
+        uint32_t pc = 0;
+        for (;;) {
+            const ConstInstr& in = code[pc++];
+            if (in.step && ++ctx.step_count > ctx.step_budget) return ConstVmResult::kRetry;
+            switch (in.op) {
+                case ConstOp::kLoadK:
+                    regs[in.dst] = prog.consts[in.imm];
+                    break;
+                case ConstOp::kMove:
+                    regs[in.dst] = regs[in.a];
+                    break;
+                case ConstOp::kGlobal: {
+                    auto sid = lookup_symbol_(prog.global_names[in.imm]);
+                    if (!sid.has_value()) return ConstVmResult::kRetry;
+                    if (!eval_const_symbol_value_impl_(*sid, regs[in.dst], in.span, ctx)) return fail_site(in);
+                    break;
+                }
+                case ConstOp::kUnary: {
+                    ConstValue v{};
+                    if (!const_vm_unary_(in.tok, regs[in.a], v)) return ConstVmResult::kRetry;
+                    v.type = in.type;
+                    regs[in.dst] = std::move(v);
+                    break;
+                }
+                case ConstOp::kBinary: {
+                    ConstValue v{};
+                    if (!const_vm_binary_(in.tok, regs[in.a], regs[in.b], v)) return ConstVmResult::kRetry;
+                    v.type = in.type;
+                    regs[in.dst] = std::move(v);
+                    break;
+                }
+                case ConstOp::kAssign: {
+                    if (!const_value_type_matches_(regs[in.dst], regs[in.a].type)) return ConstVmResult::kRetry;
+                    regs[in.a] = regs[in.dst];
+                    regs[in.dst].type = in.type;
+                    break;
+                }
+                case ConstOp::kCall: {
+                    call_args.assign(regs.begin() + in.a, regs.begin() + in.a + in.b);
+                    ConstValue v{};
+                    if (!eval_const_fn_call_impl_(prog.callees[in.imm], call_args, v, in.span, ctx)) {
+                        return fail_site(in);
+                    }
+                    if (in.type != ty::kInvalidType) v.type = in.type;
+                    regs[in.dst] = std::move(v);
+                    break;
+                }
+                case ConstOp::kStep:
+                    break;
+                case ConstOp::kSetType:
+                    regs[in.dst].type = in.type;
+                    break;
+                case ConstOp::kDefine: {
+                    ConstValue& v = regs[in.dst];
+                    if (in.type != ty::kInvalidType && !const_value_type_matches_(v, in.type)) {
+                        return ConstVmResult::kRetry;
+                    }
+                    if (v.type == ty::kInvalidType) v.type = in.type;
+                    break;
+                }
+                case ConstOp::kJump:
+                    pc = in.imm;
+                    break;
+                case ConstOp::kJumpIfNot: {
+                    const ConstValue& c = regs[in.a];
+                    if (c.kind != ConstValue::Kind::kBool) return ConstVmResult::kRetry;
+                    if (!c.b) pc = in.imm;
+                    break;
+                }
+                case ConstOp::kReturn:
+                    out = std::move(regs[in.a]);
+                    return ConstVmResult::kOk;
+                case ConstOp::kReturnUnit:
+                    out = ConstValue{};
+                    out.type = types_.builtin(ty::Builtin::kUnit);
+                    return ConstVmResult::kOk;
+                case ConstOp::kFallOff:
+                    return ConstVmResult::kRetry;
+            }
+        }
+    }
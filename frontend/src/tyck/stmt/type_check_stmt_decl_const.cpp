@@ -405,14 +405,18 @@
 
         // ----------------------------
         // 3) 본문 체크
+        //    (증분 분석이 재사용하는 아이템은 본문과 return 누락 검사를 건너뛴다)
         // ----------------------------
+        const bool body_skipped = explicit_body_skip_sids_.contains(sid);
         if (fn.is_extern) {
             if (fn.a != ast::k_invalid_stmt) {
                 diag_(diag::Code::kTypeErrorGeneric, fn.span, "extern function declaration must not have a body");
                 err_(fn.span, "extern function declaration must not have a body");
             }
-        } else if (fn.a != ast::k_invalid_stmt) {
+        } else if (fn.a != ast::k_invalid_stmt && !body_skipped) {
             check_stmt_(fn.a);
+            // 본문 식 타입/overload 캐시가 채워졌으므로 이후 const 호출은 bytecode로 내릴 수 있다.
+            if (fn.fn_is_const) const_fn_body_checked_.insert(sid);
         }
 
         // ----------------------------
@@ -428,7 +432,7 @@
         // 반환 타입이 void(Unit)/never면 "끝까지 도달" 허용
         const ty::TypeId fn_ret = fn_ctx_.ret;
 
-        if (!fn.is_extern && !is_unit(fn_ret) && !is_never(fn_ret)) {
+        if (!fn.is_extern && !body_skipped && !is_unit(fn_ret) && !is_never(fn_ret)) {
             const bool ok_all_paths = stmt_diverges_(fn.a, /*loop_control_counts=*/false);
             if (!ok_all_paths) {
                 // 여기서 “return 누락” 진단
@@ -1142,12 +1146,34 @@
             err_(diag_span, "const def requires body for const evaluation");
             return false;
         }
+
         if (ctx.call_stack.size() >= ctx.call_depth_budget) {
             diag_(diag::Code::kConstEvalCallDepthExceeded, diag_span, fn.name);
             err_(diag_span, "const evaluation call depth limit exceeded");
             return false;
         }
 
+        std::string memo_key{};
+        const bool memoizable = const_eval_bytecode_enabled_ && const_call_memo_key_(fn_sid, args, memo_key);
+        if (memoizable) {
+            // 예산을 넘길 적중은 건너뛰고 실제로 평가해, memo가 없을 때와 같은 위치에서 진단을 낸다.
+            if (auto it = const_call_memo_.find(memo_key);
+                it != const_call_memo_.end() &&
+                uint64_t(ctx.step_count) + it->second.step_cost <= ctx.step_budget &&
+                ctx.call_stack.size() + it->second.depth_cost <= ctx.call_depth_budget) {
+                ++const_eval_stats_.memo_hit_count;
+                ctx.step_count += it->second.step_cost;
+                ctx.call_depth_peak =
+                    std::max(ctx.call_depth_peak, ctx.call_stack.size() + it->second.depth_cost);
+                out = it->second.value;
+                return true;
+            }
+        }
+        const uint32_t steps_at_entry = ctx.step_count;
+        const size_t depth_at_entry = ctx.call_stack.size();
+        const size_t outer_depth_peak = ctx.call_depth_peak;
+        ctx.call_depth_peak = depth_at_entry;
+
         std::unordered_map<std::string, ConstBinding> env{};
         env.reserve(fn.param_count + 8u);
 
@@ -1347,7 +1373,36 @@
         };
 
         ctx.call_stack.push_back(fn_sid);
-        const ExecResult r = exec_stmt(exec_stmt, fn.a);
+        ctx.call_depth_peak = std::max(ctx.call_depth_peak, ctx.call_stack.size());
+        ExecResult r{};
+        bool done = false;
+        if (const ConstFnProgram* prog = const_fn_program_(fn_sid)) {
+            std::vector<ConstValue> regs(prog->reg_count);
+            for (uint32_t i = 0; i < prog->param_count; ++i) {
+                regs[i] = env.at(std::string(ast_.params()[fn.param_begin + i].name)).value;
+            }
+            const uint32_t saved_steps = ctx.step_count;
+            switch (run_const_fn_program_(*prog, regs, r.value, ctx)) {
+                case ConstVmResult::kOk:
+                    ++const_eval_stats_.bytecode_call_count;
+                    r.returned = true;
+                    done = true;
+                    break;
+                case ConstVmResult::kFailed:
+                    ctx.call_stack.pop_back();
+                    return false;
+                case ConstVmResult::kRetry:
+                    // 진단은 walker가 낸다. step도 처음부터 다시 센다.
+                    ++const_eval_stats_.vm_fallback_count;
+                    ctx.step_count = saved_steps;
+                    r.value = ConstValue{};
+                    break;
+            }
+        }
+        if (!done) {
+            ++const_eval_stats_.walker_call_count;
+            r = exec_stmt(exec_stmt, fn.a);
+        }
         ctx.call_stack.pop_back();
         if (!r.ok) return false;
         if (!r.returned) {
@@ -1362,6 +1417,14 @@
         }
         out = r.value;
         if (out.type == ty::kInvalidType) out.type = fn.fn_ret;
+        if (memoizable) {
+            ConstCallMemo memo{};
+            memo.value = out;
+            memo.step_cost = ctx.step_count - steps_at_entry;
+            memo.depth_cost = static_cast<uint32_t>(ctx.call_depth_peak - depth_at_entry);
+            const_call_memo_.emplace(std::move(memo_key), std::move(memo));
+        }
+        ctx.call_depth_peak = std::max(ctx.call_depth_peak, outer_depth_peak);
         return true;
     }
 
@@ -134,7 +134,7 @@
 
     /// @brief field 선언의 멤버 타입 제약(POD 값 타입만 허용)을 검사한다.
     void TypeChecker::check_stmt_field_decl_(ast::StmtId sid) {
-        const ast::Stmt& s = ast_.stmt(sid);
+        const ast::Stmt s = ast_.stmt(sid);
         {
             std::unordered_set<std::string> generic_params;
             for (const auto& name : collect_decl_generic_param_names_(s)) {
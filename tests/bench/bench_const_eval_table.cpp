@@ -0,0 +1,134 @@
+// Compile-time evaluation cost of a const-built lookup table.
+//
+//   parus_bench_const_eval_table [iterations] [entries]
+//
+// Generates `entries` top-level consts `T<i> = entry(i % 64)`, where `entry`
+// is a const def looping over a Collatz walk, plus a `table_sum` const def
+// that folds the first 64 entries. Each iteration parses the source (untimed)
+// and times TypeChecker::check_program once with the AST walker only and once
+// with the bytecode VM + (fn, args) memo.
+#include <parus/lex/Lexer.hpp>
+#include <parus/macro/Expander.hpp>
+#include <parus/parse/Parser.hpp>
+#include <parus/passes/Passes.hpp>
+#include <parus/tyck/TypeCheck.hpp>
+#include <parus/type/TypeResolve.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::string make_source_(int entries) {
+        std::string src = R"(
+const def entry(n: i32) -> i32 {
+    set mut x = n + 1i32;
+    set mut steps = 0i32;
+    while (x != 1i32) {
+        if (x % 2i32 == 0i32) {
+            x = x / 2i32;
+        } else {
+            x = 3i32 * x + 1i32;
+        }
+        steps = steps + 1i32;
+    }
+    return steps;
+}
+
+const def table_sum(n: i32) -> i32 {
+    set mut i = 0i32;
+    set mut acc = 0i32;
+    while (i < n) {
+        acc = acc + entry(i);
+        i = i + 1i32;
+    }
+    return acc;
+}
+
+const TOTAL: i32 = table_sum(64i32);
+)";
+        for (int i = 0; i < entries; ++i) {
+            src += "const T" + std::to_string(i) + ": i32 = entry(" + std::to_string(i % 64) + "i32);\n";
+        }
+        src += "def main() -> i32 { return TOTAL; }\n";
+        return src;
+    }
+
+    struct Program {
+        parus::ast::AstArena ast;
+        parus::ty::TypePool types;
+        parus::diag::Bag bag;
+        parus::ast::StmtId root = parus::ast::k_invalid_stmt;
+        parus::type::TypeResolveResult type_resolve{};
+        parus::passes::PassResults passes{};
+    };
+
+    bool prepare_(const std::string& src, Program& p) {
+        parus::Lexer lx(src, /*file_id=*/1, &p.bag);
+        const auto tokens = lx.lex_all();
+        parus::Parser parser(tokens, p.ast, p.types, &p.bag);
+        p.root = parser.parse_program();
+        if (!parus::macro::expand_program(p.ast, p.types, p.root, p.bag) || p.bag.has_error()) return false;
+        p.type_resolve = parus::type::resolve_program_types(p.ast, p.types, p.root, p.bag);
+        if (!p.type_resolve.ok || p.bag.has_error()) return false;
+        parus::passes::PassOptions opt{};
+        p.passes = parus::passes::run_on_program(p.ast, p.root, p.bag, opt);
+        return !p.bag.has_error();
+    }
+
+    double median_(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 5;
+    int entries = 2000;
+    if (argc > 1) iterations = std::max(1, std::atoi(argv[1]));
+    if (argc > 2) entries = std::max(1, std::atoi(argv[2]));
+
+    const std::string src = make_source_(entries);
+    std::vector<double> walker_ms{};
+    std::vector<double> vm_ms{};
+    parus::tyck::ConstEvalStats stats{};
+
+    for (int i = 0; i < iterations; ++i) {
+        for (const bool bytecode : {false, true}) {
+            Program p{};
+            if (!prepare_(src, p)) {
+                std::cerr << "error: generated source failed before tyck\n";
+                return 1;
+            }
+            parus::tyck::TypeChecker tc(p.ast, p.types, p.bag, &p.type_resolve, &p.passes.generic_prep);
+            tc.set_const_eval_bytecode(bytecode);
+            const auto start = std::chrono::steady_clock::now();
+            const auto ty = tc.check_program(p.root);
+            const auto end = std::chrono::steady_clock::now();
+            if (!ty.errors.empty() || p.bag.has_error()) {
+                std::cerr << "error: generated source failed tyck\n";
+                return 1;
+            }
+            (bytecode ? vm_ms : walker_ms).push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            if (bytecode) stats = ty.const_eval_stats;
+        }
+    }
+
+    const double walker = median_(walker_ms);
+    const double vm = median_(vm_ms);
+    std::cout << "const table over " << iterations << " iteration(s): " << entries << " const entries\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "ast-walker     " << walker << " ms\n";
+    std::cout << "bytecode+memo  " << vm << " ms  (" << (walker / vm) << "x)\n";
+    std::cout << "bytecode fns " << stats.bytecode_fn_count
+              << ", vm calls " << stats.bytecode_call_count
+              << ", walker calls " << stats.walker_call_count
+              << ", memo hits " << stats.memo_hit_count << "\n";
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Startup latency: `parusc run` (ORC JIT, in-process) vs AOT (compile -> link -> exec).
+//
+//   parus_bench_jit_startup [iterations] [source.pr]
+//
+// Without a source argument a small self-contained program is generated.
+// Each iteration measures end-to-end wall time from invoking parusc until the
+// program's exit status is observed.
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr const char* kDefaultProgram =
+        "def fib(n: i32) -> i32 {\n"
+        "    if (n < 2i32) {\n"
+        "        return n;\n"
+        "    }\n"
+        "    return fib(n - 1i32) + fib(n - 2i32);\n"
+        "}\n"
+        "\n"
+        "def main() -> i32 {\n"
+        "    if (fib(20i32) == 6765i32) {\n"
+        "        return 0i32;\n"
+        "    }\n"
+        "    return 1i32;\n"
+        "}\n";
+
+    double run_ms_(const std::string& command, int& rc) {
+        const auto start = std::chrono::steady_clock::now();
+        rc = std::system(command.c_str());
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    struct Summary {
+        double min = 0.0;
+        double median = 0.0;
+        double mean = 0.0;
+    };
+
+    Summary summarize_(std::vector<double> samples) {
+        Summary s{};
+        if (samples.empty()) return s;
+        std::sort(samples.begin(), samples.end());
+        s.min = samples.front();
+        s.median = samples[samples.size() / 2];
+        double total = 0.0;
+        for (const double v : samples) total += v;
+        s.mean = total / static_cast<double>(samples.size());
+        return s;
+    }
+
+    void print_row_(const char* name, const Summary& s) {
+        std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(2)
+                  << " min=" << std::setw(9) << s.min << "ms"
+                  << " median=" << std::setw(9) << s.median << "ms"
+                  << " mean=" << std::setw(9) << s.mean << "ms\n";
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    namespace fs = std::filesystem;
+
+    int iterations = 5;
+    if (argc > 1) iterations = std::max(1, std::atoi(argv[1]));
+
+    const fs::path work = fs::temp_directory_path() / "parus_bench_jit_startup";
+    std::error_code ec{};
+    fs::create_directories(work, ec);
+
+    fs::path source{};
+    if (argc > 2) {
+        source = argv[2];
+    } else {
+        source = work / "bench_main.pr";
+        std::ofstream ofs(source, std::ios::binary);
+        ofs << kDefaultProgram;
+    }
+    const fs::path exe = work / "bench_main.out";
+    const std::string parusc = PARUSC_BUILD_BIN;
+    const std::string quiet = " > /dev/null 2>&1";
+
+    std::vector<double> jit_samples{};
+    std::vector<double> aot_samples{};
+    for (int i = 0; i < iterations; ++i) {
+        int rc = 0;
+        const double jit_ms = run_ms_("\"" + parusc + "\" run \"" + source.string() + "\"" + quiet, rc);
+        if (rc != 0) {
+            std::cerr << "error: parusc run failed (rc=" << rc << "); is the JIT backend built with LLVM?\n";
+            return 1;
+        }
+        jit_samples.push_back(jit_ms);
+
+        const std::string aot_cmd =
+            "\"" + parusc + "\" \"" + source.string() + "\" -o \"" + exe.string() + "\"" + quiet +
+            " && \"" + exe.string() + "\"";
+        const double aot_ms = run_ms_(aot_cmd, rc);
+        if (rc != 0) {
+            std::cerr << "error: AOT compile/link/exec failed (rc=" << rc << ")\n";
+            return 1;
+        }
+        aot_samples.push_back(aot_ms);
+    }
+
+    const auto jit = summarize_(jit_samples);
+    const auto aot = summarize_(aot_samples);
+    std::cout << "startup latency over " << iterations << " iteration(s): " << source.string() << "\n";
+    print_row_("jit-run", jit);
+    print_row_("aot-exec", aot);
+    if (jit.median > 0.0) {
+        std::cout << "aot/jit median ratio: " << std::setprecision(2) << (aot.median / jit.median) << "x\n";
+    }
+    fs::remove(exe, ec);
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Keyword recognition cost on identifier-heavy input.
+//
+//   parus_bench_keyword_lookup [iterations] [words]
+//
+// Builds `words` identifiers (roughly one keyword per three plain names) and
+// classifies them with syntax::keyword_kind (perfect hash) and with a linear
+// walk over k_keyword_table, which is what the lexer's old if-chain did. It
+// also lexes the same words joined by spaces to show the end-to-end effect.
+#include <parus/lex/Lexer.hpp>
+#include <parus/syntax/Keyword.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    parus::syntax::TokenKind linear_keyword_kind_(std::string_view s) {
+        for (const auto& e : parus::syntax::k_keyword_table) {
+            if (e.text == s) return e.kind;
+        }
+        return parus::syntax::TokenKind::kIdent;
+    }
+
+    template <typename Fn>
+    double median_ms_(int iterations, Fn&& fn) {
+        std::vector<double> samples{};
+        for (int i = 0; i < iterations; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 9;
+    int words = 1000000;
+    if (argc > 1) iterations = std::max(1, std::atoi(argv[1]));
+    if (argc > 2) words = std::max(1, std::atoi(argv[2]));
+
+    static const char* kNames[] = {
+        "value", "count", "idx", "buffer", "node", "result", "lhs", "rhs", "self", "len",
+        "defer", "inits", "structure", "returned", "i32", "data", "item", "ctx", "xs", "tmp",
+    };
+    std::mt19937 rng(42);
+    std::vector<std::string> pool{};
+    pool.reserve(static_cast<size_t>(words));
+    for (int i = 0; i < words; ++i) {
+        if (rng() % 4 == 0) {
+            const auto& kw = parus::syntax::k_keyword_table[rng() % parus::syntax::k_keyword_table.size()];
+            pool.emplace_back(kw.text);
+        } else {
+            pool.emplace_back(kNames[rng() % (sizeof(kNames) / sizeof(kNames[0]))]);
+        }
+    }
+    std::string source{};
+    for (const auto& w : pool) {
+        source += w;
+        source.push_back(' ');
+    }
+
+    size_t sink = 0;
+    for (const auto& w : pool) {
+        if (parus::syntax::keyword_kind(w) != linear_keyword_kind_(w)) {
+            std::cerr << "error: perfect hash disagrees with table for '" << w << "'\n";
+            return 1;
+        }
+    }
+
+    const double hash_ms = median_ms_(iterations, [&] {
+        for (const auto& w : pool) sink += static_cast<size_t>(parus::syntax::keyword_kind(w));
+    });
+    const double linear_ms = median_ms_(iterations, [&] {
+        for (const auto& w : pool) sink += static_cast<size_t>(linear_keyword_kind_(w));
+    });
+    const double lex_ms = median_ms_(iterations, [&] {
+        parus::Lexer lx(source, /*file_id=*/1);
+        sink += lx.lex_all().size();
+    });
+
+    const double n = static_cast<double>(pool.size());
+    std::cout << "keyword lookup over " << iterations << " iteration(s): " << pool.size() << " identifiers\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "perfect-hash  " << (hash_ms * 1e6 / n) << " ns/ident\n";
+    std::cout << "linear-table  " << (linear_ms * 1e6 / n) << " ns/ident  (" << (linear_ms / hash_ms) << "x)\n";
+    std::cout << "lex_all       " << (lex_ms * 1e6 / n) << " ns/ident  "
+              << std::setprecision(1) << (static_cast<double>(source.size()) / (1024.0 * 1024.0) * 1000.0 / lex_ms)
+              << " MB/s\n";
+    std::cout << "(sink " << (sink & 1) << ")\n";
+    return 0;
+}
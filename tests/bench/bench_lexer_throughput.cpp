@@ -0,0 +1,118 @@
+// Lexer throughput (MB/s) over the parser stress corpus.
+//
+//   parus_bench_lexer_throughput [iterations] [repeat]
+//
+// The corpus is every .pr file under tests/parser_cases plus the incremental
+// fuzz seeds, concatenated `repeat` times into one buffer. Each iteration runs
+// Lexer::lex_all (UTF-8 validation included) over the whole buffer; the UTF-8
+// validation pass alone is timed separately through Lexer::seek. The bench
+// re-runs itself once per scan ISA via PARUS_LEX_SIMD, so scalar and SIMD
+// numbers come from identical inputs.
+#include <parus/lex/Lexer.hpp>
+#include <parus/lex/Scan.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    bool append_corpus_dir_(const std::filesystem::path& dir, std::string& out, size_t& files) {
+        std::error_code ec{};
+        if (!std::filesystem::is_directory(dir, ec)) return false;
+        std::vector<std::filesystem::path> paths{};
+        for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".pr") paths.push_back(entry.path());
+        }
+        std::sort(paths.begin(), paths.end());
+        for (const auto& p : paths) {
+            std::ifstream ifs(p, std::ios::binary);
+            out.append(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+            out.push_back('\n');
+            ++files;
+        }
+        return true;
+    }
+
+    double median_(std::vector<double> samples) {
+        if (samples.empty()) return 0.0;
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    int run_child_(int iterations, int repeat) {
+        std::string one{};
+        size_t files = 0;
+        if (!append_corpus_dir_(PARUS_PARSER_CASE_DIR, one, files)) {
+            std::cerr << "error: parser case directory missing: " << PARUS_PARSER_CASE_DIR << "\n";
+            return 1;
+        }
+        append_corpus_dir_(PARUS_FUZZ_INCREMENTAL_SEED_DIR, one, files);
+
+        std::string corpus{};
+        corpus.reserve(one.size() * static_cast<size_t>(repeat));
+        for (int i = 0; i < repeat; ++i) corpus += one;
+
+        std::vector<double> samples{};
+        std::vector<double> utf8_samples{};
+        size_t tokens = 0;
+        for (int i = 0; i < iterations + 1; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            parus::Lexer lx(corpus, /*file_id=*/1);
+            const auto toks = lx.lex_all();
+            const auto end = std::chrono::steady_clock::now();
+            tokens = toks.size();
+            const auto v_start = std::chrono::steady_clock::now();
+            const bool valid = lx.seek(0, static_cast<uint32_t>(corpus.size()));
+            const auto v_end = std::chrono::steady_clock::now();
+            if (!valid) {
+                std::cerr << "error: corpus is not valid UTF-8\n";
+                return 1;
+            }
+            if (i == 0) continue; // warm-up
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            utf8_samples.push_back(std::chrono::duration<double, std::milli>(v_end - v_start).count());
+        }
+
+        const double ms = std::max(median_(samples), 0.001);
+        const double utf8_ms = std::max(median_(utf8_samples), 0.001);
+        const double mb = static_cast<double>(corpus.size()) / (1024.0 * 1024.0);
+        std::cout << std::left << std::setw(8) << parus::scan::isa_name(parus::scan::kernels().isa) << std::right
+                  << std::fixed << std::setprecision(2) << " files=" << files << " bytes=" << corpus.size()
+                  << " tokens=" << tokens << " median=" << ms << "ms  MB/s=" << std::setprecision(1)
+                  << (mb * 1000.0 / ms) << "  utf8-validate MB/s=" << (mb * 1000.0 / utf8_ms) << "\n";
+        return 0;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 9;
+    int repeat = 20;
+    if (argc > 1) iterations = std::max(1, std::atoi(argv[1]));
+    if (argc > 2) repeat = std::max(1, std::atoi(argv[2]));
+
+    if (std::getenv("PARUS_LEX_SIMD") != nullptr) return run_child_(iterations, repeat);
+
+    std::cout << "lexer throughput over " << iterations << " iteration(s), corpus x" << repeat << "\n";
+    for (const auto isa : {parus::scan::ScanIsa::kScalar, parus::scan::ScanIsa::kSse2, parus::scan::ScanIsa::kAvx2}) {
+        if (parus::scan::kernels_for(isa) == nullptr) {
+            std::cout << std::left << std::setw(8) << parus::scan::isa_name(isa) << " (unavailable)\n";
+            continue;
+        }
+        const std::string cmd = std::string("PARUS_LEX_SIMD=") + parus::scan::isa_name(isa) + " \"" + argv[0] + "\" " +
+                                std::to_string(iterations) + " " + std::to_string(repeat);
+        std::cout.flush();
+        if (std::system(cmd.c_str()) != 0) {
+            std::cerr << "error: " << parus::scan::isa_name(isa) << " run failed\n";
+            return 1;
+        }
+    }
+    return 0;
+}
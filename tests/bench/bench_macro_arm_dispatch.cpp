@@ -0,0 +1,107 @@
+// Token macro arm dispatch cost for a macro with many literal-led arms.
+//
+//   parus_bench_macro_arm_dispatch [iterations] [arms] [calls]
+//
+// Generates a `with token` macro with `arms` arms `(opK, $x: expr)` and `calls`
+// call sites spread over all arms, each with distinct argument tokens so the
+// (macro, argument tokens) memo never hits. Each iteration parses the source
+// (untimed) and times macro::expand_program once with sequential arm matching
+// and once with the first-token dispatch table.
+#include <parus/lex/Lexer.hpp>
+#include <parus/macro/Expander.hpp>
+#include <parus/parse/Parser.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::string make_source_(int arms, int calls) {
+        std::string src = "macro dsl -> {\n    with token {\n";
+        for (int k = 0; k < arms; ++k) {
+            src += "        (op" + std::to_string(k) + ", $x: expr) => expr { $x + "
+                + std::to_string(k) + "i32 };\n";
+        }
+        src += "    }\n}\n\ndef main() -> i32 {\n    set mut acc = 0i32;\n";
+        for (int i = 0; i < calls; ++i) {
+            src += "    acc = acc + $dsl(op" + std::to_string(i % arms) + ", " + std::to_string(i) + "i32);\n";
+        }
+        src += "    return acc;\n}\n";
+        return src;
+    }
+
+    struct Program {
+        parus::ast::AstArena ast;
+        parus::ty::TypePool types;
+        parus::diag::Bag bag;
+        parus::ast::StmtId root = parus::ast::k_invalid_stmt;
+    };
+
+    bool parse_(const std::string& src, Program& p) {
+        parus::Lexer lx(src, /*file_id=*/1, &p.bag);
+        const auto tokens = lx.lex_all();
+        parus::Parser parser(tokens, p.ast, p.types, &p.bag);
+        p.root = parser.parse_program();
+        return !p.bag.has_error();
+    }
+
+    double median_(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 5;
+    int arms = 40;
+    int calls = 2000;
+    if (argc > 1) iterations = std::max(1, std::atoi(argv[1]));
+    if (argc > 2) arms = std::max(1, std::atoi(argv[2]));
+    if (argc > 3) calls = std::max(1, std::atoi(argv[3]));
+
+    const std::string src = make_source_(arms, calls);
+    std::vector<double> linear_ms{};
+    std::vector<double> dispatch_ms{};
+    parus::macro::ExpansionStats linear_stats{};
+    parus::macro::ExpansionStats dispatch_stats{};
+
+    for (int i = 0; i < iterations; ++i) {
+        for (const bool dispatch : {false, true}) {
+            Program p{};
+            if (!parse_(src, p)) {
+                std::cerr << "error: generated source failed to parse\n";
+                return 1;
+            }
+            parus::macro::ExpansionBudget budget{};
+            budget.max_steps = parus::macro::k_macro_budget_hard_max_steps;
+            (void)parus::macro::clamp_budget(budget);
+            parus::macro::MacroExpansionContext ctx{p.ast, p.types, p.bag, budget};
+            ctx.arm_dispatch = dispatch;
+            const auto start = std::chrono::steady_clock::now();
+            const bool ok = parus::macro::expand_program(ctx, p.root);
+            const auto end = std::chrono::steady_clock::now();
+            if (!ok || p.bag.has_error()) {
+                std::cerr << "error: generated source failed macro expansion\n";
+                return 1;
+            }
+            (dispatch ? dispatch_ms : linear_ms).push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            (dispatch ? dispatch_stats : linear_stats) = ctx.stats;
+        }
+    }
+
+    const double linear = median_(linear_ms);
+    const double dispatched = median_(dispatch_ms);
+    std::cout << "macro arm dispatch over " << iterations << " iteration(s): "
+              << arms << " arms, " << calls << " calls\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "sequential     " << linear << " ms  (" << linear_stats.token_arm_try_count << " arm tries)\n";
+    std::cout << "first-token    " << dispatched << " ms  (" << dispatch_stats.token_arm_try_count
+              << " arm tries, " << (linear / dispatched) << "x)\n";
+    return 0;
+}
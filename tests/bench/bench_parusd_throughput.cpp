@@ -0,0 +1,171 @@
+// JSON-RPC message throughput of `parusd --stdio`.
+//
+//   parus_bench_parusd_throughput [iterations] [lines] [messages]
+//
+// Opens one generated document of `lines` functions, then streams `messages`
+// full-text didChange notifications interleaved with semanticTokens/full and
+// pull-diagnostic requests. A baseline session (open + shutdown only) is
+// measured as well, so the reported rate is the cost of the extra messages:
+// JSON parsing, text patching and response serialization. Edits arrive within
+// the debounce window, so analysis is coalesced and mostly excluded.
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::string json_escape_(const std::string& s) {
+        std::string out;
+        out.reserve(s.size() + s.size() / 8);
+        for (const char c : s) {
+            switch (c) {
+                case '\\': out += "\\\\"; break;
+                case '"': out += "\\\""; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default: out.push_back(c); break;
+            }
+        }
+        return out;
+    }
+
+    std::string frame_(const std::string& payload) {
+        return "Content-Length: " + std::to_string(payload.size()) + "\r\n\r\n" + payload;
+    }
+
+    std::string make_document_(int lines, int variant) {
+        std::string text;
+        for (int i = 0; i < lines; ++i) {
+            text += "def f" + std::to_string(i) + "(a: i32, b: i32) -> i32 {\n";
+            text += "    let x: i32 = a + b * " + std::to_string(i + variant) + "i32;\n";
+            text += "    return x - a;\n";
+            text += "}\n\n";
+        }
+        return text;
+    }
+
+    double run_ms_(const std::string& command, int& rc) {
+        const auto start = std::chrono::steady_clock::now();
+        rc = std::system(command.c_str());
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    double median_(std::vector<double> samples) {
+        if (samples.empty()) return 0.0;
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    namespace fs = std::filesystem;
+
+    int iterations = 5;
+    int lines = 2000;
+    int messages = 400;
+    if (argc > 1) iterations = std::max(1, std::atoi(argv[1]));
+    if (argc > 2) lines = std::max(1, std::atoi(argv[2]));
+    if (argc > 3) messages = std::max(1, std::atoi(argv[3]));
+
+    const fs::path work = fs::temp_directory_path() / "parus_bench_parusd_throughput";
+    std::error_code ec{};
+    fs::create_directories(work, ec);
+
+    const std::string uri = "file://" + (work / "bench.pr").generic_string();
+    const std::string doc_a = json_escape_(make_document_(lines, 0));
+    const std::string doc_b = json_escape_(make_document_(lines, 1));
+
+    const std::string head =
+        frame_(R"({"jsonrpc":"2.0","id":1,"method":"initialize","params":{"processId":null,"rootUri":null,)"
+               R"("capabilities":{"textDocument":{"diagnostic":{}}}}})") +
+        frame_(R"({"jsonrpc":"2.0","method":"initialized","params":{}})") +
+        frame_("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":\"" + uri +
+               "\",\"languageId\":\"parus\",\"version\":1,\"text\":\"" + doc_a + "\"}}}");
+    const std::string tail =
+        frame_(R"({"jsonrpc":"2.0","id":2,"method":"shutdown","params":{}})") +
+        frame_(R"({"jsonrpc":"2.0","method":"exit","params":{}})");
+
+    std::string body;
+    size_t body_bytes = 0;
+    for (int i = 0; i < messages; ++i) {
+        std::string msg;
+        const int id = 100 + i;
+        switch (i % 4) {
+            case 0:
+            case 1:
+                msg = "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{\"textDocument\":{\"uri\":\"" +
+                      uri + "\",\"version\":" + std::to_string(i + 2) + "},\"contentChanges\":[{\"text\":\"" +
+                      ((i / 4) % 2 == 0 ? doc_b : doc_a) + "\"}]}}";
+                break;
+            case 2:
+                msg = "{\"jsonrpc\":\"2.0\",\"id\":" + std::to_string(id) +
+                      ",\"method\":\"textDocument/semanticTokens/full\",\"params\":{\"textDocument\":{\"uri\":\"" + uri +
+                      "\"}}}";
+                break;
+            default:
+                msg = "{\"jsonrpc\":\"2.0\",\"id\":" + std::to_string(id) +
+                      ",\"method\":\"textDocument/completion\",\"params\":{\"textDocument\":{\"uri\":\"" + uri +
+                      "\"},\"position\":{\"line\":1,\"character\":4}}}";
+                break;
+        }
+        body_bytes += msg.size();
+        body += frame_(msg);
+    }
+
+    const fs::path baseline_in = work / "baseline.in";
+    const fs::path stream_in = work / "stream.in";
+    const fs::path out = work / "session.out";
+    {
+        std::ofstream ofs(baseline_in, std::ios::binary);
+        ofs << head << tail;
+    }
+    {
+        std::ofstream ofs(stream_in, std::ios::binary);
+        ofs << head << body << tail;
+    }
+
+    const std::string parusd = PARUSD_BUILD_BIN;
+    auto command = [&](const fs::path& in) {
+        return "PARUS_NO_CORE=1 \"" + parusd + "\" --stdio < \"" + in.string() + "\" > \"" + out.string() + "\" 2>/dev/null";
+    };
+
+    std::vector<double> baseline{};
+    std::vector<double> stream{};
+    for (int i = 0; i < iterations; ++i) {
+        int rc = 0;
+        baseline.push_back(run_ms_(command(baseline_in), rc));
+        if (rc != 0) {
+            std::cerr << "error: parusd baseline session failed (rc=" << rc << ")\n";
+            return 1;
+        }
+        stream.push_back(run_ms_(command(stream_in), rc));
+        if (rc != 0) {
+            std::cerr << "error: parusd stream session failed (rc=" << rc << ")\n";
+            return 1;
+        }
+    }
+    const auto out_bytes = fs::file_size(out, ec);
+
+    const double base_ms = median_(baseline);
+    const double stream_ms = median_(stream);
+    const double extra_ms = std::max(stream_ms - base_ms, 0.001);
+    const double in_mb = static_cast<double>(body_bytes) / (1024.0 * 1024.0);
+
+    std::cout << "parusd throughput over " << iterations << " iteration(s): " << lines << " fns, " << messages
+              << " messages (" << std::fixed << std::setprecision(2) << in_mb << " MiB in, "
+              << static_cast<double>(out_bytes) / (1024.0 * 1024.0) << " MiB out)\n";
+    std::cout << "baseline median=" << base_ms << "ms  stream median=" << stream_ms << "ms\n";
+    std::cout << "messages/s=" << std::setprecision(0) << (messages * 1000.0 / extra_ms)
+              << "  input MiB/s=" << std::setprecision(1) << (in_mb * 1000.0 / extra_ms) << "\n";
+
+    fs::remove_all(work, ec);
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include <parusc/cli/Options.hpp>
+#include <parusc/cli/ValueFlags.hpp>
 
 #include <initializer_list>
 #include <iostream>
@@ -287,6 +288,76 @@ namespace {
         return ok;
     }
 
+    static bool test_run_mode_parse_() {
+        const auto opt = parse_({
+            "run",
+            "-O2",
+            "-fjit-stats",
+            "-fjit-eager",
+            "-fjit-tier-up=50",
+            "main.pr",
+            "--",
+            "alpha",
+            "-O3",
+        });
+
+        bool ok = true;
+        ok &= require_(opt.ok, "run mode parse must succeed");
+        ok &= require_(opt.mode == parusc::cli::Mode::kRun, "mode must be run");
+        ok &= require_(opt.opt_level == 2, "options before -- must apply to the compiler");
+        ok &= require_(opt.jit_stats, "-fjit-stats must be accepted in run mode");
+        ok &= require_(opt.jit_eager, "-fjit-eager must be accepted in run mode");
+        ok &= require_(opt.jit_tier_up_threshold == 50, "-fjit-tier-up=<N> must set the tier-up threshold");
+        ok &= require_(opt.inputs.size() == 1 && opt.inputs[0] == "main.pr", "run mode must keep the input file");
+        ok &= require_(opt.run_args.size() == 2 && opt.run_args[0] == "alpha" && opt.run_args[1] == "-O3",
+                       "arguments after -- must be forwarded to the program");
+        ok &= require_(opt.output_path.empty(), "run mode must not default an output path");
+        return ok;
+    }
+
+    static bool test_run_mode_conflicts_() {
+        const auto with_output = parse_({"run", "-o", "out", "main.pr"});
+        const auto with_emit = parse_({"run", "--emit-object", "main.pr"});
+        const auto with_target = parse_({"run", "--target", "wasm32-unknown-unknown", "main.pr"});
+        const auto stats_outside_run = parse_({"-fjit-stats", "main.pr"});
+        const auto tier_outside_run = parse_({"-fjit-tier-up=10", "main.pr"});
+        const auto tier_bad_value = parse_({"run", "-fjit-tier-up=abc", "main.pr"});
+        const auto tier_disabled = parse_({"run", "-fjit-tier-up=0", "main.pr"});
+        const auto tier_negative = parse_({"run", "-fjit-tier-up=-5", "main.pr"});
+        const auto tier_trailing = parse_({"run", "-fjit-tier-up=10abc", "main.pr"});
+        const auto tier_plus = parse_({"run", "-fjit-tier-up=+10", "main.pr"});
+        const auto tier_overflow = parse_({"run", "-fjit-tier-up=99999999999999999999999", "main.pr"});
+
+        bool ok = true;
+        ok &= require_(!with_output.ok, "run mode must reject -o");
+        ok &= require_(!with_emit.ok, "run mode must reject emit options");
+        ok &= require_(!with_target.ok, "run mode must reject explicit targets");
+        ok &= require_(!stats_outside_run.ok, "-fjit-stats must be rejected outside run mode");
+        ok &= require_(!tier_outside_run.ok, "-fjit-tier-up must be rejected outside run mode");
+        ok &= require_(!tier_bad_value.ok, "-fjit-tier-up must reject non-numeric values");
+        ok &= require_(tier_disabled.ok && tier_disabled.jit_tier_up_threshold == 0, "-fjit-tier-up=0 must disable tier-up");
+        ok &= require_(!tier_negative.ok, "-fjit-tier-up must reject negative values");
+        ok &= require_(!tier_trailing.ok, "-fjit-tier-up must reject trailing garbage");
+        ok &= require_(!tier_plus.ok, "-fjit-tier-up must reject signed values");
+        ok &= require_(!tier_overflow.ok, "-fjit-tier-up must reject out-of-range values");
+        return ok;
+    }
+
+    static bool test_value_flag_table_matches_parser_() {
+        // `parus run`이 쓰는 값 플래그 표는 parse_options가 실제로 값을 요구하는 플래그와 같아야 한다.
+        bool ok = true;
+        for (const auto flag : parusc::cli::kValueFlags) {
+            const auto opt = parse_({"main.pr", flag});
+            if (opt.ok || opt.error.find("requires") == std::string::npos) {
+                std::cerr << "  - " << flag << " is listed in kValueFlags but parusc does not require a value\n";
+                ok = false;
+            }
+        }
+        ok &= require_(!parusc::cli::flag_takes_value("-fsyntax-only"), "flag-only options must not be listed");
+        ok &= require_(!parusc::cli::flag_takes_value("--emit-object"), "flag-only options must not be listed");
+        return ok;
+    }
+
 } // namespace
 
 int main() {
@@ -309,6 +380,9 @@ int main() {
         {"goir_internal_flags_parse", test_goir_internal_flags_parse_},
         {"goir_emit_llvm_ir_parse", test_goir_emit_llvm_ir_parse_},
         {"goir_emit_conflicts_with_syntax_only", test_goir_emit_conflicts_with_syntax_only_},
+        {"run_mode_parse", test_run_mode_parse_},
+        {"run_mode_conflicts", test_run_mode_conflicts_},
+        {"value_flag_table_matches_parser", test_value_flag_table_matches_parser_},
     };
 
     int failed = 0;
@@ -2,6 +2,7 @@
 #include <parus/parse/Parser.hpp>
 #include <parus/diag/Render.hpp>
 #include <parus/macro/Expander.hpp>
+#include <parus/macro/Prelude.hpp>
 #include <parus/passes/Passes.hpp>
 #include <parus/cap/CapabilityCheck.hpp>
 #include <parus/tyck/TypeCheck.hpp>
@@ -16,6 +17,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -4265,6 +4267,460 @@ namespace {
         return ok;
     }
 
+    static bool test_imported_fn_template_body_loads_lazily() {
+        const std::string src = R"(
+            def main() -> i32 {
+                let a: i32 = lib_used(1i32);
+                let b: i32 = lib_used(2i32);
+                return a + b;
+            }
+        )";
+        const std::string lib_src = R"(
+            def lib_used<T>(x: T) -> T {
+                return x;
+            }
+
+            def lib_unused<T>(x: T) -> T {
+                let y: T = x;
+                return y;
+            }
+        )";
+
+        auto p = parse_program(src);
+        if (!run_macro_and_type(p)) {
+            return require_(false, "lazy imported template case must parse and resolve types");
+        }
+
+        // export index에서 읽은 template처럼, 같은 arena에 root 밖으로 붙이고 본문은 떼어 둔다.
+        parus::Lexer lib_lx(lib_src, /*file_id=*/2, &p.bag);
+        const auto lib_tokens = lib_lx.lex_all();
+        parus::Parser lib_parser(lib_tokens, p.ast, p.types, &p.bag);
+        const auto lib_root = lib_parser.parse_program();
+        (void)parus::type::resolve_program_types(p.ast, p.types, lib_root, p.bag);
+
+        struct LoadCount {
+            std::string name{};
+            int calls = 0;
+        };
+        auto counts = std::make_shared<std::vector<LoadCount>>();
+        std::vector<parus::tyck::ImportedFnTemplate> templates{};
+        const auto& lib_block = p.ast.stmt(lib_root);
+        for (uint32_t i = 0; i < lib_block.stmt_count; ++i) {
+            const auto sid = p.ast.stmt_children()[lib_block.stmt_begin + i];
+            auto& fn = p.ast.stmt_mut(sid);
+            if (fn.kind != parus::ast::StmtKind::kFnDecl) continue;
+            const auto body = fn.a;
+            fn.a = parus::ast::k_invalid_stmt;
+
+            const size_t slot = counts->size();
+            counts->push_back(LoadCount{std::string(fn.name), 0});
+            parus::tyck::ImportedFnTemplate t{};
+            t.template_sid = sid;
+            t.producer_bundle = "lib";
+            t.public_path = std::string(fn.name);
+            t.link_name = "lib$" + std::string(fn.name);
+            t.is_public_export = true;
+            t.declared_type = fn.type;
+            t.load_body = [counts, slot, body](std::string&) {
+                ++(*counts)[slot].calls;
+                return body;
+            };
+            templates.push_back(std::move(t));
+        }
+
+        // 드라이버처럼 export index 항목을 external symbol로 name resolve에 넘긴다.
+        parus::passes::PassOptions opt{};
+        for (const auto& t : templates) {
+            parus::passes::NameResolveOptions::ExternalExport x{};
+            x.kind = parus::sema::SymbolKind::kFn;
+            x.path = t.public_path;
+            x.link_name = t.link_name;
+            x.declared_type = t.declared_type;
+            x.decl_bundle_name = t.producer_bundle;
+            x.is_export = true;
+            opt.name_resolve.external_exports.push_back(std::move(x));
+        }
+        auto pres = parus::passes::run_on_program(p.ast, p.root, p.bag, opt);
+
+        parus::tyck::TypeChecker tc(p.ast, p.types, p.bag, &p.type_resolve, &pres.generic_prep);
+        tc.set_seed_symbol_table(&pres.sym);
+        tc.set_imported_fn_templates(std::move(templates));
+        const auto ty = tc.check_program(p.root);
+
+        auto calls_of = [&](std::string_view name) {
+            for (const auto& c : *counts) {
+                if (c.name == name) return c.calls;
+            }
+            return -1;
+        };
+
+        bool ok = true;
+        ok &= require_(!p.bag.has_error(), "lazy imported template case must not emit diagnostics");
+        ok &= require_(ty.errors.empty(), "lazy imported template case must not emit tyck errors");
+        ok &= require_(ty.mono_stats.imported_fn_template_available_count == 2,
+            "both imported templates must be registered as available");
+        ok &= require_(ty.mono_stats.imported_fn_template_materialized_count == 1,
+            "only the instantiated imported template must be materialized");
+        ok &= require_(calls_of("lib_used") == 1,
+            "the used template body must be loaded exactly once across repeated instantiations");
+        ok &= require_(calls_of("lib_unused") == 0,
+            "an imported template that is never instantiated must never load its body");
+        return ok;
+    }
+
+    static bool test_generic_instance_clone_keeps_type_pool_clean() {
+        const std::string src = R"(
+            def pick<T>(a: T, b: T, first: bool) -> T {
+                let zz_clone_local_a: T = a;
+                let zz_clone_local_b: T = b;
+                let zz_clone_scale: i32 = 2i32 * 3i32 + 1i32;
+                if (first) {
+                    return zz_clone_local_a;
+                }
+                return zz_clone_local_b;
+            }
+
+            def main() -> i32 {
+                let x: i32 = pick(1i32, 2i32, true);
+                let y: i64 = pick(3i64, 4i64, false);
+                return x;
+            }
+        )";
+
+        auto p = parse_program(src);
+        auto pres = run_passes(p);
+        const size_t exprs_before = p.ast.exprs().size();
+        auto ty = run_tyck(p, &pres.generic_prep);
+        const size_t expr_growth = p.ast.exprs().size() - exprs_before;
+
+        bool ok = true;
+        ok &= require_(!p.bag.has_error(), "generic clone case must not emit diagnostics");
+        ok &= require_(ty.errors.empty(), "generic clone case must not emit tyck errors");
+        ok &= require_(ty.mono_stats.instance_cloned_stmt_count > 0 && ty.mono_stats.instance_cloned_expr_count > 0,
+            "generic instantiation must report the nodes it cloned");
+        // 인스턴스마다 a, b, zz_clone_local_a, zz_clone_local_b, first 5개만 복제하고
+        // 리터럴 subtree(2i32 * 3i32 + 1i32)는 템플릿 노드를 공유한다.
+        ok &= require_(expr_growth == ty.mono_stats.instance_cloned_expr_count,
+            "expr arena growth during tyck must come only from instance cloning");
+        ok &= require_(expr_growth == 10,
+            "two instances must add only their substitution-dependent exprs to the arena");
+        ok &= require_(ty.mono_stats.instance_shared_expr_count == 2,
+            "each instance must share the literal subtree with the template");
+
+        auto sir = run_sir(p, pres, ty);
+        ok &= require_(sir.verify_errors.empty(),
+            "instances that share template expr nodes must still lower to valid SIR");
+
+        bool local_interned = false;
+        for (parus::ty::TypeId t = 0; t < p.types.count(); ++t) {
+            if (p.types.get(t).kind != parus::ty::Kind::kNamedUser) continue;
+            const std::string name = p.types.to_string(t);
+            if (name.find("zz_clone_local") != std::string::npos) local_interned = true;
+        }
+        ok &= require_(!local_interned,
+            "cloning a generic body must not intern local identifier text as a named type");
+        return ok;
+    }
+
+    static bool test_const_eval_bytecode_and_memo() {
+        const std::string src = R"(
+            const def collatz_len(n: i32) -> i32 {
+                set mut x = n;
+                set mut steps = 0i32;
+                while (x != 1i32) {
+                    if (x % 2i32 == 0i32) {
+                        x = x / 2i32;
+                    } else {
+                        x = 3i32 * x + 1i32;
+                    }
+                    steps = steps + 1i32;
+                }
+                return steps;
+            }
+
+            const def table_sum(n: i32) -> i32 {
+                set mut i = 1i32;
+                set mut acc = 0i32;
+                while (i <= n) {
+                    acc = acc + collatz_len(i);
+                    i = i + 1i32;
+                }
+                return acc;
+            }
+
+            const A: i32 = table_sum(16i32);
+            const B: i32 = table_sum(16i32) + collatz_len(27i32);
+
+            def main() -> i32 {
+                return A + B;
+            }
+        )";
+
+        auto p = parse_program(src);
+        auto pres = run_passes(p);
+        auto ty = run_tyck(p, &pres.generic_prep);
+
+        bool ok = true;
+        ok &= require_(!p.bag.has_error(), "const bytecode case must not emit diagnostics");
+        ok &= require_(ty.errors.empty(), "const bytecode case must not emit tyck errors");
+        ok &= require_(ty.const_eval_stats.bytecode_fn_count == 2,
+            "both const defs must compile to bytecode once their bodies are checked");
+        ok &= require_(ty.const_eval_stats.walker_call_count == 0,
+            "const defs without struct/shadowing constructs must not fall back to the AST walker");
+        ok &= require_(ty.const_eval_stats.memo_hit_count >= 1,
+            "repeated const call with identical args must hit the (fn, args) memo");
+
+        bool saw_a = false;
+        bool saw_b = false;
+        for (const auto& [sym, v] : ty.const_symbol_values) {
+            (void)sym;
+            if (v.text == "137") saw_a = true;
+            if (v.text == "248") saw_b = true;
+        }
+        // collatz_len(1..16) 합 = 0+1+7+2+5+8+16+3+19+6+14+9+9+17+17+4 = 137, collatz_len(27) = 111
+        ok &= require_(saw_a, "bytecode const evaluation must match the expected table sum");
+        ok &= require_(saw_b, "memoized const call must produce the same value as the first evaluation");
+        return ok;
+    }
+
+    static bool test_macro_expansion_memo_by_arg_tokens() {
+        const std::string src = R"(
+            macro stash -> {
+                with token {
+                    (zero) => stmt { let tmp: i32 = 0i32; };
+                    ($x: expr) => stmt { let tmp: i32 = $x; };
+                }
+            }
+
+            macro add_one -> {
+                with token {
+                    ($x: expr) => expr { $x + 1i32 };
+                }
+            }
+
+            def main() -> i32 {
+                $stash(1i32 + 2i32);
+                $stash(1i32 + 2i32);
+                $stash(1i32 + 2i32);
+                $stash(zero);
+                let a: i32 = $add_one(1i32 + 2i32);
+                let b: i32 = $add_one(1i32 + 2i32);
+                let c: i32 = $add_one(5i32);
+                return a + b + c;
+            }
+        )";
+
+        auto p = parse_program(src);
+        parus::macro::ExpansionStats stats{};
+        const bool macro_ok = parus::macro::expand_program(p.ast, p.types, p.root, p.bag, {}, &stats);
+        p.macro_type_ready = true;
+        p.type_resolve = parus::type::resolve_program_types(p.ast, p.types, p.root, p.bag);
+        p.macro_type_ok = macro_ok && !p.bag.has_error() && p.type_resolve.ok;
+        auto pres = run_passes(p);
+        auto ty = run_tyck(p, &pres.generic_prep);
+
+        bool ok = true;
+        ok &= require_(macro_ok && !p.bag.has_error(), "memoized macro case must not emit diagnostics");
+        ok &= require_(ty.errors.empty(), "memoized macro case must not emit tyck errors");
+        ok &= require_(stats.expansion_count == 7, "every macro call site must still be expanded");
+        ok &= require_(stats.memo_hit_count == 3,
+            "calls repeating (macro, argument tokens) must reuse the selected arm");
+        ok &= require_(stats.reused_parse_count == 3,
+            "memo hits must clone the first parsed expansion instead of reparsing");
+
+        // 복제한 expr은 별도 노드이고 span은 자기 호출 위치를 가리켜야 한다.
+        parus::ast::ExprId init_a = parus::ast::k_invalid_expr;
+        parus::ast::ExprId init_b = parus::ast::k_invalid_expr;
+        for (const auto& st : p.ast.stmts()) {
+            if (st.kind != parus::ast::StmtKind::kVar) continue;
+            if (st.name == "a") init_a = st.init;
+            if (st.name == "b") init_b = st.init;
+        }
+        ok &= require_(init_a != parus::ast::k_invalid_expr && init_b != parus::ast::k_invalid_expr && init_a != init_b,
+            "reused expansion must be a distinct expr per call site");
+        if (init_a != parus::ast::k_invalid_expr && init_b != parus::ast::k_invalid_expr) {
+            const auto& ea = p.ast.expr(init_a);
+            const auto& eb = p.ast.expr(init_b);
+            // `$x + 1i32`의 span 한쪽 끝은 macro 본문 토큰, 다른 끝은 인자 토큰에서 온다.
+            const auto& arg_a = p.ast.expr(ea.a);
+            ok &= require_(ea.kind == eb.kind && eb.span.lo == ea.span.lo && eb.span.hi > arg_a.span.hi,
+                "reused expansion span must point at its own call site");
+            ok &= require_(p.ast.expr(eb.a).span.lo > arg_a.span.hi,
+                "reused argument subtree span must follow the new argument tokens");
+        }
+
+        // 재사용한 expansion도 호출 위치마다 binder hygiene 이름을 새로 받아야 한다.
+        std::vector<std::string_view> tmp_names{};
+        for (const auto& st : p.ast.stmts()) {
+            if (st.kind != parus::ast::StmtKind::kVar) continue;
+            if (st.name == "tmp") tmp_names.push_back(st.name);
+            if (st.name.starts_with("__pm_g")) tmp_names.push_back(st.name);
+        }
+        std::sort(tmp_names.begin(), tmp_names.end());
+        ok &= require_(tmp_names.size() == 4, "each stash expansion must declare its own binder");
+        ok &= require_(std::adjacent_find(tmp_names.begin(), tmp_names.end()) == tmp_names.end(),
+            "memoized expansions must get fresh hygiene names per call site");
+        return ok;
+    }
+
+    static bool test_macro_token_arm_dispatch_by_first_token() {
+        const std::string src = R"(
+            macro pick -> {
+                with token {
+                    (one) => expr { 1i32 };
+                    (two) => expr { 2i32 };
+                    (three) => expr { 3i32 };
+                    ($x: expr) => expr { $x };
+                }
+            }
+
+            def main() -> i32 {
+                let a: i32 = $pick(three);
+                let b: i32 = $pick(two);
+                let c: i32 = $pick(9i32);
+                return a + b + c;
+            }
+        )";
+
+        auto p = parse_program(src);
+        parus::macro::ExpansionStats stats{};
+        const bool macro_ok = parus::macro::expand_program(p.ast, p.types, p.root, p.bag, {}, &stats);
+
+        bool ok = true;
+        ok &= require_(macro_ok && !p.bag.has_error(), "dispatch macro case must not emit diagnostics");
+        ok &= require_(stats.expansion_count == 3, "every dispatch macro call must expand");
+        // 순차 매칭이면 3 + 2 + 4번 arm을 시도한다. 첫 토큰 dispatch는 호출마다 한 arm만 시도한다.
+        ok &= require_(stats.token_arm_try_count == 3,
+            "first-token dispatch must skip arms whose leading literal cannot match");
+
+        auto q = parse_program(src);
+        parus::macro::ExpansionBudget budget{};
+        (void)parus::macro::clamp_budget(budget);
+        parus::macro::MacroExpansionContext linear{q.ast, q.types, q.bag, budget};
+        linear.arm_dispatch = false;
+        ok &= require_(parus::macro::expand_program(linear, q.root) && !q.bag.has_error(),
+            "linear arm matching must still accept the same calls");
+        ok &= require_(linear.stats.token_arm_try_count == 9, "linear arm matching must try arms in order");
+        return ok;
+    }
+
+    static bool test_macro_prelude_shared_across_units() {
+        const std::string prelude_path = "test://shared_macro_prelude.pr";
+        const std::string prelude_src = R"(
+            export macro twice -> {
+                with token {
+                    ($x: expr) => expr { $x + $x };
+                }
+            }
+
+            macro private_only -> {
+                with token {
+                    ($x: expr) => expr { $x };
+                }
+            }
+        )";
+        const std::string user_src = R"(
+            def main() -> i32 {
+                return $twice(21i32);
+            }
+        )";
+
+        bool ok = true;
+        std::shared_ptr<const parus::macro::MacroPrelude> first{};
+        for (int unit = 0; unit < 2; ++unit) {
+            auto p = parse_program(user_src);
+            std::string err{};
+            bool hit = false;
+            const auto prelude = parus::macro::shared_macro_prelude(
+                prelude_path, prelude_src, /*file_id=*/7u + static_cast<uint32_t>(unit), p.bag, err, &hit);
+            ok &= require_(prelude != nullptr && err.empty(), "shared macro prelude must parse");
+            if (prelude == nullptr) return false;
+            if (unit == 0) first = prelude;
+            ok &= require_(hit == (unit != 0), "second unit must reuse the parsed prelude");
+            ok &= require_(prelude == first, "unchanged prelude text must map to the same shared table");
+
+            parus::macro::append_macro_prelude(prelude, p.ast, 7u + static_cast<uint32_t>(unit));
+            ok &= require_(p.ast.macro_decls().size() == 1, "only exported top-level prelude macros are appended");
+            for (const auto& t : p.ast.macro_tokens()) {
+                if (t.span.file_id != 7u + static_cast<uint32_t>(unit) && t.span.file_id != 1u) {
+                    ok &= require_(false, "appended prelude tokens must carry this unit's prelude file id");
+                    break;
+                }
+            }
+
+            auto pres = run_passes(p);
+            auto ty = run_tyck(p, &pres.generic_prep);
+            ok &= require_(!p.bag.has_error() && ty.errors.empty(), "unit using a shared prelude macro must type-check");
+        }
+
+        auto p = parse_program(user_src);
+        std::string err{};
+        bool hit = true;
+        const auto changed = parus::macro::shared_macro_prelude(
+            prelude_path, prelude_src + "\n", /*file_id=*/9u, p.bag, err, &hit);
+        ok &= require_(changed != nullptr && !hit && changed != first,
+            "prelude text change must invalidate the shared table");
+        return ok;
+    }
+
+    static bool test_const_eval_memo_hit_charges_budgets() {
+        // 첫 평가는 memo만 채우고, 같은 인자의 두 번째 호출은 memo에 적중한다.
+        // 적중해도 원래 평가가 쓴 step/호출 깊이가 예산에 잡혀야 memo가 없을 때와 같은 진단이 난다.
+        const std::string step_src = R"(
+            const def spin(n: i32) -> i32 {
+                set mut i = 0i32;
+                while (i < n) {
+                    i = i + 1i32;
+                }
+                return i;
+            }
+
+            const A: i32 = spin(12000i32);
+            const B: i32 = spin(12000i32) + spin(12000i32);
+
+            def main() -> i32 {
+                return A;
+            }
+        )";
+        const std::string depth_src = R"(
+            const def down(n: i32) -> i32 {
+                if (n == 0i32) {
+                    return 0i32;
+                }
+                return down(n - 1i32);
+            }
+
+            const A: i32 = down(100i32);
+            const B: i32 = down(120i32);
+            const C: i32 = down(200i32);
+
+            def main() -> i32 {
+                return A + B + C;
+            }
+        )";
+
+        bool ok = true;
+        {
+            auto p = parse_program(step_src);
+            auto pres = run_passes(p);
+            auto ty = run_tyck(p, &pres.generic_prep);
+            ok &= require_(count_diag_code_(p.bag, parus::diag::Code::kConstEvalStepLimitExceeded) == 1,
+                "memoized const calls must still charge their step cost to the caller's budget");
+            ok &= require_(ty.const_eval_stats.memo_hit_count >= 1,
+                "the step-budget case must still reuse the memo while the budget allows it");
+        }
+        {
+            auto p = parse_program(depth_src);
+            auto pres = run_passes(p);
+            auto ty = run_tyck(p, &pres.generic_prep);
+            ok &= require_(count_diag_code_(p.bag, parus::diag::Code::kConstEvalCallDepthExceeded) == 1,
+                "memoized const calls must still count the call depth their evaluation needed");
+            ok &= require_(ty.const_eval_stats.memo_hit_count >= 1,
+                "recursive const calls within the depth budget must reuse the memo");
+        }
+        return ok;
+    }
+
     static bool test_file_cases_directory() {
 #ifndef PARUS_FRONTEND_CASE_DIR
         std::cerr << "  - PARUS_FRONTEND_CASE_DIR is not defined\n";
@@ -4425,6 +4881,13 @@ int main(int argc, char** argv) {
         {"generic_type_eq_constraint_mismatch_reports", test_generic_type_eq_constraint_mismatch_reports},
         {"generic_struct_constraint_checked_in_signature_types", test_generic_struct_constraint_checked_in_signature_types},
         {"mono_stats_dedup_repeated_generic_request", test_mono_stats_dedup_repeated_generic_request},
+        {"imported_fn_template_body_loads_lazily", test_imported_fn_template_body_loads_lazily},
+        {"const_eval_bytecode_and_memo", test_const_eval_bytecode_and_memo},
+        {"macro_expansion_memo_by_arg_tokens", test_macro_expansion_memo_by_arg_tokens},
+        {"macro_token_arm_dispatch_by_first_token", test_macro_token_arm_dispatch_by_first_token},
+        {"macro_prelude_shared_across_units", test_macro_prelude_shared_across_units},
+        {"const_eval_memo_hit_charges_budgets", test_const_eval_memo_hit_charges_budgets},
+        {"generic_instance_clone_keeps_type_pool_clean", test_generic_instance_clone_keeps_type_pool_clean},
         {"file_cases_directory", test_file_cases_directory},
     };
 
@@ -1,9 +1,12 @@
 #include <parus/parse/IncrementalParse.hpp>
 #include <parus/diag/Render.hpp>
+#include <parus/lex/Lexer.hpp>
+#include <parus/macro/Expander.hpp>
 
 #include <algorithm>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -166,6 +169,18 @@ static uint64_t ast_fingerprint_(const parus::parse::ParseSnapshot& snap) {
     return h;
 }
 
+template <typename A, typename B>
+static bool tokens_equal_(const A& a, const B& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].kind != b[i].kind || a[i].span.lo != b[i].span.lo || a[i].span.hi != b[i].span.hi ||
+            a[i].span.file_id != b[i].span.file_id || a[i].lexeme != b[i].lexeme) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static bool compare_snapshots_strict_(
     const std::string& tag,
     const parus::diag::Bag& inc_bag,
@@ -189,6 +204,11 @@ static bool compare_snapshots_strict_(
         return false;
     }
 
+    if (!tokens_equal_(inc_snap.tokens, full_snap.tokens)) {
+        std::cerr << "  - " << tag << ": token stream mismatch against full relex\n";
+        return false;
+    }
+
     const auto inc_fp = ast_fingerprint_(inc_snap);
     const auto full_fp = ast_fingerprint_(full_snap);
     if (inc_fp != full_fp) {
@@ -322,6 +342,11 @@ static bool run_case_(const std::filesystem::path& path) {
                       << " at step " << step << ": " << path.filename().string() << "\n";
             return false;
         }
+        if (!inc.last_relex().incremental || inc.last_relex().reused_tokens == 0) {
+            std::cerr << "  - expected incremental relex to reuse tokens at step " << step
+                      << ": " << path.filename().string() << "\n";
+            return false;
+        }
 
         parus::parse::IncrementalParserSession full_step{};
         parus::diag::Bag full_bag{};
@@ -440,6 +465,205 @@ static bool test_structural_newline_forces_fallback_() {
     return compare_snapshots_strict_("structural-newline", inc_bag, inc.snapshot(), full_bag, full.snapshot());
 }
 
+static bool test_incremental_relex_matches_full_lex_() {
+    // 각 편집 뒤 토큰 스트림이 전체 lex와 같아야 한다. 문자열/주석을 열고 닫거나 토큰을 이어 붙이는
+    // 편집은 재동기화 지점이 뒤로 밀리거나 끝까지 다시 읽어야 하는 경우다.
+    struct Edit {
+        const char* find;
+        const char* replace;
+    };
+    static const Edit kEdits[] = {
+        {"return a + b;", "return a + bb;"},       // 식별자 연장
+        {"1i32", "1.5lf"},                          // 숫자 토큰 종류 변경
+        {"def two", "/* def two"},                  // 닫히지 않은 블록 주석(끝까지 주석)
+        {"/* def two", "/* */ def two"},            // 주석 닫기
+        {"let s: text = $\"hi\";", "let s: text = $\"hi;"},   // 닫히지 않은 문자열
+        {"$\"hi;", "$\"hi\";"},                     // 문자열 닫기
+        {"// note", "// note \"quote"},             // 주석 안 편집
+        {"a + bb", "a +bb"},                        // 공백 삭제
+        {"two()", "\xea\xb0\x80()"},                // UTF-8 식별자
+        {"\xea\xb0\x80()", "\xea\xb0\x81()"},      // lead byte를 공유하는 교체
+        {"7.e", "7.5"},                             // 앞 토큰의 lookahead가 편집 지점에 닿는 경우
+    };
+
+    std::string src =
+        "def one(a: i32, b: i32) -> i32 {\n"
+        "    return a + b;\n"
+        "}\n"
+        "\n"
+        "def two() -> i32 {\n"
+        "    let s: text = $\"hi\";\n"
+        "    // note\n"
+        "    let m: f64 = 7.e;\n"
+        "    return 1i32;\n"
+        "}\n"
+        "\n"
+        "def main() -> i32 {\n"
+        "    return two();\n"
+        "}\n";
+
+    parus::parse::IncrementalParserSession inc{};
+    parus::diag::Bag init_bag{};
+    if (!inc.initialize(src, /*file_id=*/1, init_bag)) {
+        std::cerr << "  - relex fixture init failed\n";
+        return false;
+    }
+
+    uint32_t reuse_hits = 0;
+    for (const auto& e : kEdits) {
+        const size_t at = src.find(e.find);
+        if (at == std::string::npos) {
+            std::cerr << "  - relex fixture is missing '" << e.find << "'\n";
+            return false;
+        }
+        std::string next_src = src;
+        next_src.replace(at, std::strlen(e.find), e.replace);
+        const parus::parse::EditWindow edit{static_cast<uint32_t>(at), static_cast<uint32_t>(at + std::strlen(e.find))};
+
+        parus::diag::Bag inc_bag{};
+        if (!inc.reparse_with_edits(next_src, /*file_id=*/1, std::span<const parus::parse::EditWindow>(&edit, 1), inc_bag)) {
+            std::cerr << "  - relex reparse failed for edit '" << e.replace << "'\n";
+            return false;
+        }
+
+        parus::Lexer lx(next_src, /*file_id=*/1);
+        const auto full_tokens = lx.lex_all();
+        if (!tokens_equal_(inc.snapshot().tokens, full_tokens)) {
+            std::cerr << "  - incremental relex mismatch for edit '" << e.replace << "'\n";
+            return false;
+        }
+        if (inc.last_relex().incremental && inc.last_relex().reused_tokens > 0) ++reuse_hits;
+        src = std::move(next_src);
+    }
+
+    if (reuse_hits == 0) {
+        std::cerr << "  - incremental relex never reused previous tokens\n";
+        return false;
+    }
+    return true;
+}
+
+static bool test_repeated_merges_share_arena_without_garbage_() {
+    // 앞쪽 item 노드는 병합마다 그대로 공유되어야 하고(StmtId 불변), 버려진 뒤쪽 item 노드와
+    // 이전 source는 arena/session에 남지 않아야 한다.
+    std::string src{};
+    for (int i = 0; i < 8; ++i) {
+        src += "def f" + std::to_string(i) + "(a: i32) -> i32 {\n    return a + " + std::to_string(i) + "i32;\n}\n\n";
+    }
+    src += "def tail() -> i32 {\n    return 10i32;\n}\n";
+
+    parus::parse::IncrementalParserSession inc{};
+    parus::diag::Bag init_bag{};
+    if (!inc.initialize(src, /*file_id=*/1, init_bag)) {
+        std::cerr << "  - arena fixture init failed\n";
+        return false;
+    }
+    const auto first_sid = inc.snapshot().top_items.front().sid;
+    const size_t baseline_nodes = inc.snapshot().ast.exprs().size() + inc.snapshot().ast.stmts().size();
+
+    size_t merges = 0;
+    size_t max_nodes = 0;
+    for (int round = 0; round < 3000; ++round) {
+        const size_t at = src.find("return ", src.find("def tail")) + 7;
+        const size_t end = src.find("i32;", at);
+        std::string next_src = src;
+        next_src.replace(at, end - at, std::to_string(10 + (round % 90)));
+        const parus::parse::EditWindow edit{static_cast<uint32_t>(at), static_cast<uint32_t>(end)};
+
+        parus::diag::Bag inc_bag{};
+        if (!inc.reparse_with_edits(next_src, /*file_id=*/1, std::span<const parus::parse::EditWindow>(&edit, 1), inc_bag)) {
+            std::cerr << "  - arena reparse failed at round " << round << "\n";
+            return false;
+        }
+        src = std::move(next_src);
+
+        const auto& snap = inc.snapshot();
+        if (inc.last_mode() == parus::parse::ReparseMode::kIncrementalMerge) {
+            ++merges;
+            if (snap.top_items.front().sid != first_sid) {
+                std::cerr << "  - merged snapshot did not reuse the untouched prefix item\n";
+                return false;
+            }
+        }
+        // 앞쪽 item을 파싱한 최초 source와 최신 source만 남는다.
+        if (inc.retained_sources() > 2) {
+            std::cerr << "  - merge retained " << inc.retained_sources() << " source versions ("
+                      << inc.retained_source_bytes() << " bytes)\n";
+            return false;
+        }
+        max_nodes = std::max(max_nodes, snap.ast.exprs().size() + snap.ast.stmts().size());
+    }
+
+    if (merges != 3000) {
+        std::cerr << "  - expected every tail edit to merge incrementally, got " << merges << "\n";
+        return false;
+    }
+    // 병합이 만드는 partial root 하나만 다음 병합 전까지 남는다.
+    if (max_nodes > baseline_nodes + 1) {
+        std::cerr << "  - arena kept replaced nodes: " << max_nodes << " nodes (baseline "
+                  << baseline_nodes << ")\n";
+        return false;
+    }
+
+    parus::parse::IncrementalParserSession full{};
+    parus::diag::Bag full_bag{};
+    if (!full.initialize(src, /*file_id=*/1, full_bag)) {
+        std::cerr << "  - arena fixture full parse failed\n";
+        return false;
+    }
+    parus::diag::Bag inc_bag{};
+    return compare_snapshots_strict_("repeated-merge", inc_bag, inc.snapshot(), full_bag, full.snapshot());
+}
+
+static bool test_merge_drops_replaced_macro_decls_() {
+    // 병합은 뒤쪽 item을 잘라 내고 다시 파싱하므로 이전 MacroDecl이 arena에 남지 않는다.
+    // 두 번의 편집 뒤에도 전개기는 최신 MacroDecl 하나만 본다(ASan으로 source 수명 확인).
+    std::string src =
+        "def head() -> i32 {\n    return 1i32;\n}\n\n"
+        "def mid() -> i32 {\n    return 10i32;\n}\n\n"
+        "macro bump -> {\n    with token {\n        ($x: expr) => expr { $x + 1i32 };\n    }\n}\n\n"
+        "def tail() -> i32 {\n    return $bump(mid());\n}\n";
+
+    parus::parse::IncrementalParserSession inc{};
+    parus::diag::Bag init_bag{};
+    if (!inc.initialize(src, /*file_id=*/1, init_bag)) {
+        std::cerr << "  - macro fixture init failed\n";
+        return false;
+    }
+
+    for (const char* value : {"11", "12"}) {
+        const size_t at = src.find("10i32") != std::string::npos ? src.find("10i32") : src.find("11i32");
+        std::string next_src = src;
+        next_src.replace(at, 2, value);
+        const parus::parse::EditWindow edit{static_cast<uint32_t>(at), static_cast<uint32_t>(at + 2)};
+        parus::diag::Bag inc_bag{};
+        if (!inc.reparse_with_edits(next_src, /*file_id=*/1, std::span<const parus::parse::EditWindow>(&edit, 1), inc_bag)) {
+            std::cerr << "  - macro fixture reparse failed\n";
+            return false;
+        }
+        if (inc.last_mode() != parus::parse::ReparseMode::kIncrementalMerge) {
+            std::cerr << "  - macro fixture tail edit must merge incrementally\n";
+            return false;
+        }
+        src = std::move(next_src);
+    }
+    if (inc.snapshot().ast.macro_decls().size() != 1) {
+        std::cerr << "  - expected replaced macro decls to be dropped from the arena\n";
+        return false;
+    }
+
+    // parusd처럼 스냅샷 사본에서 전개한다.
+    auto ast = inc.snapshot().ast;
+    auto types = inc.snapshot().types;
+    parus::diag::Bag bag{};
+    const bool ok = parus::macro::expand_program(ast, types, inc.snapshot().root, bag, {});
+    if (!ok || bag.has_error()) {
+        std::cerr << "  - macro call after tail edits must expand once\n";
+        return false;
+    }
+    return true;
+}
+
 } // namespace
 
 int main() {
@@ -456,6 +680,9 @@ int main() {
         ++passed;
     }
     if (!test_structural_newline_forces_fallback_()) return 1;
+    if (!test_incremental_relex_matches_full_lex_()) return 1;
+    if (!test_repeated_merges_share_arena_without_garbage_()) return 1;
+    if (!test_merge_drops_replaced_macro_decls_()) return 1;
 
     std::cout << "[incremental-merge] passed " << passed << "/" << files.size() << "\n";
     return 0;
@@ -1,11 +1,14 @@
 #include <parus/diag/Render.hpp>
 #include <parus/lex/Lexer.hpp>
+#include <parus/lex/Scan.hpp>
 #include <parus/parse/Parser.hpp>
+#include <parus/syntax/Keyword.hpp>
 
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -329,6 +332,127 @@ static bool test_file_cases_directory() {
 #endif
 }
 
+static bool test_scan_kernels_match_scalar() {
+    // SIMD 스캔 루틴은 블록 경계/꼬리 위치와 상관없이 scalar와 같은 index를 돌려줘야 한다.
+    const auto* scalar = parus::scan::kernels_for(parus::scan::ScanIsa::kScalar);
+    bool ok = require_(scalar != nullptr, "scalar scan kernels must always exist");
+    if (!ok) return false;
+
+    // 공백/식별자/따옴표/역슬래시/UTF-8 바이트가 고르게 섞이도록 뽑는다.
+    static const char kAlphabet[] = " \t\n\r\v\fazAZ_09@[`{/\"\\*R\x80\xea\xff\x7f";
+    std::mt19937 rng(0x5eedu);
+    std::string buf(256, ' ');
+    for (char& c : buf) c = kAlphabet[rng() % (sizeof(kAlphabet) - 1)];
+
+    for (const auto isa : {parus::scan::ScanIsa::kSse2, parus::scan::ScanIsa::kAvx2}) {
+        const auto* k = parus::scan::kernels_for(isa);
+        if (k == nullptr) {
+            std::cout << "  (skip " << parus::scan::isa_name(isa) << ": unavailable)\n";
+            continue;
+        }
+        for (int round = 0; round < 64 && ok; ++round) {
+            for (char& c : buf) c = kAlphabet[rng() % (sizeof(kAlphabet) - 1)];
+            // 긴 run을 만들어 블록 여러 개를 건너뛰는 경로도 탄다.
+            const size_t run_at = rng() % buf.size();
+            const char run_ch = kAlphabet[rng() % 12];
+            for (size_t i = run_at; i < std::min(buf.size(), run_at + 70); ++i) buf[i] = run_ch;
+
+            for (size_t off = 0; off < 40 && ok; ++off) {
+                for (const size_t len : {size_t{0}, size_t{1}, size_t{15}, size_t{16}, size_t{31}, size_t{33}, buf.size() - off}) {
+                    if (off + len > buf.size()) continue;
+                    const char* p = buf.data() + off;
+                    ok &= require_(k->skip_ascii(p, len) == scalar->skip_ascii(p, len), "skip_ascii mismatch");
+                    ok &= require_(k->skip_space(p, len) == scalar->skip_space(p, len), "skip_space mismatch");
+                    ok &= require_(k->skip_ident(p, len) == scalar->skip_ident(p, len), "skip_ident mismatch");
+                    ok &= require_(k->find_byte(p, len, '*') == scalar->find_byte(p, len, '*'), "find_byte mismatch");
+                    ok &= require_(k->find_byte2(p, len, '"', '\\') == scalar->find_byte2(p, len, '"', '\\'),
+                                   "find_byte2 mismatch");
+                    if (!ok) {
+                        std::cerr << "    isa=" << parus::scan::isa_name(isa) << " off=" << off << " len=" << len << "\n";
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // 식별자 run 끝의 R/F는 prefixed triple-string 시작으로 떼어 낸다.
+    const std::string src = "$fooR\"\"\"x\"\"\" name /* c */ \"a\\\"b\" // tail";
+    parus::Lexer lx(src, /*file_id=*/1);
+    const auto toks = lx.lex_all();
+    std::vector<std::string_view> lexemes{};
+    for (const auto& t : toks) lexemes.push_back(t.lexeme);
+    ok &= require_(lexemes.size() == 6, "scan lexer sample must produce 5 tokens + eof");
+    if (lexemes.size() == 6) {
+        ok &= require_(lexemes[1] == "foo", "identifier run must stop before R\"\"\"");
+        ok &= require_(lexemes[2] == "R\"\"\"x\"\"\"", "prefixed triple string must follow the identifier");
+        ok &= require_(lexemes[3] == "name", "block comment must be skipped");
+        ok &= require_(lexemes[4] == "\"a\\\"b\"", "escaped quote must not end the string");
+    }
+    return ok;
+}
+
+static bool test_keyword_table_round_trip() {
+    // 표의 모든 철자는 lexer에서 그 kind로 읽히고, 한 글자만 바꾸면 식별자로 읽혀야 한다.
+    bool ok = true;
+    for (const auto& e : parus::syntax::k_keyword_table) {
+        const std::string text(e.text);
+        parus::Lexer lx(text, /*file_id=*/1);
+        const auto toks = lx.lex_all();
+        ok &= require_(toks.size() == 2 && toks[0].kind == e.kind, "keyword spelling must lex to its table kind");
+        ok &= require_(parus::syntax::is_keyword_kind(e.kind), "table kind must be reported as keyword kind");
+
+        std::string near = text;
+        near.back() = (near.back() == 'z') ? 'y' : 'z';
+        ok &= require_(parus::syntax::keyword_kind(near) == parus::syntax::TokenKind::kIdent,
+                       "near-miss spelling must stay an identifier");
+        ok &= require_(parus::syntax::keyword_kind(text + "_") == parus::syntax::TokenKind::kIdent,
+                       "keyword prefix must stay an identifier");
+        if (!ok) {
+            std::cerr << "    keyword=" << text << "\n";
+            return false;
+        }
+    }
+    ok &= require_(!parus::syntax::is_keyword_kind(parus::syntax::TokenKind::kIdent), "kIdent is not a keyword kind");
+    return ok;
+}
+
+static bool test_token_stream_round_trip() {
+    // CompactToken으로 보관한 스트림은 lexer 출력과 kind/span/lexeme가 모두 같아야 한다.
+#ifndef PARUS_PARSER_CASE_DIR
+    std::cerr << "  - PARUS_PARSER_CASE_DIR is not defined\n";
+    return false;
+#else
+    bool ok = require_(sizeof(parus::CompactToken) <= 12, "CompactToken must stay within 12 bytes");
+    std::vector<std::string> sources = {
+        "def main() -> i32 { let s = \"a\\\"b\"; return 0; }",
+        "// 주석\nlet r = R\"\"\"\n  raw \"\"\" text\n\"\"\";",
+        "",
+    };
+    for (const auto& entry : std::filesystem::directory_iterator(PARUS_PARSER_CASE_DIR)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".pr") continue;
+        std::string src{};
+        if (read_text_file_(entry.path(), src)) sources.push_back(std::move(src));
+    }
+
+    for (const auto& src : sources) {
+        parus::Lexer lx(src, /*file_id=*/7);
+        const auto toks = lx.lex_all();
+        const parus::TokenStream stream(src, /*file_id=*/7, toks);
+        ok &= require_(stream.size() == toks.size(), "token stream size mismatch");
+        for (size_t i = 0; ok && i < toks.size(); ++i) {
+            const auto t = stream[i];
+            ok &= require_(t.kind == toks[i].kind && t.span.file_id == 7 && t.span.lo == toks[i].span.lo &&
+                               t.span.hi == toks[i].span.hi && t.lexeme == toks[i].lexeme,
+                           "compact token must rebuild the lexer token");
+        }
+        ok &= require_(stream.lower_bound(0) == 0, "lower_bound(0) must be the first token");
+        if (!ok) return false;
+    }
+    return ok;
+#endif
+}
+
 } // namespace
 
 int main() {
@@ -343,6 +467,9 @@ int main() {
         {"recovery_nested_delim_survives", test_recovery_nested_delim_survives},
         {"expect_directive_precedence", test_expect_directive_precedence},
         {"file_cases_directory", test_file_cases_directory},
+        {"scan_kernels_match_scalar", test_scan_kernels_match_scalar},
+        {"keyword_table_round_trip", test_keyword_table_round_trip},
+        {"token_stream_round_trip", test_token_stream_round_trip},
     };
 
     int failed = 0;
@@ -321,6 +321,72 @@ bool test_tool_passthrough() {
     return true;
 }
 
+bool test_run_flag_value_not_taken_as_source() {
+    const std::string bin = PARUS_BUILD_BIN;
+    auto [rc, out] = run_capture("\"" + bin + "\" run --sysroot /p");
+    if (rc == 0 || !contains(out, "run command requires a source file")) {
+        std::cerr << "run must not take a flag value as the source file\n" << out;
+        return false;
+    }
+    return true;
+}
+
+bool test_jit_run_tier_up_hot_function() {
+    const std::string parusc = PARUSC_BUILD_BIN;
+    const auto sysroot_and_target = resolve_installed_sysroot_and_target();
+    if (!sysroot_and_target) {
+        std::cerr << "failed to resolve installed sysroot for jit tier-up test\n";
+        return false;
+    }
+    const auto& [sysroot, _target] = *sysroot_and_target;
+    std::error_code ec{};
+    const auto temp_root = std::filesystem::temp_directory_path(ec) / "parus-cli-jit-tier-up";
+    std::filesystem::remove_all(temp_root, ec);
+    std::filesystem::create_directories(temp_root, ec);
+    if (ec) {
+        std::cerr << "temp dir create failed\n";
+        return false;
+    }
+
+    const auto main_pr = temp_root / "main.pr";
+    const std::string main_src =
+        "def fib(n: i32) -> i32 {\n"
+        "  if (n < 2i32) {\n"
+        "    return n;\n"
+        "  }\n"
+        "  return fib(n - 1i32) + fib(n - 2i32);\n"
+        "}\n"
+        "\n"
+        "def main() -> i32 {\n"
+        "  if (fib(20i32) == 6765i32) {\n"
+        "    return 7i32;\n"
+        "  }\n"
+        "  return 1i32;\n"
+        "}\n";
+    if (!write_text(main_pr, main_src)) {
+        std::cerr << "failed to write jit tier-up sample\n";
+        std::filesystem::remove_all(temp_root, ec);
+        return false;
+    }
+
+    auto [rc, out] = run_capture(
+        "\"" + parusc + "\" run -fjit-tier-up=3 -fjit-stats \"" + main_pr.string() + "\"" +
+        " --sysroot \"" + sysroot + "\"; echo EXIT:$?");
+    std::filesystem::remove_all(temp_root, ec);
+    if (contains(out, "built without JIT backend support")) {
+        return rc == 0 && !contains(out, "EXIT:0");
+    }
+    if (rc != 0 || !contains(out, "EXIT:7")) {
+        std::cerr << "jit tier-up sample exit mismatch (expected 7)\n" << out;
+        return false;
+    }
+    if (!contains(out, "tiered_up=") || contains(out, "tiered_up=0 ") || !contains(out, "jit-stats: hot ")) {
+        std::cerr << "hot recursive function must be tiered up after 3 calls\n" << out;
+        return false;
+    }
+    return true;
+}
+
 bool test_bundle_strict_export_violation() {
     const std::string bin = PARUS_BUILD_BIN;
 
@@ -9957,6 +10023,8 @@ int main() {
     const bool ok126 = test_exception_c_abi_wrapper_runtime();
     const bool ok127 = test_exception_imported_direct_typed_catch_runtime();
     const bool ok128 = test_exception_recoverable_payload_envelope_rejected();
+    const bool ok129 = test_run_flag_value_not_taken_as_source();
+    const bool ok130 = test_jit_run_tier_up_hot_function();
 
     if (!ok1 || !ok2 || !ok3 || !ok4 || !ok5 || !ok6 || !ok7 || !ok8 || !ok9 || !ok10 || !ok11 ||
         !ok12 || !ok13 || !ok14 || !ok15 || !ok16 || !ok17 || !ok18 || !ok19 || !ok20 || !ok21 || !ok22 || !ok23 ||
@@ -9969,7 +10037,7 @@ int main() {
         !ok95 || !ok96 || !ok97 || !ok98 || !ok99 || !ok100 || !ok101 || !ok102 || !ok103 || !ok104 || !ok105 ||
         !ok106 || !ok107 || !ok108 || !ok109 || !ok110 || !ok111 || !ok112 || !ok113 || !ok114 || !ok115 ||
         !ok116 || !ok117 || !ok118 || !ok119 || !ok120 || !ok121 || !ok122 || !ok123 || !ok124 || !ok125 ||
-        !ok126 || !ok127 || !ok128) {
+        !ok126 || !ok127 || !ok128 || !ok129 || !ok130) {
         return 1;
     }
 
@@ -93,7 +93,9 @@ std::string run_lsp_session(
         return "failed to write input stream";
     }
 
-    std::string cmd = "PARUS_NO_CORE=1 ";
+    // parusd 워크스페이스 인덱스 저장본이 사용자 캐시를 더럽히지 않도록 임시 디렉터리로 돌린다.
+    std::string cmd = "PARUS_NO_CORE=1 XDG_CACHE_HOME=\""
+        + (std::filesystem::temp_directory_path() / "parusd-lsp-tests-cache").string() + "\" ";
     if (!env_prefix.empty()) {
         cmd += std::string(env_prefix) + " ";
     }
@@ -144,7 +146,7 @@ bool test_valid_lei_and_semantic_empty() {
         std::cerr << "expected empty diagnostics for valid lei\n" << out << "\n";
         return false;
     }
-    if (!contains(out, "\"id\":2") || !contains(out, "\"result\":{\"data\":[]}")) {
+    if (!contains(out, "\"id\":2") || !contains(out, "\"result\":{\"resultId\":\"1\",\"data\":[]}")) {
         std::cerr << "expected empty semantic token result for lei\n" << out << "\n";
         return false;
     }
@@ -911,7 +913,8 @@ bool test_parus_incremental_newline_falls_back_cleanly() {
     };
 
     int rc = 0;
-    const std::string out = run_lsp_session(payloads, rc, "PARUSD_TRACE_INCREMENTAL=1");
+    // 편집마다 진단/trace가 남아야 하므로 분석 워커의 revision 합치기를 끄고 돌린다.
+    const std::string out = run_lsp_session(payloads, rc, "PARUSD_TRACE_INCREMENTAL=1 PARUSD_SYNC_ANALYSIS=1");
     if (rc != 0) {
         std::cerr << "incremental actor newline lsp session failed, rc=" << rc << "\n" << out << "\n";
         return false;
@@ -928,6 +931,773 @@ bool test_parus_incremental_newline_falls_back_cleanly() {
     return true;
 }
 
+size_t count_occurrences(std::string_view haystack, std::string_view needle) {
+    size_t n = 0;
+    for (size_t pos = haystack.find(needle); pos != std::string_view::npos; pos = haystack.find(needle, pos + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+bool test_background_analysis_coalesces_and_cancels() {
+    const std::string uri = "file:///tmp/parusd_background_worker.pr";
+    const std::string text =
+        "def add(a: i32, b: i32) -> i32 {\\n"
+        "  return a + b;\\n"
+        "}\\n"
+        "def main() -> i32 {\\n"
+        "  return add(a: 1i32, b: 2i32);\\n"
+        "}\\n";
+
+    std::vector<std::string> payloads{
+        R"({"jsonrpc":"2.0","id":51,"method":"initialize","params":{"processId":null,"rootUri":null,"capabilities":{}}})",
+        R"({"jsonrpc":"2.0","method":"initialized","params":{}})",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":\"" + uri
+            + "\",\"languageId\":\"parus\",\"version\":1,\"text\":\"" + text + "\"}}}",
+        "{\"jsonrpc\":\"2.0\",\"id\":52,\"method\":\"textDocument/definition\",\"params\":{\"textDocument\":{\"uri\":\""
+            + uri + "\"},\"position\":{\"line\":4,\"character\":10}}}",
+        R"({"jsonrpc":"2.0","method":"$/cancelRequest","params":{"id":52}})",
+        R"({"jsonrpc":"2.0","method":"$/cancelRequest","params":{"id":9999}})",
+    };
+    for (int v = 2; v <= 6; ++v) {
+        payloads.push_back(
+            "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{\"textDocument\":{\"uri\":\"" + uri
+            + "\",\"version\":" + std::to_string(v) + "},\"contentChanges\":[{\"range\":{\"start\":{\"line\":5,\"character\":1},"
+            "\"end\":{\"line\":5,\"character\":1}},\"text\":\"\\n\"}]}}");
+    }
+    payloads.push_back(
+        "{\"jsonrpc\":\"2.0\",\"id\":53,\"method\":\"textDocument/completion\",\"params\":{\"textDocument\":{\"uri\":\""
+        + uri + "\"},\"position\":{\"line\":4,\"character\":9}}}");
+    payloads.push_back(R"({"jsonrpc":"2.0","id":54,"method":"shutdown","params":{}})");
+    payloads.push_back(R"({"jsonrpc":"2.0","method":"exit","params":{}})");
+
+    int rc = 0;
+    const std::string out = run_lsp_session(payloads, rc);
+    if (rc != 0) {
+        std::cerr << "background analysis session failed, rc=" << rc << "\n" << out << "\n";
+        return false;
+    }
+    // definition은 분석 완료 전에 취소되면 RequestCancelled, 아니면 정상 결과로 정확히 한 번 응답한다.
+    if (count_occurrences(out, "\"id\":52") != 1) {
+        std::cerr << "deferred definition request must be answered exactly once\n" << out << "\n";
+        return false;
+    }
+    if (contains(out, "\"id\":9999")) {
+        std::cerr << "cancel for an unknown request id must not produce a response\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "\"id\":53") || !contains(out, "\"label\":\"add\"")) {
+        std::cerr << "completion must be served from the last good analysis\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "\"uri\":\"" + uri + "\",\"version\":6,\"diagnostics\":")) {
+        std::cerr << "diagnostics for the latest version must be published before shutdown\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "\"id\":54,\"result\":null")) {
+        std::cerr << "shutdown must be answered after pending analysis\n" << out << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool test_did_close_releases_work_copies() {
+    const std::string uri_a = "file:///tmp/parusd_close_a.pr";
+    const std::string uri_b = "file:///tmp/parusd_close_b.pr";
+    const std::string text =
+        "def add(a: i32, b: i32) -> i32 {\\n"
+        "  return a + b;\\n"
+        "}\\n";
+    const auto did_open = [&](const std::string& uri) {
+        return "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":\"" + uri
+            + "\",\"languageId\":\"parus\",\"version\":1,\"text\":\"" + text + "\"}}}";
+    };
+    const auto did_close = [&](const std::string& uri) {
+        return "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didClose\",\"params\":{\"textDocument\":{\"uri\":\""
+            + uri + "\"}}}";
+    };
+    std::vector<std::string> payloads{
+        R"({"jsonrpc":"2.0","id":81,"method":"initialize","params":{"processId":null,"rootUri":null,"capabilities":{}}})",
+        R"({"jsonrpc":"2.0","method":"initialized","params":{}})",
+        did_open(uri_a),
+        did_open(uri_b),
+        "{\"jsonrpc\":\"2.0\",\"id\":82,\"method\":\"textDocument/completion\",\"params\":{\"textDocument\":{\"uri\":\""
+            + uri_a + "\"},\"position\":{\"line\":1,\"character\":2}}}",
+        "{\"jsonrpc\":\"2.0\",\"id\":83,\"method\":\"textDocument/completion\",\"params\":{\"textDocument\":{\"uri\":\""
+            + uri_b + "\"},\"position\":{\"line\":1,\"character\":2}}}",
+        did_close(uri_a),
+        did_close(uri_b),
+        R"({"jsonrpc":"2.0","id":84,"method":"shutdown","params":{}})",
+        R"({"jsonrpc":"2.0","method":"exit","params":{}})",
+    };
+
+    // 동기 분석(닫기 전에 작업이 끝남)과 백그라운드 워커 모두 닫힌 문서의 작업 사본을 남기지 않아야 한다.
+    for (const std::string_view env : {std::string_view("PARUSD_TRACE_ANALYSIS_STATS=1 PARUSD_SYNC_ANALYSIS=1"),
+                                       std::string_view("PARUSD_TRACE_ANALYSIS_STATS=1")}) {
+        int rc = 0;
+        const std::string out = run_lsp_session(payloads, rc, env);
+        if (rc != 0) {
+            std::cerr << "didClose session failed, rc=" << rc << "\n" << out << "\n";
+            return false;
+        }
+        if (!contains(out, "\"id\":82") || !contains(out, "\"id\":83")) {
+            std::cerr << "completion must be answered for both documents\n" << out << "\n";
+            return false;
+        }
+        if (!contains(out, "[parusd] analysis-stats") || !contains(out, " work_docs=0\n")) {
+            std::cerr << "didClose must release the analysis work copy (" << env << ")\n" << out << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_semantic_tokens_delta_and_range() {
+    const std::string uri = "file:///tmp/parusd_semantic_delta.pr";
+    const std::string text =
+        "def add(a: i32, b: i32) -> i32 {\\n"
+        "  return a + b;\\n"
+        "}\\n"
+        "def main() -> i32 {\\n"
+        "  return add(1i32, 2i32);\\n"
+        "}\\n";
+
+    std::vector<std::string> payloads{
+        R"({"jsonrpc":"2.0","id":61,"method":"initialize","params":{"processId":null,"rootUri":null,"capabilities":{}}})",
+        R"({"jsonrpc":"2.0","method":"initialized","params":{}})",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":\"" + uri
+            + "\",\"languageId\":\"parus\",\"version\":1,\"text\":\"" + text + "\"}}}",
+        "{\"jsonrpc\":\"2.0\",\"id\":62,\"method\":\"textDocument/semanticTokens/full\",\"params\":{\"textDocument\":{\"uri\":\""
+            + uri + "\"}}}",
+        "{\"jsonrpc\":\"2.0\",\"id\":63,\"method\":\"textDocument/semanticTokens/full/delta\",\"params\":{\"textDocument\":{\"uri\":\""
+            + uri + "\"},\"previousResultId\":\"1\"}}",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{\"textDocument\":{\"uri\":\"" + uri
+            + "\",\"version\":2},\"contentChanges\":[{\"range\":{\"start\":{\"line\":3,\"character\":0},"
+              "\"end\":{\"line\":3,\"character\":0}},\"text\":\"\\n\"}]}}",
+        "{\"jsonrpc\":\"2.0\",\"id\":64,\"method\":\"textDocument/semanticTokens/full/delta\",\"params\":{\"textDocument\":{\"uri\":\""
+            + uri + "\"},\"previousResultId\":\"1\"}}",
+        "{\"jsonrpc\":\"2.0\",\"id\":65,\"method\":\"textDocument/semanticTokens/full/delta\",\"params\":{\"textDocument\":{\"uri\":\""
+            + uri + "\"},\"previousResultId\":\"stale\"}}",
+        "{\"jsonrpc\":\"2.0\",\"id\":66,\"method\":\"textDocument/semanticTokens/range\",\"params\":{\"textDocument\":{\"uri\":\""
+            + uri + "\"},\"range\":{\"start\":{\"line\":0,\"character\":0},\"end\":{\"line\":1,\"character\":0}}}}",
+        R"({"jsonrpc":"2.0","id":67,"method":"shutdown","params":{}})",
+        R"({"jsonrpc":"2.0","method":"exit","params":{}})",
+    };
+
+    int rc = 0;
+    // 편집 직후 delta가 새 분석 결과를 보도록 동기 분석으로 돌린다.
+    const std::string out = run_lsp_session(payloads, rc, "PARUSD_SYNC_ANALYSIS=1");
+    if (rc != 0) {
+        std::cerr << "semantic tokens delta session failed, rc=" << rc << "\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "\"semanticTokensProvider\"") || !contains(out, "\"full\":{\"delta\":true},\"range\":true")) {
+        std::cerr << "initialize must advertise semantic token delta and range support\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "\"id\":62,\"result\":{\"resultId\":\"1\",\"data\":[0,")) {
+        std::cerr << "full semantic tokens must carry a resultId\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "\"id\":63,\"result\":{\"resultId\":\"1\",\"edits\":[]}")) {
+        std::cerr << "delta without changes must return empty edits\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "\"id\":64,\"result\":{\"resultId\":\"2\",\"edits\":[{\"start\":")) {
+        std::cerr << "delta after an edit must return a single token edit\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "\"id\":65,\"result\":{\"resultId\":\"3\",\"data\":[")) {
+        std::cerr << "delta with an unknown previousResultId must fall back to full tokens\n" << out << "\n";
+        return false;
+    }
+    const auto range_pos = out.find("\"id\":66,\"result\":{\"data\":[0,");
+    if (range_pos == std::string::npos) {
+        std::cerr << "range semantic tokens must return viewport data\n" << out << "\n";
+        return false;
+    }
+    // range는 0번째 줄 토큰만 포함하므로 줄 증가(delta_line) 값이 모두 0이어야 한다.
+    const auto range_end = out.find(']', range_pos);
+    const std::string range_data = out.substr(range_pos, range_end - range_pos);
+    const auto first_values = range_data.find("[0,");
+    for (size_t i = first_values + 1, field = 0; i < range_data.size(); ++field) {
+        const size_t comma = range_data.find(',', i);
+        const std::string value = range_data.substr(i, comma == std::string::npos ? std::string::npos : comma - i);
+        if (field % 5 == 0 && value != "0") {
+            std::cerr << "range semantic tokens must not include tokens outside the range\n" << out << "\n";
+            return false;
+        }
+        if (comma == std::string::npos) break;
+        i = comma + 1;
+    }
+    return true;
+}
+
+bool test_pull_diagnostics_and_debounce() {
+    const std::string uri = "file:///tmp/parusd_pull_diag.pr";
+    const std::string text =
+        "def add(a: i32, b: i32) -> i32 {\\n"
+        "  return a + b;\\n"
+        "}\\n";
+    const auto did_change = [&](int version) {
+        return "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{\"textDocument\":{\"uri\":\"" + uri
+            + "\",\"version\":" + std::to_string(version)
+            + "},\"contentChanges\":[{\"range\":{\"start\":{\"line\":3,\"character\":0},"
+              "\"end\":{\"line\":3,\"character\":0}},\"text\":\"\\n\"}]}}";
+    };
+    const std::string did_open =
+        "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":\"" + uri
+        + "\",\"languageId\":\"parus\",\"version\":1,\"text\":\"" + text + "\"}}}";
+
+    // pull 모드: 클라이언트가 textDocument.diagnostic을 지원하면 push 없이 요청에만 응답한다.
+    std::vector<std::string> pull_payloads{
+        R"({"jsonrpc":"2.0","id":71,"method":"initialize","params":{"processId":null,"rootUri":null,"capabilities":{"textDocument":{"diagnostic":{}}},"initializationOptions":{"parus":{"diagnostics":{"debounceMs":500}}}}})",
+        R"({"jsonrpc":"2.0","method":"initialized","params":{}})",
+        did_open,
+        did_change(2),
+        did_change(3),
+        did_change(4),
+        "{\"jsonrpc\":\"2.0\",\"id\":72,\"method\":\"textDocument/diagnostic\",\"params\":{\"textDocument\":{\"uri\":\""
+            + uri + "\"}}}",
+        "{\"jsonrpc\":\"2.0\",\"id\":73,\"method\":\"textDocument/diagnostic\",\"params\":{\"textDocument\":{\"uri\":\""
+            + uri + "\"},\"previousResultId\":\"4\"}}",
+        R"({"jsonrpc":"2.0","id":74,"method":"shutdown","params":{}})",
+        R"({"jsonrpc":"2.0","method":"exit","params":{}})",
+    };
+
+    int rc = 0;
+    const std::string out = run_lsp_session(pull_payloads, rc, "PARUSD_TRACE_ANALYSIS_STATS=1");
+    if (rc != 0) {
+        std::cerr << "pull diagnostics session failed, rc=" << rc << "\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "\"diagnosticProvider\":{\"interFileDependencies\":true,\"workspaceDiagnostics\":false}")) {
+        std::cerr << "initialize must advertise diagnosticProvider\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "\"id\":72,\"result\":{\"kind\":\"full\",\"resultId\":\"4\",\"items\":[")) {
+        std::cerr << "pull diagnostics must report the latest revision\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "\"id\":73,\"result\":{\"kind\":\"unchanged\",\"resultId\":\"4\"}")) {
+        std::cerr << "pull diagnostics with the current resultId must be unchanged\n" << out << "\n";
+        return false;
+    }
+    if (contains(out, "textDocument/publishDiagnostics")) {
+        std::cerr << "pull mode must not push diagnostics\n" << out << "\n";
+        return false;
+    }
+    const auto stats_pos = out.find("[parusd] analysis-stats");
+    if (stats_pos == std::string::npos || !contains(out, "pull_full=1 pull_unchanged=1")) {
+        std::cerr << "expected analysis stats log\n" << out << "\n";
+        return false;
+    }
+    const auto coalesced_pos = out.find("coalesced=", stats_pos);
+    if (coalesced_pos == std::string::npos
+        || std::atoi(out.c_str() + coalesced_pos + std::string_view("coalesced=").size()) < 2) {
+        std::cerr << "debounced edits must be coalesced into one analysis\n" << out << "\n";
+        return false;
+    }
+
+    // push 모드: debounce 창 안의 연속 편집은 마지막 version 하나로만 publish된다.
+    std::vector<std::string> push_payloads{
+        R"({"jsonrpc":"2.0","id":75,"method":"initialize","params":{"processId":null,"rootUri":null,"capabilities":{},"initializationOptions":{"parus":{"diagnostics":{"debounceMs":500}}}}})",
+        R"({"jsonrpc":"2.0","method":"initialized","params":{}})",
+        did_open,
+        did_change(2),
+        did_change(3),
+        did_change(4),
+        R"({"jsonrpc":"2.0","id":76,"method":"shutdown","params":{}})",
+        R"({"jsonrpc":"2.0","method":"exit","params":{}})",
+    };
+    const std::string push_out = run_lsp_session(push_payloads, rc);
+    if (rc != 0) {
+        std::cerr << "debounced push session failed, rc=" << rc << "\n" << push_out << "\n";
+        return false;
+    }
+    if (!contains(push_out, "\"uri\":\"" + uri + "\",\"version\":4,\"diagnostics\":")) {
+        std::cerr << "expected diagnostics for the final version\n" << push_out << "\n";
+        return false;
+    }
+    if (contains(push_out, "\"version\":2,\"diagnostics\":") || contains(push_out, "\"version\":3,\"diagnostics\":")) {
+        std::cerr << "debounced edits must not publish intermediate versions\n" << push_out << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool test_pull_lei_change_requests_diagnostic_refresh() {
+    const auto stamp = std::to_string(
+        static_cast<long long>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    const auto root = std::filesystem::temp_directory_path() / ("parusd-lei-pull-refresh-" + stamp);
+    const auto config_lei = root / "config.lei";
+    const auto main_pr = root / "src" / "main.pr";
+    const std::string main_text =
+        "def main() -> i32 {\n"
+        "  return 0i32;\n"
+        "}\n";
+    if (!write_text(config_lei, "plan master = master & {};\n") || !write_text(main_pr, main_text)) {
+        std::cerr << "failed to write pull refresh fixture\n";
+        std::error_code ec{};
+        std::filesystem::remove_all(root, ec);
+        return false;
+    }
+
+    const std::string main_uri = to_file_uri(main_pr);
+    const std::string lei_uri = to_file_uri(config_lei);
+    const auto payloads_for = [&](std::string_view capabilities) {
+        return std::vector<std::string>{
+            "{\"jsonrpc\":\"2.0\",\"id\":91,\"method\":\"initialize\",\"params\":{\"processId\":null,\"rootUri\":null,"
+                "\"capabilities\":" + std::string(capabilities) + "}}",
+            R"({"jsonrpc":"2.0","method":"initialized","params":{}})",
+            "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":\""
+                + json_escape(main_uri) + "\",\"languageId\":\"parus\",\"version\":1,\"text\":\""
+                + json_escape(main_text) + "\"}}}",
+            "{\"jsonrpc\":\"2.0\",\"method\":\"workspace/didChangeWatchedFiles\",\"params\":{\"changes\":[{\"uri\":\""
+                + json_escape(lei_uri) + "\",\"type\":2}]}}",
+            R"({"jsonrpc":"2.0","id":92,"method":"shutdown","params":{}})",
+            R"({"jsonrpc":"2.0","method":"exit","params":{}})",
+        };
+    };
+
+    int push_rc = 0;
+    const std::string push_out = run_lsp_session(payloads_for("{}"), push_rc, "PARUSD_SYNC_ANALYSIS=1");
+    int pull_rc = 0;
+    const std::string pull_out = run_lsp_session(
+        payloads_for(R"({"textDocument":{"diagnostic":{}},"workspace":{"diagnostics":{"refreshSupport":true}}})"),
+        pull_rc, "PARUSD_SYNC_ANALYSIS=1");
+    int no_support_rc = 0;
+    const std::string no_support_out = run_lsp_session(
+        payloads_for(R"({"textDocument":{"diagnostic":{}}})"), no_support_rc, "PARUSD_SYNC_ANALYSIS=1");
+    std::error_code ec{};
+    std::filesystem::remove_all(root, ec);
+
+    if (push_rc != 0 || pull_rc != 0 || no_support_rc != 0) {
+        std::cerr << "pull refresh sessions failed\n" << push_out << "\n" << pull_out << "\n" << no_support_out << "\n";
+        return false;
+    }
+    if (contains(push_out, "workspace/diagnostic/refresh") || contains(no_support_out, "workspace/diagnostic/refresh")) {
+        std::cerr << "diagnostic refresh must only go to pull clients with refreshSupport\n"
+                  << push_out << "\n" << no_support_out << "\n";
+        return false;
+    }
+    if (count_occurrences(pull_out, "\"method\":\"workspace/diagnostic/refresh\"") != 1) {
+        std::cerr << "pull-mode lei change must request a diagnostic refresh for re-checked documents\n"
+                  << pull_out << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool test_incremental_tyck_reuses_unchanged_items() {
+    const std::string uri = "file:///tmp/parusd_incremental_tyck.pr";
+    const std::string text =
+        "def add(a: i32, b: i32) -> i32 {\\n"
+        "  return a + b;\\n"
+        "}\\n"
+        "\\n"
+        "def diff(a: i32, b: i32) -> i32 {\\n"
+        "  let x: bool = 1i32;\\n"
+        "  return a - b;\\n"
+        "}\\n"
+        "\\n"
+        "def main() -> i32 {\\n"
+        "  return add(1i32, 2i32);\\n"
+        "}\\n";
+    const auto did_change = [&](int version, int line, int start, int end, std::string_view new_text) {
+        return "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{\"textDocument\":{\"uri\":\"" + uri
+            + "\",\"version\":" + std::to_string(version)
+            + "},\"contentChanges\":[{\"range\":{\"start\":{\"line\":" + std::to_string(line)
+            + ",\"character\":" + std::to_string(start) + "},\"end\":{\"line\":" + std::to_string(line)
+            + ",\"character\":" + std::to_string(end) + "}},\"text\":\"" + std::string(new_text) + "\"}]}}";
+    };
+
+    std::vector<std::string> payloads{
+        R"({"jsonrpc":"2.0","id":81,"method":"initialize","params":{"processId":null,"rootUri":null,"capabilities":{}}})",
+        R"({"jsonrpc":"2.0","method":"initialized","params":{}})",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":\"" + uri
+            + "\",\"languageId\":\"parus\",\"version\":1,\"text\":\"" + text + "\"}}}",
+        // main 본문만 수정: add/diff는 재사용된다.
+        did_change(2, 10, 13, 14, "3"),
+        // add 시그니처 수정: add와 add를 호출하는 main은 다시 검사된다.
+        did_change(3, 0, 11, 14, "i64"),
+        R"({"jsonrpc":"2.0","id":82,"method":"shutdown","params":{}})",
+        R"({"jsonrpc":"2.0","method":"exit","params":{}})",
+    };
+
+    int rc = 0;
+    const std::string out = run_lsp_session(payloads, rc, "PARUSD_TRACE_INCREMENTAL=1 PARUSD_SYNC_ANALYSIS=1");
+    if (rc != 0) {
+        std::cerr << "incremental tyck session failed, rc=" << rc << "\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "revision=1 parse=full tyck=full reused=0/3")) {
+        std::cerr << "first analysis must type-check every item\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "tyck=incremental reused=2/3")) {
+        std::cerr << "body-only edit must reuse the other items\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "tyck=incremental reused=1/3")) {
+        std::cerr << "signature edit must re-check dependent items\n" << out << "\n";
+        return false;
+    }
+    // 재사용된 diff의 tyck 진단은 매 버전 유지되어야 한다.
+    for (const int version : {2, 3}) {
+        const auto pos = out.find("\"version\":" + std::to_string(version) + ",\"diagnostics\":");
+        if (pos == std::string::npos) {
+            std::cerr << "missing diagnostics for version " << version << "\n" << out << "\n";
+            return false;
+        }
+        const auto end = out.find("Content-Length", pos);
+        if (out.substr(pos, end - pos).find("TypeLetInitMismatch") == std::string::npos) {
+            std::cerr << "reused item diagnostics must be republished\n" << out << "\n";
+            return false;
+        }
+    }
+    const auto v3 = out.find("\"version\":3,\"diagnostics\":");
+    if (out.substr(v3, out.find("Content-Length", v3) - v3).find("TypeBinaryOperandsMustMatch") == std::string::npos) {
+        std::cerr << "re-checked item must report its new diagnostics\n" << out << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool test_workspace_index_symbols_and_references() {
+    const auto stamp = std::to_string(
+        static_cast<long long>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    const auto root = std::filesystem::temp_directory_path() / ("parusd-workspace-index-" + stamp);
+    const auto cache_home = std::filesystem::temp_directory_path() / ("parusd-workspace-cache-" + stamp);
+
+    const auto config_lei = root / "config.lei";
+    const auto math_lei = root / "math" / "math.lei";
+    const auto math_add = root / "math" / "api" / "src" / "add.pr";
+    const auto app_lei = root / "app" / "app.lei";
+    const auto app_main = root / "app" / "src" / "main.pr";
+
+    const std::string config_text =
+        "import math from \"./math/math.lei\";\n"
+        "import app from \"./app/app.lei\";\n"
+        "proto ProjectMeta { name: string; version: string; };\n"
+        "plan master = master & {\n"
+        "  project = ProjectMeta & {\n"
+        "    name = \"index-demo\";\n"
+        "    version = \"0.1.0\";\n"
+        "  };\n"
+        "  bundles = [math::math_bundle, app::app_bundle];\n"
+        "  tasks = [];\n"
+        "  codegens = [];\n"
+        "};\n";
+    const std::string math_lei_text =
+        "export plan math_module = module & {\n"
+        "  sources = [\"math/api/src/add.pr\"];\n"
+        "  imports = [];\n"
+        "};\n"
+        "export plan math_bundle = bundle & {\n"
+        "  name = \"math\";\n"
+        "  kind = \"lib\";\n"
+        "  modules = [math_module];\n"
+        "  deps = [];\n"
+        "};\n";
+    const std::string app_lei_text =
+        "export plan app_module = module & {\n"
+        "  sources = [\"app/src/main.pr\"];\n"
+        "  imports = [\"::math::api\"];\n"
+        "};\n"
+        "export plan app_bundle = bundle & {\n"
+        "  name = \"app\";\n"
+        "  kind = \"bin\";\n"
+        "  modules = [app_module];\n"
+        "  deps = [\"math\"];\n"
+        "};\n";
+    const std::string math_add_text =
+        "export def add(a: i32, b: i32) -> i32 {\n"
+        "  return a + b;\n"
+        "}\n";
+    const std::string math_add_mul_text = math_add_text +
+        "export def mul(a: i32, b: i32) -> i32 {\n"
+        "  return a * b;\n"
+        "}\n";
+    const std::string app_main_text =
+        "import ::math::api as m;\n"
+        "def main() -> i32 {\n"
+        "  return m::add(1i32, 2i32);\n"
+        "}\n";
+
+    auto cleanup = [&] {
+        std::error_code ec{};
+        std::filesystem::remove_all(root, ec);
+        std::filesystem::remove_all(cache_home, ec);
+    };
+    if (!write_text(config_lei, config_text) ||
+        !write_text(math_lei, math_lei_text) ||
+        !write_text(math_add, math_add_text) ||
+        !write_text(app_lei, app_lei_text) ||
+        !write_text(app_main, app_main_text)) {
+        std::cerr << "failed to write workspace index fixture\n";
+        cleanup();
+        return false;
+    }
+
+    const std::string root_uri = to_file_uri(root);
+    const std::string uri = to_file_uri(app_main);
+    const std::string add_uri = to_file_uri(math_add);
+    const std::string init =
+        "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"initialize\",\"params\":{\"processId\":null,\"rootUri\":\""
+        + json_escape(root_uri) + "\",\"capabilities\":{}}}";
+    const auto symbol_query = [](int id, std::string_view query) {
+        return "{\"jsonrpc\":\"2.0\",\"id\":" + std::to_string(id)
+            + ",\"method\":\"workspace/symbol\",\"params\":{\"query\":\"" + std::string(query) + "\"}}";
+    };
+    const auto references = [&](int id, bool include_decl) {
+        return "{\"jsonrpc\":\"2.0\",\"id\":" + std::to_string(id)
+            + ",\"method\":\"textDocument/references\",\"params\":{\"textDocument\":{\"uri\":\"" + json_escape(uri)
+            + "\"},\"position\":{\"line\":2,\"character\":12},\"context\":{\"includeDeclaration\":"
+            + (include_decl ? "true" : "false") + "}}}";
+    };
+    const auto response_for = [](const std::string& out, int id) {
+        const auto pos = out.find("\"id\":" + std::to_string(id) + ",\"result\"");
+        if (pos == std::string::npos) return std::string{};
+        return out.substr(pos, out.find("Content-Length", pos) - pos);
+    };
+
+    std::vector<std::string> payloads{
+        init,
+        R"({"jsonrpc":"2.0","method":"initialized","params":{}})",
+        symbol_query(2, "AD"),
+        "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":\"" + json_escape(uri)
+            + "\",\"languageId\":\"parus\",\"version\":1,\"text\":\"" + json_escape(app_main_text) + "\"}}}",
+        references(3, /*include_decl=*/true),
+        references(4, /*include_decl=*/false),
+        R"({"jsonrpc":"2.0","id":5,"method":"shutdown","params":{}})",
+        R"({"jsonrpc":"2.0","method":"exit","params":{}})",
+    };
+
+    int rc = 0;
+    const std::string env =
+        "XDG_CACHE_HOME=\"" + cache_home.string() + "\" PARUSD_TRACE_INCREMENTAL=1 PARUSD_SYNC_ANALYSIS=1";
+    const std::string out = run_lsp_session(payloads, rc, env);
+    if (rc != 0) {
+        std::cerr << "workspace index session failed, rc=" << rc << "\n" << out << "\n";
+        cleanup();
+        return false;
+    }
+    if (!contains(out, "\"workspaceSymbolProvider\":true") || !contains(out, "\"referencesProvider\":true")) {
+        std::cerr << "initialize must advertise workspace symbol/references\n" << out << "\n";
+        cleanup();
+        return false;
+    }
+    if (!contains(out, "files=2 reindexed=2")) {
+        std::cerr << "first session must index every bundle source\n" << out << "\n";
+        cleanup();
+        return false;
+    }
+    const std::string symbols = response_for(out, 2);
+    if (!contains(symbols, "\"name\":\"add\",\"kind\":12") || !contains(symbols, add_uri) ||
+        !contains(symbols, "\"containerName\":\"math::api\"")) {
+        std::cerr << "workspace/symbol must find unopened bundle declarations\n" << out << "\n";
+        cleanup();
+        return false;
+    }
+    const std::string refs_with_decl = response_for(out, 3);
+    if (!contains(refs_with_decl, add_uri) || !contains(refs_with_decl, uri)) {
+        std::cerr << "references must include declaration and cross-file uses\n" << out << "\n";
+        cleanup();
+        return false;
+    }
+    const std::string refs_without_decl = response_for(out, 4);
+    if (contains(refs_without_decl, add_uri) || !contains(refs_without_decl, uri)) {
+        std::cerr << "includeDeclaration=false must drop the declaration site\n" << out << "\n";
+        cleanup();
+        return false;
+    }
+    bool persisted = false;
+    std::error_code iter_ec{};
+    for (std::filesystem::recursive_directory_iterator it(cache_home / "parus" / "parusd", iter_ec), end;
+         !iter_ec && it != end; it.increment(iter_ec)) {
+        if (it->path().filename() == "workspace-index.v1") persisted = true;
+    }
+    if (!persisted || std::filesystem::exists(root / "target" / "parus" / "cache" / "parusd")) {
+        std::cerr << "workspace index must be persisted under the user cache dir, not the project tree\n";
+        cleanup();
+        return false;
+    }
+
+    // 두 번째 세션: 저장본을 읽고 디스크에서 바뀐 add.pr만 다시 색인한다.
+    if (!write_text(math_add, math_add_mul_text)) {
+        std::cerr << "failed to update workspace index fixture\n";
+        cleanup();
+        return false;
+    }
+    std::vector<std::string> reload_payloads{
+        init,
+        R"({"jsonrpc":"2.0","method":"initialized","params":{}})",
+        symbol_query(2, "mul"),
+        "{\"jsonrpc\":\"2.0\",\"method\":\"workspace/didChangeWatchedFiles\",\"params\":{\"changes\":[{\"uri\":\""
+            + json_escape(add_uri) + "\",\"type\":2}]}}",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"workspace/didChangeWatchedFiles\",\"params\":{\"changes\":[{\"uri\":\""
+            + json_escape(add_uri) + "\",\"type\":2}]}}",
+        symbol_query(3, "mul"),
+        R"({"jsonrpc":"2.0","id":4,"method":"shutdown","params":{}})",
+        R"({"jsonrpc":"2.0","method":"exit","params":{}})",
+    };
+    const std::string reload_out = run_lsp_session(reload_payloads, rc, env);
+    cleanup();
+    if (rc != 0) {
+        std::cerr << "workspace index reload session failed, rc=" << rc << "\n" << reload_out << "\n";
+        return false;
+    }
+    if (!contains(reload_out, "files=2 reindexed=1")) {
+        std::cerr << "reload must reuse persisted entries for unchanged files\n" << reload_out << "\n";
+        return false;
+    }
+    // 스캔과 파일 변경 두 번이 저장 한 번으로 묶여야 한다.
+    if (count_occurrences(reload_out, "[parusd] workspace-index saved root=") != 1) {
+        std::cerr << "workspace index saves must be batched per root\n" << reload_out << "\n";
+        return false;
+    }
+    for (const int id : {2, 3}) {
+        if (!contains(response_for(reload_out, id), "\"name\":\"mul\",\"kind\":12")) {
+            std::cerr << "workspace/symbol must see declarations added on disk\n" << reload_out << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_lei_change_refreshes_only_changed_bundles() {
+    const auto stamp = std::to_string(
+        static_cast<long long>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    const auto root = std::filesystem::temp_directory_path() / ("parusd-lei-scoped-" + stamp);
+
+    const auto config_lei = root / "config.lei";
+    const auto math_lei = root / "math" / "math.lei";
+    const auto math_add = root / "math" / "api" / "src" / "add.pr";
+    const auto app_lei = root / "app" / "app.lei";
+    const auto app_main = root / "app" / "src" / "main.pr";
+
+    const std::string config_text =
+        "import math from \"./math/math.lei\";\n"
+        "import app from \"./app/app.lei\";\n"
+        "proto ProjectMeta { name: string; version: string; };\n"
+        "plan master = master & {\n"
+        "  project = ProjectMeta & {\n"
+        "    name = \"lsp-demo\";\n"
+        "    version = \"0.1.0\";\n"
+        "  };\n"
+        "  bundles = [math::math_bundle, app::app_bundle];\n"
+        "  tasks = [];\n"
+        "  codegens = [];\n"
+        "};\n";
+
+    const std::string math_lei_text =
+        "export plan math_module = module & {\n"
+        "  sources = [\"math/api/src/add.pr\"];\n"
+        "  imports = [];\n"
+        "};\n"
+        "export plan math_bundle = bundle & {\n"
+        "  name = \"math\";\n"
+        "  kind = \"lib\";\n"
+        "  modules = [math_module];\n"
+        "  deps = [];\n"
+        "};\n";
+
+    const std::string app_lei_text =
+        "export plan app_module = module & {\n"
+        "  sources = [\"app/src/main.pr\"];\n"
+        "  imports = [\"::math::api\"];\n"
+        "};\n"
+        "export plan app_bundle = bundle & {\n"
+        "  name = \"app\";\n"
+        "  kind = \"bin\";\n"
+        "  modules = [app_module];\n"
+        "  deps = [\"math\"];\n"
+        "};\n";
+    std::string app_lei_no_imports = app_lei_text;
+    app_lei_no_imports.replace(app_lei_no_imports.find("[\"::math::api\"]"), 15, "[]");
+
+    const std::string math_add_text =
+        "export def add(a: i32, b: i32) -> i32 {\n"
+        "  return a + b;\n"
+        "}\n";
+
+    const std::string app_main_text =
+        "import ::math::api as m;\n"
+        "def main() -> i32 {\n"
+        "  return m::add(1i32, 2i32);\n"
+        "}\n";
+
+    if (!write_text(config_lei, config_text) ||
+        !write_text(math_lei, math_lei_text) ||
+        !write_text(math_add, math_add_text) ||
+        !write_text(app_lei, app_lei_text) ||
+        !write_text(app_main, app_main_text)) {
+        std::cerr << "failed to write scoped lei fixture\n";
+        std::error_code ec{};
+        std::filesystem::remove_all(root, ec);
+        return false;
+    }
+
+    const std::string main_uri = to_file_uri(app_main);
+    const std::string add_uri = to_file_uri(math_add);
+    const std::string lei_uri = to_file_uri(app_lei);
+    const auto open = [](const std::string& uri, std::string_view lang, const std::string& text) {
+        return "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":\""
+            + json_escape(uri) + "\",\"languageId\":\"" + std::string(lang) + "\",\"version\":1,\"text\":\""
+            + json_escape(text) + "\"}}}";
+    };
+    const auto change = [&](int version, const std::string& text) {
+        return "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{\"textDocument\":{\"uri\":\""
+            + json_escape(lei_uri) + "\",\"version\":" + std::to_string(version)
+            + "},\"contentChanges\":[{\"text\":\"" + json_escape(text) + "\"}]}}";
+    };
+
+    std::vector<std::string> payloads{
+        R"({"jsonrpc":"2.0","id":1,"method":"initialize","params":{"processId":null,"rootUri":null,"capabilities":{}}})",
+        R"({"jsonrpc":"2.0","method":"initialized","params":{}})",
+        open(main_uri, "parus", app_main_text),
+        open(add_uri, "parus", math_add_text),
+        open(lei_uri, "lei", app_lei_text),
+        // bundle 메타데이터가 그대로인 편집: .pr 문서는 다시 분석하지 않는다.
+        change(2, app_lei_text + "\n"),
+        // app bundle의 import가 바뀐다: app 소스만 다시 분석한다(math는 app에 의존하지 않는다).
+        change(3, app_lei_no_imports),
+        R"({"jsonrpc":"2.0","id":2,"method":"shutdown","params":{}})",
+        R"({"jsonrpc":"2.0","method":"exit","params":{}})",
+    };
+
+    int rc = 0;
+    const std::string out = run_lsp_session(payloads, rc, "PARUSD_TRACE_INCREMENTAL=1 PARUSD_SYNC_ANALYSIS=1");
+    std::error_code ec{};
+    std::filesystem::remove_all(root, ec);
+
+    if (rc != 0) {
+        std::cerr << "scoped lei session failed, rc=" << rc << "\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "changed_bundles=all refreshed=2")) {
+        std::cerr << "first lei refresh without a baseline must re-check every project source\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "changed_bundles=0 refreshed=0")) {
+        std::cerr << "metadata-neutral lei edit must not re-check parus documents\n" << out << "\n";
+        return false;
+    }
+    if (!contains(out, "changed_bundles=1 refreshed=1")) {
+        std::cerr << "lei edit must re-check only sources of the changed bundle\n" << out << "\n";
+        return false;
+    }
+    const size_t add_runs = count_occurrences(out, "[parusd] uri=" + add_uri + " lang=parus");
+    const size_t main_runs = count_occurrences(out, "[parusd] uri=" + main_uri + " lang=parus");
+    if (add_runs != 2 || main_runs != 3) {
+        std::cerr << "unexpected parus re-analysis counts (add=" << add_runs << ", main=" << main_runs << ")\n"
+                  << out << "\n";
+        return false;
+    }
+    return true;
+}
+
 } // namespace
 
 int main() {
@@ -946,8 +1716,16 @@ int main() {
     const bool ok13 = test_parus_module_first_bundle_context();
     const bool ok14 = test_parus_core_export_index_auto_loaded_for_non_core_bundle();
     const bool ok15 = test_parus_incremental_newline_falls_back_cleanly();
-
-    if (!ok1 || !ok2 || !ok3 || !ok4 || !ok5 || !ok6 || !ok7 || !ok8 || !ok9 || !ok10 || !ok11 || !ok12 || !ok13 || !ok14 || !ok15) return 1;
+    const bool ok16 = test_background_analysis_coalesces_and_cancels();
+    const bool ok17 = test_did_close_releases_work_copies();
+    const bool ok18 = test_semantic_tokens_delta_and_range();
+    const bool ok19 = test_pull_diagnostics_and_debounce();
+    const bool ok20 = test_pull_lei_change_requests_diagnostic_refresh();
+    const bool ok21 = test_incremental_tyck_reuses_unchanged_items();
+    const bool ok22 = test_workspace_index_symbols_and_references();
+    const bool ok23 = test_lei_change_refreshes_only_changed_bundles();
+
+    if (!ok1 || !ok2 || !ok3 || !ok4 || !ok5 || !ok6 || !ok7 || !ok8 || !ok9 || !ok10 || !ok11 || !ok12 || !ok13 || !ok14 || !ok15 || !ok16 || !ok17 || !ok18 || !ok19 || !ok20 || !ok21 || !ok22 || !ok23) return 1;
     std::cout << "parusd lsp tests passed\n";
     return 0;
 }
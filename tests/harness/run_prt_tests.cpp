@@ -1,5 +1,6 @@
 #include <cstdint>
 #include <iostream>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -14,6 +15,7 @@ void  __parus_actor_commit(void* ctx);
 void  __parus_actor_recast(void* ctx);
 void  __parus_actor_leave(void* ctx);
 uint64_t __parus_prt_debug_live_actors(void);
+uint64_t __parus_prt_dump_stats(char* buf, uint64_t cap, uint32_t format);
 }
 
 namespace {
@@ -114,6 +116,54 @@ namespace {
         return ok;
     }
 
+    constexpr uint32_t kStatsText = 0;
+    constexpr uint32_t kStatsJson = 1;
+
+    static std::string dump_stats_(uint32_t format) {
+        const uint64_t need = __parus_prt_dump_stats(nullptr, 0, format);
+        std::string out(static_cast<size_t>(need) + 1, '\0');
+        const uint64_t wrote = __parus_prt_dump_stats(out.data(), out.size(), format);
+        out.resize(static_cast<size_t>(wrote));
+        return out;
+    }
+
+    static bool test_dump_stats_() {
+        bool ok = true;
+        void* handle = __parus_actor_new(/*type_tag=*/4242, sizeof(int32_t), alignof(int32_t));
+        ok &= require_(handle != nullptr, "actor_new for stats case must return a handle");
+        if (!ok) return false;
+        for (int i = 0; i < 3; ++i) {
+            void* ctx = __parus_actor_enter(handle, kModePub);
+            __parus_actor_leave(ctx);
+        }
+        void* sub_ctx = __parus_actor_enter(handle, kModeSub);
+        __parus_actor_leave(sub_ctx);
+        __parus_actor_release(handle);
+
+        char tiny[8]{};
+        const uint64_t need = __parus_prt_dump_stats(tiny, sizeof(tiny), kStatsText);
+        ok &= require_(need >= sizeof(tiny), "dump_stats must report the untruncated length");
+        ok &= require_(tiny[sizeof(tiny) - 1] == '\0', "dump_stats must NUL-terminate truncated output");
+
+        const std::string text = dump_stats_(kStatsText);
+        const std::string json = dump_stats_(kStatsJson);
+        ok &= require_(text.find("live_actors ") != std::string::npos, "text stats must report live actors");
+        ok &= require_(!json.empty() && json.front() == '{' && json.back() == '}', "json stats must be a single object");
+#if defined(PARUS_PRT_STATS) && PARUS_PRT_STATS
+        ok &= require_(json.find("\"enabled\":true") != std::string::npos, "instrumented build must report enabled stats");
+        ok &= require_(text.find("type_tag 4242: created=1 destroyed=1 enter_shared=1 enter_exclusive=3 leave=4")
+                           != std::string::npos,
+                       "text stats must carry per-type_tag counters");
+        ok &= require_(json.find("{\"type_tag\":4242,\"created\":1,\"destroyed\":1,\"enter_shared\":1,\"enter_exclusive\":3,\"leave\":4")
+                           != std::string::npos,
+                       "json stats must carry per-type_tag counters");
+        ok &= require_(json.find("{\"type_tag\":9,") != std::string::npos, "stress actor type_tag must be recorded");
+#else
+        ok &= require_(json.find("\"enabled\":false") != std::string::npos, "default build must report disabled stats");
+#endif
+        return ok;
+    }
+
 } // namespace
 
 int main() {
@@ -125,7 +175,11 @@ int main() {
     const bool ok2 = test_concurrent_actor_mutation_();
     std::cout << (ok2 ? "  -> PASS\n" : "  -> FAIL\n");
 
-    if (!ok1 || !ok2) {
+    std::cout << "[TEST] prt_dump_stats (" << PARUS_PRT_VARIANT << ")\n";
+    const bool ok3 = test_dump_stats_();
+    std::cout << (ok3 ? "  -> PASS\n" : "  -> FAIL\n");
+
+    if (!ok1 || !ok2 || !ok3) {
         std::cout << "\nFAILED prt test suite\n";
         return 1;
     }
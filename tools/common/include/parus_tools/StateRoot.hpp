@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <filesystem>
 #include <optional>
+#include <string>
 #include <system_error>
 
 namespace parus_tools::paths {
@@ -56,6 +60,49 @@ inline std::filesystem::path ninja_cache_dir(std::filesystem::path anchor) {
     return cache_root(std::move(anchor)) / "ninja";
 }
 
+/// 프로젝트 밖(사용자 캐시 디렉터리)의 parus 캐시 루트.
+/// `XDG_CACHE_HOME` → 플랫폼 기본 위치 → 임시 디렉터리 순으로 고른다.
+inline std::filesystem::path user_cache_root() {
+    const auto env = [](const char* name) {
+        const char* v = std::getenv(name);
+        return (v == nullptr) ? std::string{} : std::string(v);
+    };
+    if (const auto xdg = env("XDG_CACHE_HOME"); !xdg.empty()) {
+        return std::filesystem::path(xdg) / "parus";
+    }
+#if defined(_WIN32)
+    if (const auto local = env("LOCALAPPDATA"); !local.empty()) {
+        return std::filesystem::path(local) / "parus" / "cache";
+    }
+#else
+    if (const auto home = env("HOME"); !home.empty()) {
+#if defined(__APPLE__)
+        return std::filesystem::path(home) / "Library" / "Caches" / "parus";
+#else
+        return std::filesystem::path(home) / ".cache" / "parus";
+#endif
+    }
+#endif
+    std::error_code ec{};
+    return std::filesystem::temp_directory_path(ec) / "parus-cache";
+}
+
+/// parusd 워크스페이스 인덱스 저장 위치. 소스 트리(sysroot 포함)를 더럽히지 않도록
+/// 사용자 캐시 아래에 프로젝트 루트별 디렉터리(`<이름>-<경로 해시>`)를 둔다.
+inline std::filesystem::path parusd_cache_dir(std::filesystem::path anchor) {
+    const auto root = project_root_or_anchor(std::move(anchor));
+    uint64_t h = 1469598103934665603ull;
+    for (const unsigned char c : root.generic_string()) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    char hex[17]{};
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(h));
+    std::string name = root.filename().string();
+    if (name.empty()) name = "root";
+    return user_cache_root() / "parusd" / (name + "-" + hex);
+}
+
 inline std::filesystem::path index_dir(std::filesystem::path anchor) {
     return state_root(std::move(anchor)) / "index";
 }
@@ -23,6 +23,7 @@ enum class Command : uint8_t {
     kDoctor,
     kConfig,
     kTool,
+    kRun,
 };
 
 enum class ConfigAction : uint8_t {
@@ -91,6 +92,12 @@ struct ConfigOptions {
     std::string value{};
 };
 
+struct RunOptions {
+    std::string source{};
+    std::vector<std::string> compiler_flags{};
+    std::vector<std::string> program_args{};
+};
+
 struct ToolOptions {
     std::string tool_name{};
     std::vector<std::string> passthrough{};
@@ -108,6 +115,7 @@ struct Options {
     DoctorOptions doctor{};
     ConfigOptions config{};
     ToolOptions tool{};
+    RunOptions run{};
 
     bool ok = true;
     std::string error{};
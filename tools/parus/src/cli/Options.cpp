@@ -1,4 +1,5 @@
 #include <parus_tool/cli/Options.hpp>
+#include <parusc/cli/ValueFlags.hpp>
 
 #include <cctype>
 #include <limits>
@@ -10,7 +11,7 @@ namespace {
 
 bool is_command(std::string_view s) {
     return s == "build" || s == "check" || s == "graph" || s == "lsp" ||
-           s == "doctor" || s == "config" || s == "tool";
+           s == "doctor" || s == "config" || s == "tool" || s == "run";
 }
 
 Command to_command(std::string_view s) {
@@ -21,6 +22,7 @@ Command to_command(std::string_view s) {
     if (s == "doctor") return Command::kDoctor;
     if (s == "config") return Command::kConfig;
     if (s == "tool") return Command::kTool;
+    if (s == "run") return Command::kRun;
     return Command::kNone;
 }
 
@@ -122,7 +124,8 @@ void print_usage(std::ostream& os) {
         << "  config set <key> <value> [--global|--project]\n"
         << "  config unset <key> [--global|--project]\n"
         << "  config init [--global|--project]\n"
-        << "  tool <parusc|parusd|parus-lld|lei> -- <args...>\n";
+        << "  tool <parusc|parusd|parus-lld|lei> -- <args...>\n"
+        << "  run <file.pr> [-O<N>] [parusc flags...] [-- <program-args...>]\n";
 }
 
 Options parse_options(int argc, char** argv) {
@@ -569,6 +572,43 @@ Options parse_options(int argc, char** argv) {
         return out;
     }
 
+    if (out.command == Command::kRun) {
+        for (; i < args.size(); ++i) {
+            const auto a = args[i];
+            if (a == "--") {
+                for (++i; i < args.size(); ++i) {
+                    out.run.program_args.emplace_back(args[i]);
+                }
+                break;
+            }
+            if (parusc::cli::flag_takes_value(a)) {
+                if (i + 1 >= args.size()) {
+                    out.ok = false;
+                    out.error = std::string(a) + " requires a value";
+                    return out;
+                }
+                out.run.compiler_flags.emplace_back(a);
+                out.run.compiler_flags.emplace_back(args[++i]);
+                continue;
+            }
+            if (!a.empty() && a[0] != '-') {
+                if (!out.run.source.empty()) {
+                    out.ok = false;
+                    out.error = "run accepts a single source file";
+                    return out;
+                }
+                out.run.source = std::string(a);
+                continue;
+            }
+            out.run.compiler_flags.emplace_back(a);
+        }
+        if (out.run.source.empty()) {
+            out.ok = false;
+            out.error = "run command requires a source file";
+        }
+        return out;
+    }
+
     out.ok = false;
     out.error = "unreachable command parse state";
     return out;
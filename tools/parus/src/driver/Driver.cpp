@@ -316,6 +316,8 @@ std::optional<std::filesystem::path> config_anchor(const cli::Options& opt) {
             return std::filesystem::path(opt.check.entry);
         case cli::Command::kGraph:
             return std::filesystem::path(opt.graph.entry);
+        case cli::Command::kRun:
+            return std::filesystem::path(opt.run.source);
         default:
             return std::nullopt;
     }
@@ -1058,6 +1060,21 @@ int run_tool(const cli::Options& opt,
     return proc::run_argv(argv);
 }
 
+int run_jit(const cli::Options& opt,
+            const config::EffectiveSettings& settings,
+            const char* argv0) {
+    const auto parusc = resolve_tool_with_config("parusc", opt, settings, argv0);
+
+    std::vector<std::string> argv{parusc, "run"};
+    argv.insert(argv.end(), opt.run.compiler_flags.begin(), opt.run.compiler_flags.end());
+    argv.push_back(opt.run.source);
+    if (!opt.run.program_args.empty()) {
+        argv.push_back("--");
+        argv.insert(argv.end(), opt.run.program_args.begin(), opt.run.program_args.end());
+    }
+    return proc::run_argv(argv);
+}
+
 int run_doctor(const cli::Options& opt,
                config::EffectiveSettings settings,
                const char* argv0) {
@@ -1111,6 +1128,8 @@ int run(const cli::Options& opt, const char* argv0) {
             return run_doctor(opt, runtime.settings, argv0);
         case cli::Command::kTool:
             return run_tool(opt, runtime.settings, argv0);
+        case cli::Command::kRun:
+            return run_jit(opt, runtime.settings, argv0);
         default:
             return 1;
     }
@@ -10,10 +10,12 @@
 #include <parus/diag/Render.hpp>
 #include <parus/lex/Lexer.hpp>
 #include <parus/macro/Expander.hpp>
+#include <parus/macro/Prelude.hpp>
 #include <parus/os/File.hpp>
 #include <parus/parse/IncrementalParse.hpp>
 #include <parus/parse/Parser.hpp>
 #include <parus/passes/Passes.hpp>
+#include <parus/syntax/Keyword.hpp>
 #include <parus/text/SourceManager.hpp>
 #include <parus/type/TypeResolve.hpp>
 #include <parus/ty/TypePool.hpp>
@@ -29,20 +31,29 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <sstream>
 #include <span>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -54,6 +65,9 @@
 
 namespace {
 
+    /// @brief 파싱된 JSON 값. 문자열과 키는 원문 payload(escape가 있으면 JsonStringStore)를 빌린다.
+    ///
+    /// LSP 메시지의 객체는 작아서 키 조회는 선형 탐색이 해시맵보다 싸다.
     struct JsonValue {
         enum class Kind : uint8_t {
             kNull,
@@ -67,14 +81,25 @@ namespace {
         Kind kind = Kind::kNull;
         bool bool_v = false;
         double number_v = 0.0;
-        std::string string_v{};
+        std::string_view string_v{};
         std::vector<JsonValue> array_v{};
-        std::unordered_map<std::string, JsonValue> object_v{};
+        std::vector<std::pair<std::string_view, JsonValue>> object_v{};
     };
 
+    /// @brief escape를 풀어야 했던 문자열의 저장소. deque라 원소 주소가 유지된다.
+    using JsonStringStore = std::deque<std::string>;
+
+    /// @brief 수신한 JSON-RPC 메시지 하나. root가 payload/strings를 빌리므로 힙에 두고 포인터로 옮긴다.
+    struct JsonMessage {
+        std::string payload{};
+        JsonStringStore strings{};
+        JsonValue root{};
+    };
+
+    /// @brief 원문을 복사하지 않는 JSON 파서. src와 store는 결과 JsonValue보다 오래 살아야 한다.
     class JsonParser {
     public:
-        explicit JsonParser(std::string_view src) : src_(src) {}
+        JsonParser(std::string_view src, JsonStringStore& store) : src_(src), store_(store) {}
 
         bool parse(JsonValue& out) {
             skip_ws_();
@@ -148,10 +173,11 @@ namespace {
                 while (pos_ < src_.size() && std::isdigit(static_cast<unsigned char>(src_[pos_]))) ++pos_;
             }
 
-            const std::string text(src_.substr(begin, pos_ - begin));
-            char* endp = nullptr;
-            const double v = std::strtod(text.c_str(), &endp);
-            if (endp == text.c_str() || (endp != nullptr && *endp != '\0')) return fail_();
+            double v = 0.0;
+            const char* first = src_.data() + begin;
+            const char* last = src_.data() + pos_;
+            const auto [ptr, ec] = std::from_chars(first, last, v);
+            if (ec != std::errc{} || ptr != last) return fail_();
 
             out = JsonValue{};
             out.kind = JsonValue::Kind::kNumber;
@@ -160,11 +186,11 @@ namespace {
         }
 
         bool parse_string_value_(JsonValue& out) {
-            std::string s;
+            std::string_view s{};
             if (!parse_string_(s)) return false;
             out = JsonValue{};
             out.kind = JsonValue::Kind::kString;
-            out.string_v = std::move(s);
+            out.string_v = s;
             return true;
         }
 
@@ -197,43 +223,63 @@ namespace {
             return -1;
         }
 
-        bool parse_string_(std::string& out) {
+        /// @brief escape가 없으면 원문 구간을 그대로 빌리고, 있으면 store_에 한 번만 풀어 쓴다.
+        bool parse_string_(std::string_view& out) {
             if (pos_ >= src_.size() || src_[pos_] != '"') return fail_();
             ++pos_;
 
+            const size_t begin = pos_;
+            const size_t stop = src_.find_first_of("\"\\", pos_);
+            if (stop == std::string_view::npos) return fail_();
+            if (src_[stop] == '"') {
+                out = src_.substr(begin, stop - begin);
+                pos_ = stop + 1;
+                return true;
+            }
+
+            std::string& buf = store_.emplace_back();
+            buf.append(src_.substr(begin, stop - begin));
+            pos_ = stop;
             while (pos_ < src_.size()) {
                 const char ch = src_[pos_++];
-                if (ch == '"') return true;
-                if (ch == '\\') {
-                    if (pos_ >= src_.size()) return fail_();
-                    const char esc = src_[pos_++];
-                    switch (esc) {
-                        case '"': out.push_back('"'); break;
-                        case '\\': out.push_back('\\'); break;
-                        case '/': out.push_back('/'); break;
-                        case 'b': out.push_back('\b'); break;
-                        case 'f': out.push_back('\f'); break;
-                        case 'n': out.push_back('\n'); break;
-                        case 'r': out.push_back('\r'); break;
-                        case 't': out.push_back('\t'); break;
-                        case 'u': {
-                            if (pos_ + 4 > src_.size()) return fail_();
-                            uint32_t cp = 0;
-                            for (int i = 0; i < 4; ++i) {
-                                const int hv = hex_value_(src_[pos_ + i]);
-                                if (hv < 0) return fail_();
-                                cp = (cp << 4) | static_cast<uint32_t>(hv);
-                            }
-                            pos_ += 4;
-                            append_utf8_(out, cp);
-                            break;
+                if (ch == '"') {
+                    out = buf;
+                    return true;
+                }
+                if (ch != '\\') {
+                    // 다음 escape/끝 따옴표까지 한 번에 붙인다.
+                    const size_t next = src_.find_first_of("\"\\", pos_);
+                    if (next == std::string_view::npos) return fail_();
+                    buf.append(src_.substr(pos_ - 1, next - (pos_ - 1)));
+                    pos_ = next;
+                    continue;
+                }
+                if (pos_ >= src_.size()) return fail_();
+                const char esc = src_[pos_++];
+                switch (esc) {
+                    case '"': buf.push_back('"'); break;
+                    case '\\': buf.push_back('\\'); break;
+                    case '/': buf.push_back('/'); break;
+                    case 'b': buf.push_back('\b'); break;
+                    case 'f': buf.push_back('\f'); break;
+                    case 'n': buf.push_back('\n'); break;
+                    case 'r': buf.push_back('\r'); break;
+                    case 't': buf.push_back('\t'); break;
+                    case 'u': {
+                        if (pos_ + 4 > src_.size()) return fail_();
+                        uint32_t cp = 0;
+                        for (int i = 0; i < 4; ++i) {
+                            const int hv = hex_value_(src_[pos_ + i]);
+                            if (hv < 0) return fail_();
+                            cp = (cp << 4) | static_cast<uint32_t>(hv);
                         }
-                        default:
-                            return fail_();
+                        pos_ += 4;
+                        append_utf8_(buf, cp);
+                        break;
                     }
-                    continue;
+                    default:
+                        return fail_();
                 }
-                out.push_back(ch);
             }
             return fail_();
         }
@@ -286,7 +332,7 @@ namespace {
             }
 
             while (pos_ < src_.size()) {
-                std::string key;
+                std::string_view key{};
                 if (!parse_string_(key)) return false;
 
                 skip_ws_();
@@ -295,7 +341,7 @@ namespace {
 
                 JsonValue val{};
                 if (!parse_value_(val)) return false;
-                out.object_v.emplace(std::move(key), std::move(val));
+                out.object_v.emplace_back(key, std::move(val));
 
                 skip_ws_();
                 if (pos_ >= src_.size()) return fail_();
@@ -333,15 +379,18 @@ namespace {
         }
 
         std::string_view src_{};
+        JsonStringStore& store_;
         size_t pos_ = 0;
         bool ok_ = true;
     };
 
+    /// @brief 객체 멤버 조회. 키가 중복되면 처음 값을 쓴다.
     const JsonValue* obj_get_(const JsonValue& obj, std::string_view key) {
         if (obj.kind != JsonValue::Kind::kObject) return nullptr;
-        const auto it = obj.object_v.find(std::string(key));
-        if (it == obj.object_v.end()) return nullptr;
-        return &it->second;
+        for (const auto& [k, v] : obj.object_v) {
+            if (k == key) return &v;
+        }
+        return nullptr;
     }
 
     std::optional<std::string_view> as_string_(const JsonValue* v) {
@@ -409,10 +458,14 @@ namespace {
         return static_cast<size_t>(in.gcount()) == content_length;
     }
 
-    std::string json_escape_(std::string_view s) {
-        std::string out;
-        out.reserve(s.size() + 8);
-        for (const char ch : s) {
+    /// @brief s를 escape해 out 뒤에 붙인다. escape가 필요 없는 구간은 통째로 복사한다.
+    void append_json_escaped_(std::string& out, std::string_view s) {
+        size_t run = 0;
+        for (size_t i = 0; i < s.size(); ++i) {
+            const unsigned char ch = static_cast<unsigned char>(s[i]);
+            if (ch >= 0x20 && ch != '"' && ch != '\\') continue;
+            out.append(s.substr(run, i - run));
+            run = i + 1;
             switch (ch) {
                 case '"': out += "\\\""; break;
                 case '\\': out += "\\\\"; break;
@@ -421,20 +474,73 @@ namespace {
                 case '\n': out += "\\n"; break;
                 case '\r': out += "\\r"; break;
                 case '\t': out += "\\t"; break;
-                default:
-                    if (static_cast<unsigned char>(ch) < 0x20) {
-                        char buf[7]{};
-                        std::snprintf(buf, sizeof(buf), "\\u%04X", static_cast<unsigned char>(ch));
-                        out += buf;
-                    } else {
-                        out.push_back(ch);
-                    }
+                default: {
+                    char buf[7]{};
+                    std::snprintf(buf, sizeof(buf), "\\u%04X", ch);
+                    out += buf;
                     break;
+                }
             }
         }
+        out.append(s.substr(run));
+    }
+
+    std::string json_escape_(std::string_view s) {
+        std::string out;
+        out.reserve(s.size() + 8);
+        append_json_escaped_(out, s);
         return out;
     }
 
+    /// @brief 응답 JSON을 버퍼 하나에 이어 쓰는 writer.
+    ///
+    /// 조각마다 임시 문자열을 만들지 않는다. 숫자는 to_chars로, 문자열은 escape하며 바로 붙이고,
+    /// 큰 u32 배열(semantic tokens)은 최대 길이만큼 한 번에 늘려 직접 쓴다.
+    class JsonWriter {
+    public:
+        explicit JsonWriter(std::string& out) : out_(out) {}
+
+        JsonWriter& raw(std::string_view s) {
+            out_.append(s);
+            return *this;
+        }
+
+        JsonWriter& string(std::string_view s) {
+            out_.push_back('"');
+            append_json_escaped_(out_, s);
+            out_.push_back('"');
+            return *this;
+        }
+
+        template <typename Int>
+            requires std::is_integral_v<Int>
+        JsonWriter& number(Int v) {
+            char buf[24];
+            const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+            out_.append(buf, r.ptr);
+            return *this;
+        }
+
+        JsonWriter& u32_array(std::span<const uint32_t> data) {
+            constexpr size_t kMaxDigits = 10;
+            const size_t base = out_.size();
+            out_.resize_and_overwrite(base + 2 + data.size() * (kMaxDigits + 1), [&](char* buf, size_t) {
+                char* p = buf + base;
+                *p++ = '[';
+                for (size_t i = 0; i < data.size(); ++i) {
+                    if (i != 0) *p++ = ',';
+                    p = std::to_chars(p, p + kMaxDigits, data[i]).ptr;
+                }
+                *p++ = ']';
+                return static_cast<size_t>(p - buf);
+            });
+            return *this;
+        }
+
+    private:
+        std::string& out_;
+    };
+
     std::string json_value_to_text_(const JsonValue& v) {
         switch (v.kind) {
             case JsonValue::Kind::kNull:
@@ -550,6 +656,11 @@ namespace {
         std::vector<DefinitionBinding> definition_bindings{};
         std::unordered_map<std::string, std::vector<LspLocation>> top_level_definitions{};
         parus::parse::ReparseMode parse_mode = parus::parse::ReparseMode::kNone;
+
+        // 증분 tyck 통계: tyck를 돌렸는지, top-level def 중 이전 결과를 재사용한 수.
+        bool tyck_ran = false;
+        uint32_t tyck_def_items = 0;
+        uint32_t tyck_reused_items = 0;
     };
 
     static constexpr uint32_t kSemModDeclaration = 1u << 0;
@@ -606,7 +717,7 @@ namespace {
     struct TextChange {
         bool has_range = false;
         Range range{};
-        std::string text{};
+        std::string_view text{}; // 수신 메시지를 빌린다(handle_did_change_ 동안만 유효)
     };
 
     struct DocumentState {
@@ -615,20 +726,48 @@ namespace {
         uint64_t revision = 0;
         DocLang lang = DocLang::kUnknown;
 
+        // didOpen 시점 revision. 분석 워커가 같은 URI의 재오픈을 구분하는 데 쓴다.
+        uint64_t open_revision = 0;
+
         std::vector<parus::parse::EditWindow> pending_edits{};
 
+        // 증분 파서 세션은 분석 워커 쪽 복사본에서만 사용된다.
         parus::parse::IncrementalParserSession parse_session{};
         bool parse_ready = false;
 
+        /// @brief top-level def 하나의 tyck/capability 진단. 줄 번호는 아이템 시작 줄 기준 상대값이다.
+        struct TyckItemEntry {
+            std::vector<LspDiag> tyck_diags{};
+            std::vector<LspDiag> cap_diags{};
+            bool cap_checked = false;
+        };
+
+        /// @brief 증분 tyck 캐시(분석 워커 전용). 직전 분석에서 tyck까지 돈 경우에만 유효하다.
+        struct TyckItemCache {
+            bool valid = false;
+            uint64_t non_def_hash = 0;
+            std::unordered_map<std::string, uint64_t> def_signatures{};
+            std::unordered_map<uint64_t, TyckItemEntry> items{}; // content hash -> entry
+        } tyck_items{};
+
+        // 외부 환경(config.lei, export-index)이 바뀌어 tyck 캐시를 버려야 할 때 세운다.
+        bool drop_tyck_items = false;
+
         struct AnalysisCache {
             uint64_t revision = 0;
             bool valid = false;
             std::vector<LspDiag> diagnostics{};
+            // (line, start) 순으로 정렬되어 있다. range 요청은 이 순서로 이분 탐색한다.
             std::vector<SemToken> semantic_tokens{};
+            std::vector<uint32_t> semantic_data{};
             std::vector<CompletionEntry> completion_items{};
             std::vector<DefinitionBinding> definition_bindings{};
             std::unordered_map<std::string, std::vector<LspLocation>> top_level_definitions{};
         } analysis{};
+
+        // 마지막으로 보낸 semanticTokens full/delta 결과. 다음 delta 요청의 기준이다.
+        std::string semantic_result_id{};
+        std::vector<uint32_t> semantic_sent_data{};
     };
 
     struct ServerMacroConfig {
@@ -637,6 +776,16 @@ namespace {
         std::vector<std::string> warnings{};
     };
 
+    struct ServerDiagnosticsConfig {
+        /// @brief didChange 후 분석을 미루는 시간(ms). 0이면 즉시 분석한다.
+        uint32_t debounce_ms = 150;
+        /// @brief 클라이언트가 `textDocument/diagnostic`(pull)을 지원하면 push publish를 멈춘다.
+        bool pull = false;
+        /// @brief 클라이언트가 `workspace/diagnostic/refresh` 요청을 받을 수 있는지.
+        bool refresh_support = false;
+        std::vector<std::string> warnings{};
+    };
+
     struct ServerCImportConfig {
         std::vector<std::string> include_dirs{};
         std::vector<std::string> isystem_dirs{};
@@ -887,7 +1036,7 @@ namespace {
         if (node.kind != JsonValue::Kind::kObject) return false;
         const auto text = as_string_(obj_get_(node, "text"));
         if (!text.has_value()) return false;
-        out.text = std::string(*text);
+        out.text = *text;
 
         Range r{};
         if (parse_range_(obj_get_(node, "range"), r)) {
@@ -956,14 +1105,13 @@ namespace {
         return cfg;
     }
 
-    void parse_string_array_field_(const std::unordered_map<std::string, JsonValue>& obj,
+    void parse_string_array_field_(const JsonValue& obj,
                                    std::string_view key,
                                    std::vector<std::string>& out,
                                    std::vector<std::string>& warnings,
                                    std::string_view warning_prefix) {
-        const auto it = obj.find(std::string(key));
-        if (it == obj.end()) return;
-        const JsonValue* node = &it->second;
+        const JsonValue* node = obj_get_(obj, key);
+        if (node == nullptr) return;
         if (node->kind != JsonValue::Kind::kArray) {
             warnings.push_back(std::string(warning_prefix) + std::string(key) + " must be array<string>");
             return;
@@ -979,6 +1127,53 @@ namespace {
         }
     }
 
+    ServerDiagnosticsConfig parse_diagnostics_config_from_initialize_(const JsonValue* params) {
+        constexpr uint32_t kMaxDebounceMs = 5000;
+        ServerDiagnosticsConfig cfg{};
+        if (params == nullptr || params->kind != JsonValue::Kind::kObject) return cfg;
+
+        if (const auto* caps = obj_get_(*params, "capabilities");
+            caps != nullptr && caps->kind == JsonValue::Kind::kObject) {
+            if (const auto* td = obj_get_(*caps, "textDocument");
+                td != nullptr && td->kind == JsonValue::Kind::kObject) {
+                const auto* pull = obj_get_(*td, "diagnostic");
+                cfg.pull = (pull != nullptr && pull->kind == JsonValue::Kind::kObject);
+            }
+            if (const auto* ws = obj_get_(*caps, "workspace");
+                ws != nullptr && ws->kind == JsonValue::Kind::kObject) {
+                if (const auto* diag = obj_get_(*ws, "diagnostics");
+                    diag != nullptr && diag->kind == JsonValue::Kind::kObject) {
+                    const auto* refresh = obj_get_(*diag, "refreshSupport");
+                    cfg.refresh_support = (refresh != nullptr && refresh->kind == JsonValue::Kind::kBool && refresh->bool_v);
+                }
+            }
+        }
+
+        const auto* init_opts = obj_get_(*params, "initializationOptions");
+        if (init_opts == nullptr || init_opts->kind != JsonValue::Kind::kObject) return cfg;
+
+        const JsonValue* root = init_opts;
+        if (const auto* parus_cfg = obj_get_(*init_opts, "parus");
+            parus_cfg != nullptr && parus_cfg->kind == JsonValue::Kind::kObject) {
+            root = parus_cfg;
+        }
+        const auto* diag_cfg = obj_get_(*root, "diagnostics");
+        if (diag_cfg == nullptr || diag_cfg->kind != JsonValue::Kind::kObject) return cfg;
+
+        const auto v = as_i64_(obj_get_(*diag_cfg, "debounceMs"));
+        if (!v.has_value()) return cfg;
+        if (*v <= 0) {
+            cfg.debounce_ms = 0;
+        } else if (*v > kMaxDebounceMs) {
+            cfg.debounce_ms = kMaxDebounceMs;
+            cfg.warnings.push_back(
+                "diagnostics debounce clamped: debounceMs " + std::to_string(*v) + " -> " + std::to_string(kMaxDebounceMs));
+        } else {
+            cfg.debounce_ms = static_cast<uint32_t>(*v);
+        }
+        return cfg;
+    }
+
     ServerCImportConfig parse_cimport_config_from_initialize_(const JsonValue* params) {
         ServerCImportConfig cfg{};
         if (params == nullptr || params->kind != JsonValue::Kind::kObject) return cfg;
@@ -992,7 +1187,7 @@ namespace {
         }
         const auto* cimport = obj_get_(*root, "cimport");
         if (cimport == nullptr || cimport->kind != JsonValue::Kind::kObject) return cfg;
-        const auto* cobj = &cimport->object_v;
+        const auto* cobj = cimport;
 
         constexpr std::string_view kWarnPrefix = "initializationOptions.parus.cimport.";
         parse_string_array_field_(*cobj, "includeDirs", cfg.include_dirs, cfg.warnings, kWarnPrefix);
@@ -1158,68 +1353,6 @@ namespace {
         return true;
     }
 
-    bool is_keyword_token_kind_(parus::syntax::TokenKind kind) {
-        using K = parus::syntax::TokenKind;
-        switch (kind) {
-            case K::kKwTrue:
-            case K::kKwFalse:
-            case K::kKwNull:
-            case K::kKwAnd:
-            case K::kKwOr:
-            case K::kKwNot:
-            case K::kKwXor:
-            case K::kKwMut:
-            case K::kKwStatic:
-            case K::kKwConst:
-            case K::kKwLet:
-            case K::kKwSet:
-            case K::kKwIf:
-            case K::kKwElif:
-            case K::kKwElse:
-            case K::kKwWhile:
-            case K::kKwDo:
-            case K::kKwReturn:
-            case K::kKwBreak:
-            case K::kKwContinue:
-            case K::kKwManual:
-            case K::kKwExport:
-            case K::kKwExtern:
-            case K::kKwLayout:
-            case K::kKwAlign:
-            case K::kKwFn:
-            case K::kKwMacro:
-            case K::kKwField:
-            case K::kKwActs:
-            case K::kKwClass:
-            case K::kKwProto:
-            case K::kKwActor:
-            case K::kKwInit:
-            case K::kKwDeinit:
-            case K::kKwDraft:
-            case K::kKwSwitch:
-            case K::kKwCase:
-            case K::kKwDefault:
-            case K::kKwLoop:
-            case K::kKwIn:
-            case K::kKwCommit:
-            case K::kKwRecast:
-            case K::kKwPub:
-            case K::kKwSub:
-            case K::kKwPure:
-            case K::kKwComptime:
-            case K::kKwUse:
-            case K::kKwImport:
-            case K::kKwModule:
-            case K::kKwAs:
-            case K::kKwNest:
-            case K::kKwWith:
-            case K::kKwRequire:
-                return true;
-            default:
-                return false;
-        }
-    }
-
     bool is_operator_token_kind_(parus::syntax::TokenKind kind) {
         using K = parus::syntax::TokenKind;
         switch (kind) {
@@ -1289,7 +1422,7 @@ namespace {
     }
 
     std::unordered_map<uint64_t, SemClass> collect_decl_semantic_map_(
-        const std::vector<parus::Token>& toks
+        const parus::TokenStream& toks
     ) {
         std::unordered_map<uint64_t, SemClass> out;
         using K = parus::syntax::TokenKind;
@@ -1660,6 +1793,8 @@ namespace {
         std::unordered_map<std::string, std::string> module_head_by_source{};
         std::unordered_map<std::string, std::vector<std::string>> module_imports_by_source{};
         std::unordered_map<std::string, std::vector<std::string>> module_cimport_isystem_by_source{};
+
+        bool operator==(const BundleUnitMeta&) const = default;
     };
 
     struct ParusBundleLintContext {
@@ -1689,6 +1824,9 @@ namespace {
     std::unordered_map<std::string, BundleUnitsSnapshotCache> g_bundle_units_cache_{};
     std::unordered_map<std::string, LintContextCacheEntry> g_lint_context_cache_{};
 
+    // 분석 워커와 메인 스레드(definition fallback, .lei 변경 무효화)가 함께 접근한다.
+    std::mutex g_lint_cache_mu_{};
+
     std::string parent_dir_norm_(std::string_view path) {
         namespace fs = std::filesystem;
         std::error_code ec{};
@@ -1754,20 +1892,34 @@ namespace {
         return static_cast<uint64_t>(t.time_since_epoch().count());
     }
 
+    /// @brief bundle unit 스냅샷 키. 열린 .lei의 overlay 텍스트도 해시로 포함한다.
     std::string make_bundle_units_cache_key_(
         const std::filesystem::path& config_lei,
-        const std::vector<std::string>& loaded_modules
+        const std::vector<std::string>& loaded_modules,
+        const std::unordered_map<std::string, std::string>* overlays = nullptr
     ) {
         std::vector<std::string> mods = loaded_modules;
         std::sort(mods.begin(), mods.end());
         mods.erase(std::unique(mods.begin(), mods.end()), mods.end());
 
-        std::string key = normalize_host_path_(config_lei.string());
+        std::string key{};
+        auto append_overlay = [&](const std::string& norm) {
+            if (overlays == nullptr) return;
+            const auto it = overlays->find(norm);
+            if (it == overlays->end()) return;
+            key += "#ov=" + std::to_string(std::hash<std::string>{}(it->second));
+        };
+
+        const std::string config_norm = normalize_host_path_(config_lei.string());
+        key = config_norm;
         key += "|cfg_m=" + std::to_string(file_mtime_tick_(config_lei));
+        append_overlay(config_norm);
         for (const auto& m : mods) {
-            key += "|m=" + normalize_host_path_(m);
+            const auto norm = normalize_host_path_(m);
+            key += "|m=" + norm;
             key += "@";
             key += std::to_string(file_mtime_tick_(std::filesystem::path(m)));
+            append_overlay(norm);
         }
         return key;
     }
@@ -1801,8 +1953,9 @@ namespace {
         std::string io_err{};
         if (!parus::open_file(path.string(), text, io_err)) return std::nullopt;
 
+        JsonStringStore strings{};
         JsonValue root{};
-        JsonParser parser(text);
+        JsonParser parser(text, strings);
         if (!parser.parse(root)) return std::nullopt;
 
         if (const auto value = as_string_(obj_get_(root, key)); value.has_value()) {
@@ -1902,116 +2055,6 @@ namespace {
         return {};
     }
 
-    std::string_view clone_sv_into_ast_(parus::ast::AstArena& dst, std::string_view s) {
-        if (s.empty()) return {};
-        return dst.add_owned_string(std::string(s));
-    }
-
-    parus::Token clone_token_into_ast_(parus::ast::AstArena& dst, const parus::Token& src) {
-        parus::Token out = src;
-        out.lexeme = clone_sv_into_ast_(dst, src.lexeme);
-        return out;
-    }
-
-    void copy_macro_token_range_into_ast_(
-        const parus::ast::AstArena& src,
-        parus::ast::AstArena& dst,
-        uint32_t in_begin,
-        uint32_t in_count,
-        uint32_t& out_begin,
-        uint32_t& out_count
-    ) {
-        out_begin = static_cast<uint32_t>(dst.macro_tokens().size());
-        out_count = 0;
-
-        const auto& toks = src.macro_tokens();
-        const uint64_t begin = in_begin;
-        const uint64_t end = begin + in_count;
-        if (begin > toks.size() || end > toks.size()) return;
-        for (uint32_t i = 0; i < in_count; ++i) {
-            const auto& t = toks[in_begin + i];
-            (void)dst.add_macro_token(clone_token_into_ast_(dst, t));
-            ++out_count;
-        }
-    }
-
-    void append_top_level_macro_decls_(
-        const parus::ast::AstArena& src,
-        parus::ast::AstArena& dst
-    ) {
-        const auto& src_decls = src.macro_decls();
-        const auto& src_groups = src.macro_groups();
-        const auto& src_arms = src.macro_arms();
-        const auto& src_caps = src.macro_captures();
-
-        for (const auto& d : src_decls) {
-            if (d.scope_depth != 0) continue;
-            if (!d.is_export) continue; // expose only public core macros to user files
-
-            parus::ast::MacroDecl nd{};
-            nd.name = clone_sv_into_ast_(dst, d.name);
-            nd.scope_depth = 0;
-            nd.is_export = true;
-            nd.span = d.span;
-            nd.group_begin = static_cast<uint32_t>(dst.macro_groups().size());
-            nd.group_count = 0;
-
-            const uint64_t g_begin = d.group_begin;
-            const uint64_t g_end = g_begin + d.group_count;
-            if (g_begin > src_groups.size() || g_end > src_groups.size()) continue;
-
-            for (uint32_t gi = 0; gi < d.group_count; ++gi) {
-                const auto& g = src_groups[d.group_begin + gi];
-                parus::ast::MacroGroup ng{};
-                ng.match_kind = g.match_kind;
-                ng.span = g.span;
-                ng.arm_begin = static_cast<uint32_t>(dst.macro_arms().size());
-                ng.arm_count = 0;
-
-                const uint64_t a_begin = g.arm_begin;
-                const uint64_t a_end = a_begin + g.arm_count;
-                if (a_begin > src_arms.size() || a_end > src_arms.size()) continue;
-
-                for (uint32_t ai = 0; ai < g.arm_count; ++ai) {
-                    const auto& a = src_arms[g.arm_begin + ai];
-                    parus::ast::MacroArm na{};
-                    na.out_kind = a.out_kind;
-                    na.span = a.span;
-                    na.capture_begin = static_cast<uint32_t>(dst.macro_captures().size());
-                    na.capture_count = 0;
-
-                    const uint64_t c_begin = a.capture_begin;
-                    const uint64_t c_end = c_begin + a.capture_count;
-                    if (c_begin <= src_caps.size() && c_end <= src_caps.size()) {
-                        for (uint32_t ci = 0; ci < a.capture_count; ++ci) {
-                            auto cap = src_caps[a.capture_begin + ci];
-                            cap.name = clone_sv_into_ast_(dst, cap.name);
-                            (void)dst.add_macro_capture(cap);
-                            ++na.capture_count;
-                        }
-                    }
-
-                    copy_macro_token_range_into_ast_(
-                        src, dst, a.pattern_token_begin, a.pattern_token_count,
-                        na.pattern_token_begin, na.pattern_token_count
-                    );
-                    copy_macro_token_range_into_ast_(
-                        src, dst, a.template_token_begin, a.template_token_count,
-                        na.template_token_begin, na.template_token_count
-                    );
-
-                    (void)dst.add_macro_arm(na);
-                    ++ng.arm_count;
-                }
-
-                (void)dst.add_macro_group(ng);
-                ++nd.group_count;
-            }
-
-            (void)dst.add_macro_decl(nd);
-        }
-    }
-
     bool load_core_macro_prelude_into_ast_(
         parus::ast::AstArena& dst_ast,
         parus::SourceManager& sm,
@@ -2040,27 +2083,12 @@ namespace {
             return false;
         }
 
+        // 재분석마다 같은 prelude를 다시 lex/parse 하지 않도록 내용 hash 기준 공유 캐시를 쓴다.
         const uint32_t fid = sm.add(prelude_path, text);
-        parus::Lexer lexer(sm.content(fid), fid, &bag);
-        auto tokens = lexer.lex_all();
-        if (bag.has_error()) {
-            out_err = "failed to lex core macro prelude: " + prelude_path;
-            return false;
-        }
+        const auto prelude = parus::macro::shared_macro_prelude(prelude_path, std::move(text), fid, bag, out_err);
+        if (prelude == nullptr) return false;
 
-        parus::ast::AstArena src_ast{};
-        parus::ty::TypePool src_types{};
-        parus::diag::Bag local_bag{};
-        parus::ParserFeatureFlags flags{};
-        parus::Parser p(tokens, src_ast, src_types, &local_bag, 128, flags);
-        (void)p.parse_program();
-        if (local_bag.has_error()) {
-            for (const auto& d : local_bag.diags()) bag.add(d);
-            out_err = "failed to parse core macro prelude: " + prelude_path;
-            return false;
-        }
-
-        append_top_level_macro_decls_(src_ast, dst_ast);
+        parus::macro::append_macro_prelude(prelude, dst_ast, fid);
         return true;
     }
 
@@ -2152,23 +2180,6 @@ namespace {
         return next == '/' || next == '\\';
     }
 
-    void invalidate_lint_caches_for_root_(const std::filesystem::path& root) {
-        for (auto it = g_bundle_units_cache_.begin(); it != g_bundle_units_cache_.end();) {
-            if (is_under_root_(it->second.config_lei.parent_path(), root)) {
-                it = g_bundle_units_cache_.erase(it);
-            } else {
-                ++it;
-            }
-        }
-        for (auto it = g_lint_context_cache_.begin(); it != g_lint_context_cache_.end();) {
-            if (is_under_root_(it->second.config_lei.parent_path(), root)) {
-                it = g_lint_context_cache_.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
-
     std::string shell_quote_(std::string_view s) {
         bool need = s.empty();
         for (const char c : s) {
@@ -2554,8 +2565,9 @@ namespace {
             return fail("failed to read export-index: " + index_path.string());
         }
 
+        JsonStringStore strings{};
         JsonValue root{};
-        JsonParser parser(json);
+        JsonParser parser(json, strings);
         if (!parser.parse(root)) {
             return fail("failed to parse export-index json: " + index_path.string());
         }
@@ -2724,16 +2736,15 @@ namespace {
         std::string& out_cache_key,
         const std::unordered_map<std::string, std::string>* overlays = nullptr
     ) {
-        const bool use_overlay = (overlays != nullptr && !overlays->empty());
+        // overlay 텍스트는 키에 해시로 들어가므로 열린 .lei가 있어도 스냅샷을 재사용할 수 있다.
         const std::string config_key = normalize_host_path_(config_lei.string());
-        if (!use_overlay) {
-            if (auto it = g_bundle_units_cache_.find(config_key); it != g_bundle_units_cache_.end()) {
-                const std::string key_now = make_bundle_units_cache_key_(config_lei, it->second.loaded_module_paths);
-                if (key_now == it->second.cache_key) {
-                    out_units = it->second.units;
-                    out_cache_key = key_now;
-                    return true;
-                }
+        if (auto it = g_bundle_units_cache_.find(config_key); it != g_bundle_units_cache_.end()) {
+            const std::string key_now =
+                make_bundle_units_cache_key_(config_lei, it->second.loaded_module_paths, overlays);
+            if (key_now == it->second.cache_key) {
+                out_units = it->second.units;
+                out_cache_key = key_now;
+                return true;
             }
         }
 
@@ -2742,25 +2753,23 @@ namespace {
         if (!collect_bundle_units_from_master_(config_lei, units, &loaded_modules, overlays)) {
             return false;
         }
-        const std::string key_now = make_bundle_units_cache_key_(config_lei, loaded_modules);
+        const std::string key_now = make_bundle_units_cache_key_(config_lei, loaded_modules, overlays);
 
-        if (!use_overlay) {
-            BundleUnitsSnapshotCache snap{};
-            snap.config_lei = config_lei;
-            snap.cache_key = key_now;
-            snap.loaded_module_paths = std::move(loaded_modules);
-            snap.units = units;
-            g_bundle_units_cache_[config_key] = std::move(snap);
-        }
+        BundleUnitsSnapshotCache snap{};
+        snap.config_lei = config_lei;
+        snap.cache_key = key_now;
+        snap.loaded_module_paths = std::move(loaded_modules);
+        snap.units = units;
+        g_bundle_units_cache_[config_key] = std::move(snap);
 
         out_units = std::move(units);
         out_cache_key = key_now;
         return true;
     }
 
-    std::optional<ParusBundleLintContext> build_parus_bundle_lint_context_(
+    std::optional<ParusBundleLintContext> build_parus_bundle_lint_context_unlocked_(
         std::string_view uri_or_path,
-        const std::unordered_map<std::string, std::string>* overlays = nullptr
+        const std::unordered_map<std::string, std::string>* overlays
     ) {
         std::string current_file = std::string(uri_or_path);
         if (const auto fs_path = uri_to_file_path_(uri_or_path); fs_path.has_value()) {
@@ -2776,13 +2785,10 @@ namespace {
             return std::nullopt;
         }
 
-        const bool use_overlay = (overlays != nullptr && !overlays->empty());
-        if (!use_overlay) {
-            if (auto it = g_lint_context_cache_.find(normalized_current); it != g_lint_context_cache_.end()) {
-                if (same_file_path_(it->second.config_lei, *config_lei) &&
-                    it->second.cache_key == units_cache_key) {
-                    return it->second.ctx;
-                }
+        if (auto it = g_lint_context_cache_.find(normalized_current); it != g_lint_context_cache_.end()) {
+            if (same_file_path_(it->second.config_lei, *config_lei) &&
+                it->second.cache_key == units_cache_key) {
+                return it->second.ctx;
             }
         }
 
@@ -2927,23 +2933,163 @@ namespace {
             load_one_bundle(dep, /*same_bundle=*/false);
         }
 
-        if (!use_overlay) {
-            g_lint_context_cache_[normalized_current] = LintContextCacheEntry{
-                *config_lei,
-                units_cache_key,
-                ctx,
-            };
-        }
+        g_lint_context_cache_[normalized_current] = LintContextCacheEntry{
+            *config_lei,
+            units_cache_key,
+            ctx,
+        };
         return ctx;
     }
+
+    std::optional<ParusBundleLintContext> build_parus_bundle_lint_context_(
+        std::string_view uri_or_path,
+        const std::unordered_map<std::string, std::string>* overlays = nullptr
+    ) {
+        std::lock_guard<std::mutex> lock(g_lint_cache_mu_);
+        return build_parus_bundle_lint_context_unlocked_(uri_or_path, overlays);
+    }
+
+    /// @brief 현재 overlay 기준 bundle unit 목록. 스냅샷 캐시를 함께 갱신한다.
+    std::optional<std::vector<BundleUnitMeta>> bundle_units_for_config_(
+        const std::filesystem::path& config_lei,
+        const std::unordered_map<std::string, std::string>* overlays
+    ) {
+        std::lock_guard<std::mutex> lock(g_lint_cache_mu_);
+        std::vector<BundleUnitMeta> units{};
+        std::string cache_key{};
+        if (!get_bundle_units_for_config_(config_lei, units, cache_key, overlays)) return std::nullopt;
+        return units;
+    }
+
+    /// @brief 두 unit 목록을 bundle 이름으로 비교해 메타데이터가 바뀐 소스 경로(정규화)를 모은다.
+    ///
+    /// 바뀐 bundle뿐 아니라 그 bundle에 (전이적으로) 의존하는 bundle의 소스도 포함한다.
+    std::unordered_set<std::string> changed_bundle_sources_(
+        const std::vector<BundleUnitMeta>& before,
+        const std::vector<BundleUnitMeta>& after,
+        size_t* out_changed_bundles = nullptr
+    ) {
+        std::unordered_map<std::string, const BundleUnitMeta*> before_by_name{};
+        std::unordered_map<std::string, const BundleUnitMeta*> after_by_name{};
+        for (const auto& u : before) before_by_name.emplace(u.bundle_name, &u);
+        for (const auto& u : after) after_by_name.emplace(u.bundle_name, &u);
+
+        std::unordered_set<std::string> changed{};
+        for (const auto& [name, u] : after_by_name) {
+            const auto prev = before_by_name.find(name);
+            if (prev == before_by_name.end() || !(*prev->second == *u)) changed.insert(name);
+        }
+        for (const auto& [name, u] : before_by_name) {
+            if (!after_by_name.contains(name)) changed.insert(name);
+        }
+        for (bool grew = !changed.empty(); grew;) {
+            grew = false;
+            for (const auto& u : after) {
+                if (changed.contains(u.bundle_name)) continue;
+                for (const auto& dep : u.bundle_deps) {
+                    if (!changed.contains(dep)) continue;
+                    changed.insert(u.bundle_name);
+                    grew = true;
+                    break;
+                }
+            }
+        }
+
+        std::unordered_set<std::string> sources{};
+        for (const auto* units : {&before, &after}) {
+            for (const auto& u : *units) {
+                if (!changed.contains(u.bundle_name)) continue;
+                sources.insert(u.normalized_sources.begin(), u.normalized_sources.end());
+            }
+        }
+        if (out_changed_bundles != nullptr) *out_changed_bundles = changed.size();
+        return sources;
+    }
 #endif
 
+    constexpr uint64_t kFnv1a64Basis = 14695981039346656037ull;
+
+    uint64_t fnv1a64_(std::string_view s, uint64_t h = kFnv1a64Basis) {
+        for (const char c : s) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    uint64_t fnv1a64_u64_(uint64_t v, uint64_t h) {
+        for (int i = 0; i < 8; ++i) {
+            h ^= (v >> (i * 8)) & 0xffu;
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    /// @brief 증분 tyck 판단에 쓰는 top-level 아이템 지문.
+    struct TopItemFingerprint {
+        parus::ast::StmtId sid = parus::ast::k_invalid_stmt;
+        uint32_t lo = 0;
+        uint32_t hi = 0;
+        bool is_def = false;
+        std::string_view name{};
+        uint64_t content_hash = 0;   // 아이템 텍스트 + 시작 컬럼
+        uint64_t signature_hash = 0; // def 본문 `{` 이전 토큰열(공백 무관)
+        std::vector<std::string_view> refs{}; // 아이템이 쓰는 식별자
+    };
+
+    std::vector<TopItemFingerprint> fingerprint_top_items_(
+        const parus::parse::ParseSnapshot& snapshot,
+        std::string_view text
+    ) {
+        using K = parus::syntax::TokenKind;
+        const auto& toks = snapshot.tokens;
+        std::vector<TopItemFingerprint> out{};
+        out.reserve(snapshot.top_items.size());
+
+        size_t tok_i = 0;
+        for (const auto& item : snapshot.top_items) {
+            TopItemFingerprint fp{};
+            fp.sid = item.sid;
+            fp.lo = item.lo;
+            fp.hi = std::max(item.hi, item.lo);
+            const auto& st = snapshot.ast.stmt(item.sid);
+            fp.is_def = (st.kind == parus::ast::StmtKind::kFnDecl);
+            fp.name = st.name;
+
+            const size_t lo = std::min<size_t>(fp.lo, text.size());
+            const size_t hi = std::min<size_t>(fp.hi, text.size());
+            const size_t nl = (lo == 0) ? std::string_view::npos : text.rfind('\n', lo - 1);
+            const size_t column = (nl == std::string_view::npos) ? lo : (lo - nl - 1);
+            fp.content_hash = fnv1a64_(text.substr(lo, hi - lo), fnv1a64_u64_(column, kFnv1a64Basis));
+
+            while (tok_i < toks.size() && toks[tok_i].span.lo < fp.lo) ++tok_i;
+            uint64_t sig = kFnv1a64Basis;
+            bool in_header = fp.is_def;
+            for (size_t j = tok_i; j < toks.size() && toks[j].span.lo < fp.hi; ++j) {
+                const auto& tok = toks[j];
+                if (in_header) {
+                    if (tok.kind == K::kLBrace) {
+                        in_header = false;
+                    } else {
+                        sig = fnv1a64_(tok.lexeme, sig);
+                        sig = fnv1a64_("\x1f", sig);
+                    }
+                }
+                if (tok.kind == K::kIdent) fp.refs.push_back(tok.lexeme);
+            }
+            fp.signature_hash = sig;
+            out.push_back(std::move(fp));
+        }
+        return out;
+    }
+
     AnalysisResult analyze_parus_document_(
         std::string_view uri,
         DocumentState& doc,
         const parus::macro::ExpansionBudget& macro_budget,
         const ServerCImportConfig& cimport_cfg,
-        const std::unordered_map<std::string, std::string>* lei_overlays
+        const std::unordered_map<std::string, std::string>* lei_overlays,
+        const std::vector<parus::diag::Diagnostic>* carried_parse_diags = nullptr
     ) {
         AnalysisResult out;
 
@@ -2955,6 +3101,9 @@ namespace {
         const std::string current_dir = parent_dir_norm_(normalized_current);
 
         parus::diag::Bag bag;
+        if (carried_parse_diags != nullptr) {
+            for (const auto& d : *carried_parse_diags) bag.add(d);
+        }
         if (!doc.parse_ready || !doc.parse_session.ready()) {
             doc.parse_ready = doc.parse_session.initialize(sm.content(file_id), file_id, bag);
             doc.pending_edits.clear();
@@ -2969,17 +3118,71 @@ namespace {
             out.parse_mode = parus::parse::ReparseMode::kNone;
             return out;
         }
+        const size_t parse_diag_count = bag.diags().size();
 
         out.parse_mode = doc.parse_session.last_mode();
 
         // Incremental parser snapshot은 다음 reparse의 정본으로 유지해야 한다.
         // (macro/type-check 단계에서 snapshot을 직접 변형하면 didChange 이후 진단이 불안정해진다.)
+        // 전개/타입 해석/tyck가 기존 노드를 제자리에서 고치므로 mark/truncate로는 되돌릴 수 없어 복사한다.
+        // 병합은 교체된 item을 arena에서 잘라 내므로 사본에는 살아있는 노드만 들어 있다.
         const auto& snapshot = doc.parse_session.snapshot();
         auto ast = snapshot.ast;
         auto types = snapshot.types;
         auto root = snapshot.root;
         const auto& toks = snapshot.tokens;
 
+        // 증분 tyck: 직전 분석과 내용이 같고 시그니처가 바뀐 def를 참조하지 않는 top-level def는
+        // 본문 검사를 건너뛰고 이전 tyck/capability 진단을 재사용한다. def가 아닌 아이템
+        // (import, class, acts, nest ...)이 하나라도 바뀌면 전체를 다시 검사한다.
+        const auto item_fps = fingerprint_top_items_(snapshot, doc.text);
+        uint64_t non_def_hash = kFnv1a64Basis;
+        std::unordered_map<std::string, uint64_t> def_signatures{};
+        std::unordered_map<uint64_t, uint32_t> content_counts{};
+        for (const auto& fp : item_fps) {
+            ++content_counts[fp.content_hash];
+            if (!fp.is_def) {
+                non_def_hash = fnv1a64_u64_(fp.content_hash, non_def_hash);
+                continue;
+            }
+            ++out.tyck_def_items;
+            // 오버로드는 같은 이름의 시그니처 해시 합으로 본다.
+            def_signatures[std::string(fp.name)] += fp.signature_hash;
+        }
+
+        const auto& prev_items = doc.tyck_items;
+        std::vector<uint8_t> item_reused(item_fps.size(), 0u);
+        std::unordered_set<parus::ast::StmtId> body_skip_sids{};
+        // 재사용 아이템의 tyck 오류는 이번 bag에 다시 생기지 않으므로 capability 검사 여부를 따로 판단한다.
+        bool reused_has_tyck_error = false;
+        if (prev_items.valid && prev_items.non_def_hash == non_def_hash) {
+            std::unordered_set<std::string_view> changed_names{};
+            for (const auto& [name, sig] : def_signatures) {
+                const auto it = prev_items.def_signatures.find(name);
+                if (it == prev_items.def_signatures.end() || it->second != sig) changed_names.insert(name);
+            }
+            for (const auto& [name, sig] : prev_items.def_signatures) {
+                if (!def_signatures.contains(name)) changed_names.insert(name);
+            }
+            for (size_t i = 0; i < item_fps.size(); ++i) {
+                const auto& fp = item_fps[i];
+                if (!fp.is_def || content_counts[fp.content_hash] != 1) continue;
+                if (!prev_items.items.contains(fp.content_hash)) continue;
+                const bool uses_changed = std::any_of(fp.refs.begin(), fp.refs.end(), [&](std::string_view r) {
+                    return changed_names.contains(r);
+                });
+                if (uses_changed) continue;
+                item_reused[i] = 1u;
+                body_skip_sids.insert(fp.sid);
+                ++out.tyck_reused_items;
+                const auto& cached = prev_items.items.at(fp.content_hash);
+                reused_has_tyck_error = reused_has_tyck_error ||
+                    std::any_of(cached.tyck_diags.begin(), cached.tyck_diags.end(), [](const LspDiag& d) {
+                        return d.severity == 1;
+                    });
+            }
+        }
+
 #if PARUSD_ENABLE_LEI
         std::optional<ParusBundleLintContext> lint_ctx_for_doc{};
         if (!bag.has_error()) {
@@ -3019,6 +3222,9 @@ namespace {
         std::unordered_map<uint64_t, SemClass> resolved_map;
         parus::passes::PassResults pass_res{};
         bool has_pass_results = false;
+        size_t tyck_diag_begin = 0;
+        size_t cap_diag_begin = 0;
+        bool cap_ran = false;
         std::unordered_map<std::string, std::vector<LspLocation>> external_definitions{};
         if (!bag.has_error()) {
             const bool auto_core_macro_injection =
@@ -3576,10 +3782,29 @@ namespace {
                             if (!core_impl_marker_file_ids.empty()) {
                                 tc.set_core_impl_marker_file_ids(std::move(core_impl_marker_file_ids));
                             }
+                            if (!body_skip_sids.empty()) {
+                                tc.set_body_skip_stmts(std::move(body_skip_sids));
+                            }
+                            tyck_diag_begin = bag.diags().size();
                             const auto ty = tc.check_program(root);
-
-                            if (!bag.has_error() && ty.errors.empty()) {
+                            cap_diag_begin = bag.diags().size();
+                            out.tyck_ran = true;
+
+                            if (!bag.has_error() && ty.errors.empty() && !reused_has_tyck_error) {
+                                // 재사용 아이템에 capability 결과가 없으면(직전 분석이 tyck 오류로 멈춘 경우)
+                                // 캐시를 버리고 전체를 다시 검사한다. 재귀는 한 번만 일어난다.
+                                for (size_t i = 0; i < item_fps.size(); ++i) {
+                                    if (item_reused[i] == 0u) continue;
+                                    if (prev_items.items.at(item_fps[i].content_hash).cap_checked) continue;
+                                    doc.tyck_items = DocumentState::TyckItemCache{};
+                                    const std::vector<parus::diag::Diagnostic> parse_diags(
+                                        bag.diags().begin(),
+                                        bag.diags().begin() + static_cast<std::ptrdiff_t>(parse_diag_count));
+                                    return analyze_parus_document_(
+                                        uri, doc, macro_budget, cimport_cfg, lei_overlays, &parse_diags);
+                                }
                                 (void)parus::cap::run_capability_check(ast, root, pass_res.name_resolve, ty, types, bag);
+                                cap_ran = true;
                             }
                         }
                     }
@@ -3624,8 +3849,8 @@ namespace {
             const auto& tok = toks[i];
             if (tok.kind == K::kEof || tok.kind == K::kError) continue;
 
-            const auto prev_kind = (i > 0) ? toks[i - 1].kind : K::kError;
-            const auto next_kind = (i + 1 < toks.size()) ? toks[i + 1].kind : K::kError;
+            const auto prev_kind = (i > 0) ? toks.kind(i - 1) : K::kError;
+            const auto next_kind = (i + 1 < toks.size()) ? toks.kind(i + 1) : K::kError;
             SemClass sem_class{};
             bool has_sem_class = false;
 
@@ -3675,7 +3900,7 @@ namespace {
             } else if (tok.kind == K::kAt) {
                 sem_class = SemClass{static_cast<uint32_t>(SemTokenType::kDecorator), 0};
                 has_sem_class = true;
-            } else if (is_keyword_token_kind_(tok.kind)) {
+            } else if (parus::syntax::is_keyword_kind(tok.kind)) {
                 sem_class = SemClass{static_cast<uint32_t>(SemTokenType::kKeyword), 0};
                 has_sem_class = true;
             } else if (is_operator_token_kind_(tok.kind)) {
@@ -3691,8 +3916,24 @@ namespace {
             }
         }
 
+        const auto item_index_for = [&](const parus::Span& sp) -> size_t {
+            if (sp.file_id != file_id) return item_fps.size();
+            const auto it = std::upper_bound(item_fps.begin(), item_fps.end(), sp.lo,
+                                             [](uint32_t off, const TopItemFingerprint& fp) { return off < fp.lo; });
+            if (it == item_fps.begin()) return item_fps.size();
+            const size_t idx = static_cast<size_t>(it - item_fps.begin()) - 1;
+            return (sp.lo < item_fps[idx].hi) ? idx : item_fps.size();
+        };
+        const auto item_start_line = [&](size_t idx) -> uint32_t {
+            const auto lc = sm.line_col(file_id, item_fps[idx].lo);
+            return (lc.line > 0) ? (lc.line - 1) : 0;
+        };
+
+        std::vector<DocumentState::TyckItemEntry> fresh_items(item_fps.size());
         out.diagnostics.reserve(bag.diags().size());
-        for (const auto& d : bag.diags()) {
+        const auto& all_diags = bag.diags();
+        for (size_t di = 0; di < all_diags.size(); ++di) {
+            const auto& d = all_diags[di];
             const auto sp = d.span();
             const uint32_t end_off = (sp.hi >= sp.lo) ? sp.hi : sp.lo;
             const auto begin_lc = sm.line_col(sp.file_id, sp.lo);
@@ -3706,9 +3947,55 @@ namespace {
             ld.severity = to_lsp_severity_(d.severity());
             ld.code = parus::diag::code_name(d.code());
             ld.message = parus::diag::render_message(d, parus::diag::Language::kEn);
+
+            if (out.tyck_ran && di >= tyck_diag_begin) {
+                const size_t item = item_index_for(sp);
+                if (item < item_fps.size() && item_fps[item].is_def) {
+                    // 재사용 아이템의 tyck 진단은 아래에서 캐시로 대체한다.
+                    if (item_reused[item] != 0u) continue;
+                    const uint32_t base = item_start_line(item);
+                    LspDiag rel = ld;
+                    rel.start_line -= std::min(rel.start_line, base);
+                    rel.end_line -= std::min(rel.end_line, base);
+                    auto& entry = fresh_items[item];
+                    (di >= cap_diag_begin ? entry.cap_diags : entry.tyck_diags).push_back(std::move(rel));
+                }
+            }
             out.diagnostics.push_back(std::move(ld));
         }
 
+        if (!out.tyck_ran) {
+            out.tyck_reused_items = 0;
+            doc.tyck_items = DocumentState::TyckItemCache{};
+            return out;
+        }
+
+        DocumentState::TyckItemCache next_items{};
+        next_items.valid = true;
+        next_items.non_def_hash = non_def_hash;
+        for (size_t i = 0; i < item_fps.size(); ++i) {
+            if (!item_fps[i].is_def) continue;
+            auto& entry = fresh_items[i];
+            if (item_reused[i] != 0u) {
+                entry = prev_items.items.at(item_fps[i].content_hash);
+                const uint32_t base = item_start_line(i);
+                const auto append_shifted = [&](const std::vector<LspDiag>& src) {
+                    for (LspDiag ld : src) {
+                        ld.start_line += base;
+                        ld.end_line += base;
+                        out.diagnostics.push_back(std::move(ld));
+                    }
+                };
+                append_shifted(entry.tyck_diags);
+                if (cap_ran) append_shifted(entry.cap_diags);
+            } else {
+                entry.cap_checked = cap_ran;
+            }
+            next_items.items[item_fps[i].content_hash] = std::move(entry);
+        }
+        next_items.def_signatures = std::move(def_signatures);
+        doc.tyck_items = std::move(next_items);
+
         return out;
     }
 
@@ -4122,20 +4409,6 @@ namespace {
         return out;
     }
 
-    std::unordered_map<std::string, std::string> build_lei_overlay_map_(
-        const std::unordered_map<std::string, DocumentState>& documents
-    ) {
-        std::unordered_map<std::string, std::string> out{};
-        out.reserve(documents.size());
-        for (const auto& [doc_uri, state] : documents) {
-            if (state.lang != DocLang::kLei) continue;
-            const auto fs_path = uri_to_file_path_(doc_uri);
-            if (!fs_path.has_value()) continue;
-            out.insert_or_assign(normalize_host_path_(*fs_path), state.text);
-        }
-        return out;
-    }
-
     AnalysisResult analyze_document_(
         std::string_view uri,
         DocumentState& doc,
@@ -4171,7 +4444,7 @@ namespace {
         }
     }
 
-    std::vector<uint32_t> encode_semantic_tokens_data_(std::vector<SemToken> toks) {
+    void sort_semantic_tokens_(std::vector<SemToken>& toks) {
         std::sort(toks.begin(), toks.end(), [](const SemToken& a, const SemToken& b) {
             if (a.line != b.line) return a.line < b.line;
             if (a.start_character != b.start_character) return a.start_character < b.start_character;
@@ -4179,7 +4452,10 @@ namespace {
             if (a.token_type != b.token_type) return a.token_type < b.token_type;
             return a.token_modifiers < b.token_modifiers;
         });
+    }
 
+    /// @brief 이미 (line, start) 순으로 정렬된 토큰을 LSP 상대 좌표 배열로 인코딩한다.
+    std::vector<uint32_t> encode_sorted_semantic_tokens_(std::span<const SemToken> toks) {
         std::vector<uint32_t> data;
         data.reserve(toks.size() * 5);
 
@@ -4207,17 +4483,73 @@ namespace {
         return data;
     }
 
+    std::vector<uint32_t> encode_semantic_tokens_data_(std::vector<SemToken> toks) {
+        sort_semantic_tokens_(toks);
+        return encode_sorted_semantic_tokens_(toks);
+    }
+
+    /// @brief 정렬된 토큰 중 range와 겹치는 구간을 잘라낸다.
+    std::span<const SemToken> semantic_tokens_in_range_(std::span<const SemToken> sorted, const Range& range) {
+        const auto before_start = [&](const SemToken& t) {
+            if (t.line != range.start.line) return t.line < range.start.line;
+            return t.start_character + t.length <= range.start.character;
+        };
+        const auto at_or_after_end = [&](const SemToken& t) {
+            if (t.line != range.end.line) return t.line > range.end.line;
+            return t.start_character >= range.end.character;
+        };
+        size_t lo = static_cast<size_t>(
+            std::lower_bound(sorted.begin(), sorted.end(), range.start.line,
+                             [](const SemToken& t, uint32_t line) { return t.line < line; }) - sorted.begin());
+        while (lo < sorted.size() && before_start(sorted[lo])) ++lo;
+        size_t hi = lo;
+        while (hi < sorted.size() && !at_or_after_end(sorted[hi])) ++hi;
+        return sorted.subspan(lo, hi - lo);
+    }
+
     std::string build_semantic_tokens_result_(const std::vector<SemToken>& toks) {
         const auto data = encode_semantic_tokens_data_(toks);
-        std::string json = "{\"data\":[";
-        for (size_t i = 0; i < data.size(); ++i) {
-            if (i != 0) json += ",";
-            json += std::to_string(data[i]);
-        }
-        json += "]}";
+        std::string json{};
+        JsonWriter(json).raw("{\"data\":").u32_array(data).raw("}");
         return json;
     }
 
+    void write_semantic_tokens_data_result_(JsonWriter& w, std::string_view result_id, std::span<const uint32_t> data) {
+        w.raw("{");
+        if (!result_id.empty()) {
+            w.raw("\"resultId\":").string(result_id).raw(",");
+        }
+        w.raw("\"data\":").u32_array(data).raw("}");
+    }
+
+    /// @brief 이전에 보낸 배열과 현재 배열의 공통 prefix/suffix를 제외한 단일 edit을 만든다.
+    void write_semantic_tokens_delta_result_(
+        JsonWriter& w,
+        std::string_view result_id,
+        std::span<const uint32_t> prev,
+        std::span<const uint32_t> cur
+    ) {
+        size_t prefix = 0;
+        while (prefix < prev.size() && prefix < cur.size() && prev[prefix] == cur[prefix]) ++prefix;
+        size_t suffix = 0;
+        while (suffix < prev.size() - prefix && suffix < cur.size() - prefix &&
+               prev[prev.size() - 1 - suffix] == cur[cur.size() - 1 - suffix]) {
+            ++suffix;
+        }
+
+        w.raw("{\"resultId\":").string(result_id).raw(",\"edits\":[");
+        const size_t delete_count = prev.size() - prefix - suffix;
+        const size_t insert_count = cur.size() - prefix - suffix;
+        if (delete_count != 0 || insert_count != 0) {
+            w.raw("{\"start\":").number(prefix).raw(",\"deleteCount\":").number(delete_count);
+            if (insert_count != 0) {
+                w.raw(",\"data\":").u32_array(cur.subspan(prefix, insert_count));
+            }
+            w.raw("}");
+        }
+        w.raw("]}");
+    }
+
     bool is_ident_char_(char ch) {
         const unsigned char u = static_cast<unsigned char>(ch);
         return std::isalnum(u) || ch == '_';
@@ -4260,6 +4592,15 @@ namespace {
         return std::string(text.substr(begin, end - begin));
     }
 
+    std::string ident_at_offset_(std::string_view text, size_t off) {
+        if (off > text.size()) off = text.size();
+        size_t begin = off;
+        while (begin > 0 && is_ident_char_(text[begin - 1])) --begin;
+        size_t end = off;
+        while (end < text.size() && is_ident_char_(text[end])) ++end;
+        return std::string(text.substr(begin, end - begin));
+    }
+
     std::string build_completion_result_(
         const std::vector<CompletionEntry>& items,
         std::string_view prefix
@@ -4316,6 +4657,9 @@ namespace {
         json += "\"positionEncoding\":\"utf-16\",";
         json += "\"completionProvider\":{\"triggerCharacters\":[\".\",\":\"],\"resolveProvider\":false},";
         json += "\"definitionProvider\":true,";
+        json += "\"referencesProvider\":true,";
+        json += "\"workspaceSymbolProvider\":true,";
+        json += "\"diagnosticProvider\":{\"interFileDependencies\":true,\"workspaceDiagnostics\":false},";
         json += "\"semanticTokensProvider\":{";
         json += "\"legend\":{";
         json += "\"tokenTypes\":[";
@@ -4331,40 +4675,63 @@ namespace {
         }
         json += "]";
         json += "},";
-        json += "\"full\":true,";
-        json += "\"range\":false";
+        json += "\"full\":{\"delta\":true},";
+        json += "\"range\":true";
         json += "}";
         json += "}}";
         return json;
     }
 
+    void append_lsp_diagnostics_json_(std::string& json, const std::vector<LspDiag>& diags) {
+        JsonWriter w(json);
+        w.raw("[");
+        for (size_t i = 0; i < diags.size(); ++i) {
+            if (i != 0) w.raw(",");
+            const auto& d = diags[i];
+            w.raw("{\"range\":{\"start\":{\"line\":").number(d.start_line)
+             .raw(",\"character\":").number(d.start_character)
+             .raw("},\"end\":{\"line\":").number(d.end_line)
+             .raw(",\"character\":").number(d.end_character)
+             .raw("}},\"severity\":").number(d.severity)
+             .raw(",\"code\":").string(d.code)
+             .raw(",\"source\":\"parusd\",\"message\":").string(d.message)
+             .raw("}");
+        }
+        w.raw("]");
+    }
+
     std::string build_publish_diagnostics_(
         std::string_view uri,
         int64_t version,
         const std::vector<LspDiag>& diags
     ) {
         std::string json;
-        json += "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{";
-        json += "\"uri\":\"" + json_escape_(uri) + "\",";
-        json += "\"version\":" + std::to_string(version) + ",";
-        json += "\"diagnostics\":[";
-        for (size_t i = 0; i < diags.size(); ++i) {
-            if (i != 0) json += ",";
-            const auto& d = diags[i];
-            json += "{";
-            json += "\"range\":{";
-            json += "\"start\":{\"line\":" + std::to_string(d.start_line)
-                 + ",\"character\":" + std::to_string(d.start_character) + "},";
-            json += "\"end\":{\"line\":" + std::to_string(d.end_line)
-                 + ",\"character\":" + std::to_string(d.end_character) + "}";
-            json += "},";
-            json += "\"severity\":" + std::to_string(d.severity) + ",";
-            json += "\"code\":\"" + json_escape_(d.code) + "\",";
-            json += "\"source\":\"parusd\",";
-            json += "\"message\":\"" + json_escape_(d.message) + "\"";
-            json += "}";
-        }
-        json += "]}}";
+        json.reserve(128 + uri.size() + diags.size() * 160);
+        JsonWriter(json)
+            .raw("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":")
+            .string(uri)
+            .raw(",\"version\":")
+            .number(version)
+            .raw(",\"diagnostics\":");
+        append_lsp_diagnostics_json_(json, diags);
+        json += "}}";
+        return json;
+    }
+
+    /// @brief `textDocument/diagnostic` 응답. result_id가 이전 값과 같으면 unchanged를 보낸다.
+    std::string build_document_diagnostic_result_(
+        std::string_view result_id,
+        std::optional<std::string_view> previous_result_id,
+        const std::vector<LspDiag>& diags
+    ) {
+        std::string json = "{\"kind\":";
+        if (previous_result_id.has_value() && *previous_result_id == result_id) {
+            json += "\"unchanged\",\"resultId\":\"" + json_escape_(result_id) + "\"}";
+            return json;
+        }
+        json += "\"full\",\"resultId\":\"" + json_escape_(result_id) + "\",\"items\":";
+        append_lsp_diagnostics_json_(json, diags);
+        json += "}";
         return json;
     }
 
@@ -4377,13 +4744,21 @@ namespace {
         return json;
     }
 
-    std::string build_response_result_(const JsonValue* id, std::string_view result_json) {
+    /// @brief 응답 envelope와 result를 버퍼 하나에 직접 쓴다. 큰 result를 중간 문자열로 복사하지 않는다.
+    template <typename WriteResult>
+    std::string write_response_result_(const JsonValue* id, WriteResult&& write_result) {
         if (id == nullptr) return {};
-        std::string out = "{\"jsonrpc\":\"2.0\",\"id\":" + json_value_to_text_(*id)
-                        + ",\"result\":" + std::string(result_json) + "}";
+        std::string out = "{\"jsonrpc\":\"2.0\",\"id\":" + json_value_to_text_(*id) + ",\"result\":";
+        JsonWriter w(out);
+        write_result(w);
+        out += "}";
         return out;
     }
 
+    std::string build_response_result_(const JsonValue* id, std::string_view result_json) {
+        return write_response_result_(id, [&](JsonWriter& w) { w.raw(result_json); });
+    }
+
     std::string build_response_error_(const JsonValue* id, int code, std::string_view message) {
         if (id == nullptr) return {};
         std::string out = "{\"jsonrpc\":\"2.0\",\"id\":" + json_value_to_text_(*id)
@@ -4394,55 +4769,897 @@ namespace {
         return out;
     }
 
-    class LspServer {
+    /// @brief 워크스페이스 인덱스의 선언 하나. 위치는 이름 토큰 기준이다.
+    struct IndexedDecl {
+        std::string name{};
+        std::string container{};
+        uint32_t kind = 0; // LSP SymbolKind
+        uint32_t line = 0;
+        uint32_t character = 0;
+        uint32_t end_character = 0;
+    };
+
+    /// @brief 식별자 토큰 하나의 위치(참조 후보).
+    struct IndexedRef {
+        uint32_t line = 0;
+        uint32_t character = 0;
+        uint32_t end_character = 0;
+    };
+
+    /// @brief 파일 하나의 색인. overlay면 열린 문서 텍스트 기준이라 디스크에 저장하지 않는다.
+    struct IndexedFile {
+        int64_t mtime = 0;
+        uint64_t size = 0;
+        bool overlay = false;
+        std::vector<IndexedDecl> decls{};
+        std::unordered_map<std::string, std::vector<IndexedRef>> refs{};
+    };
+
+    /// @brief workspace/symbol 질의 결과 한 건.
+    struct WorkspaceSymbolHit {
+        std::string path{};
+        IndexedDecl decl{};
+    };
+
+    uint32_t symbol_kind_for_stmt_(parus::ast::StmtKind kind) {
+        using K = parus::ast::StmtKind;
+        switch (kind) {
+            case K::kFnDecl: return 12;    // Function
+            case K::kProtoDecl: return 11; // Interface
+            case K::kFieldDecl: return 23; // Struct
+            case K::kClassDecl:
+            case K::kActorDecl:
+            case K::kActsDecl: return 5;   // Class
+            case K::kVar: return 13;       // Variable
+            default: return 13;
+        }
+    }
+
+    /// @brief span 안에서 name과 같은 첫 식별자 토큰을 찾는다. 없으면 span 시작을 쓴다.
+    parus::Span decl_name_span_(const parus::TokenStream& tokens, const parus::Span& decl, std::string_view name) {
+        for (size_t i = tokens.lower_bound(decl.lo); i < tokens.size() && tokens.span(i).lo < decl.hi; ++i) {
+            if (tokens.kind(i) == parus::syntax::TokenKind::kIdent && tokens.lexeme(i) == name) return tokens.span(i);
+        }
+        parus::Span sp = decl;
+        sp.hi = sp.lo + static_cast<uint32_t>(name.size());
+        return sp;
+    }
+
+    void collect_workspace_decls_stmt_(
+        const parus::ast::AstArena& ast,
+        parus::ast::StmtId sid,
+        const parus::TokenStream& tokens,
+        const parus::SourceManager& sm,
+        uint32_t file_id,
+        std::vector<std::string>& ns_stack,
+        std::vector<IndexedDecl>& out
+    ) {
+        if (sid == parus::ast::k_invalid_stmt) return;
+        const auto& s = ast.stmt(sid);
+        const auto& kids = ast.stmt_children();
+
+        if (s.kind == parus::ast::StmtKind::kBlock) {
+            const uint64_t end = static_cast<uint64_t>(s.stmt_begin) + s.stmt_count;
+            if (s.stmt_begin <= kids.size() && end <= kids.size()) {
+                for (uint32_t i = 0; i < s.stmt_count; ++i) {
+                    collect_workspace_decls_stmt_(ast, kids[s.stmt_begin + i], tokens, sm, file_id, ns_stack, out);
+                }
+            }
+            return;
+        }
+
+        if (s.kind == parus::ast::StmtKind::kNestDecl) {
+            const auto& segs = ast.path_segs();
+            uint32_t pushed = 0;
+            const uint64_t end = static_cast<uint64_t>(s.nest_path_begin) + s.nest_path_count;
+            if (s.nest_path_begin <= segs.size() && end <= segs.size()) {
+                for (uint32_t i = 0; i < s.nest_path_count; ++i) {
+                    ns_stack.push_back(std::string(segs[s.nest_path_begin + i]));
+                    ++pushed;
+                }
+            }
+            if (!s.nest_is_file_directive) {
+                collect_workspace_decls_stmt_(ast, s.a, tokens, sm, file_id, ns_stack, out);
+            }
+            while (pushed > 0) {
+                ns_stack.pop_back();
+                --pushed;
+            }
+            return;
+        }
+
+        bool named = false;
+        switch (s.kind) {
+            case parus::ast::StmtKind::kFnDecl:
+            case parus::ast::StmtKind::kFieldDecl:
+            case parus::ast::StmtKind::kProtoDecl:
+            case parus::ast::StmtKind::kClassDecl:
+            case parus::ast::StmtKind::kActorDecl:
+            case parus::ast::StmtKind::kActsDecl:
+                named = true;
+                break;
+            case parus::ast::StmtKind::kVar:
+                named = s.is_static || s.is_extern || s.is_export || (s.link_abi == parus::ast::LinkAbi::kC);
+                break;
+            default:
+                break;
+        }
+        if (!named || s.name.empty()) return;
+
+        const auto sp = decl_name_span_(tokens, s.span, s.name);
+        const auto begin_lc = sm.line_col(file_id, sp.lo);
+        const auto end_lc = sm.line_col(file_id, sp.hi);
+        if (begin_lc.line == 0 || begin_lc.col == 0 || end_lc.col == 0) return;
+
+        IndexedDecl d{};
+        d.name = std::string(s.name);
+        for (size_t i = 0; i < ns_stack.size(); ++i) {
+            if (i) d.container += "::";
+            d.container += ns_stack[i];
+        }
+        d.kind = symbol_kind_for_stmt_(s.kind);
+        d.line = begin_lc.line - 1;
+        d.character = begin_lc.col - 1;
+        d.end_character = (end_lc.line == begin_lc.line) ? end_lc.col - 1 : d.character + static_cast<uint32_t>(d.name.size());
+        out.push_back(std::move(d));
+    }
+
+    /// @brief 파싱 결과로 파일 색인을 만든다. 토큰 span은 sm의 file_id 파일 기준 오프셋이어야 한다.
+    IndexedFile index_parus_parsed_(
+        const parus::ast::AstArena& ast,
+        parus::ast::StmtId root,
+        const parus::TokenStream& tokens,
+        const parus::SourceManager& sm,
+        uint32_t file_id,
+        std::string_view module_head
+    ) {
+        IndexedFile out{};
+        std::vector<std::string> ns_stack{};
+        if (!module_head.empty()) ns_stack.push_back(std::string(module_head));
+        collect_workspace_decls_stmt_(ast, root, tokens, sm, file_id, ns_stack, out.decls);
+
+        for (const auto& t : tokens) {
+            if (t.kind != parus::syntax::TokenKind::kIdent || t.lexeme.empty()) continue;
+            const auto begin_lc = sm.line_col(file_id, t.span.lo);
+            const auto end_lc = sm.line_col(file_id, t.span.hi);
+            if (begin_lc.line == 0 || begin_lc.col == 0) continue;
+            IndexedRef r{};
+            r.line = begin_lc.line - 1;
+            r.character = begin_lc.col - 1;
+            r.end_character = (end_lc.line == begin_lc.line) ? end_lc.col - 1
+                                                             : r.character + static_cast<uint32_t>(t.lexeme.size());
+            out.refs[std::string(t.lexeme)].push_back(r);
+        }
+        return out;
+    }
+
+    /// @brief 텍스트를 lex/parse해서 파일 색인을 만든다(매크로 확장/타입체크 없음).
+    IndexedFile index_parus_text_(
+        std::string_view path,
+        std::string text,
+        std::string_view module_head,
+        const parus::ParserFeatureFlags& flags
+    ) {
+        parus::SourceManager sm;
+        const uint32_t file_id = sm.add(std::string(path), std::move(text));
+        parus::diag::Bag bag;
+        parus::Lexer lexer(sm.content(file_id), file_id, &bag);
+        const auto tokens = lexer.lex_all();
+        parus::ast::AstArena ast{};
+        parus::ty::TypePool types{};
+        parus::Parser parser(tokens, ast, types, &bag, 128, flags);
+        const auto root = parser.parse_program();
+        return index_parus_parsed_(ast, root, parus::TokenStream(sm.content(file_id), file_id, tokens), sm, file_id,
+                                   module_head);
+    }
+
+    bool file_stamp_(const std::string& path, int64_t& mtime, uint64_t& size) {
+        std::error_code ec{};
+        const auto t = std::filesystem::last_write_time(path, ec);
+        if (ec) return false;
+        const auto sz = std::filesystem::file_size(path, ec);
+        if (ec) return false;
+        mtime = static_cast<int64_t>(t.time_since_epoch().count());
+        size = static_cast<uint64_t>(sz);
+        return true;
+    }
+
+    /// @brief config.lei 루트별 워크스페이스 심볼 색인(선언 + 식별자 참조 위치).
+    ///
+    /// 디스크 파일은 전용 스레드가 읽어 색인하고 루트마다 사용자 캐시
+    /// (`parus_tools::paths::parusd_cache_dir`)의 `workspace-index.v1`에 저장한다. 저장은 변경이
+    /// 잠잠해진 뒤(kCacheSaveDelay)나 종료 시 루트 단위로 한 번에 한다. 다음 실행은 저장본을
+    /// 읽은 뒤 mtime/size가 바뀐 파일만 다시 색인한다. 열린 문서는 분석 워커의 파싱 결과로
+    /// 덮어쓴다(overlay). 참조는 식별자 이름 기준(lexical)이다.
+    class WorkspaceIndex {
     public:
-        int run() {
+        /// @brief inline_mode면 스레드 없이 drain()에서 작업을 처리한다(PARUSD_SYNC_ANALYSIS).
+        void start(bool inline_mode, bool trace) {
+            inline_mode_ = inline_mode;
+            trace_ = trace;
+            if (inline_mode_) return;
+            thread_ = std::thread([this] { thread_loop_(); });
+        }
+
+        void stop() {
+            if (inline_mode_) {
+                drain();
+                flush_dirty_caches_();
+                return;
+            }
+            if (!thread_.joinable()) return;
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            thread_.join();
+        }
+
+        void set_parser_features(const parus::ParserFeatureFlags& flags) {
+            std::lock_guard<std::mutex> lock(mu_);
+            parser_features_ = flags;
+        }
+
+        /// @brief 처음 보는 루트면 전체 색인을 예약한다.
+        void ensure_root(const std::filesystem::path& config_lei) {
+            const std::string key = normalize_host_path_(config_lei.parent_path().string());
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                if (roots_.contains(key)) return;
+                roots_[key].config_lei = config_lei;
+                push_task_unlocked_(Task{Task::Kind::kScanRoot, key});
+            }
+            cv_.notify_one();
+        }
+
+        /// @brief .lei 변경 등으로 소스 목록이 바뀌었을 수 있는 루트를 다시 훑는다.
+        void rescan_root(const std::filesystem::path& root_dir) {
+            const std::string key = normalize_host_path_(root_dir.string());
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                if (!roots_.contains(key)) return;
+                push_task_unlocked_(Task{Task::Kind::kScanRoot, key});
+            }
+            cv_.notify_one();
+        }
+
+        /// @brief 디스크에서 바뀐 소스 파일 하나를 다시 색인한다.
+        void refresh_file(const std::string& path) {
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                if (root_key_for_file_unlocked_(path).empty()) return;
+                push_task_unlocked_(Task{Task::Kind::kRefreshFile, path});
+            }
+            cv_.notify_one();
+        }
+
+        /// @brief 루트 안 파일의 모듈 head(컨테이너 접두). 모르면 빈 문자열.
+        std::string module_head_for(const std::string& path) const {
+            std::lock_guard<std::mutex> lock(mu_);
+            const auto key = root_key_for_file_unlocked_(path);
+            if (key.empty()) return {};
+            const auto& root = roots_.at(key);
+            const auto it = root.module_head_by_source.find(path);
+            return it == root.module_head_by_source.end() ? std::string{} : it->second;
+        }
+
+        /// @brief 열린 문서의 색인을 반영한다. 색인 중인 루트 밖 파일은 무시한다.
+        void update_overlay(const std::string& path, IndexedFile file) {
+            std::lock_guard<std::mutex> lock(mu_);
+            const auto key = root_key_for_file_unlocked_(path);
+            if (key.empty()) return;
+            file.overlay = true;
+            auto& root = roots_[key];
+            auto [it, inserted] = root.files.try_emplace(path);
+            // 디스크 색인은 저장본에 계속 쓰이도록 overlay가 걷힐 때까지 따로 보관한다.
+            if (!inserted && !it->second.overlay && it->second.mtime != -1) {
+                root.shadowed[path] = std::move(it->second);
+            }
+            it->second = std::move(file);
+        }
+
+        /// @brief 문서를 닫으면 overlay를 버리고 디스크 내용으로 다시 색인한다.
+        void drop_overlay(const std::string& path) {
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                const auto key = root_key_for_file_unlocked_(path);
+                if (key.empty()) return;
+                auto& files = roots_[key].files;
+                const auto it = files.find(path);
+                if (it == files.end() || !it->second.overlay) return;
+                roots_[key].shadowed.erase(path);
+                it->second.overlay = false;
+                it->second.mtime = -1;
+                push_task_unlocked_(Task{Task::Kind::kRefreshFile, path});
+            }
+            cv_.notify_one();
+        }
+
+        bool contains_file(const std::string& path) const {
+            std::lock_guard<std::mutex> lock(mu_);
+            const auto key = root_key_for_file_unlocked_(path);
+            return !key.empty() && roots_.at(key).files.contains(path);
+        }
+
+        /// @brief 이름에 query가 (대소문자 무시) 포함된 선언. 이름/경로/위치 순으로 정렬해 limit개까지.
+        ///
+        /// 락 안에서는 포인터만 모아 상위 limit개를 고르고, 그 limit개만 복사한다.
+        std::vector<WorkspaceSymbolHit> query_symbols(std::string_view query, size_t limit) const {
+            const std::string q = lower_ascii_(std::string(query));
+            auto matches = [&q](std::string_view name) {
+                if (q.empty()) return true;
+                if (name.size() < q.size()) return false;
+                for (size_t i = 0; i + q.size() <= name.size(); ++i) {
+                    size_t k = 0;
+                    while (k < q.size() &&
+                           static_cast<char>(std::tolower(static_cast<unsigned char>(name[i + k]))) == q[k]) {
+                        ++k;
+                    }
+                    if (k == q.size()) return true;
+                }
+                return false;
+            };
+            using Ref = std::pair<const std::string*, const IndexedDecl*>;
+            std::vector<WorkspaceSymbolHit> out{};
+            std::lock_guard<std::mutex> lock(mu_);
+            std::vector<Ref> refs{};
+            for (const auto& [_, root] : roots_) {
+                for (const auto& [path, file] : root.files) {
+                    for (const auto& d : file.decls) {
+                        if (matches(d.name)) refs.emplace_back(&path, &d);
+                    }
+                }
+            }
+            const auto less = [](const Ref& a, const Ref& b) {
+                if (a.second->name != b.second->name) return a.second->name < b.second->name;
+                if (*a.first != *b.first) return *a.first < *b.first;
+                return a.second->line < b.second->line;
+            };
+            const size_t n = std::min(limit, refs.size());
+            std::partial_sort(refs.begin(), refs.begin() + static_cast<std::ptrdiff_t>(n), refs.end(), less);
+            out.reserve(n);
+            for (size_t i = 0; i < n; ++i) out.push_back(WorkspaceSymbolHit{*refs[i].first, *refs[i].second});
+            return out;
+        }
+
+        /// @brief name 식별자의 모든 등장 위치. include_decl이 false면 같은 이름의 선언 위치는 뺀다.
+        std::vector<LspLocation> references(std::string_view name, bool include_decl) const {
+            std::vector<std::pair<std::string, IndexedRef>> hits{};
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                const std::string key(name);
+                for (const auto& [_, root] : roots_) {
+                    for (const auto& [path, file] : root.files) {
+                        collect_refs_(path, file, key, include_decl, hits);
+                    }
+                }
+            }
+            return refs_to_locations_(std::move(hits));
+        }
+
+        /// @brief 인덱스 밖 파일 하나에서 name의 등장 위치를 찾는다.
+        static std::vector<LspLocation> file_references(
+            std::string_view uri,
+            const IndexedFile& file,
+            const std::string& name,
+            bool include_decl
+        ) {
+            std::vector<std::pair<std::string, IndexedRef>> hits{};
+            collect_refs_(std::string(uri), file, name, include_decl, hits);
+            auto out = refs_to_locations_(std::move(hits));
+            for (auto& loc : out) loc.uri = std::string(uri);
+            return out;
+        }
+
+        /// @brief 예약된 작업을 호출 스레드에서 모두 처리한다(inline 모드 전용).
+        void drain() {
+            Task task{};
+            while (pop_task_(task)) run_task_(task);
+        }
+
+    private:
+        struct Task {
+            enum class Kind : uint8_t { kScanRoot, kRefreshFile };
+            Kind kind = Kind::kScanRoot;
+            std::string key{}; // kScanRoot: 루트 디렉터리, kRefreshFile: 파일 경로
+        };
+
+        struct Root {
+            std::filesystem::path config_lei{};
+            std::unordered_set<std::string> sources{};
+            std::unordered_map<std::string, std::string> module_head_by_source{};
+            std::unordered_map<std::string, IndexedFile> files{};
+            // overlay로 가려진 파일의 마지막 디스크 색인. 저장본에는 이것을 쓴다.
+            std::unordered_map<std::string, IndexedFile> shadowed{};
+        };
+
+        static constexpr std::string_view kCacheHeader = "parusd-workspace-index 1";
+        // 마지막 색인 작업 뒤 이만큼 조용하면 바뀐 루트의 저장본을 쓴다.
+        static constexpr std::chrono::milliseconds kCacheSaveDelay{2000};
+
+        static void collect_refs_(
+            const std::string& path,
+            const IndexedFile& file,
+            const std::string& name,
+            bool include_decl,
+            std::vector<std::pair<std::string, IndexedRef>>& out
+        ) {
+            const auto it = file.refs.find(name);
+            if (it == file.refs.end()) return;
+            for (const auto& r : it->second) {
+                if (!include_decl) {
+                    const bool is_decl = std::any_of(file.decls.begin(), file.decls.end(), [&](const IndexedDecl& d) {
+                        return d.name == name && d.line == r.line && d.character == r.character;
+                    });
+                    if (is_decl) continue;
+                }
+                out.emplace_back(path, r);
+            }
+        }
+
+        static std::vector<LspLocation> refs_to_locations_(std::vector<std::pair<std::string, IndexedRef>> hits) {
+            std::sort(hits.begin(), hits.end(), [](const auto& a, const auto& b) {
+                if (a.first != b.first) return a.first < b.first;
+                if (a.second.line != b.second.line) return a.second.line < b.second.line;
+                return a.second.character < b.second.character;
+            });
+            std::vector<LspLocation> out{};
+            out.reserve(hits.size());
+            for (const auto& [path, r] : hits) {
+                LspLocation loc{};
+                loc.uri = file_path_to_uri_(path);
+                loc.start_line = r.line;
+                loc.start_character = r.character;
+                loc.end_line = r.line;
+                loc.end_character = r.end_character;
+                out.push_back(std::move(loc));
+            }
+            return out;
+        }
+
+        void push_task_unlocked_(Task task) {
+            for (const auto& t : tasks_) {
+                if (t.kind == task.kind && t.key == task.key) return;
+            }
+            tasks_.push_back(std::move(task));
+        }
+
+        bool pop_task_(Task& out) {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (tasks_.empty()) return false;
+            out = std::move(tasks_.front());
+            tasks_.pop_front();
+            return true;
+        }
+
+        void thread_loop_() {
             while (true) {
-                std::string payload;
-                if (!read_lsp_message_(std::cin, payload)) {
-                    return 0;
+                Task task{};
+                {
+                    std::unique_lock<std::mutex> lock(mu_);
+                    const auto ready = [this] { return stop_ || !tasks_.empty(); };
+                    if (dirty_roots_.empty()) {
+                        cv_.wait(lock, ready);
+                    } else if (!cv_.wait_for(lock, kCacheSaveDelay, ready)) {
+                        lock.unlock();
+                        flush_dirty_caches_();
+                        continue;
+                    }
+                    if (stop_) {
+                        lock.unlock();
+                        flush_dirty_caches_();
+                        return;
+                    }
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
                 }
+                run_task_(task);
+            }
+        }
 
-                JsonValue msg{};
-                JsonParser parser(payload);
-                if (!parser.parse(msg) || msg.kind != JsonValue::Kind::kObject) {
-                    continue;
+        /// @brief path가 속한 루트 키. 가장 깊은 루트를 고른다.
+        std::string root_key_for_file_unlocked_(const std::string& path) const {
+            std::string best{};
+            for (const auto& [key, _] : roots_) {
+                if (key.size() <= best.size()) continue;
+                if (is_under_root_(std::filesystem::path(path), std::filesystem::path(key))) best = key;
+            }
+            return best;
+        }
+
+        void run_task_(const Task& task) {
+            if (task.kind == Task::Kind::kScanRoot) {
+                scan_root_(task.key);
+            } else {
+                refresh_file_(task.key);
+            }
+        }
+
+        static std::filesystem::path cache_file_(const std::string& root_key) {
+            return parus_tools::paths::parusd_cache_dir(std::filesystem::path(root_key)) / "workspace-index.v1";
+        }
+
+        void scan_root_(const std::string& root_key) {
+            std::filesystem::path config_lei{};
+            parus::ParserFeatureFlags flags{};
+            std::unordered_map<std::string, std::pair<int64_t, uint64_t>> current{};
+            bool first_scan = false;
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                const auto it = roots_.find(root_key);
+                if (it == roots_.end()) return;
+                config_lei = it->second.config_lei;
+                flags = parser_features_;
+                first_scan = it->second.sources.empty();
+                for (const auto& [path, file] : it->second.files) {
+                    current[path] = {file.overlay ? -1 : file.mtime, file.size};
                 }
+            }
 
-                const JsonValue* id = obj_get_(msg, "id");
-                const auto method = as_string_(obj_get_(msg, "method"));
-                if (!method.has_value()) {
+            std::vector<BundleUnitMeta> units{};
+            {
+                std::string cache_key{};
+                std::lock_guard<std::mutex> lock(g_lint_cache_mu_);
+                if (!get_bundle_units_for_config_(config_lei, units, cache_key)) return;
+            }
+            std::unordered_set<std::string> sources{};
+            std::unordered_map<std::string, std::string> heads{};
+            for (const auto& u : units) {
+                for (const auto& src : u.normalized_sources) {
+                    sources.insert(src);
+                    if (const auto it = u.module_head_by_source.find(src); it != u.module_head_by_source.end()) {
+                        heads[src] = it->second;
+                    }
+                }
+            }
+
+            std::unordered_map<std::string, IndexedFile> cached{};
+            if (first_scan) load_cache_(root_key, cached);
+
+            // 바뀐 파일만 락 밖에서 다시 색인한다. 그대로인 파일은 기존 항목을 유지한다.
+            std::unordered_map<std::string, IndexedFile> fresh{};
+            std::unordered_set<std::string> missing{};
+            size_t reindexed = 0;
+            for (const auto& src : sources) {
+                int64_t mtime = 0;
+                uint64_t size = 0;
+                if (!file_stamp_(src, mtime, size)) {
+                    missing.insert(src);
                     continue;
                 }
+                if (const auto it = current.find(src); it != current.end()) {
+                    if (it->second.first == -1) continue; // overlay
+                    if (it->second.first == mtime && it->second.second == size) continue;
+                }
+                if (const auto it = cached.find(src); it != cached.end() &&
+                    it->second.mtime == mtime && it->second.size == size) {
+                    fresh[src] = std::move(it->second);
+                    continue;
+                }
+                std::ifstream ifs(src, std::ios::binary);
+                if (!ifs) {
+                    missing.insert(src);
+                    continue;
+                }
+                std::ostringstream oss;
+                oss << ifs.rdbuf();
+                const auto head = heads.find(src);
+                auto file = index_parus_text_(src, std::move(oss).str(),
+                                              head == heads.end() ? std::string_view{} : std::string_view(head->second),
+                                              flags);
+                file.mtime = mtime;
+                file.size = size;
+                fresh[src] = std::move(file);
+                ++reindexed;
+            }
+
+            size_t file_count = 0;
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                const auto it = roots_.find(root_key);
+                if (it == roots_.end()) return;
+                auto& root = it->second;
+                for (auto fit = root.files.begin(); fit != root.files.end();) {
+                    const bool gone = !sources.contains(fit->first) || missing.contains(fit->first);
+                    if (gone) root.shadowed.erase(fit->first);
+                    if (gone && !fit->second.overlay) {
+                        fit = root.files.erase(fit);
+                    } else {
+                        ++fit;
+                    }
+                }
+                for (auto& [path, file] : fresh) {
+                    auto& slot = root.files[path];
+                    if (slot.overlay) continue; // 스캔 도중 열린 문서가 우선한다.
+                    slot = std::move(file);
+                }
+                root.sources = std::move(sources);
+                root.module_head_by_source = std::move(heads);
+                file_count = root.files.size();
+                dirty_roots_.insert(root_key);
+            }
+
+            if (trace_) {
+                std::cerr << "[parusd] workspace-index root=" << root_key
+                          << " files=" << file_count
+                          << " reindexed=" << reindexed << "\n";
+            }
+        }
+
+        void refresh_file_(const std::string& path) {
+            std::string root_key{};
+            std::string head{};
+            parus::ParserFeatureFlags flags{};
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                root_key = root_key_for_file_unlocked_(path);
+                if (root_key.empty()) return;
+                const auto& root = roots_.at(root_key);
+                if (!root.sources.contains(path)) return;
+                if (const auto it = root.files.find(path); it != root.files.end() && it->second.overlay) return;
+                if (const auto it = root.module_head_by_source.find(path); it != root.module_head_by_source.end()) {
+                    head = it->second;
+                }
+                flags = parser_features_;
+            }
+
+            int64_t mtime = 0;
+            uint64_t size = 0;
+            std::optional<IndexedFile> file{};
+            if (file_stamp_(path, mtime, size)) {
+                std::ifstream ifs(path, std::ios::binary);
+                if (ifs) {
+                    std::ostringstream oss;
+                    oss << ifs.rdbuf();
+                    file = index_parus_text_(path, std::move(oss).str(), head, flags);
+                    file->mtime = mtime;
+                    file->size = size;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mu_);
+            const auto it = roots_.find(root_key);
+            if (it == roots_.end()) return;
+            auto& files = it->second.files;
+            if (const auto fit = files.find(path); fit != files.end() && fit->second.overlay) return;
+            if (file.has_value()) {
+                files[path] = std::move(*file);
+            } else {
+                files.erase(path);
+            }
+            dirty_roots_.insert(root_key);
+        }
 
-                const auto params = obj_get_(msg, "params");
-                if (*method == "initialize") {
-                    const auto macro_cfg = parse_macro_config_from_initialize_(params);
-                    const auto cimport_cfg = parse_cimport_config_from_initialize_(params);
-                    macro_budget_ = macro_cfg.budget;
-                    parser_features_ = macro_cfg.parser_features;
-                    cimport_cfg_ = cimport_cfg;
-
-                    const std::string result = build_initialize_result_();
-                    const auto response = build_response_result_(id, result);
-                    if (!response.empty()) write_lsp_message_(std::cout, response);
-                    for (const auto& w : macro_cfg.warnings) {
-                        notify_log_message_(/*warning=*/2, w);
+        /// @brief 바뀐 루트의 저장본을 쓴다. 직렬화만 락 안에서 하고 파일 쓰기는 락 밖에서 한다.
+        void flush_dirty_caches_() {
+            std::vector<std::pair<std::string, std::string>> pending{};
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                for (const auto& root_key : dirty_roots_) {
+                    const auto it = roots_.find(root_key);
+                    if (it == roots_.end()) continue;
+                    pending.emplace_back(root_key, serialize_root_unlocked_(it->second));
+                }
+                dirty_roots_.clear();
+            }
+            for (const auto& [root_key, serialized] : pending) {
+                save_cache_(root_key, serialized);
+                if (trace_) std::cerr << "[parusd] workspace-index saved root=" << root_key << "\n";
+            }
+        }
+
+        /// 형식(줄 단위):
+        ///   F <mtime> <size> <path>
+        ///   D <kind> <line> <char> <end_char> <name> <container|->
+        ///   R <name> <line> <char> <end_char> ...
+        static std::string serialize_root_unlocked_(const Root& root) {
+            std::string out(kCacheHeader);
+            out += "\n";
+            for (const auto& [path, entry] : root.files) {
+                const IndexedFile* disk = &entry;
+                if (entry.overlay) {
+                    const auto it = root.shadowed.find(path);
+                    if (it == root.shadowed.end()) continue;
+                    disk = &it->second;
+                }
+                const IndexedFile& file = *disk;
+                out += "F " + std::to_string(file.mtime) + " " + std::to_string(file.size) + " " + path + "\n";
+                for (const auto& d : file.decls) {
+                    out += "D " + std::to_string(d.kind) + " " + std::to_string(d.line) + " " +
+                           std::to_string(d.character) + " " + std::to_string(d.end_character) + " " + d.name + " " +
+                           (d.container.empty() ? std::string("-") : d.container) + "\n";
+                }
+                for (const auto& [name, refs] : file.refs) {
+                    out += "R " + name;
+                    for (const auto& r : refs) {
+                        out += " " + std::to_string(r.line) + " " + std::to_string(r.character) + " " +
+                               std::to_string(r.end_character);
+                    }
+                    out += "\n";
+                }
+            }
+            return out;
+        }
+
+        static void save_cache_(const std::string& root_key, const std::string& serialized) {
+            namespace fs = std::filesystem;
+            const auto path = cache_file_(root_key);
+            std::error_code ec{};
+            fs::create_directories(path.parent_path(), ec);
+            if (ec) return;
+            const auto tmp = fs::path(path.string() + ".tmp");
+            {
+                std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+                if (!ofs) return;
+                ofs << serialized;
+                if (!ofs) return;
+            }
+            fs::rename(tmp, path, ec);
+            if (ec) fs::remove(tmp, ec);
+        }
+
+        /// @brief 저장본을 읽는다. 형식이 맞지 않으면 비운 채로 돌아간다(전체 재색인).
+        static void load_cache_(const std::string& root_key, std::unordered_map<std::string, IndexedFile>& out) {
+            std::ifstream ifs(cache_file_(root_key), std::ios::binary);
+            if (!ifs) return;
+            std::string line{};
+            if (!std::getline(ifs, line) || line != kCacheHeader) return;
+
+            auto next_field = [](std::string_view& rest) {
+                const size_t sp = rest.find(' ');
+                const std::string_view field = rest.substr(0, sp);
+                rest = (sp == std::string_view::npos) ? std::string_view{} : rest.substr(sp + 1);
+                return field;
+            };
+            auto parse_num = [](std::string_view s, auto& v) {
+                const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+                return ec == std::errc{} && ptr == s.data() + s.size();
+            };
+
+            IndexedFile* cur = nullptr;
+            while (std::getline(ifs, line)) {
+                if (line.size() < 2 || line[1] != ' ') {
+                    out.clear();
+                    return;
+                }
+                std::string_view rest = std::string_view(line).substr(2);
+                bool ok = true;
+                if (line[0] == 'F') {
+                    int64_t mtime = 0;
+                    uint64_t size = 0;
+                    ok = parse_num(next_field(rest), mtime) && parse_num(next_field(rest), size) && !rest.empty();
+                    if (ok) {
+                        cur = &out[std::string(rest)];
+                        cur->mtime = mtime;
+                        cur->size = size;
                     }
-                    for (const auto& w : cimport_cfg.warnings) {
-                        notify_log_message_(/*warning=*/2, w);
+                } else if (line[0] == 'D' && cur != nullptr) {
+                    IndexedDecl d{};
+                    ok = parse_num(next_field(rest), d.kind) && parse_num(next_field(rest), d.line) &&
+                         parse_num(next_field(rest), d.character) && parse_num(next_field(rest), d.end_character);
+                    d.name = std::string(next_field(rest));
+                    d.container = std::string(next_field(rest));
+                    if (d.container == "-") d.container.clear();
+                    ok = ok && !d.name.empty();
+                    if (ok) cur->decls.push_back(std::move(d));
+                } else if (line[0] == 'R' && cur != nullptr) {
+                    auto& refs = cur->refs[std::string(next_field(rest))];
+                    while (ok && !rest.empty()) {
+                        IndexedRef r{};
+                        ok = parse_num(next_field(rest), r.line) && parse_num(next_field(rest), r.character) &&
+                             parse_num(next_field(rest), r.end_character);
+                        if (ok) refs.push_back(r);
                     }
+                } else {
+                    ok = false;
+                }
+                if (!ok) {
+                    out.clear();
+                    return;
+                }
+            }
+        }
+
+        mutable std::mutex mu_{};
+        std::condition_variable cv_{};
+        std::deque<Task> tasks_{};
+        std::unordered_map<std::string, Root> roots_{}; // 정규화된 루트 디렉터리 → 색인
+        std::unordered_set<std::string> dirty_roots_{}; // 저장본보다 새로운 루트
+        parus::ParserFeatureFlags parser_features_{};
+        bool inline_mode_ = false;
+        bool trace_ = false;
+        bool stop_ = false;
+        std::thread thread_{};
+    };
+
+    std::string build_workspace_symbol_result_(const std::vector<WorkspaceSymbolHit>& hits) {
+        std::string json = "[";
+        for (size_t i = 0; i < hits.size(); ++i) {
+            if (i != 0) json += ",";
+            const auto& h = hits[i];
+            json += "{";
+            json += "\"name\":\"" + json_escape_(h.decl.name) + "\",";
+            json += "\"kind\":" + std::to_string(h.decl.kind) + ",";
+            json += "\"location\":{";
+            json += "\"uri\":\"" + json_escape_(file_path_to_uri_(h.path)) + "\",";
+            json += "\"range\":{";
+            json += "\"start\":{\"line\":" + std::to_string(h.decl.line) +
+                    ",\"character\":" + std::to_string(h.decl.character) + "},";
+            json += "\"end\":{\"line\":" + std::to_string(h.decl.line) +
+                    ",\"character\":" + std::to_string(h.decl.end_character) + "}";
+            json += "}}";
+            if (!h.decl.container.empty()) {
+                json += ",\"containerName\":\"" + json_escape_(h.decl.container) + "\"";
+            }
+            json += "}";
+        }
+        json += "]";
+        return json;
+    }
+
+    class LspServer {
+    public:
+        int run() {
+            workspace_index_.start(sync_analysis_, trace_incremental_);
+            start_worker_();
+            const int rc = serve_();
+            stop_worker_();
+            workspace_index_.stop();
+            if (trace_analysis_stats_) log_analysis_stats_();
+            return rc;
+        }
+
+    private:
+        /// @brief 예약된 분석. due 이전에는 워커가 꺼내지 않는다(didChange debounce).
+        struct AnalysisJob {
+            std::string uri{};
+            std::chrono::steady_clock::time_point due{};
+        };
+
+        /// @brief 분석 스케줄링 누적 통계. PARUSD_TRACE_ANALYSIS_STATS=1이면 종료 시 stderr에 남긴다.
+        struct AnalysisStats {
+            std::atomic<uint64_t> scheduled{0};  // schedule_analysis_ 호출 수
+            std::atomic<uint64_t> coalesced{0};  // 이미 대기 중인 분석에 합쳐져 건너뛴 수
+            std::atomic<uint64_t> run{0};        // 실제로 분석 파이프라인을 돌린 수
+            std::atomic<uint64_t> reused{0};     // 텍스트 변화가 없어 캐시로 끝낸 수
+            std::atomic<uint64_t> superseded{0}; // 끝났지만 그 사이 새 편집이 들어와 publish하지 않은 수
+            std::atomic<uint64_t> pull_full{0};
+            std::atomic<uint64_t> pull_unchanged{0};
+        };
+
+        /// @brief 분석 결과를 기다리는 요청. 첫 분석이 끝나거나 취소될 때까지 보관한다.
+        struct DeferredRequest {
+            std::string uri{};
+            std::string method{};
+            std::string id_text{};
+            std::unique_ptr<JsonMessage> msg{};
+        };
+
+        int serve_() {
+            while (true) {
+                auto msg = std::make_unique<JsonMessage>();
+                if (!read_lsp_message_(std::cin, msg->payload)) {
+                    return 0;
+                }
+
+                JsonParser parser(msg->payload, msg->strings);
+                if (!parser.parse(msg->root) || msg->root.kind != JsonValue::Kind::kObject) {
                     continue;
                 }
 
-                if (*method == "initialized") {
+                const auto method = as_string_(obj_get_(msg->root, "method"));
+                if (!method.has_value()) {
                     continue;
                 }
 
                 if (*method == "shutdown") {
+                    // 진행 중인 분석의 진단까지 내보낸 뒤 응답한다.
+                    wait_analysis_idle_();
+                    std::lock_guard<std::mutex> lock(docs_mu_);
                     shutdown_requested_ = true;
-                    const auto response = build_response_result_(id, "null");
-                    if (!response.empty()) write_lsp_message_(std::cout, response);
+                    const auto response = build_response_result_(obj_get_(msg->root, "id"), "null");
+                    if (!response.empty()) send_(response);
                     continue;
                 }
 
@@ -4450,57 +5667,216 @@ namespace {
                     return shutdown_requested_ ? 0 : 1;
                 }
 
-                if (*method == "textDocument/didOpen") {
-                    handle_did_open_(params);
-                    continue;
+                {
+                    std::lock_guard<std::mutex> lock(docs_mu_);
+                    dispatch_message_(std::string(*method), std::move(msg));
                 }
-
-                if (*method == "textDocument/didChange") {
-                    handle_did_change_(params);
-                    continue;
+                if (sync_analysis_) {
+                    workspace_index_.drain();
+                    drain_analysis_inline_();
                 }
+            }
+        }
 
-                if (*method == "textDocument/didClose") {
-                    handle_did_close_(params);
-                    continue;
+        /// @brief shutdown/exit를 제외한 메시지를 처리한다. docs_mu_를 잡은 상태로 호출된다.
+        void dispatch_message_(const std::string& method, std::unique_ptr<JsonMessage> msg) {
+            const JsonValue* id = obj_get_(msg->root, "id");
+            const auto params = obj_get_(msg->root, "params");
+            if (method == "initialize") {
+                const auto macro_cfg = parse_macro_config_from_initialize_(params);
+                const auto cimport_cfg = parse_cimport_config_from_initialize_(params);
+                const auto diag_cfg = parse_diagnostics_config_from_initialize_(params);
+                macro_budget_ = macro_cfg.budget;
+                parser_features_ = macro_cfg.parser_features;
+                cimport_cfg_ = cimport_cfg;
+                pull_diagnostics_ = diag_cfg.pull;
+                diagnostic_refresh_support_ = diag_cfg.refresh_support;
+                workspace_index_.set_parser_features(parser_features_);
+                {
+                    std::lock_guard<std::mutex> lock(queue_mu_);
+                    debounce_ = std::chrono::milliseconds(diag_cfg.debounce_ms);
                 }
 
-                if (*method == "workspace/didChangeWatchedFiles") {
-                    handle_did_change_watched_files_(params);
-                    continue;
+                const std::string result = build_initialize_result_();
+                const auto response = build_response_result_(id, result);
+                if (!response.empty()) send_(response);
+                for (const auto& w : macro_cfg.warnings) {
+                    notify_log_message_(/*warning=*/2, w);
                 }
-
-                if (*method == "textDocument/completion") {
-                    handle_completion_(id, params);
-                    continue;
+                for (const auto& w : cimport_cfg.warnings) {
+                    notify_log_message_(/*warning=*/2, w);
                 }
+                for (const auto& w : diag_cfg.warnings) {
+                    notify_log_message_(/*warning=*/2, w);
+                }
+                index_workspace_root_(params);
+                return;
+            }
 
-                if (*method == "textDocument/definition") {
-                    handle_definition_(id, params);
-                    continue;
+            if (method == "initialized") {
+                return;
+            }
+
+            if (method == "$/cancelRequest") {
+                handle_cancel_request_(params);
+                return;
+            }
+
+            if (method == "textDocument/didOpen") {
+                handle_did_open_(params);
+                return;
+            }
+
+            if (method == "textDocument/didChange") {
+                handle_did_change_(params);
+                return;
+            }
+
+            if (method == "textDocument/didClose") {
+                handle_did_close_(params);
+                return;
+            }
+
+            if (method == "workspace/didChangeWatchedFiles") {
+                handle_did_change_watched_files_(params);
+                return;
+            }
+
+            if (method == "workspace/symbol") {
+                handle_workspace_symbol_(id, params);
+                return;
+            }
+
+            if (is_analysis_request_(method)) {
+                if (id == nullptr) return;
+                const auto uri = request_uri_(params);
+                if (uri.has_value() && !analysis_ready_for_(method, *uri)) {
+                    // 클라이언트가 결과를 기다리므로 debounce 중인 분석을 당긴다.
+                    expedite_analysis_(*uri);
+                    deferred_.push_back(DeferredRequest{
+                        std::string(*uri),
+                        method,
+                        json_value_to_text_(*id),
+                        std::move(msg),
+                    });
+                    return;
                 }
+                dispatch_analysis_request_(method, id, params);
+                return;
+            }
 
-                if (*method == "textDocument/semanticTokens/full") {
-                    handle_semantic_tokens_full_(id, params);
+            if (id != nullptr) {
+                const auto response = build_response_error_(id, -32601, "method not found");
+                if (!response.empty()) send_(response);
+            }
+        }
+
+        static bool is_analysis_request_(std::string_view method) {
+            return method == "textDocument/completion" ||
+                   method == "textDocument/definition" ||
+                   method == "textDocument/references" ||
+                   method == "textDocument/diagnostic" ||
+                   method == "textDocument/semanticTokens/full" ||
+                   method == "textDocument/semanticTokens/full/delta" ||
+                   method == "textDocument/semanticTokens/range";
+        }
+
+        static std::optional<std::string_view> request_uri_(const JsonValue* params) {
+            if (params == nullptr || params->kind != JsonValue::Kind::kObject) return std::nullopt;
+            const auto* td = obj_get_(*params, "textDocument");
+            if (td == nullptr || td->kind != JsonValue::Kind::kObject) return std::nullopt;
+            return as_string_(obj_get_(*td, "uri"));
+        }
+
+        /// @brief 지금 캐시로 응답할 수 있는지 판단한다.
+        ///
+        /// completion/semanticTokens는 분석이 진행 중이어도 마지막 성공 결과로 바로 응답한다.
+        /// definition/references는 오프셋이 현재 텍스트(references는 워크스페이스 인덱스의
+        /// overlay)와 맞아야 하고, diagnostic(pull)은 현재 텍스트의 진단을 돌려줘야 하므로
+        /// 최신 revision 분석을 기다린다.
+        bool analysis_ready_for_(std::string_view method, std::string_view uri) const {
+            const auto it = documents_.find(std::string(uri));
+            if (it == documents_.end()) return true;
+            const auto& st = it->second;
+            if (!st.analysis.valid) return false;
+            if (method == "textDocument/definition" || method == "textDocument/references" ||
+                method == "textDocument/diagnostic") {
+                return st.analysis.revision == st.revision;
+            }
+            return true;
+        }
+
+        void dispatch_analysis_request_(std::string_view method, const JsonValue* id, const JsonValue* params) {
+            if (method == "textDocument/completion") {
+                handle_completion_(id, params);
+            } else if (method == "textDocument/definition") {
+                handle_definition_(id, params);
+            } else if (method == "textDocument/references") {
+                handle_references_(id, params);
+            } else if (method == "textDocument/diagnostic") {
+                handle_document_diagnostic_(id, params);
+            } else if (method == "textDocument/semanticTokens/full") {
+                handle_semantic_tokens_full_(id, params, /*delta=*/false);
+            } else if (method == "textDocument/semanticTokens/full/delta") {
+                handle_semantic_tokens_full_(id, params, /*delta=*/true);
+            } else if (method == "textDocument/semanticTokens/range") {
+                handle_semantic_tokens_range_(id, params);
+            }
+        }
+
+        /// @brief 보류 요청 중 응답 가능한 것을 처리한다. force면 캐시 상태와 무관하게 응답한다.
+        void flush_deferred_(std::optional<std::string_view> uri, bool force) {
+            for (size_t i = 0; i < deferred_.size();) {
+                auto& d = deferred_[i];
+                const bool match = !uri.has_value() || d.uri == *uri;
+                if (!match || (!force && !analysis_ready_for_(d.method, d.uri))) {
+                    ++i;
                     continue;
                 }
+                DeferredRequest req = std::move(d);
+                deferred_.erase(deferred_.begin() + static_cast<std::ptrdiff_t>(i));
+                dispatch_analysis_request_(req.method, obj_get_(req.msg->root, "id"), obj_get_(req.msg->root, "params"));
+            }
+        }
 
-                if (id != nullptr) {
-                    const auto response = build_response_error_(id, -32601, "method not found");
-                    if (!response.empty()) write_lsp_message_(std::cout, response);
-                }
+        void handle_cancel_request_(const JsonValue* params) {
+            if (params == nullptr || params->kind != JsonValue::Kind::kObject) return;
+            const auto* cancel_id = obj_get_(*params, "id");
+            if (cancel_id == nullptr) return;
+            const std::string id_text = json_value_to_text_(*cancel_id);
+            for (auto it = deferred_.begin(); it != deferred_.end(); ++it) {
+                if (it->id_text != id_text) continue;
+                // LSP RequestCancelled
+                const auto response = build_response_error_(obj_get_(it->msg->root, "id"), -32800, "request cancelled");
+                deferred_.erase(it);
+                if (!response.empty()) send_(response);
+                return;
             }
         }
 
-    private:
+        void send_(std::string_view payload) {
+            std::lock_guard<std::mutex> lock(out_mu_);
+            write_lsp_message_(std::cout, payload);
+        }
+
+        /// @brief push 진단을 보낸다. 클라이언트가 pull 모드면 아무것도 보내지 않는다.
         void publish_diagnostics_(std::string_view uri, int64_t version, const std::vector<LspDiag>& diags) {
+            if (pull_diagnostics_) return;
             const auto msg = build_publish_diagnostics_(uri, version, diags);
-            write_lsp_message_(std::cout, msg);
+            send_(msg);
+        }
+
+        /// @brief pull 모드 클라이언트에 `workspace/diagnostic/refresh`를 보낸다. docs_mu_를 잡은 상태로 호출된다.
+        void request_diagnostic_refresh_() {
+            if (!pull_diagnostics_ || !diagnostic_refresh_support_) return;
+            const std::string msg = "{\"jsonrpc\":\"2.0\",\"id\":\"parusd-diagnostic-refresh-"
+                + std::to_string(++server_request_seq_) + "\",\"method\":\"workspace/diagnostic/refresh\"}";
+            send_(msg);
         }
 
         void notify_log_message_(int severity, std::string_view text) {
             const auto msg = build_window_log_message_(severity, text);
-            write_lsp_message_(std::cout, msg);
+            send_(msg);
         }
 
         std::optional<std::filesystem::path> config_lei_for_uri_(std::string_view uri) const {
@@ -4517,6 +5893,10 @@ namespace {
             return false;
         }
 
+        /// @brief .lei 변경 뒤 프로젝트 문서를 다시 분석하도록 예약한다.
+        ///
+        /// 같은 프로젝트의 .lei 문서는 바로 다시 분석한다. .pr 문서는 root 단위 refresh 작업이
+        /// bundle 메타데이터를 비교한 뒤 실제로 바뀐 bundle의 문서만 다시 분석한다.
         void refresh_open_documents_for_project_roots_(
             const std::vector<std::filesystem::path>& roots,
             std::optional<std::string_view> skip_uri = std::nullopt
@@ -4524,21 +5904,97 @@ namespace {
             if (roots.empty()) return;
             for (auto& [doc_uri, state] : documents_) {
                 if (skip_uri.has_value() && doc_uri == *skip_uri) continue;
-                if (state.lang != DocLang::kParus && state.lang != DocLang::kLei) continue;
+                if (state.lang != DocLang::kLei) continue;
 
                 const auto cfg = config_lei_for_uri_(doc_uri);
                 if (!cfg.has_value()) continue;
                 const auto root = cfg->parent_path();
                 if (!root_list_contains_(roots, root)) continue;
 
-                state.analysis.valid = false;
                 state.revision = ++revision_seq_;
-                ensure_analysis_cache_(doc_uri, state);
-                publish_diagnostics_(doc_uri, state.version, state.analysis.diagnostics);
-                state.pending_edits.clear();
+                schedule_analysis_(doc_uri);
+            }
+            for (const auto& root : roots) {
+                schedule_analysis_(std::string(kLeiRefreshJobPrefix) + normalize_host_path_(root.string()),
+                                   /*debounce=*/true);
             }
         }
 
+        /// @brief root 프로젝트에서 bundle 메타데이터가 바뀐 .pr 문서만 다시 분석하도록 예약한다.
+        ///
+        /// 비교 기준은 root별로 마지막 refresh 때의 unit 목록이다. 기준이 없거나 Lei 평가가
+        /// 실패하면 프로젝트의 .pr 문서를 모두 다시 분석한다.
+        void run_lei_refresh_job_(const std::filesystem::path& root) {
+#if PARUSD_ENABLE_LEI
+            std::shared_ptr<const std::unordered_map<std::string, std::string>> overlays{};
+            {
+                std::lock_guard<std::mutex> lock(docs_mu_);
+                overlays = current_lei_overlays_();
+            }
+            const auto root_key = normalize_host_path_(root.string());
+            auto units = bundle_units_for_config_(root / "config.lei", overlays.get());
+
+            std::optional<std::unordered_set<std::string>> changed_sources{};
+            size_t changed_bundles = 0;
+            if (units.has_value()) {
+                if (const auto it = lei_refresh_baselines_.find(root_key); it != lei_refresh_baselines_.end()) {
+                    changed_sources = changed_bundle_sources_(it->second, *units, &changed_bundles);
+                }
+                lei_refresh_baselines_.insert_or_assign(root_key, std::move(*units));
+            } else {
+                lei_refresh_baselines_.erase(root_key);
+            }
+
+            std::lock_guard<std::mutex> lock(docs_mu_);
+            size_t refreshed = 0;
+            for (auto& [doc_uri, state] : documents_) {
+                if (state.lang != DocLang::kParus) continue;
+                const auto cfg = config_lei_for_uri_(doc_uri);
+                if (!cfg.has_value() || !same_file_path_(cfg->parent_path(), root)) continue;
+                if (changed_sources.has_value()) {
+                    const auto fs_path = uri_to_file_path_(doc_uri);
+                    if (!fs_path.has_value() || !changed_sources->contains(normalize_host_path_(*fs_path))) continue;
+                }
+
+                state.revision = ++revision_seq_;
+                state.drop_tyck_items = true;
+                schedule_analysis_(doc_uri);
+                ++refreshed;
+            }
+            // pull 모드에서는 push할 수 없으므로, 다시 분석된 문서의 진단을 클라이언트가 당겨 가도록 알린다.
+            if (refreshed > 0) request_diagnostic_refresh_();
+            if (trace_incremental_) {
+                std::cerr << "[parusd] lei-refresh root=" << root_key << " changed_bundles="
+                          << (changed_sources.has_value() ? std::to_string(changed_bundles) : std::string("all"))
+                          << " refreshed=" << refreshed << "\n";
+            }
+#else
+            (void)root;
+#endif
+        }
+
+        /// @brief 열린 .lei 문서의 overlay 항목 하나를 갱신한다. text가 nullptr이면 항목을 지운다.
+        void update_lei_overlay_(std::string_view uri, const std::string* text) {
+            const auto fs_path = uri_to_file_path_(uri);
+            if (!fs_path.has_value()) return;
+            auto key = normalize_host_path_(*fs_path);
+            if (text != nullptr) {
+                lei_overlays_.insert_or_assign(std::move(key), *text);
+            } else {
+                lei_overlays_.erase(key);
+            }
+            lei_overlay_snapshot_.reset();
+        }
+
+        /// @brief 분석 작업이 공유하는 overlay 스냅샷. .lei 편집 뒤 처음 요청될 때만 새로 만든다.
+        /// docs_mu_를 잡은 상태로 호출된다.
+        std::shared_ptr<const std::unordered_map<std::string, std::string>> current_lei_overlays_() {
+            if (lei_overlay_snapshot_ == nullptr) {
+                lei_overlay_snapshot_ = std::make_shared<const std::unordered_map<std::string, std::string>>(lei_overlays_);
+            }
+            return lei_overlay_snapshot_;
+        }
+
         void handle_did_change_watched_files_(const JsonValue* params) {
             if (params == nullptr || params->kind != JsonValue::Kind::kObject) return;
             const auto* changes = obj_get_(*params, "changes");
@@ -4552,6 +6008,10 @@ namespace {
                 const auto fs_path = uri_to_file_path_(*uri);
                 if (!fs_path.has_value()) continue;
                 std::filesystem::path changed(*fs_path);
+                if (changed.extension() == ".pr") {
+                    workspace_index_.refresh_file(normalize_host_path_(*fs_path));
+                    continue;
+                }
                 if (changed.extension() != ".lei") continue;
                 const auto cfg = find_config_lei_for_file_(changed);
                 if (!cfg.has_value()) continue;
@@ -4561,46 +6021,284 @@ namespace {
 
             if (roots.empty()) return;
             for (const auto& root : roots) {
-                invalidate_lint_caches_for_root_(root);
+                workspace_index_.rescan_root(root);
             }
             refresh_open_documents_for_project_roots_(roots);
         }
 
-        void ensure_analysis_cache_(std::string_view uri, DocumentState& st) {
-            if (st.analysis.valid && st.analysis.revision == st.revision) {
-                return;
+        /// @brief initialize의 rootUri가 config.lei 프로젝트면 워크스페이스 색인을 바로 시작한다.
+        void index_workspace_root_(const JsonValue* params) {
+            if (params == nullptr || params->kind != JsonValue::Kind::kObject) return;
+            const auto root_uri = as_string_(obj_get_(*params, "rootUri"));
+            if (!root_uri.has_value()) return;
+            const auto root_path = uri_to_file_path_(*root_uri);
+            if (!root_path.has_value()) return;
+            std::error_code ec{};
+            const auto cfg = std::filesystem::path(*root_path) / "config.lei";
+            if (!std::filesystem::exists(cfg, ec)) return;
+            workspace_index_.ensure_root(std::filesystem::weakly_canonical(cfg, ec));
+        }
+
+        void start_worker_() {
+            if (sync_analysis_) return;
+            worker_ = std::thread([this] { worker_loop_(); });
+        }
+
+        /// @brief 대기 중인 분석을 모두 끝내고 워커를 멈춘다. 남은 보류 요청은 현재 캐시로 응답한다.
+        void stop_worker_() {
+            if (sync_analysis_) {
+                drain_analysis_inline_();
+            } else if (worker_.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(queue_mu_);
+                    worker_stop_ = true;
+                }
+                queue_cv_.notify_all();
+                worker_.join();
+            }
+            std::lock_guard<std::mutex> lock(docs_mu_);
+            flush_deferred_(std::nullopt, /*force=*/true);
+        }
+
+        /// @brief URI 분석을 예약한다. 이미 대기 중이면 합쳐진다(최신 revision 우선).
+        ///
+        /// debounce면 debounce_ 뒤로 예약하고, 대기 중인 예약의 시각도 그만큼 다시 미룬다.
+        void schedule_analysis_(std::string_view uri, bool debounce = false) {
+            {
+                std::lock_guard<std::mutex> lock(queue_mu_);
+                const auto now = std::chrono::steady_clock::now();
+                const auto due = debounce ? now + debounce_ : now;
+                analysis_stats_.scheduled.fetch_add(1, std::memory_order_relaxed);
+                if (!queued_.insert(std::string(uri)).second) {
+                    analysis_stats_.coalesced.fetch_add(1, std::memory_order_relaxed);
+                    for (auto& job : queue_) {
+                        if (job.uri != uri) continue;
+                        job.due = debounce ? due : std::min(job.due, due);
+                        break;
+                    }
+                } else {
+                    queue_.push_back(AnalysisJob{std::string(uri), due});
+                }
             }
+            queue_cv_.notify_one();
+        }
 
-            if (st.lang == DocLang::kParus) {
-                st.parse_session.set_feature_flags(parser_features_);
+        /// @brief 대기 중인 URI 분석을 debounce 없이 바로 실행하도록 당긴다.
+        void expedite_analysis_(std::string_view uri) {
+            {
+                std::lock_guard<std::mutex> lock(queue_mu_);
+                if (!queued_.contains(std::string(uri))) return;
+                for (auto& job : queue_) {
+                    if (job.uri == uri) job.due = {};
+                }
             }
+            queue_cv_.notify_one();
+        }
+
+        /// @brief due가 가장 이른 예약을 고른다. queue_mu_를 잡은 상태로 호출된다.
+        std::deque<AnalysisJob>::iterator earliest_analysis_job_() {
+            return std::min_element(queue_.begin(), queue_.end(), [](const AnalysisJob& a, const AnalysisJob& b) {
+                return a.due < b.due;
+            });
+        }
 
-            std::unordered_map<std::string, std::string> lei_overlays{};
+        bool pop_analysis_job_(std::string& uri) {
+            std::lock_guard<std::mutex> lock(queue_mu_);
+            if (queue_.empty()) return false;
+            const auto it = earliest_analysis_job_();
+            uri = std::move(it->uri);
+            queue_.erase(it);
+            queued_.erase(uri);
+            return true;
+        }
+
+        void worker_loop_() {
+            while (true) {
+                std::string uri;
+                {
+                    std::unique_lock<std::mutex> lock(queue_mu_);
+                    while (true) {
+                        queue_cv_.wait(lock, [this] { return worker_stop_ || !queue_.empty(); });
+                        if (queue_.empty()) return;
+                        const auto it = earliest_analysis_job_();
+                        if (worker_stop_ || it->due <= std::chrono::steady_clock::now()) {
+                            uri = std::move(it->uri);
+                            queue_.erase(it);
+                            queued_.erase(uri);
+                            break;
+                        }
+                        // debounce 대기 중 새 예약/당김이 오면 깨어나 다시 고른다.
+                        const auto due = it->due;
+                        queue_cv_.wait_until(lock, due);
+                    }
+                    worker_busy_ = true;
+                }
+                run_analysis_job_(uri);
+                {
+                    std::lock_guard<std::mutex> lock(queue_mu_);
+                    worker_busy_ = false;
+                }
+                idle_cv_.notify_all();
+            }
+        }
+
+        void drain_analysis_inline_() {
+            std::string uri;
+            while (pop_analysis_job_(uri)) run_analysis_job_(uri);
+        }
+
+        void wait_analysis_idle_() {
+            if (sync_analysis_) {
+                drain_analysis_inline_();
+                return;
+            }
+            std::unique_lock<std::mutex> lock(queue_mu_);
+            for (auto& job : queue_) job.due = {};
+            queue_cv_.notify_one();
+            idle_cv_.wait(lock, [this] { return queue_.empty() && !worker_busy_; });
+        }
+
+        void log_analysis_stats_() const {
+            const auto load = [](const std::atomic<uint64_t>& v) { return v.load(std::memory_order_relaxed); };
+            std::cerr << "[parusd] analysis-stats"
+                      << " scheduled=" << load(analysis_stats_.scheduled)
+                      << " coalesced=" << load(analysis_stats_.coalesced)
+                      << " run=" << load(analysis_stats_.run)
+                      << " reused=" << load(analysis_stats_.reused)
+                      << " superseded=" << load(analysis_stats_.superseded)
+                      << " pull_full=" << load(analysis_stats_.pull_full)
+                      << " pull_unchanged=" << load(analysis_stats_.pull_unchanged)
+                      << " work_docs=" << work_docs_.size()
+                      << "\n";
+        }
+
+        /// @brief 문서 스냅샷을 떠서 락 밖에서 분석하고, 결과를 캐시에 반영한다.
+        ///
+        /// 분석 도중 새 편집이 들어오면 결과는 마지막 성공 캐시로만 저장되고 진단 publish는
+        /// 이미 예약된 다음 분석에 맡긴다.
+        void run_analysis_job_(const std::string& uri) {
+            if (uri.starts_with(kLeiRefreshJobPrefix)) {
+                run_lei_refresh_job_(std::filesystem::path(uri.substr(kLeiRefreshJobPrefix.size())));
+                return;
+            }
+
+            std::shared_ptr<const std::unordered_map<std::string, std::string>> lei_overlays{};
             const std::unordered_map<std::string, std::string>* lei_overlays_ptr = nullptr;
+            parus::macro::ExpansionBudget macro_budget{};
+            ServerCImportConfig cimport_cfg{};
+            DocumentState* work = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(docs_mu_);
+                auto it = documents_.find(uri);
+                if (it == documents_.end()) {
+                    work_docs_.erase(uri);
+                    return;
+                }
+                auto& st = it->second;
+                if (st.analysis.valid && st.analysis.revision == st.revision) {
+                    // 텍스트 변화 없이 version만 바뀐 경우: 캐시된 진단을 새 version으로 재publish.
+                    analysis_stats_.reused.fetch_add(1, std::memory_order_relaxed);
+                    publish_diagnostics_(uri, st.version, st.analysis.diagnostics);
+                    flush_deferred_(uri, /*force=*/false);
+                    return;
+                }
+
+                auto& wd = work_docs_[uri];
+                if (wd.open_revision != st.open_revision) {
+                    wd = DocumentState{};
+                    wd.open_revision = st.open_revision;
+                } else {
+                    wd.pending_edits.insert(wd.pending_edits.end(), st.pending_edits.begin(), st.pending_edits.end());
+                }
+                st.pending_edits.clear();
+                if (st.drop_tyck_items) {
+                    wd.tyck_items = DocumentState::TyckItemCache{};
+                    st.drop_tyck_items = false;
+                }
+                wd.text = st.text;
+                wd.version = st.version;
+                wd.revision = st.revision;
+                wd.lang = st.lang;
+                work = &wd;
+                active_work_uri_ = uri;
+
+                macro_budget = macro_budget_;
+                cimport_cfg = cimport_cfg_;
+                if (wd.lang == DocLang::kParus) {
+                    wd.parse_session.set_feature_flags(parser_features_);
+                }
 #if PARUSD_ENABLE_LEI
-            lei_overlays = build_lei_overlay_map_(documents_);
-            lei_overlays_ptr = &lei_overlays;
+                lei_overlays = current_lei_overlays_();
+                lei_overlays_ptr = lei_overlays.get();
 #endif
+            }
 
-            auto analyzed = analyze_document_(uri, st, macro_budget_, cimport_cfg_, lei_overlays_ptr);
-            st.analysis.revision = st.revision;
+            analysis_stats_.run.fetch_add(1, std::memory_order_relaxed);
+            auto analyzed = analyze_document_(uri, *work, macro_budget, cimport_cfg, lei_overlays_ptr);
+            sort_semantic_tokens_(analyzed.semantic_tokens);
+            auto semantic_data = encode_sorted_semantic_tokens_(analyzed.semantic_tokens);
+
+            if (trace_incremental_) {
+                const char* lang_name = "unknown";
+                if (work->lang == DocLang::kParus) lang_name = "parus";
+                if (work->lang == DocLang::kLei) lang_name = "lei";
+                std::cerr << "[parusd] uri=" << uri
+                          << " lang=" << lang_name
+                          << " revision=" << work->revision
+                          << " parse=" << reparse_mode_name_(analyzed.parse_mode);
+                if (work->lang == DocLang::kParus) {
+                    const char* tyck_mode = "none";
+                    if (analyzed.tyck_ran) tyck_mode = (analyzed.tyck_reused_items > 0) ? "incremental" : "full";
+                    std::cerr << " tyck=" << tyck_mode
+                              << " reused=" << analyzed.tyck_reused_items << "/" << analyzed.tyck_def_items;
+                }
+                std::cerr << "\n";
+            }
+
+            // 열린 문서 내용을 워크스페이스 인덱스에 overlay로 반영한다(프로젝트 밖 파일은 무시된다).
+            std::optional<std::pair<std::string, IndexedFile>> index_overlay{};
+            if (work->lang == DocLang::kParus && work->parse_ready && work->parse_session.ready()) {
+                if (const auto fs_path = uri_to_file_path_(uri); fs_path.has_value()) {
+                    std::string path = normalize_host_path_(*fs_path);
+                    const auto& snap = work->parse_session.snapshot();
+                    parus::SourceManager sm;
+                    const uint32_t file_id = sm.add(path, work->text);
+                    auto file = index_parus_parsed_(snap.ast, snap.root, snap.tokens, sm, file_id,
+                                                    workspace_index_.module_head_for(path));
+                    index_overlay.emplace(std::move(path), std::move(file));
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(docs_mu_);
+            active_work_uri_.clear();
+            auto it = documents_.find(uri);
+            if (it == documents_.end()) {
+                // 분석 도중 닫힌 문서: didClose가 미뤄 둔 작업 사본 정리를 여기서 한다.
+                work_docs_.erase(uri);
+                return;
+            }
+            if (it->second.open_revision != work->open_revision) {
+                return;
+            }
+            if (index_overlay.has_value()) {
+                workspace_index_.update_overlay(index_overlay->first, std::move(index_overlay->second));
+            }
+            auto& st = it->second;
+            st.analysis.revision = work->revision;
             st.analysis.valid = true;
             st.analysis.diagnostics = std::move(analyzed.diagnostics);
             st.analysis.semantic_tokens = std::move(analyzed.semantic_tokens);
+            st.analysis.semantic_data = std::move(semantic_data);
             st.analysis.completion_items = std::move(analyzed.completion_items);
             st.analysis.definition_bindings = std::move(analyzed.definition_bindings);
             st.analysis.top_level_definitions = std::move(analyzed.top_level_definitions);
 
-            if (trace_incremental_) {
-                const char* lang_name = "unknown";
-                if (st.lang == DocLang::kParus) lang_name = "parus";
-                if (st.lang == DocLang::kLei) lang_name = "lei";
-                std::cerr << "[parusd] uri=" << uri
-                          << " lang=" << lang_name
-                          << " revision=" << st.revision
-                          << " parse=" << reparse_mode_name_(analyzed.parse_mode)
-                          << "\n";
+            if (st.revision == work->revision) {
+                publish_diagnostics_(uri, st.version, st.analysis.diagnostics);
+            } else {
+                analysis_stats_.superseded.fetch_add(1, std::memory_order_relaxed);
             }
+            flush_deferred_(uri, /*force=*/false);
         }
 
         void handle_did_open_(const JsonValue* params) {
@@ -4616,19 +6314,22 @@ namespace {
             st.text = std::string(*text);
             st.version = as_i64_(obj_get_(*td, "version")).value_or(0);
             st.revision = ++revision_seq_;
+            st.open_revision = st.revision;
             st.lang = doc_lang_from_uri_(*uri);
-            if (st.lang == DocLang::kParus) {
-                st.parse_session.set_feature_flags(parser_features_);
-            }
 
             auto it = documents_.insert_or_assign(std::string(*uri), std::move(st)).first;
-            ensure_analysis_cache_(*uri, it->second);
-            publish_diagnostics_(*uri, it->second.version, it->second.analysis.diagnostics);
+            schedule_analysis_(*uri);
+
+            if (it->second.lang == DocLang::kParus || it->second.lang == DocLang::kLei) {
+                if (const auto cfg = config_lei_for_uri_(*uri); cfg.has_value()) {
+                    workspace_index_.ensure_root(*cfg);
+                }
+            }
 
             if (it->second.lang == DocLang::kLei) {
+                update_lei_overlay_(*uri, &it->second.text);
                 if (const auto cfg = config_lei_for_uri_(*uri); cfg.has_value()) {
                     const std::vector<std::filesystem::path> roots{cfg->parent_path()};
-                    invalidate_lint_caches_for_root_(cfg->parent_path());
                     refresh_open_documents_for_project_roots_(roots, *uri);
                 }
             }
@@ -4669,30 +6370,19 @@ namespace {
                 if (incoming_version.has_value()) {
                     it->second.version = *incoming_version;
                 }
-                ensure_analysis_cache_(*uri, it->second);
-                publish_diagnostics_(*uri, it->second.version, it->second.analysis.diagnostics);
-                it->second.pending_edits.clear();
-                if (it->second.lang == DocLang::kLei) {
-                    if (const auto cfg = config_lei_for_uri_(*uri); cfg.has_value()) {
-                        const std::vector<std::filesystem::path> roots{cfg->parent_path()};
-                        invalidate_lint_caches_for_root_(cfg->parent_path());
-                        refresh_open_documents_for_project_roots_(roots, *uri);
-                    }
-                }
+                schedule_analysis_(*uri);
                 return;
             }
 
+            // 마지막 성공 분석 캐시는 유지한다. 새 분석이 끝날 때까지 요청은 그 캐시로 응답한다.
+            // 연속 입력은 debounce 창 안에서 한 번의 분석으로 합쳐진다.
             it->second.version = incoming_version.value_or(it->second.version + 1);
             it->second.revision = ++revision_seq_;
-            it->second.analysis.valid = false;
-
-            ensure_analysis_cache_(*uri, it->second);
-            publish_diagnostics_(*uri, it->second.version, it->second.analysis.diagnostics);
-            it->second.pending_edits.clear();
+            schedule_analysis_(*uri, /*debounce=*/true);
             if (it->second.lang == DocLang::kLei) {
+                update_lei_overlay_(*uri, &it->second.text);
                 if (const auto cfg = config_lei_for_uri_(*uri); cfg.has_value()) {
                     const std::vector<std::filesystem::path> roots{cfg->parent_path()};
-                    invalidate_lint_caches_for_root_(cfg->parent_path());
                     refresh_open_documents_for_project_roots_(roots, *uri);
                 }
             }
@@ -4711,36 +6401,137 @@ namespace {
             if (it != documents_.end()) closing_lang = it->second.lang;
 
             documents_.erase(std::string(*uri));
+            // 워커가 지금 쓰고 있는 사본이면 작업 종료 시점에 워커가 지운다.
+            if (active_work_uri_ != *uri) {
+                work_docs_.erase(std::string(*uri));
+            }
             publish_diagnostics_(*uri, /*version=*/0, {});
+            flush_deferred_(*uri, /*force=*/true);
+
+            if (closing_lang == DocLang::kParus) {
+                if (const auto fs_path = uri_to_file_path_(*uri); fs_path.has_value()) {
+                    workspace_index_.drop_overlay(normalize_host_path_(*fs_path));
+                }
+            }
 
             if (closing_lang == DocLang::kLei) {
+                update_lei_overlay_(*uri, nullptr);
                 if (const auto cfg = config_lei_for_uri_(*uri); cfg.has_value()) {
                     const std::vector<std::filesystem::path> roots{cfg->parent_path()};
-                    invalidate_lint_caches_for_root_(cfg->parent_path());
                     refresh_open_documents_for_project_roots_(roots);
                 }
             }
         }
 
-        void handle_semantic_tokens_full_(const JsonValue* id, const JsonValue* params) {
-            if (id == nullptr) return;
-            if (params == nullptr || params->kind != JsonValue::Kind::kObject) {
+        /// @brief LSP 3.17 pull 진단. resultId는 분석 revision이다.
+        void handle_document_diagnostic_(const JsonValue* id, const JsonValue* params) {
+            const auto uri = request_uri_(params);
+            if (!uri.has_value()) {
                 const auto response = build_response_error_(id, -32602, "invalid params");
-                if (!response.empty()) write_lsp_message_(std::cout, response);
+                if (!response.empty()) send_(response);
                 return;
             }
+            const auto previous = as_string_(obj_get_(*params, "previousResultId"));
+
+            std::string result{};
+            const auto it = documents_.find(std::string(*uri));
+            if (it == documents_.end() || !it->second.analysis.valid) {
+                result = build_document_diagnostic_result_("0", previous, {});
+            } else {
+                const auto& analysis = it->second.analysis;
+                const std::string result_id = std::to_string(analysis.revision);
+                if (previous.has_value() && *previous == result_id) {
+                    analysis_stats_.pull_unchanged.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    analysis_stats_.pull_full.fetch_add(1, std::memory_order_relaxed);
+                }
+                result = build_document_diagnostic_result_(result_id, previous, analysis.diagnostics);
+            }
+            const auto response = build_response_result_(id, result);
+            if (!response.empty()) send_(response);
+        }
+
+        /// @brief semanticTokens 요청의 공통 파라미터를 검사한다. 실패하면 오류 응답까지 보낸다.
+        std::optional<std::string_view> semantic_tokens_request_uri_(const JsonValue* id, const JsonValue* params) {
+            if (params == nullptr || params->kind != JsonValue::Kind::kObject) {
+                const auto response = build_response_error_(id, -32602, "invalid params");
+                if (!response.empty()) send_(response);
+                return std::nullopt;
+            }
 
             const auto td = obj_get_(*params, "textDocument");
             if (td == nullptr || td->kind != JsonValue::Kind::kObject) {
                 const auto response = build_response_error_(id, -32602, "invalid params");
-                if (!response.empty()) write_lsp_message_(std::cout, response);
-                return;
+                if (!response.empty()) send_(response);
+                return std::nullopt;
             }
 
             const auto uri = as_string_(obj_get_(*td, "uri"));
             if (!uri.has_value()) {
                 const auto response = build_response_error_(id, -32602, "textDocument.uri is required");
-                if (!response.empty()) write_lsp_message_(std::cout, response);
+                if (!response.empty()) send_(response);
+                return std::nullopt;
+            }
+            return uri;
+        }
+
+        /// @brief full(delta=false) 또는 full/delta 요청을 처리한다.
+        ///
+        /// 인코딩된 배열은 분석 워커가 미리 만들어 두므로 여기서는 직렬화만 한다.
+        /// delta는 previousResultId가 마지막으로 보낸 결과와 같을 때만 edit으로 응답하고,
+        /// 그 외에는 full 결과로 응답한다.
+        void handle_semantic_tokens_full_(const JsonValue* id, const JsonValue* params, bool delta) {
+            if (id == nullptr) return;
+            const auto uri = semantic_tokens_request_uri_(id, params);
+            if (!uri.has_value()) return;
+
+            const auto it = documents_.find(std::string(*uri));
+            if (it == documents_.end()) {
+                const auto result = build_semantic_tokens_result_({});
+                const auto response = build_response_result_(id, result);
+                if (!response.empty()) send_(response);
+                return;
+            }
+
+            auto& st = it->second;
+            const auto& data = st.analysis.semantic_data;
+            std::string response{};
+            std::optional<std::string_view> previous{};
+            if (delta) previous = as_string_(obj_get_(*params, "previousResultId"));
+
+            if (previous.has_value() && !st.semantic_result_id.empty() && *previous == st.semantic_result_id &&
+                st.semantic_sent_data == data) {
+                // 변경 없음: 같은 resultId로 빈 edit을 돌려준다.
+                response = write_response_result_(id, [&](JsonWriter& w) {
+                    write_semantic_tokens_delta_result_(w, st.semantic_result_id, data, data);
+                });
+            } else {
+                const std::string next_id = std::to_string(++semantic_result_seq_);
+                if (previous.has_value() && !st.semantic_result_id.empty() && *previous == st.semantic_result_id) {
+                    response = write_response_result_(id, [&](JsonWriter& w) {
+                        write_semantic_tokens_delta_result_(w, next_id, st.semantic_sent_data, data);
+                    });
+                } else {
+                    response = write_response_result_(id, [&](JsonWriter& w) {
+                        write_semantic_tokens_data_result_(w, next_id, data);
+                    });
+                }
+                st.semantic_result_id = next_id;
+                st.semantic_sent_data = data;
+            }
+            if (!response.empty()) send_(response);
+        }
+
+        /// @brief 보이는 영역만 인코딩한다. resultId는 발급하지 않는다(delta 기준을 바꾸지 않음).
+        void handle_semantic_tokens_range_(const JsonValue* id, const JsonValue* params) {
+            if (id == nullptr) return;
+            const auto uri = semantic_tokens_request_uri_(id, params);
+            if (!uri.has_value()) return;
+
+            Range range{};
+            if (!parse_range_(obj_get_(*params, "range"), range)) {
+                const auto response = build_response_error_(id, -32602, "range is required");
+                if (!response.empty()) send_(response);
                 return;
             }
 
@@ -4748,14 +6539,16 @@ namespace {
             if (it == documents_.end()) {
                 const auto result = build_semantic_tokens_result_({});
                 const auto response = build_response_result_(id, result);
-                if (!response.empty()) write_lsp_message_(std::cout, response);
+                if (!response.empty()) send_(response);
                 return;
             }
 
-            ensure_analysis_cache_(*uri, it->second);
-            const auto result = build_semantic_tokens_result_(it->second.analysis.semantic_tokens);
-            const auto response = build_response_result_(id, result);
-            if (!response.empty()) write_lsp_message_(std::cout, response);
+            const auto visible = semantic_tokens_in_range_(it->second.analysis.semantic_tokens, range);
+            const auto data = encode_sorted_semantic_tokens_(visible);
+            const auto response = write_response_result_(id, [&](JsonWriter& w) {
+                write_semantic_tokens_data_result_(w, {}, data);
+            });
+            if (!response.empty()) send_(response);
         }
 
         std::vector<LspLocation> find_definition_targets_(
@@ -4846,69 +6639,136 @@ namespace {
             if (id == nullptr) return;
             if (params == nullptr || params->kind != JsonValue::Kind::kObject) {
                 const auto response = build_response_error_(id, -32602, "invalid params");
-                if (!response.empty()) write_lsp_message_(std::cout, response);
+                if (!response.empty()) send_(response);
                 return;
             }
 
             const auto* td = obj_get_(*params, "textDocument");
             if (td == nullptr || td->kind != JsonValue::Kind::kObject) {
                 const auto response = build_response_error_(id, -32602, "invalid params");
-                if (!response.empty()) write_lsp_message_(std::cout, response);
+                if (!response.empty()) send_(response);
                 return;
             }
             const auto uri = as_string_(obj_get_(*td, "uri"));
             Position pos{};
             if (!uri.has_value() || !parse_position_(obj_get_(*params, "position"), pos)) {
                 const auto response = build_response_error_(id, -32602, "textDocument.uri/position is required");
-                if (!response.empty()) write_lsp_message_(std::cout, response);
+                if (!response.empty()) send_(response);
                 return;
             }
 
             const auto it = documents_.find(std::string(*uri));
             if (it == documents_.end()) {
                 const auto response = build_response_result_(id, "[]");
-                if (!response.empty()) write_lsp_message_(std::cout, response);
+                if (!response.empty()) send_(response);
                 return;
             }
 
-            ensure_analysis_cache_(*uri, it->second);
             const size_t off = byte_offset_from_position_(it->second.text, pos);
             const std::string prefix = symbol_prefix_before_offset_(it->second.text, off);
             const auto result = build_completion_result_(it->second.analysis.completion_items, prefix);
             const auto response = build_response_result_(id, result);
-            if (!response.empty()) write_lsp_message_(std::cout, response);
+            if (!response.empty()) send_(response);
+        }
+
+        /// @brief 워크스페이스 인덱스에서 이름으로 선언을 찾는다. 색인 중이면 지금까지의 결과로 답한다.
+        void handle_workspace_symbol_(const JsonValue* id, const JsonValue* params) {
+            if (id == nullptr) return;
+            std::string_view query{};
+            if (params != nullptr && params->kind == JsonValue::Kind::kObject) {
+                query = as_string_(obj_get_(*params, "query")).value_or(std::string_view{});
+            }
+            const auto hits = workspace_index_.query_symbols(query, kWorkspaceSymbolLimit);
+            const auto response = build_response_result_(id, build_workspace_symbol_result_(hits));
+            if (!response.empty()) send_(response);
+        }
+
+        /// @brief 커서 아래 식별자와 같은 이름의 등장 위치를 워크스페이스 인덱스에서 모은다.
+        ///
+        /// 인덱스에 없는 파일(config.lei 프로젝트 밖)은 그 문서 안에서만 찾는다.
+        void handle_references_(const JsonValue* id, const JsonValue* params) {
+            if (id == nullptr) return;
+            if (params == nullptr || params->kind != JsonValue::Kind::kObject) {
+                const auto response = build_response_error_(id, -32602, "invalid params");
+                if (!response.empty()) send_(response);
+                return;
+            }
+            const auto uri = request_uri_(params);
+            Position pos{};
+            if (!uri.has_value() || !parse_position_(obj_get_(*params, "position"), pos)) {
+                const auto response = build_response_error_(id, -32602, "textDocument.uri/position is required");
+                if (!response.empty()) send_(response);
+                return;
+            }
+            bool include_decl = true;
+            if (const auto* ctx = obj_get_(*params, "context"); ctx != nullptr && ctx->kind == JsonValue::Kind::kObject) {
+                if (const auto* v = obj_get_(*ctx, "includeDeclaration");
+                    v != nullptr && v->kind == JsonValue::Kind::kBool) {
+                    include_decl = v->bool_v;
+                }
+            }
+
+            const auto it = documents_.find(std::string(*uri));
+            const auto fs_path = uri_to_file_path_(*uri);
+            std::string text{};
+            if (it != documents_.end()) {
+                if (it->second.lang != DocLang::kParus) {
+                    const auto response = build_response_result_(id, "[]");
+                    if (!response.empty()) send_(response);
+                    return;
+                }
+                text = it->second.text;
+            } else if (fs_path.has_value()) {
+                std::ifstream ifs(*fs_path, std::ios::binary);
+                std::ostringstream oss;
+                oss << ifs.rdbuf();
+                text = std::move(oss).str();
+            }
+
+            const std::string name = ident_at_offset_(text, byte_offset_from_position_(text, pos));
+            std::vector<LspLocation> locs{};
+            if (!name.empty()) {
+                const std::string path = fs_path.has_value() ? normalize_host_path_(*fs_path) : std::string(*uri);
+                if (workspace_index_.contains_file(path)) {
+                    locs = workspace_index_.references(name, include_decl);
+                } else {
+                    auto file = index_parus_text_(path, text, {}, parser_features_);
+                    locs = WorkspaceIndex::file_references(*uri, file, name, include_decl);
+                }
+            }
+            const auto response = build_response_result_(id, build_definition_result_(locs));
+            if (!response.empty()) send_(response);
         }
 
         void handle_definition_(const JsonValue* id, const JsonValue* params) {
             if (id == nullptr) return;
             if (params == nullptr || params->kind != JsonValue::Kind::kObject) {
                 const auto response = build_response_error_(id, -32602, "invalid params");
-                if (!response.empty()) write_lsp_message_(std::cout, response);
+                if (!response.empty()) send_(response);
                 return;
             }
 
             const auto* td = obj_get_(*params, "textDocument");
             if (td == nullptr || td->kind != JsonValue::Kind::kObject) {
                 const auto response = build_response_error_(id, -32602, "invalid params");
-                if (!response.empty()) write_lsp_message_(std::cout, response);
+                if (!response.empty()) send_(response);
                 return;
             }
             const auto uri = as_string_(obj_get_(*td, "uri"));
             Position pos{};
             if (!uri.has_value() || !parse_position_(obj_get_(*params, "position"), pos)) {
                 const auto response = build_response_error_(id, -32602, "textDocument.uri/position is required");
-                if (!response.empty()) write_lsp_message_(std::cout, response);
+                if (!response.empty()) send_(response);
                 return;
             }
 
             const auto it = documents_.find(std::string(*uri));
             if (it == documents_.end()) {
                 const auto response = build_response_result_(id, "null");
-                if (!response.empty()) write_lsp_message_(std::cout, response);
+                if (!response.empty()) send_(response);
                 return;
             }
 
-            ensure_analysis_cache_(*uri, it->second);
             const size_t off = byte_offset_from_position_(it->second.text, pos);
             auto targets = find_definition_targets_(it->second, off);
             if (targets.empty()) {
@@ -4916,13 +6776,55 @@ namespace {
             }
             const auto result = build_definition_result_(targets);
             const auto response = build_response_result_(id, result);
-            if (!response.empty()) write_lsp_message_(std::cout, response);
+            if (!response.empty()) send_(response);
         }
 
+        // docs_mu_: documents_, deferred_, 서버 설정. 메인 스레드는 메시지 하나를 처리하는 동안 잡는다.
+        std::mutex docs_mu_{};
+        std::mutex out_mu_{};
         std::unordered_map<std::string, DocumentState> documents_{};
+        std::vector<DeferredRequest> deferred_{};
         bool shutdown_requested_ = false;
         uint64_t revision_seq_ = 0;
+        uint64_t semantic_result_seq_ = 0;
         bool trace_incremental_ = (std::getenv("PARUSD_TRACE_INCREMENTAL") != nullptr);
+        bool trace_analysis_stats_ = (std::getenv("PARUSD_TRACE_ANALYSIS_STATS") != nullptr);
+        bool pull_diagnostics_ = false;
+        bool diagnostic_refresh_support_ = false;
+        // 서버가 클라이언트로 보내는 요청의 id 순번. 클라이언트 응답은 method가 없어 무시된다.
+        uint64_t server_request_seq_ = 0;
+        AnalysisStats analysis_stats_{};
+        WorkspaceIndex workspace_index_{};
+        static constexpr size_t kWorkspaceSymbolLimit = 1000;
+
+        // 열린 .lei 문서의 overlay(정규화 경로 -> 텍스트). 편집된 항목만 갱신하고, 분석 작업은
+        // 다음 .lei 편집 전까지 같은 불변 스냅샷을 공유한다. 둘 다 docs_mu_로 보호된다.
+        std::unordered_map<std::string, std::string> lei_overlays_{};
+        std::shared_ptr<const std::unordered_map<std::string, std::string>> lei_overlay_snapshot_{};
+        // .lei 변경 refresh 작업의 큐 키 접두어. 뒤에 프로젝트 root 경로가 붙는다.
+        static constexpr std::string_view kLeiRefreshJobPrefix = "lei-refresh:";
+#if PARUSD_ENABLE_LEI
+        // root별 마지막 refresh 때의 bundle unit 목록. 분석 스레드에서만 접근한다.
+        std::unordered_map<std::string, std::vector<BundleUnitMeta>> lei_refresh_baselines_{};
+#endif
+
+        // PARUSD_SYNC_ANALYSIS=1이면 워커 없이 메시지마다 메인 스레드에서 분석한다(결정적 trace용).
+        bool sync_analysis_ = (std::getenv("PARUSD_SYNC_ANALYSIS") != nullptr);
+        std::mutex queue_mu_{};
+        std::condition_variable queue_cv_{};
+        std::condition_variable idle_cv_{};
+        std::deque<AnalysisJob> queue_{};
+        std::unordered_set<std::string> queued_{};
+        std::chrono::steady_clock::duration debounce_ = std::chrono::milliseconds(150);
+        bool worker_busy_ = false;
+        bool worker_stop_ = false;
+        std::thread worker_{};
+
+        // URI별 증분 파서 세션을 가진 작업 사본. 분석은 워커가 락 밖에서 하고,
+        // 맵 자체(추가/삭제)는 docs_mu_로 보호된다.
+        std::unordered_map<std::string, DocumentState> work_docs_{};
+        // 워커가 락 밖에서 분석 중인 work_docs_ 항목의 URI(없으면 빈 문자열). docs_mu_로 보호된다.
+        std::string active_work_uri_{};
         parus::macro::ExpansionBudget macro_budget_ = parus::macro::default_budget_jit();
         parus::ParserFeatureFlags parser_features_{};
         ServerCImportConfig cimport_cfg_{};